@@ -50,4 +50,20 @@ function(oblo_setup_build_configurations)
     if(OBLO_DEBUG)
         add_definitions(-DOBLO_DEBUG)
     endif()
+
+    if(OBLO_MEMORY_TRACKING)
+        add_definitions(-DOBLO_MEMORY_TRACKING)
+    endif()
+
+    if(OBLO_BUILTIN_PROFILER)
+        add_definitions(-DOBLO_BUILTIN_PROFILER)
+    endif()
+
+    if(OBLO_ENABLE_AVX2)
+        if(MSVC)
+            add_compile_options(/arch:AVX2)
+        else()
+            add_compile_options(-mavx2 -mfma)
+        endif()
+    endif()
 endfunction()
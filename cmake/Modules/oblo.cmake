@@ -3,6 +3,9 @@ include(build_configurations)
 option(OBLO_ENABLE_ASSERT "Enables internal asserts" OFF)
 option(OBLO_DISABLE_COMPILER_OPTIMIZATIONS "Disables compiler optimizations" OFF)
 option(OBLO_DEBUG "Activates code useful for debugging" OFF)
+option(OBLO_MEMORY_TRACKING "Tracks the allocations of the global allocators by memory tag" OFF)
+option(OBLO_ENABLE_AVX2 "Compiles with AVX2 and FMA enabled, which enables the 8-wide math kernels" OFF)
+option(OBLO_BUILTIN_PROFILER "Records profiling scopes with the built-in profiler when Tracy is not enabled" ON)
 
 define_property(GLOBAL PROPERTY oblo_3rdparty_targets BRIEF_DOCS "3rd party targets" FULL_DOCS "List of 3rd party targets")
 
@@ -59,11 +62,13 @@ function(oblo_find_source_files)
     file(GLOB_RECURSE _private_includes src/*.hpp)
     file(GLOB_RECURSE _public_includes include/*.hpp)
     file(GLOB_RECURSE _test_src test/*.cpp test/*.hpp)
+    file(GLOB_RECURSE _benchmark_src benchmark/*.cpp benchmark/*.hpp)
 
     set(_oblo_src ${_src} PARENT_SCOPE)
     set(_oblo_private_includes ${_private_includes} PARENT_SCOPE)
     set(_oblo_public_includes ${_public_includes} PARENT_SCOPE)
     set(_oblo_test_src ${_test_src} PARENT_SCOPE)
+    set(_oblo_benchmark_src ${_benchmark_src} PARENT_SCOPE)
 endfunction(oblo_find_source_files)
 
 function(oblo_add_source_files target)
@@ -93,6 +98,32 @@ function(oblo_add_test_impl name)
     set(_oblo_test_target ${_test_target} PARENT_SCOPE)
 endfunction(oblo_add_test_impl)
 
+function(oblo_add_benchmark_impl name)
+    set(_benchmark_target "${_oblo_target_prefix}_${name}_benchmarks")
+
+    add_executable(${_benchmark_target} ${_oblo_benchmark_src})
+    target_link_libraries(${_benchmark_target} PRIVATE benchmark::benchmark_main)
+
+    add_executable("${_oblo_alias_prefix}::benchmark::${name}" ALIAS ${_benchmark_target})
+
+    set_target_properties(
+        ${_benchmark_target} PROPERTIES
+        FOLDER ${OBLO_FOLDER_TESTS}
+        PROJECT_LABEL "${name}_benchmarks"
+    )
+
+    target_include_directories(
+        ${_benchmark_target} PRIVATE
+        $<BUILD_INTERFACE:${CMAKE_CURRENT_SOURCE_DIR}/benchmark>
+    )
+
+    if(MSVC)
+        set_target_properties(${_benchmark_target} PROPERTIES VS_DEBUGGER_WORKING_DIRECTORY "${CMAKE_RUNTIME_OUTPUT_DIRECTORY}")
+    endif(MSVC)
+
+    set(_oblo_benchmark_target ${_benchmark_target} PARENT_SCOPE)
+endfunction(oblo_add_benchmark_impl)
+
 function(oblo_setup_source_groups target)
     source_group("Private\\Source" FILES ${_oblo_src})
     source_group("Private\\Headers" FILES ${_oblo_private_includes})
@@ -200,6 +231,12 @@ function(oblo_add_library name)
         endif()
     endif()
 
+    if(DEFINED _oblo_benchmark_src)
+        # Benchmarks are not registered as tests, they are meant to be run manually, e.g. through scripts/RunBenchmarks.ps1
+        oblo_add_benchmark_impl(${name})
+        target_link_libraries(${_oblo_benchmark_target} PRIVATE ${_target})
+    endif()
+
     add_library("${_oblo_alias_prefix}::${name}" ALIAS ${_target})
     oblo_setup_source_groups(${_target})
 
@@ -64,7 +64,7 @@ namespace oblo::editor
             time m_baseTime{};
         };
 
-        const log_queue* init_log(time bootTime)
+        log_queue* init_log(time bootTime)
         {
             auto& mm = module_manager::get();
 
@@ -159,6 +159,11 @@ namespace oblo::editor
 
         m_assetRegistry.discover_assets();
 
+        if (!m_assetRegistry.start_watching())
+        {
+            log::warn("Assets will not be reimported automatically when their sources change");
+        }
+
         resourceRegistry.register_provider(&asset_registry::find_artifact_resource, &m_assetRegistry);
 
         if (!m_runtime.init({
@@ -217,6 +222,9 @@ namespace oblo::editor
         m_runtime.shutdown();
         platform::shutdown();
 
+        // Background reimports run on the job manager, so they have to complete before it shuts down
+        m_assetRegistry.shutdown();
+
         m_jobManager.shutdown();
     }
 
@@ -227,6 +235,21 @@ namespace oblo::editor
 
         m_timeStats.dt = dt;
 
+        // Log sinks run on a separate thread, messages are collected here to be displayed in the editor
+        m_logQueue->fetch_pending();
+
+        {
+            m_reimportedArtifacts.clear();
+            m_assetRegistry.update(m_reimportedArtifacts);
+
+            auto& resourceRegistry = m_runtimeRegistry.get_resource_registry();
+
+            for (const auto& artifactId : m_reimportedArtifacts)
+            {
+                resourceRegistry.reload_resource(artifactId);
+            }
+        }
+
         m_runtime.update({.dt = dt});
         m_lastFrameTime = now;
     }
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <oblo/asset/asset_registry.hpp>
+#include <oblo/core/dynamic_array.hpp>
 #include <oblo/core/time/time.hpp>
+#include <oblo/core/uuid.hpp>
 #include <oblo/editor/data/time_stats.hpp>
 #include <oblo/editor/window_manager.hpp>
 #include <oblo/runtime/runtime.hpp>
@@ -46,12 +48,13 @@ namespace oblo::editor
         void update_imgui(const vk::sandbox_update_imgui_context& context);
 
     private:
-        const log_queue* m_logQueue{};
+        log_queue* m_logQueue{};
         job_manager m_jobManager;
         window_manager m_windowManager;
         runtime_registry m_runtimeRegistry;
         runtime m_runtime;
         asset_registry m_assetRegistry;
+        dynamic_array<uuid> m_reimportedArtifacts;
         time_stats m_timeStats{};
         time m_lastFrameTime{};
     };
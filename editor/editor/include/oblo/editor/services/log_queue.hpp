@@ -1,9 +1,12 @@
 #pragma once
 
 #include <oblo/core/deque.hpp>
+#include <oblo/core/dynamic_array.hpp>
 #include <oblo/core/string/cstring_view.hpp>
 #include <oblo/core/time/time.hpp>
 
+#include <mutex>
+
 namespace oblo::log
 {
     enum class severity : u8;
@@ -11,6 +14,9 @@ namespace oblo::log
 
 namespace oblo::editor
 {
+    /// @brief Collects log messages to display in the editor.
+    /// @remarks Messages can be pushed from any thread, but they only become visible to get_messages after
+    /// fetch_pending is called, which is expected to happen on the main thread once per frame.
     class log_queue
     {
     public:
@@ -33,6 +39,9 @@ namespace oblo::editor
 
         void push(log::severity severity, time timestamp, cstring_view message);
 
+        /// @brief Moves the messages pushed since the last call to the list returned by get_messages.
+        void fetch_pending();
+
         const deque<message>& get_messages() const
         {
             return m_messages;
@@ -41,8 +50,15 @@ namespace oblo::editor
     private:
         struct buffer;
 
+    private:
+        struct pending_message;
+
     private:
         deque<buffer> m_stringAllocator;
         deque<message> m_messages;
+
+        std::mutex m_pendingMutex;
+        dynamic_array<pending_message> m_pending;
+        dynamic_array<pending_message> m_fetched;
     };
 }
\ No newline at end of file
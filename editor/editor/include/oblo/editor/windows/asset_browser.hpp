@@ -3,11 +3,15 @@
 #include <oblo/core/dynamic_array.hpp>
 #include <oblo/core/string/string.hpp>
 #include <oblo/core/string/string_builder.hpp>
+#include <oblo/core/time/time.hpp>
 #include <oblo/core/uuid.hpp>
 
+#include <memory>
+
 namespace oblo
 {
     class asset_registry;
+    class batch_importer;
 }
 
 namespace oblo::editor
@@ -17,11 +21,17 @@ namespace oblo::editor
     class asset_browser final
     {
     public:
+        asset_browser();
+        asset_browser(const asset_browser&) = delete;
+        asset_browser(asset_browser&&) = delete;
+        ~asset_browser();
+
         void init(const window_update_context& ctx);
         bool update(const window_update_context& ctx);
 
     private:
         void reset_path();
+        void update_import();
 
     private:
         asset_registry* m_registry{};
@@ -29,5 +39,7 @@ namespace oblo::editor
         string_builder m_current;
         uuid m_expandedAsset{};
         dynamic_array<string> m_breadcrumbs;
+        std::unique_ptr<batch_importer> m_batchImporter;
+        time m_importBegin{};
     };
 }
\ No newline at end of file
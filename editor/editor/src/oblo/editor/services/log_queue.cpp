@@ -9,6 +9,14 @@ namespace oblo::editor
         char data[log::detail::MaxLogMessageLength + 1];
     };
 
+    struct log_queue::pending_message
+    {
+        log::severity severity;
+        time timestamp;
+        u32 length;
+        buffer content;
+    };
+
     constexpr usize MessagesPerDequeChunk{1024};
 
     log_queue::log_queue() :
@@ -21,9 +29,31 @@ namespace oblo::editor
 
     void log_queue::push(log::severity severity, time timestamp, cstring_view message)
     {
-        auto& newMessage = m_stringAllocator.push_back_default();
-        std::memcpy(newMessage.data, message.data(), message.size() + 1);
+        const std::lock_guard lock{m_pendingMutex};
+
+        auto& pending = m_pending.emplace_back();
+        pending.severity = severity;
+        pending.timestamp = timestamp;
+        pending.length = u32(message.size());
+        std::memcpy(pending.content.data, message.data(), message.size() + 1);
+    }
+
+    void log_queue::fetch_pending()
+    {
+        {
+            // Swapping the arrays keeps the lock short, and reuses the memory of the previous frame
+            const std::lock_guard lock{m_pendingMutex};
+            m_pending.swap(m_fetched);
+        }
+
+        for (const auto& pending : m_fetched)
+        {
+            auto& newMessage = m_stringAllocator.push_back_default();
+            std::memcpy(newMessage.data, pending.content.data, pending.length + 1);
+
+            m_messages.emplace_back(pending.severity, pending.timestamp, cstring_view{newMessage.data, pending.length});
+        }
 
-        m_messages.emplace_back(severity, timestamp, cstring_view{newMessage.data, message.size()});
+        m_fetched.clear();
     }
 }
\ No newline at end of file
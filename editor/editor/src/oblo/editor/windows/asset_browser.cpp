@@ -2,6 +2,7 @@
 
 #include <oblo/asset/asset_meta.hpp>
 #include <oblo/asset/asset_registry.hpp>
+#include <oblo/asset/batch_importer.hpp>
 #include <oblo/asset/importer.hpp>
 #include <oblo/core/debug.hpp>
 #include <oblo/core/platform/shell.hpp>
@@ -29,6 +30,10 @@ namespace oblo::editor
         m_current = m_path;
     }
 
+    asset_browser::asset_browser() = default;
+
+    asset_browser::~asset_browser() = default;
+
     bool asset_browser::update(const window_update_context&)
     {
         bool open{true};
@@ -41,27 +46,33 @@ namespace oblo::editor
                 {
                     string_builder file;
 
-                    if (platform::open_file_dialog(file))
+                    if (!m_batchImporter && platform::open_file_dialog(file))
                     {
-                        auto importer = m_registry->create_importer(file);
+                        auto batchImporter = std::make_unique<batch_importer>(*m_registry);
 
-                        if (importer.is_valid() && importer.init())
+                        if (batchImporter->add(file, m_current.view()) && batchImporter->start())
                         {
-                            const data_document defaultImportSettings;
-
-                            const auto timeBegin = clock::now();
-                            const auto success = importer.execute(m_current.view(), defaultImportSettings);
-                            const auto timeEnd = clock::now();
-                            const f32 executionTime = to_f32_seconds(timeEnd - timeBegin);
-
-                            log::info("Import of '{}' {}. Execution time: {:.2f}s",
-                                file,
-                                success ? "succeeded" : "failed",
-                                executionTime);
+                            m_batchImporter = std::move(batchImporter);
+                            m_importBegin = clock::now();
                         }
                     }
                 }
 
+                if (ImGui::MenuItem("Refresh Imports"))
+                {
+                    const auto timeBegin = clock::now();
+                    const auto result = m_registry->refresh_imports();
+                    const auto timeEnd = clock::now();
+                    const f32 executionTime = to_f32_seconds(timeEnd - timeBegin);
+
+                    log::info("Refresh of imports completed: {} reimported, {} up to date, {} failed. Execution time: "
+                              "{:.2f}s",
+                        result.reimported,
+                        result.upToDate,
+                        result.failed,
+                        executionTime);
+                }
+
                 if (ImGui::MenuItem("Open in Explorer"))
                 {
                     platform::open_folder(m_current.view());
@@ -70,6 +81,8 @@ namespace oblo::editor
                 ImGui::EndPopup();
             }
 
+            update_import();
+
             if (m_current != m_path)
             {
                 if (ImGui::Button(".."))
@@ -180,6 +193,48 @@ namespace oblo::editor
         return open;
     }
 
+    void asset_browser::update_import()
+    {
+        if (!m_batchImporter)
+        {
+            return;
+        }
+
+        const auto progress = m_batchImporter->get_progress();
+
+        if (!m_batchImporter->is_done())
+        {
+            ImGui::ProgressBar(f32(progress.completed) / f32(progress.total));
+
+            if (ImGui::Button("Cancel Import"))
+            {
+                m_batchImporter->cancel();
+            }
+
+            return;
+        }
+
+        m_batchImporter->wait();
+
+        const f32 executionTime = to_f32_seconds(clock::now() - m_importBegin);
+
+        for (usize i = 0; i < m_batchImporter->get_files_count(); ++i)
+        {
+            if (m_batchImporter->get_status(i) == batch_import_status::failed)
+            {
+                log::error("Import of '{}' failed", m_batchImporter->get_source_file(i));
+            }
+        }
+
+        log::info("Import completed: {} succeeded, {} failed, {} canceled. Execution time: {:.2f}s",
+            progress.completed - progress.failed - progress.canceled,
+            progress.failed,
+            progress.canceled,
+            executionTime);
+
+        m_batchImporter.reset();
+    }
+
     void asset_browser::reset_path()
     {
         m_current = m_path;
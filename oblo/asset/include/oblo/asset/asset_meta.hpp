@@ -2,6 +2,7 @@
 
 #include <oblo/core/string/string.hpp>
 #include <oblo/core/type_id.hpp>
+#include <oblo/core/types.hpp>
 #include <oblo/core/uuid.hpp>
 
 namespace oblo
@@ -12,6 +13,9 @@ namespace oblo
         type_id type;
         uuid importId;
         string importName;
+        /// @brief Hash of the data, which is stored by content and shared by identical artifacts. It's 0 when the data
+        /// is stored by id instead.
+        u64 contentHash;
     };
 
     struct asset_meta
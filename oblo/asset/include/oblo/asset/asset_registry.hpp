@@ -2,7 +2,9 @@
 
 #include <oblo/core/dynamic_array.hpp>
 #include <oblo/core/string/cstring_view.hpp>
+#include <oblo/core/time/time.hpp>
 #include <oblo/core/type_id.hpp>
+#include <oblo/core/types.hpp>
 
 #include <memory>
 #include <span>
@@ -10,12 +12,14 @@
 namespace oblo
 {
     struct uuid;
+    class data_document;
     class string;
     class string_builder;
 }
 
 namespace oblo
 {
+    class batch_importer;
     class importer;
 
     struct artifact_meta;
@@ -23,8 +27,23 @@ namespace oblo
     struct asset_type_desc;
     struct file_importer_desc;
     struct import_preview;
+    struct import_record;
     struct import_node_config;
 
+    enum class reimport_result : u8
+    {
+        up_to_date,
+        reimported,
+        failed,
+    };
+
+    struct refresh_imports_result
+    {
+        u32 upToDate;
+        u32 reimported;
+        u32 failed;
+    };
+
     class asset_registry
     {
     public:
@@ -41,6 +60,17 @@ namespace oblo
 
         void discover_assets();
 
+        /// @brief Starts watching the assets directory and the source files of the imported assets for changes.
+        /// @remarks Changes are only processed when calling update.
+        /// @param debounce How long files have to stay untouched before their changes are processed.
+        bool start_watching(time debounce = time::from_milliseconds(500u));
+
+        /// @brief Processes the changes detected since watching started. Assets whose sources changed are reimported in
+        /// the background, metas changed in the assets directory by anything but the registry itself are reloaded.
+        /// @param reimportedArtifacts Receives the artifacts that were reimported since the last call, resources
+        /// loaded from these should be reloaded.
+        void update(dynamic_array<uuid>& reimportedArtifacts);
+
         void register_type(const asset_type_desc& desc);
         void unregister_type(type_id type);
         bool has_asset_type(type_id type) const;
@@ -52,10 +82,27 @@ namespace oblo
 
         [[nodiscard]] importer create_importer(cstring_view sourceFile);
 
+        /// @brief Imports an asset again if any of its inputs changed since the last import.
+        /// @remarks The import is considered stale when the content of any source file, the import settings or the
+        /// version of the importer differ from the ones recorded by the last import.
+        reimport_result reimport_if_stale(const uuid& assetId);
+
+        /// @brief Calls reimport_if_stale on all imported assets.
+        refresh_imports_result refresh_imports();
+
         bool find_asset_by_id(const uuid& id, asset_meta& assetMeta) const;
         bool find_asset_by_path(cstring_view path, uuid& id, asset_meta& assetMeta) const;
         bool find_asset_by_meta_path(cstring_view path, uuid& id, asset_meta& assetMeta) const;
 
+        /// @brief Retrieves the path of an asset, relative to the asset directory and without the meta extension, i.e.
+        /// in the form accepted by find_asset_by_path.
+        bool find_asset_path(const uuid& id, string_builder& path) const;
+
+        /// @brief Moves the meta of an asset, keeping the path index up to date.
+        /// @param destination The new path of the asset, without the meta extension. Relative paths are interpreted as
+        /// relative to the asset directory.
+        bool move_asset(const uuid& id, string_view destination);
+
         bool find_asset_artifacts(const uuid& id, dynamic_array<uuid>& artifacts) const;
 
         bool load_artifact_meta(const uuid& artifactId, artifact_meta& artifact) const;
@@ -68,6 +115,7 @@ namespace oblo
 
     private:
         struct impl;
+        friend class batch_importer;
         friend class importer;
 
         enum class write_policy
@@ -79,6 +127,19 @@ namespace oblo
     private:
         uuid generate_uuid();
 
+        /// @brief Checks whether an import is stale and, if so, prepares the importer to reimport it.
+        /// @param deferredSources When not null, the sources are not hashed. Unless the import is already known to be
+        /// stale, they are moved here and the importer is prepared anyway, the caller has to check them before
+        /// executing it.
+        /// @return Either up_to_date or failed, or reimported when the importer is ready to be executed.
+        reimport_result prepare_reimport(const uuid& assetId,
+            importer& assetImporter,
+            data_document& importSettings,
+            string_builder& assetPath,
+            import_record* deferredSources = nullptr);
+
+        void watch_import_sources(const uuid& assetId, std::span<const string> sourceFiles);
+
         bool save_artifact(const uuid& id,
             const type_id& type,
             const void* dataPtr,
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <oblo/asset/importer.hpp>
+#include <oblo/core/dynamic_array.hpp>
+#include <oblo/core/string/cstring_view.hpp>
+#include <oblo/core/string/string.hpp>
+#include <oblo/core/string/string_view.hpp>
+#include <oblo/core/types.hpp>
+#include <oblo/core/uuid.hpp>
+#include <oblo/properties/serialization/data_document.hpp>
+
+#include <atomic>
+#include <mutex>
+
+namespace oblo
+{
+    class asset_registry;
+
+    struct job;
+    using job_handle = job*;
+
+    enum class batch_import_status : u8
+    {
+        pending,
+        importing,
+        succeeded,
+        failed,
+        canceled,
+    };
+
+    struct batch_import_progress
+    {
+        u32 total;
+        /// @brief Number of files that reached a final state, i.e. succeeded, failed or canceled.
+        u32 completed;
+        u32 failed;
+        u32 canceled;
+    };
+
+    /// @brief Imports multiple source files concurrently on the job manager of the calling thread.
+    /// @remarks File importers run in parallel, while the results are saved to the registry by update or wait, on the
+    /// thread that owns the registry. Asset types and file importers should not be registered or unregistered while
+    /// the batch is running.
+    class batch_importer
+    {
+    public:
+        explicit batch_importer(asset_registry& registry);
+        batch_importer(const batch_importer&) = delete;
+        batch_importer(batch_importer&&) noexcept = delete;
+        batch_importer& operator=(const batch_importer&) = delete;
+        batch_importer& operator=(batch_importer&&) noexcept = delete;
+
+        /// @brief Cancels the pending imports and waits for the running ones.
+        ~batch_importer();
+
+        /// @brief Adds a file to the batch, it has to be called before start.
+        /// @return False if no importer is registered for the file, or the batch already started.
+        bool add(cstring_view sourceFile, string_view destinationDir, data_document importSettings = {});
+
+        /// @brief Starts importing all files, the call returns immediately when a job manager is available on the
+        /// calling thread, otherwise the files are imported before returning.
+        bool start();
+
+        /// @brief Requests the cancellation of the batch. Pending files are skipped and files that are being imported
+        /// are not saved to the registry.
+        void cancel();
+
+        /// @brief Saves the files that finished importing to the registry, without waiting for the others.
+        /// @remarks It has to be called from the thread that started the batch, until the batch is done.
+        void update();
+
+        /// @brief Waits for the batch to complete and saves the results, it has to be called from the thread that
+        /// started it.
+        void wait();
+
+        bool is_done() const;
+
+        batch_import_progress get_progress() const;
+
+        usize get_files_count() const;
+        cstring_view get_source_file(usize index) const;
+        batch_import_status get_status(usize index) const;
+
+        /// @brief Retrieves the id of the asset created by the import, only valid if the import succeeded.
+        uuid get_import_id(usize index) const;
+
+    private:
+        struct file_import
+        {
+            importer fileImporter;
+            string destinationDir;
+            data_document importSettings;
+            uuid importId;
+            uuid importUuid;
+            batch_import_status status;
+        };
+
+    private:
+        void import_file(usize index);
+        void finalize_file(file_import& file);
+        void complete_file(file_import& file, batch_import_status status);
+
+    private:
+        asset_registry* m_registry{};
+        dynamic_array<file_import> m_files;
+        job_handle m_job{};
+        bool m_started{};
+        std::atomic<bool> m_cancel{};
+        std::atomic<u32> m_completed{};
+        std::atomic<u32> m_failed{};
+        std::atomic<u32> m_canceled{};
+
+        // Files that were imported successfully, waiting for update to save them
+        std::mutex m_importedMutex;
+        dynamic_array<usize> m_imported;
+    };
+}
\ No newline at end of file
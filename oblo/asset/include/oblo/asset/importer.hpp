@@ -15,6 +15,7 @@
 namespace oblo
 {
     class asset_registry;
+    class batch_importer;
     class importer;
 
     struct artifact_meta;
@@ -53,7 +54,10 @@ namespace oblo
         importer(const importer&) = delete;
         importer(importer&&) noexcept;
 
-        importer(importer_config config, const type_id& importerType, std::unique_ptr<file_importer> fileImporter);
+        importer(importer_config config,
+            const type_id& importerType,
+            u32 importerVersion,
+            std::unique_ptr<file_importer> fileImporter);
 
         ~importer();
 
@@ -64,6 +68,12 @@ namespace oblo
 
         bool execute(string_view destinationDir, const data_document& importSettings);
 
+        /// @brief Imports again an asset that was previously imported, overwriting it.
+        /// @remarks The asset and the artifacts keep their ids, so references to them stay valid.
+        /// @param assetId The id of the asset to overwrite.
+        /// @param assetPath The path of the asset, without the meta extension.
+        bool reimport(const uuid& assetId, string_view assetPath, const data_document& importSettings);
+
         bool is_valid() const noexcept;
 
         const importer_config& get_config() const;
@@ -71,9 +81,26 @@ namespace oblo
         uuid get_import_id() const;
 
     private:
+        friend class asset_registry;
+        friend class batch_importer;
+
+    private:
+        bool execute_impl(const uuid& importId,
+            string_view destinationDir,
+            string_view assetName,
+            const data_document& importSettings,
+            bool overwrite);
+
+        /// @brief Runs the file importer, without modifying the registry.
+        bool run_import(const uuid& importId, const uuid& importUuid, const data_document& importSettings);
+
         bool begin_import(asset_registry& registry, std::span<import_node_config> importNodesConfig);
-        bool finalize_import(asset_registry& registry, string_view destinationDir);
-        bool write_source_files(std::span<const string> sourceFiles);
+        bool finalize_import(asset_registry& registry,
+            string_view destinationDir,
+            string_view assetName,
+            const data_document& importSettings,
+            bool overwrite);
+        bool write_source_files(std::span<const string> sourceFiles, const data_document& importSettings);
 
     private:
         importer_config m_config;
@@ -83,6 +110,7 @@ namespace oblo
         std::unordered_map<uuid, artifact_meta> m_artifacts;
         uuid m_importId{};
         type_id m_importerType{};
+        u32 m_importerVersion{};
     };
 
     using create_file_importer_fn = std::unique_ptr<file_importer> (*)();
@@ -92,5 +120,7 @@ namespace oblo
         type_id type;
         create_file_importer_fn create;
         std::span<const string_view> extensions;
+        /// @brief Should be increased when the output of the importer changes, to make previous imports stale.
+        u32 version;
     };
 }
\ No newline at end of file
@@ -0,0 +1,210 @@
+#include <oblo/asset/asset_database.hpp>
+
+#include <oblo/core/filesystem/filesystem.hpp>
+#include <oblo/core/string/string_builder.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace oblo
+{
+    namespace
+    {
+        static_assert(sizeof(asset_database_header) % alignof(asset_database_entry) == 0);
+        static_assert(sizeof(asset_database_entry) % alignof(uuid) == 0);
+    }
+
+    expected<> asset_database_reader::open(cstring_view path)
+    {
+        close();
+
+        if (!m_file.open(path))
+        {
+            return unspecified_error;
+        }
+
+        const auto bytes = m_file.get_bytes();
+
+        if (bytes.size() < sizeof(asset_database_header))
+        {
+            close();
+            return unspecified_error;
+        }
+
+        asset_database_header header;
+        std::memcpy(&header, bytes.data(), sizeof(header));
+
+        const usize entriesSize = usize{header.entriesCount} * sizeof(asset_database_entry);
+        const usize artifactsSize = usize{header.artifactsCount} * sizeof(uuid);
+
+        if (header.magic != AssetDatabaseMagic || header.version != AssetDatabaseVersion ||
+            bytes.size() != sizeof(header) + entriesSize + artifactsSize + header.stringsSize)
+        {
+            close();
+            return unspecified_error;
+        }
+
+        const byte* it = bytes.data() + sizeof(header);
+
+        m_entries = {reinterpret_cast<const asset_database_entry*>(it), header.entriesCount};
+        it += entriesSize;
+
+        m_artifacts = {reinterpret_cast<const uuid*>(it), header.artifactsCount};
+        it += artifactsSize;
+
+        m_strings = {reinterpret_cast<const char*>(it), header.stringsSize};
+
+        // Validate all ranges once, so lookups don't need to
+        for (const auto& entry : m_entries)
+        {
+            if (usize{entry.pathOffset} + entry.pathLength > m_strings.size() ||
+                usize{entry.typeHintOffset} + entry.typeHintLength > m_strings.size() ||
+                usize{entry.firstArtifact} + entry.artifactsCount > m_artifacts.size())
+            {
+                close();
+                return unspecified_error;
+            }
+        }
+
+        m_file.advise(filesystem::mapped_file_advice::random);
+
+        return no_error;
+    }
+
+    void asset_database_reader::close()
+    {
+        m_file.close();
+        m_entries = {};
+        m_artifacts = {};
+        m_strings = {};
+    }
+
+    u32 asset_database_reader::get_entries_count() const
+    {
+        return u32(m_entries.size());
+    }
+
+    bool asset_database_reader::find(string_view path, asset_database_record& record) const
+    {
+        const auto it = std::lower_bound(m_entries.begin(),
+            m_entries.end(),
+            path,
+            [this](const asset_database_entry& entry, string_view p)
+            { return get_string(entry.pathOffset, entry.pathLength).compare(p) < 0; });
+
+        if (it == m_entries.end() || get_string(it->pathOffset, it->pathLength) != path)
+        {
+            return false;
+        }
+
+        record = {
+            .id = it->id,
+            .mainArtifactHint = it->mainArtifactHint,
+            .stamp = it->stamp,
+            .typeHint = get_string(it->typeHintOffset, it->typeHintLength),
+            .isImported = it->isImported != 0,
+            .artifacts = m_artifacts.subspan(it->firstArtifact, it->artifactsCount),
+        };
+
+        return true;
+    }
+
+    string_view asset_database_reader::get_string(u32 offset, u32 length) const
+    {
+        return m_strings.substr(offset, length);
+    }
+
+    void asset_database_writer::add(string_view path, const asset_database_record& record)
+    {
+        auto& entry = m_entries.push_back_default();
+
+        entry = {
+            .id = record.id,
+            .mainArtifactHint = record.mainArtifactHint,
+            .stamp = record.stamp,
+            .pathOffset = add_string(path),
+            .pathLength = u32(path.size()),
+            .typeHintOffset = add_string(record.typeHint),
+            .typeHintLength = u32(record.typeHint.size()),
+            .firstArtifact = u32(m_artifacts.size()),
+            .artifactsCount = u32(record.artifacts.size()),
+            .isImported = u8(record.isImported),
+        };
+
+        m_artifacts.append(record.artifacts.begin(), record.artifacts.end());
+    }
+
+    expected<> asset_database_writer::write(cstring_view path)
+    {
+        const string_view strings{m_strings.data(), m_strings.size()};
+
+        // Entries are sorted by path, to allow binary searching them when reading
+        std::sort(m_entries.begin(),
+            m_entries.end(),
+            [strings](const asset_database_entry& lhs, const asset_database_entry& rhs)
+            {
+                return strings.substr(lhs.pathOffset, lhs.pathLength)
+                           .compare(strings.substr(rhs.pathOffset, rhs.pathLength)) < 0;
+            });
+
+        const asset_database_header header{
+            .magic = AssetDatabaseMagic,
+            .version = AssetDatabaseVersion,
+            .entriesCount = u32(m_entries.size()),
+            .artifactsCount = u32(m_artifacts.size()),
+            .stringsSize = u32(m_strings.size()),
+        };
+
+        const usize entriesSize = m_entries.size() * sizeof(asset_database_entry);
+        const usize artifactsSize = m_artifacts.size() * sizeof(uuid);
+
+        string_builder tmpPath;
+        tmpPath.append(path).append(".tmp");
+
+        {
+            filesystem::mapped_file file;
+
+            if (!file.create(tmpPath, sizeof(header) + entriesSize + artifactsSize + m_strings.size()))
+            {
+                return unspecified_error;
+            }
+
+            byte* it = file.get_writable_bytes().data();
+
+            std::memcpy(it, &header, sizeof(header));
+            it += sizeof(header);
+
+            // Each copy is guarded, since the arrays might be empty and have no data
+            if (entriesSize != 0)
+            {
+                std::memcpy(it, m_entries.data(), entriesSize);
+                it += entriesSize;
+            }
+
+            if (artifactsSize != 0)
+            {
+                std::memcpy(it, m_artifacts.data(), artifactsSize);
+                it += artifactsSize;
+            }
+
+            if (!m_strings.empty())
+            {
+                std::memcpy(it, m_strings.data(), m_strings.size());
+            }
+
+            if (!file.flush())
+            {
+                return unspecified_error;
+            }
+        }
+
+        return filesystem::rename(tmpPath, path);
+    }
+
+    u32 asset_database_writer::add_string(string_view str)
+    {
+        const auto offset = u32(m_strings.size());
+        m_strings.append(str.begin(), str.end());
+        return offset;
+    }
+}
\ No newline at end of file
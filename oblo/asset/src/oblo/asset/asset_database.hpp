@@ -0,0 +1,108 @@
+#pragma once
+
+#include <oblo/core/dynamic_array.hpp>
+#include <oblo/core/expected.hpp>
+#include <oblo/core/filesystem/mapped_file.hpp>
+#include <oblo/core/string/cstring_view.hpp>
+#include <oblo/core/string/string_view.hpp>
+#include <oblo/core/types.hpp>
+#include <oblo/core/uuid.hpp>
+
+#include <span>
+
+namespace oblo
+{
+    // The asset database caches the asset metas found in the assets directory, so that startup only needs to parse the
+    // metas that changed since the last run. It's a single file made of a header, followed by the entries sorted by
+    // path, the artifacts of all entries and finally the strings referenced by the entries.
+
+    constexpr u32 AssetDatabaseMagic{0x4244414F}; // OADB
+    constexpr u32 AssetDatabaseVersion{1};
+
+    constexpr cstring_view AssetDatabaseFileName{"assets.odb"};
+
+    /// @brief Identifies the state of a file on disk, when it doesn't match the file has to be parsed again.
+    struct file_stamp
+    {
+        i64 lastWriteTime;
+        u64 size;
+
+        bool operator==(const file_stamp&) const = default;
+    };
+
+    struct asset_database_header
+    {
+        u32 magic;
+        u32 version;
+        u32 entriesCount;
+        u32 artifactsCount;
+        u32 stringsSize;
+        u32 reserved;
+    };
+
+    struct asset_database_entry
+    {
+        uuid id;
+        uuid mainArtifactHint;
+        file_stamp stamp;
+        u32 pathOffset;
+        u32 pathLength;
+        u32 typeHintOffset;
+        u32 typeHintLength;
+        u32 firstArtifact;
+        u32 artifactsCount;
+        u8 isImported;
+        u8 reserved[7];
+    };
+
+    struct asset_database_record
+    {
+        uuid id;
+        uuid mainArtifactHint;
+        file_stamp stamp;
+        /// @brief The type hint as written in the meta, it might not be registered.
+        string_view typeHint;
+        bool isImported;
+        std::span<const uuid> artifacts;
+    };
+
+    /// @brief Memory maps the asset database, records point into the mapping and are valid until it's closed.
+    class asset_database_reader
+    {
+    public:
+        expected<> open(cstring_view path);
+        void close();
+
+        u32 get_entries_count() const;
+
+        /// @brief Looks up the record of a meta, given its path relative to the assets directory.
+        bool find(string_view path, asset_database_record& record) const;
+
+    private:
+        string_view get_string(u32 offset, u32 length) const;
+
+    private:
+        filesystem::mapped_file m_file;
+        std::span<const asset_database_entry> m_entries;
+        std::span<const uuid> m_artifacts;
+        string_view m_strings;
+    };
+
+    class asset_database_writer
+    {
+    public:
+        /// @brief Adds the record of a meta, given its path relative to the assets directory.
+        void add(string_view path, const asset_database_record& record);
+
+        /// @brief Writes the database to a temporary file first, then replaces the destination.
+        expected<> write(cstring_view path);
+
+    private:
+        u32 add_string(string_view str);
+
+    private:
+        dynamic_array<asset_database_entry> m_entries;
+        dynamic_array<uuid> m_artifacts;
+        dynamic_array<char> m_strings;
+    };
+}
\ No newline at end of file
@@ -1,23 +1,51 @@
 #include <oblo/asset/asset_registry.hpp>
 
 #include <oblo/asset/any_asset.hpp>
+#include <oblo/asset/asset_database.hpp>
 #include <oblo/asset/asset_meta.hpp>
 #include <oblo/asset/asset_type_desc.hpp>
 #include <oblo/asset/import_artifact.hpp>
 #include <oblo/asset/import_preview.hpp>
+#include <oblo/asset/import_record.hpp>
 #include <oblo/asset/importer.hpp>
 #include <oblo/core/array_size.hpp>
 #include <oblo/core/debug.hpp>
+#include <oblo/core/filesystem/file.hpp>
 #include <oblo/core/filesystem/filesystem.hpp>
+#include <oblo/core/filesystem/mapped_file.hpp>
+#include <oblo/core/flat_hash_map.hpp>
+#include <oblo/core/flat_hash_set.hpp>
+#include <oblo/core/memory_tracking.hpp>
 #include <oblo/log/log.hpp>
 #include <oblo/core/string/string_builder.hpp>
+#include <oblo/core/string/transparent_string_hash.hpp>
+#include <oblo/core/time/clock.hpp>
 #include <oblo/core/uuid.hpp>
+#include <oblo/core/utility.hpp>
 #include <oblo/core/uuid_generator.hpp>
+#include <oblo/properties/serialization/data_document.hpp>
+#include <oblo/properties/serialization/json.hpp>
+#include <oblo/thread/job_manager.hpp>
+#include <oblo/thread/parallel_for.hpp>
 
 #include <nlohmann/json.hpp>
 
+#define RAPIDJSON_ASSERT(x) OBLO_ASSERT(x)
+
+#include <rapidjson/reader.h>
+
+#include <efsw/efsw.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
-#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
 #include <vector>
 
 namespace oblo
@@ -32,80 +60,213 @@ namespace oblo
         {
             create_file_importer_fn create;
             dynamic_array<string> extensions;
+            u32 version;
         };
 
-        using asset_types_map = std::unordered_map<type_id, asset_type_info>;
+        using asset_types_map = flat_hash_map<type_id, asset_type_info>;
 
-        bool load_asset_meta(asset_meta& meta,
-            std::vector<uuid>& artifacts,
-            const asset_types_map& assetTypes,
-            const std::filesystem::path& path)
+        nlohmann::json parse_json(std::span<const byte> bytes)
         {
-            std::ifstream in{path};
+            const auto* const begin = reinterpret_cast<const char*>(bytes.data());
+            return nlohmann::json::parse(begin, begin + bytes.size(), nullptr, false);
+        }
 
-            if (!in)
+        // Reads the asset meta with a SAX parser, in-situ on the file buffer, to avoid building a DOM for each asset
+        class asset_meta_handler : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, asset_meta_handler>
+        {
+        public:
+            asset_meta_handler(asset_meta& meta, std::vector<uuid>& artifacts, string& typeHint) :
+                m_meta{meta}, m_artifacts{artifacts}, m_typeHint{typeHint}
             {
-                return false;
             }
 
-            const auto json = nlohmann::json::parse(in, nullptr, false);
-
-            if (json.is_discarded())
+            bool is_complete() const
             {
-                return false;
+                return m_hasId && m_hasMainArtifactHint;
             }
 
-            const std::string_view id = json["id"].get<std::string_view>();
-
-            if (auto parsed = uuid::parse(id))
+            bool Key(const char* str, rapidjson::SizeType length, bool)
             {
-                meta.id = *parsed;
+                if (m_depth == 1)
+                {
+                    const string_view key{str, length};
+
+                    if (key == "id")
+                    {
+                        m_field = field::id;
+                    }
+                    else if (key == "mainArtifactHint")
+                    {
+                        m_field = field::main_artifact_hint;
+                    }
+                    else if (key == "typeHint")
+                    {
+                        m_field = field::type_hint;
+                    }
+                    else if (key == "isImported")
+                    {
+                        m_field = field::is_imported;
+                    }
+                    else if (key == "artifacts")
+                    {
+                        m_field = field::artifacts;
+                    }
+                    else
+                    {
+                        m_field = field::none;
+                    }
+                }
+
+                return true;
             }
-            else
+
+            bool String(const char* str, rapidjson::SizeType length, bool)
             {
-                return false;
+                const string_view value{str, length};
+
+                if (m_isInArtifacts)
+                {
+                    if (m_depth == 2)
+                    {
+                        if (const auto parsed = uuid::parse(value))
+                        {
+                            m_artifacts.emplace_back(*parsed);
+                        }
+                    }
+
+                    return true;
+                }
+
+                if (m_depth != 1)
+                {
+                    return true;
+                }
+
+                switch (std::exchange(m_field, field::none))
+                {
+                case field::id:
+                    m_hasId = m_meta.id.parse_from(value);
+                    return m_hasId;
+
+                case field::main_artifact_hint:
+                    m_hasMainArtifactHint = m_meta.mainArtifactHint.parse_from(value);
+                    return m_hasMainArtifactHint;
+
+                case field::type_hint:
+                    m_typeHint = value;
+                    return true;
+
+                default:
+                    return true;
+                }
             }
 
-            const hashed_string_view type{json["typeHint"].get<std::string_view>()};
+            bool Bool(bool b)
+            {
+                if (m_depth == 1 && std::exchange(m_field, field::none) == field::is_imported)
+                {
+                    m_meta.isImported = b;
+                }
+
+                return true;
+            }
 
-            const auto typeIt = assetTypes.find(type_id{type});
+            bool StartObject()
+            {
+                ++m_depth;
+                return true;
+            }
 
-            if (typeIt != assetTypes.end())
+            bool EndObject(rapidjson::SizeType)
             {
-                meta.typeHint = typeIt->first;
+                --m_depth;
+                m_field = field::none;
+                return true;
             }
 
-            const std::string_view mainArtifactHint = json["mainArtifactHint"].get<std::string_view>();
+            bool StartArray()
+            {
+                m_isInArtifacts = m_depth == 1 && m_field == field::artifacts;
+                ++m_depth;
+                return true;
+            }
 
-            if (auto parsed = uuid::parse(mainArtifactHint))
+            bool EndArray(rapidjson::SizeType)
             {
-                meta.mainArtifactHint = *parsed;
+                if (--m_depth == 1)
+                {
+                    m_isInArtifacts = false;
+                    m_field = field::none;
+                }
+
+                return true;
             }
-            else
+
+            // Any other value (null, numbers) is ignored
+            bool Default()
             {
-                return false;
+                if (m_depth == 1)
+                {
+                    m_field = field::none;
+                }
+
+                return true;
             }
 
-            const auto isImported = json.find("isImported");
+        private:
+            enum class field : u8
+            {
+                none,
+                id,
+                main_artifact_hint,
+                type_hint,
+                is_imported,
+                artifacts,
+            };
+
+        private:
+            asset_meta& m_meta;
+            std::vector<uuid>& m_artifacts;
+            string& m_typeHint;
+            u32 m_depth{};
+            field m_field{field::none};
+            bool m_isInArtifacts{};
+            bool m_hasId{};
+            bool m_hasMainArtifactHint{};
+        };
+
+        type_id find_type_hint(const asset_types_map& assetTypes, string_view typeHint)
+        {
+            const auto typeIt = assetTypes.find(type_id{hashed_string_view{typeHint}});
+            return typeIt != assetTypes.end() ? typeIt->first : type_id{};
+        }
+
+        bool load_asset_meta(asset_meta& meta,
+            std::vector<uuid>& artifacts,
+            string& typeHint,
+            const asset_types_map& assetTypes,
+            cstring_view path,
+            string_builder& buffer)
+        {
+            const auto content = filesystem::load_text_file_into_memory(buffer, path);
 
-            if (isImported != json.end())
+            if (!content || content->empty())
             {
-                meta.isImported = isImported->get<bool>();
+                return false;
             }
 
-            const auto artifactsJson = json.find("artifacts");
+            asset_meta_handler handler{meta, artifacts, typeHint};
+
+            // The builder is null-terminated, as required by the in-situ stream
+            rapidjson::InsituStringStream stream{content->data()};
+            rapidjson::Reader reader;
 
-            if (artifactsJson != json.end())
+            if (reader.Parse<rapidjson::kParseInsituFlag>(stream, handler).IsError() || !handler.is_complete())
             {
-                for (auto& artifact : *artifactsJson)
-                {
-                    if (const auto parsed = uuid::parse(artifact.get<std::string_view>()))
-                    {
-                        artifacts.emplace_back(*parsed);
-                    }
-                }
+                return false;
             }
 
+            meta.typeHint = find_type_hint(assetTypes, typeHint);
             return true;
         }
 
@@ -138,31 +299,28 @@ namespace oblo
             return !ofs.bad();
         }
 
-        // TODO: Need to read the full meta instead
-        bool load_asset_id_from_meta(string_view path, uuid& id)
-        {
-            std::ifstream in{path.as<std::string>()};
+        constexpr std::string_view ArtifactContentDirectory{"content"};
 
-            if (!in)
-            {
-                return false;
-            }
+        string_builder& append_content_hash(string_builder& out, u64 hash)
+        {
+            return out.format("{:016x}", hash);
+        }
 
-            const auto json = nlohmann::json::parse(in, nullptr, false);
+        // Checks the whole content of two files, since a matching hash is not enough to share the data
+        bool have_same_content(cstring_view lhs, cstring_view rhs)
+        {
+            filesystem::mapped_file lhsFile, rhsFile;
 
-            if (json.is_discarded())
+            if (!lhsFile.open(lhs) || !rhsFile.open(rhs))
             {
                 return false;
             }
 
-            const auto it = json.find("id");
+            const auto lhsBytes = lhsFile.get_bytes();
+            const auto rhsBytes = rhsFile.get_bytes();
 
-            if (it == json.end())
-            {
-                return false;
-            }
-
-            return id.parse_from(it->get<std::string_view>());
+            return lhsBytes.size() == rhsBytes.size() &&
+                (lhsBytes.empty() || std::memcmp(lhsBytes.data(), rhsBytes.data(), lhsBytes.size()) == 0);
         }
 
         bool save_artifact_meta(const artifact_meta& artifact, cstring_view destination)
@@ -184,6 +342,12 @@ namespace oblo
                 json["name"] = artifact.importName.as<std::string>();
             }
 
+            if (artifact.contentHash != 0)
+            {
+                string_builder contentHash;
+                json["content"] = append_content_hash(contentHash, artifact.contentHash).view().as<std::string_view>();
+            }
+
             std::ofstream ofs{destination.as<std::string>()};
 
             if (!ofs)
@@ -195,18 +359,35 @@ namespace oblo
             return !ofs.bad();
         }
 
+        bool parse_content_hash(const nlohmann::json& json, u64& contentHash)
+        {
+            contentHash = 0;
+
+            if (const auto it = json.find("content"); it != json.end() && it->is_string())
+            {
+                const auto str = it->get<std::string_view>();
+
+                if (std::from_chars(str.data(), str.data() + str.size(), contentHash, 16).ec != std::errc{})
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
         bool load_artifact_meta(cstring_view source,
-            const std::unordered_map<type_id, asset_type_info>& assetTypes,
+            const asset_types_map& assetTypes,
             artifact_meta& artifact)
         {
-            std::ifstream ifs{source.as<std::string>()};
+            filesystem::mapped_file file;
 
-            if (!ifs)
+            if (!file.open(source))
             {
                 return false;
             }
 
-            const auto json = nlohmann::json::parse(ifs, nullptr, false);
+            const auto json = parse_json(file.get_bytes());
 
             if (json.empty())
             {
@@ -241,9 +422,50 @@ namespace oblo
             if (const auto it = json.find("importId"); it != json.end())
             {
                 const auto id = uuid::parse(it->get<std::string_view>());
-                artifact.id = id ? *id : uuid{};
+                artifact.importId = id ? *id : uuid{};
+            }
+
+            return parse_content_hash(json, artifact.contentHash);
+        }
+
+        // Only reads the content hash, which doesn't require the type of the artifact to be registered
+        bool load_artifact_content_hash(cstring_view source, u64& contentHash)
+        {
+            filesystem::mapped_file file;
+
+            if (!file.open(source))
+            {
+                return false;
+            }
+
+            const auto json = parse_json(file.get_bytes());
+            return !json.empty() && parse_content_hash(json, contentHash);
+        }
+
+        bool get_file_stamp(cstring_view path, file_stamp& out)
+        {
+            std::error_code ec;
+            const std::filesystem::path p{std::u8string_view{path.u8data(), path.size()}};
+
+            const auto lastWriteTime = std::filesystem::last_write_time(p, ec);
+
+            if (ec)
+            {
+                return false;
+            }
+
+            const auto size = std::filesystem::file_size(p, ec);
+
+            if (ec)
+            {
+                return false;
             }
 
+            out = {
+                .lastWriteTime = lastWriteTime.time_since_epoch().count(),
+                .size = size,
+            };
+
             return true;
         }
 
@@ -261,137 +483,1038 @@ namespace oblo
         {
             asset_meta meta;
             std::vector<uuid> artifacts;
+            /// @brief Key in the path index, empty if the meta is not in the assets directory.
+            string path;
         };
 
         constexpr std::string_view ArtifactMetaExtension{".oartifact"};
-    }
 
-    struct asset_registry::impl
-    {
-        uuid_random_generator uuidGenerator;
-        std::unordered_map<type_id, asset_type_info> assetTypes;
-        std::unordered_map<type_id, file_importer_info> importers;
-        std::unordered_map<uuid, asset_entry> assets;
-        string_builder assetsDir;
-        string_builder artifactsDir;
-        string_builder sourceFilesDir;
+#ifdef _WIN32
+        constexpr bool IsFileSystemCaseInsensitive{true};
+#else
+        constexpr bool IsFileSystemCaseInsensitive{false};
+#endif
 
-        string_builder& make_asset_path(string_builder& out, string_view directory)
+        // Only ASCII letters are folded, which covers drive letters and the names used for assets in practice
+        template <typename Char>
+        constexpr Char fold_path_char(Char c)
         {
-            if (filesystem::is_relative(directory))
+            if constexpr (IsFileSystemCaseInsensitive)
             {
-                out.append(assetsDir);
-                out.append_path_separator();
+                return c >= Char('A') && c <= Char('Z') ? Char(c - Char('A') + Char('a')) : c;
+            }
+            else
+            {
+                return c;
             }
-
-            out.append(directory);
-            return out;
         }
-    };
-
-    asset_registry::asset_registry() = default;
 
-    asset_registry::~asset_registry()
-    {
-        shutdown();
-    }
-
-    bool asset_registry::initialize(cstring_view assetsDir, cstring_view artifactsDir, cstring_view sourceFilesDir)
-    {
-        if (!ensure_directories(assetsDir) || !ensure_directories(artifactsDir) || !ensure_directories(sourceFilesDir))
+        bool are_path_components_equal(const std::filesystem::path& lhs, const std::filesystem::path& rhs)
         {
-            return false;
+            const auto& l = lhs.native();
+            const auto& r = rhs.native();
+
+            return std::equal(l.begin(),
+                l.end(),
+                r.begin(),
+                r.end(),
+                [](auto a, auto b) { return fold_path_char(a) == fold_path_char(b); });
         }
 
-        m_impl = std::make_unique<impl>();
+        // Keys of the path index, which ignore case where the file system does
+        struct index_path_hash
+        {
+            using is_transparent = void;
 
-        m_impl->assetsDir.append(assetsDir).make_absolute_path();
-        m_impl->artifactsDir.append(artifactsDir).make_absolute_path();
-        m_impl->sourceFilesDir.append(sourceFilesDir).make_absolute_path();
+            usize operator()(string_view str) const
+            {
+                if constexpr (!IsFileSystemCaseInsensitive)
+                {
+                    return hash<string_view>{}(str);
+                }
+                else
+                {
+                    // Folded in chunks, to avoid allocating a lowercase copy
+                    char buffer[64];
+                    usize h{};
 
-        return true;
-    }
+                    for (usize offset = 0; offset < str.size(); offset += array_size(buffer))
+                    {
+                        const usize count = min(str.size() - offset, usize{array_size(buffer)});
 
-    void asset_registry::shutdown()
-    {
-        m_impl.reset();
-    }
+                        for (usize i = 0; i < count; ++i)
+                        {
+                            buffer[i] = fold_path_char(str.at(offset + i));
+                        }
 
-    void asset_registry::register_type(const asset_type_desc& desc)
-    {
-        m_impl->assetTypes.emplace(desc.type, desc);
-    }
+                        h = hash_xxhz(buffer, count, h);
+                    }
 
-    void asset_registry::unregister_type(type_id type)
-    {
-        m_impl->assetTypes.erase(type);
-    }
+                    return h;
+                }
+            }
 
-    bool asset_registry::has_asset_type(type_id type) const
-    {
-        return m_impl->assetTypes.contains(type);
-    }
+            usize operator()(const string& str) const
+            {
+                return (*this)(string_view{str.data(), str.size()});
+            }
+        };
 
-    bool asset_registry::create_directories(string_view directory)
-    {
-        string_builder sb;
-        m_impl->make_asset_path(sb, directory);
+        struct index_path_equal
+        {
+            using is_transparent = void;
 
-        return ensure_directories(sb);
-    }
+            template <typename L, typename R>
+            bool operator()(const L& lhs, const R& rhs) const
+            {
+                return std::equal(lhs.data(),
+                    lhs.data() + lhs.size(),
+                    rhs.data(),
+                    rhs.data() + rhs.size(),
+                    [](char a, char b) { return fold_path_char(a) == fold_path_char(b); });
+            }
+        };
 
-    void asset_registry::register_file_importer(const file_importer_desc& desc)
-    {
-        const auto [it, inserted] = m_impl->importers.emplace(desc.type, file_importer_info{});
+        template <typename T>
+        using index_path_map = flat_hash_map<string, T, index_path_hash, index_path_equal>;
 
-        if (inserted)
-        {
-            auto& info = it->second;
-            info.create = desc.create;
-            info.extensions.reserve(desc.extensions.size());
+        using string_set = flat_hash_set<string, transparent_string_hash, transparent_string_equal>;
 
-            for (const string_view ext : desc.extensions)
+        // Collects the files touched on disk, along with the time of the last change, to debounce the processing
+        struct watch_listener final : efsw::FileWatchListener
+        {
+            void handleFileAction(
+                efsw::WatchID, const std::string& dir, const std::string& filename, efsw::Action, std::string) override
             {
-                info.extensions.emplace_back(ext.as<string>());
+                const auto now = clock::now();
+
+                std::lock_guard lock{mutex};
+                builder.clear().append(dir).append_path(filename);
+                touchedFiles[builder.as<string>()] = now;
             }
-        }
-    }
 
-    void asset_registry::unregister_file_importer(type_id type)
-    {
-        m_impl->importers.erase(type);
-    }
+            std::mutex mutex;
+            string_builder builder;
+            flat_hash_map<string, time, transparent_string_hash, transparent_string_equal> touchedFiles;
+        };
 
-    importer asset_registry::create_importer(cstring_view sourceFile)
-    {
-        const auto ext = filesystem::extension(sourceFile);
+        // The importer runs on a worker thread, while the results are saved on the thread that updates the registry
+        struct background_reimport
+        {
+            uuid assetId;
+            uuid importUuid;
+            importer assetImporter;
+            data_document importSettings;
+            string_builder assetPath;
+            // Sources to hash before running the importer, empty when the import is already known to be stale
+            import_record deferredSources;
+            string_builder importDir;
+            job_handle job{};
+            std::atomic<bool> isDone{};
+            bool succeeded{};
+            bool isUpToDate{};
+        };
 
-        for (auto& [type, assetImporter] : m_impl->importers)
+        // Hashing the sources is the expensive part of checking whether an import is stale
+        expected<bool> have_import_sources_changed(const uuid& assetId,
+            std::span<const import_source_record> sources,
+            string_view importDir,
+            string_view assetsDir)
         {
-            for (const auto& importerExt : assetImporter.extensions)
+            string_builder sourcePath;
+
+            for (const auto& source : sources)
             {
-                if (importerExt == ext)
+                resolve_import_record_path(sourcePath, source.path, assetsDir);
+
+                auto sourceHash = hash_file_content(sourcePath);
+
+                if (!sourceHash)
                 {
-                    return importer{
-                        importer_config{
-                            .registry = this,
-                            .sourceFile = sourceFile.as<string>(),
-                        },
-                        type,
-                        assetImporter.create(),
-                    };
+                    // The original might not be available on this machine, in which case the copy stored with the
+                    // import tells whether the import is still up to date
+                    sourcePath.clear().append(importDir).append_path(filesystem::filename(source.path));
+                    sourceHash = hash_file_content(sourcePath);
+                }
+
+                if (!sourceHash)
+                {
+                    log::error("Asset {} cannot be reimported, source file {} is missing", assetId, source.path);
+                    return unspecified_error;
+                }
+
+                if (*sourceHash != source.hash)
+                {
+                    return true;
                 }
             }
+
+            return false;
         }
 
-        return {};
+        // Source files are matched against the paths reported by the watcher, so both are made absolute and normal
+        void make_watch_key(string_builder& out, string_view path)
+        {
+            std::error_code ec;
+            const auto p = std::filesystem::absolute(std::u8string_view{path.u8data(), path.size()}, ec);
+            out.clear().append(p.lexically_normal().generic_u8string().c_str());
+        }
     }
 
-    uuid asset_registry::generate_uuid()
+    struct asset_registry::impl
+    {
+        uuid_random_generator uuidGenerator;
+        asset_types_map assetTypes;
+        flat_hash_map<type_id, file_importer_info> importers;
+        flat_hash_map<uuid, asset_entry> assets;
+        index_path_map<uuid> pathToId;
+        string_builder assetsDir;
+        string_builder artifactsDir;
+        string_builder sourceFilesDir;
+        std::filesystem::path assetsRoot;
+
+        watch_listener watchListener;
+        std::optional<efsw::FileWatcher> fileWatcher;
+        time watchDebounce{};
+
+        flat_hash_map<string, dynamic_array<uuid>, transparent_string_hash, transparent_string_equal> sourceToAssets;
+        string_set watchedDirectories;
+
+        dynamic_array<std::unique_ptr<background_reimport>> reimports;
+        dynamic_array<uuid> pendingReimports;
+
+        // Stamps of the metas written by the registry itself, to ignore the notifications caused by them
+        index_path_map<file_stamp> writtenMetas;
+
+        // Serializes saving artifacts, since checking and replacing content files is not atomic, while batch imports
+        // and background reimports might finalize at the same time
+        std::mutex contentMutex;
+
+        // Number of artifact metas referencing each content file, counted when discovering assets, or on the first
+        // save when assets were never discovered
+        flat_hash_map<u64, u32> contentRefs;
+        bool hasContentRefs{};
+
+        // Incremented by each save, to detect the ones that happened while counting the references
+        u64 contentSavesCount{};
+
+        string_builder& make_artifact_meta_path(string_builder& out, const uuid& artifactId) const
+        {
+            char uuidBuffer[36];
+            return out.clear().append(artifactsDir).append_path(artifactId.format_to(uuidBuffer)).append(
+                ArtifactMetaExtension);
+        }
+
+        // Data is stored by content when the hash is known, otherwise next to the meta, named after the id
+        string_builder& make_artifact_data_path(string_builder& out, const uuid& artifactId, u64 contentHash) const
+        {
+            out.clear().append(artifactsDir);
+
+            if (contentHash != 0)
+            {
+                out.append_path(ArtifactContentDirectory).append_path_separator();
+                return append_content_hash(out, contentHash);
+            }
+
+            char uuidBuffer[36];
+            return out.append_path(artifactId.format_to(uuidBuffer));
+        }
+
+        string_builder& make_asset_path(string_builder& out, string_view directory)
+        {
+            if (filesystem::is_relative(directory))
+            {
+                out.append(assetsDir);
+                out.append_path_separator();
+            }
+
+            out.append(directory);
+            return out;
+        }
+
+        // Paths in the index are relative to the assets directory, lexically normalized and with forward slashes, so
+        // that lookups can be performed without accessing the file system
+        bool make_index_path(string_builder& out, string_view metaPath) const
+        {
+            std::filesystem::path p{std::u8string_view{metaPath.u8data(), metaPath.size()}};
+
+            if (p.is_relative())
+            {
+                p = assetsRoot / p;
+            }
+
+            // Unlike lexically_relative, components are compared ignoring case where the file system does, so that
+            // a different case in the drive letter or in the directories still matches the assets directory
+            const auto normal = p.lexically_normal();
+            auto it = normal.begin();
+
+            for (const auto& component : assetsRoot)
+            {
+                if (component.empty())
+                {
+                    // The trailing separator of the root
+                    continue;
+                }
+
+                if (it == normal.end() || !are_path_components_equal(*it, component))
+                {
+                    return false;
+                }
+
+                ++it;
+            }
+
+            std::filesystem::path relative;
+
+            for (; it != normal.end(); ++it)
+            {
+                relative /= *it;
+            }
+
+            if (relative.empty() || *relative.begin() == "..")
+            {
+                return false;
+            }
+
+            out.clear().append(relative.generic_u8string().c_str());
+            return true;
+        }
+
+        void watch_source(const uuid& assetId, string_view source)
+        {
+            string_builder key;
+            make_watch_key(key, source);
+
+            auto& assetIds = sourceToAssets[key.as<string>()];
+
+            if (std::find(assetIds.begin(), assetIds.end(), assetId) == assetIds.end())
+            {
+                assetIds.push_back(assetId);
+            }
+
+            const auto directory = filesystem::parent_path(key.view());
+
+            if (watchedDirectories.emplace(directory.as<string>()).second &&
+                fileWatcher->addWatch(directory.as<std::string>(), &watchListener, false) < 0)
+            {
+                log::warn("Failed to watch directory {}", directory);
+            }
+        }
+
+        bool is_reimporting(const uuid& assetId) const
+        {
+            return std::any_of(reimports.begin(),
+                reimports.end(),
+                [&assetId](const std::unique_ptr<background_reimport>& r) { return r->assetId == assetId; });
+        }
+
+        // Counts the artifact metas referencing each content file, the metas are parsed in parallel when possible
+        flat_hash_map<u64, u32> count_content_refs() const
+        {
+            dynamic_array<string> metaPaths;
+
+            std::error_code ec;
+            string_builder metaPath;
+
+            for (auto&& entry : std::filesystem::directory_iterator{artifactsDir.view().as<std::string>(), ec})
+            {
+                metaPath.clear().append(entry.path().u8string().c_str());
+
+                if (entry.is_regular_file(ec) && filesystem::extension(metaPath) == ArtifactMetaExtension)
+                {
+                    metaPaths.emplace_back(metaPath.as<string>());
+                }
+            }
+
+            dynamic_array<u64> contentHashes;
+            contentHashes.resize(metaPaths.size());
+
+            const auto loadContentHashes = [&metaPaths, &contentHashes](const job_range range)
+            {
+                for (u32 i = range.begin; i < range.end; ++i)
+                {
+                    if (!load_artifact_content_hash(metaPaths[i], contentHashes[i]))
+                    {
+                        contentHashes[i] = 0;
+                    }
+                }
+            };
+
+            const job_range allMetas{0, u32(metaPaths.size())};
+
+            if (job_manager::get())
+            {
+                constexpr u32 granularity{64};
+                parallel_for(loadContentHashes, allMetas, granularity);
+            }
+            else
+            {
+                loadContentHashes(allMetas);
+            }
+
+            flat_hash_map<u64, u32> refs;
+
+            for (const u64 contentHash : contentHashes)
+            {
+                if (contentHash != 0)
+                {
+                    ++refs[contentHash];
+                }
+            }
+
+            return refs;
+        }
+
+        // Deletes the content file when the last artifact referencing it is gone
+        void release_content(u64 contentHash)
+        {
+            const auto it = contentRefs.find(contentHash);
+
+            if (it == contentRefs.end() || --it->second != 0)
+            {
+                return;
+            }
+
+            string_builder dataPath;
+            make_artifact_data_path(dataPath, uuid{}, contentHash);
+
+            // When the file can't be deleted the entry is kept, so the content can still be referenced by new artifacts
+            if (filesystem::remove(dataPath).value_or(false))
+            {
+                contentRefs.erase(it);
+            }
+        }
+
+        void track_meta_write(string_view indexPath, cstring_view metaPath)
+        {
+            if (file_stamp stamp; fileWatcher && get_file_stamp(metaPath, stamp))
+            {
+                writtenMetas[indexPath.as<string>()] = stamp;
+            }
+        }
+
+        // Updates the entry of a meta that changed on disk, without walking the whole assets directory
+        void reload_asset_meta(cstring_view metaPath)
+        {
+            string_builder indexPath;
+
+            if (!make_index_path(indexPath, metaPath))
+            {
+                return;
+            }
+
+            file_stamp stamp;
+
+            if (!get_file_stamp(metaPath, stamp))
+            {
+                // The meta was deleted, or moved somewhere else
+                if (const auto it = pathToId.find(indexPath.view()); it != pathToId.end())
+                {
+                    assets.erase(it->second);
+                    pathToId.erase(it);
+                }
+
+                writtenMetas.erase(indexPath.view());
+                return;
+            }
+
+            if (const auto it = writtenMetas.find(indexPath.view()); it != writtenMetas.end() && it->second == stamp)
+            {
+                return;
+            }
+
+            asset_entry loaded;
+            string typeHint;
+            string_builder buffer;
+
+            if (!load_asset_meta(loaded.meta, loaded.artifacts, typeHint, assetTypes, metaPath, buffer))
+            {
+                log::warn("Failed to load asset meta {}", metaPath);
+                return;
+            }
+
+            const uuid id = loaded.meta.id;
+
+            // The path is left as is, set_asset_path takes care of updating it along with the index
+            auto& entry = assets[id];
+            entry.meta = loaded.meta;
+            entry.artifacts = std::move(loaded.artifacts);
+
+            set_asset_path(id, indexPath);
+        }
+
+        void set_asset_path(const uuid& id, string_view indexPath)
+        {
+            auto& entry = assets.at(id);
+
+            if (!entry.path.empty())
+            {
+                pathToId.erase(entry.path);
+            }
+
+            entry.path = indexPath;
+
+            const auto [it, inserted] = pathToId.emplace(entry.path, id);
+
+            if (!inserted && it->second != id)
+            {
+                // The meta of another asset was overwritten, so that asset is gone
+                const uuid previous = std::exchange(it->second, id);
+                assets.erase(previous);
+            }
+        }
+    };
+
+    asset_registry::asset_registry() = default;
+
+    asset_registry::~asset_registry()
+    {
+        shutdown();
+    }
+
+    bool asset_registry::initialize(cstring_view assetsDir, cstring_view artifactsDir, cstring_view sourceFilesDir)
+    {
+        if (!ensure_directories(assetsDir) || !ensure_directories(artifactsDir) || !ensure_directories(sourceFilesDir))
+        {
+            return false;
+        }
+
+        m_impl = std::make_unique<impl>();
+
+        m_impl->assetsDir.append(assetsDir).make_absolute_path();
+        m_impl->assetsRoot =
+            std::filesystem::path{std::u8string_view{m_impl->assetsDir.view().u8data(), m_impl->assetsDir.size()}}
+                .lexically_normal();
+        m_impl->artifactsDir.append(artifactsDir).make_absolute_path();
+        m_impl->sourceFilesDir.append(sourceFilesDir).make_absolute_path();
+
+        return true;
+    }
+
+    void asset_registry::shutdown()
+    {
+        if (m_impl)
+        {
+            m_impl->fileWatcher.reset();
+
+            for (auto& reimport : m_impl->reimports)
+            {
+                if (reimport->job)
+                {
+                    job_manager::get()->wait(reimport->job);
+                }
+            }
+        }
+
+        m_impl.reset();
+    }
+
+    void asset_registry::register_type(const asset_type_desc& desc)
+    {
+        m_impl->assetTypes.emplace(desc.type, desc);
+    }
+
+    void asset_registry::unregister_type(type_id type)
+    {
+        m_impl->assetTypes.erase(type);
+    }
+
+    bool asset_registry::has_asset_type(type_id type) const
+    {
+        return m_impl->assetTypes.contains(type);
+    }
+
+    bool asset_registry::create_directories(string_view directory)
+    {
+        string_builder sb;
+        m_impl->make_asset_path(sb, directory);
+
+        return ensure_directories(sb);
+    }
+
+    void asset_registry::register_file_importer(const file_importer_desc& desc)
+    {
+        const auto [it, inserted] = m_impl->importers.emplace(desc.type, file_importer_info{});
+
+        if (inserted)
+        {
+            auto& info = it->second;
+            info.create = desc.create;
+            info.version = desc.version;
+            info.extensions.reserve(desc.extensions.size());
+
+            for (const string_view ext : desc.extensions)
+            {
+                info.extensions.emplace_back(ext.as<string>());
+            }
+        }
+    }
+
+    void asset_registry::unregister_file_importer(type_id type)
+    {
+        m_impl->importers.erase(type);
+    }
+
+    importer asset_registry::create_importer(cstring_view sourceFile)
+    {
+        const auto ext = filesystem::extension(sourceFile);
+
+        for (auto& [type, assetImporter] : m_impl->importers)
+        {
+            for (const auto& importerExt : assetImporter.extensions)
+            {
+                if (importerExt == ext)
+                {
+                    return importer{
+                        importer_config{
+                            .registry = this,
+                            .sourceFile = sourceFile.as<string>(),
+                        },
+                        type,
+                        assetImporter.version,
+                        assetImporter.create(),
+                    };
+                }
+            }
+        }
+
+        return {};
+    }
+
+    reimport_result asset_registry::reimport_if_stale(const uuid& assetId)
+    {
+        importer assetImporter;
+        data_document importSettings;
+        string_builder assetPath;
+
+        const auto result = prepare_reimport(assetId, assetImporter, importSettings, assetPath);
+
+        if (result != reimport_result::reimported)
+        {
+            return result;
+        }
+
+        if (!assetImporter.init() || !assetImporter.reimport(assetId, assetPath, importSettings))
+        {
+            log::error("Failed to reimport asset {}", assetId);
+            return reimport_result::failed;
+        }
+
+        return reimport_result::reimported;
+    }
+
+    reimport_result asset_registry::prepare_reimport(const uuid& assetId,
+        importer& assetImporter,
+        data_document& importSettings,
+        string_builder& assetPath,
+        import_record* deferredSources)
+    {
+        const auto assetIt = m_impl->assets.find(assetId);
+
+        if (assetIt == m_impl->assets.end() || !assetIt->second.meta.isImported)
+        {
+            return reimport_result::up_to_date;
+        }
+
+        char uuidBuffer[36];
+
+        string_builder importDir;
+        importDir.append(m_impl->sourceFilesDir).append_path(assetId.format_to(uuidBuffer));
+
+        string_builder path;
+        path.append(importDir).append_path(ImportRecordFilename);
+
+        import_record record;
+
+        if (!read_import_record(record, path))
+        {
+            log::error("Failed to read the import record of asset {}", assetId);
+            return reimport_result::failed;
+        }
+
+        const auto importerIt = std::find_if(m_impl->importers.begin(),
+            m_impl->importers.end(),
+            [&record](const auto& kv) { return kv.first.name == string_view{record.importer}; });
+
+        if (importerIt == m_impl->importers.end())
+        {
+            log::error("Asset {} was imported with {}, which is not registered", assetId, record.importer);
+            return reimport_result::failed;
+        }
+
+        const auto& importerInfo = importerIt->second;
+
+        bool isStale = importerInfo.version != record.importerVersion;
+
+        path.clear().append(importDir).append_path(ImportSettingsFilename);
+
+        const bool hasSettings = filesystem::exists(path).value_or(false);
+
+        if (!isStale)
+        {
+            const auto settingsHash = hasSettings ? hash_file_content(path) : expected<u64>{0};
+            isStale = !settingsHash || *settingsHash != record.settingsHash;
+        }
+
+        if (deferredSources)
+        {
+            deferredSources->sources.clear();
+
+            if (!isStale && record.sources.empty())
+            {
+                return reimport_result::up_to_date;
+            }
+
+            if (!isStale)
+            {
+                deferredSources->sources = std::move(record.sources);
+            }
+        }
+        else if (!isStale)
+        {
+            const auto sourcesChanged =
+                have_import_sources_changed(assetId, record.sources, importDir, m_impl->assetsDir);
+
+            if (!sourcesChanged)
+            {
+                return reimport_result::failed;
+            }
+
+            if (!*sourcesChanged)
+            {
+                return reimport_result::up_to_date;
+            }
+        }
+
+        if (hasSettings && !json::read(importSettings, path))
+        {
+            log::error("Failed to read the import settings of asset {}", assetId);
+            return reimport_result::failed;
+        }
+
+        if (!find_asset_path(assetId, assetPath))
+        {
+            return reimport_result::failed;
+        }
+
+        string_builder sourcePath;
+        resolve_import_record_path(sourcePath, record.source, m_impl->assetsDir);
+
+        if (!filesystem::exists(sourcePath).value_or(false))
+        {
+            // When the original is missing the import is repeated from the copies, which are stored next to each other
+            sourcePath.clear().append(importDir).append_path(filesystem::filename(record.source));
+        }
+
+        assetImporter = importer{
+            importer_config{
+                .registry = this,
+                .sourceFile = sourcePath.as<string>(),
+            },
+            importerIt->first,
+            importerInfo.version,
+            importerInfo.create(),
+        };
+
+        return reimport_result::reimported;
+    }
+
+    refresh_imports_result asset_registry::refresh_imports()
+    {
+        // Reimporting modifies the assets map, so the ids are gathered first
+        dynamic_array<uuid> importedAssets;
+        importedAssets.reserve(m_impl->assets.size());
+
+        for (const auto& [id, entry] : m_impl->assets)
+        {
+            if (entry.meta.isImported)
+            {
+                importedAssets.emplace_back(id);
+            }
+        }
+
+        refresh_imports_result result{};
+
+        for (const auto& id : importedAssets)
+        {
+            switch (reimport_if_stale(id))
+            {
+            case reimport_result::up_to_date:
+                ++result.upToDate;
+                break;
+
+            case reimport_result::reimported:
+                ++result.reimported;
+                break;
+
+            case reimport_result::failed:
+                ++result.failed;
+                break;
+            }
+        }
+
+        return result;
+    }
+
+    bool asset_registry::start_watching(time debounce)
+    {
+        if (m_impl->fileWatcher)
+        {
+            return true;
+        }
+
+        auto& watcher = m_impl->fileWatcher.emplace();
+        m_impl->watchDebounce = debounce;
+
+        if (watcher.addWatch(m_impl->assetsDir.view().as<std::string>(), &m_impl->watchListener, true) < 0)
+        {
+            log::error("Failed to watch the assets directory {}", m_impl->assetsDir);
+            m_impl->fileWatcher.reset();
+            return false;
+        }
+
+        // The sources of previous imports are found in their import records
+        char uuidBuffer[36];
+        string_builder recordPath, sourcePath;
+        import_record record;
+
+        for (const auto& [id, entry] : m_impl->assets)
+        {
+            if (!entry.meta.isImported)
+            {
+                continue;
+            }
+
+            recordPath.clear()
+                .append(m_impl->sourceFilesDir)
+                .append_path(id.format_to(uuidBuffer))
+                .append_path(ImportRecordFilename);
+
+            if (!read_import_record(record, recordPath))
+            {
+                continue;
+            }
+
+            for (const auto& source : record.sources)
+            {
+                m_impl->watch_source(id, resolve_import_record_path(sourcePath, source.path, m_impl->assetsDir));
+            }
+        }
+
+        watcher.watch();
+
+        return true;
+    }
+
+    void asset_registry::update(dynamic_array<uuid>& reimportedArtifacts)
+    {
+        if (!m_impl->fileWatcher)
+        {
+            return;
+        }
+
+        dynamic_array<string> changedFiles;
+
+        {
+            const auto now = clock::now();
+
+            auto& listener = m_impl->watchListener;
+            const std::lock_guard lock{listener.mutex};
+
+            for (const auto& [file, lastChange] : listener.touchedFiles)
+            {
+                if (now - lastChange >= m_impl->watchDebounce)
+                {
+                    changedFiles.push_back(file);
+                }
+            }
+
+            for (const auto& file : changedFiles)
+            {
+                listener.touchedFiles.erase(file);
+            }
+        }
+
+        // Assets that changed while being reimported are checked again once the reimport is done
+        dynamic_array<uuid> changedAssets;
+
+        for (usize i = 0; i < m_impl->pendingReimports.size();)
+        {
+            const uuid& assetId = m_impl->pendingReimports[i];
+
+            if (m_impl->is_reimporting(assetId))
+            {
+                ++i;
+                continue;
+            }
+
+            changedAssets.push_back(assetId);
+            m_impl->pendingReimports.erase_unordered(m_impl->pendingReimports.begin() + i);
+        }
+
+        {
+            string_builder key;
+
+            for (const auto& file : changedFiles)
+            {
+                if (filesystem::extension(file) == AssetMetaExtension)
+                {
+                    m_impl->reload_asset_meta(file);
+                    continue;
+                }
+
+                make_watch_key(key, file);
+
+                const auto it = m_impl->sourceToAssets.find(key.view());
+
+                if (it == m_impl->sourceToAssets.end())
+                {
+                    continue;
+                }
+
+                for (const auto& assetId : it->second)
+                {
+                    if (std::find(changedAssets.begin(), changedAssets.end(), assetId) == changedAssets.end())
+                    {
+                        changedAssets.push_back(assetId);
+                    }
+                }
+            }
+        }
+
+        auto* const jm = job_manager::get();
+
+        for (const auto& assetId : changedAssets)
+        {
+            if (m_impl->is_reimporting(assetId))
+            {
+                // The running reimport might have read the sources before this change
+                auto& pending = m_impl->pendingReimports;
+
+                if (std::find(pending.begin(), pending.end(), assetId) == pending.end())
+                {
+                    pending.push_back(assetId);
+                }
+
+                continue;
+            }
+
+            auto reimport = std::make_unique<background_reimport>();
+
+            if (prepare_reimport(assetId,
+                    reimport->assetImporter,
+                    reimport->importSettings,
+                    reimport->assetPath,
+                    &reimport->deferredSources) != reimport_result::reimported)
+            {
+                continue;
+            }
+
+            char uuidBuffer[36];
+
+            reimport->assetId = assetId;
+            reimport->importUuid = generate_uuid();
+            reimport->importDir.append(m_impl->sourceFilesDir).append_path(assetId.format_to(uuidBuffer));
+
+            // The sources are hashed on the worker too, so that checking whether they changed doesn't stall the update
+            auto run = [r = reimport.get(), assetsDir = m_impl->assetsDir.view()]
+            {
+                if (!r->deferredSources.sources.empty())
+                {
+                    const auto sourcesChanged =
+                        have_import_sources_changed(r->assetId, r->deferredSources.sources, r->importDir, assetsDir);
+
+                    r->isUpToDate = sourcesChanged && !*sourcesChanged;
+
+                    if (!sourcesChanged || r->isUpToDate)
+                    {
+                        r->isDone.store(true, std::memory_order_release);
+                        return;
+                    }
+                }
+
+                r->succeeded = r->assetImporter.init() &&
+                    r->assetImporter.run_import(r->assetId, r->importUuid, r->importSettings);
+
+                r->isDone.store(true, std::memory_order_release);
+            };
+
+            if (jm)
+            {
+                reimport->job = jm->push_waitable(std::move(run));
+            }
+            else
+            {
+                run();
+            }
+
+            m_impl->reimports.push_back(std::move(reimport));
+        }
+
+        // Saving the results is done here, so the registry is only modified by the thread that updates it
+        for (usize i = 0; i < m_impl->reimports.size();)
+        {
+            auto& reimport = *m_impl->reimports[i];
+
+            if (!reimport.isDone.load(std::memory_order_acquire))
+            {
+                ++i;
+                continue;
+            }
+
+            if (reimport.job)
+            {
+                jm->wait(reimport.job);
+            }
+
+            const string_view assetPath{reimport.assetPath};
+
+            if (reimport.isUpToDate)
+            {
+                // The file changed on disk, but the content is the same as the last import
+                log::debug("Asset {} is up to date", reimport.assetId);
+            }
+            else if (reimport.succeeded &&
+                reimport.assetImporter.finalize_import(*this,
+                    filesystem::parent_path(assetPath),
+                    filesystem::filename(assetPath),
+                    reimport.importSettings,
+                    true))
+            {
+                log::info("Asset {} was reimported", reimport.assetId);
+
+                if (const auto it = m_impl->assets.find(reimport.assetId); it != m_impl->assets.end())
+                {
+                    reimportedArtifacts.append(it->second.artifacts.begin(), it->second.artifacts.end());
+                }
+            }
+            else
+            {
+                log::error("Failed to reimport asset {}", reimport.assetId);
+            }
+
+            m_impl->reimports.erase(m_impl->reimports.begin() + i);
+        }
+    }
+
+    uuid asset_registry::generate_uuid()
     {
         return m_impl->uuidGenerator.generate();
     }
 
+    void asset_registry::watch_import_sources(const uuid& assetId, std::span<const string> sourceFiles)
+    {
+        if (!m_impl->fileWatcher)
+        {
+            return;
+        }
+
+        for (const auto& source : sourceFiles)
+        {
+            m_impl->watch_source(assetId, source);
+        }
+    }
+
     bool asset_registry::save_artifact(const uuid& artifactId,
         const type_id& type,
         const void* dataPtr,
@@ -405,25 +1528,110 @@ namespace oblo
             return false;
         }
 
+        string_builder artifactMetaPath;
+        m_impl->make_artifact_meta_path(artifactMetaPath, artifactId);
+
+        if (policy == write_policy::no_overwrite && filesystem::exists(artifactMetaPath).value_or(true))
+        {
+            return false;
+        }
+
+        string_builder contentDir;
+        contentDir.append(m_impl->artifactsDir).append_path(ArtifactContentDirectory);
+
+        if (!ensure_directories(contentDir))
+        {
+            return false;
+        }
+
+        // The hash is only known after saving, so the data is written to a temporary file first, named after the id to
+        // avoid clashing with other artifacts being saved
         char uuidBuffer[36];
 
-        auto artifactPath = m_impl->artifactsDir;
-        ensure_directories(artifactPath);
+        string_builder tmpPath;
+        tmpPath.append(contentDir).append_path(artifactId.format_to(uuidBuffer)).append(".tmp");
 
-        artifactPath.append_path(artifactId.format_to(uuidBuffer));
+        const auto saveFunction = typeIt->second.save;
 
-        std::error_code ec;
+        if (!saveFunction(dataPtr, tmpPath))
+        {
+            return false;
+        }
+
+        const std::lock_guard lock{m_impl->contentMutex};
+
+        if (!m_impl->hasContentRefs)
+        {
+            m_impl->contentRefs = m_impl->count_content_refs();
+            m_impl->hasContentRefs = true;
+        }
+
+        ++m_impl->contentSavesCount;
 
-        if (policy == write_policy::no_overwrite && filesystem::exists(artifactPath).value_or(true))
+        const auto contentHash = hash_file_content(tmpPath);
+
+        if (!contentHash)
         {
             return false;
         }
 
-        auto artifactMetaPath = artifactPath;
-        artifactMetaPath.append(ArtifactMetaExtension);
+        // The data previously referenced by the artifact is released once the meta points to the new one
+        u64 previousContentHash{};
+        const bool hasPreviousMeta = load_artifact_content_hash(artifactMetaPath, previousContentHash);
 
-        const auto saveFunction = typeIt->second.save;
-        return saveFunction(dataPtr, artifactPath) && save_artifact_meta(meta, artifactMetaPath);
+        artifact_meta contentMeta = meta;
+        contentMeta.contentHash = *contentHash;
+
+        string_builder dataPath;
+        m_impl->make_artifact_data_path(dataPath, artifactId, contentMeta.contentHash);
+
+        if (!filesystem::exists(dataPath).value_or(false))
+        {
+            if (!filesystem::rename(tmpPath, dataPath))
+            {
+                return false;
+            }
+        }
+        else if (have_same_content(tmpPath, dataPath))
+        {
+            // Identical data was already saved, e.g. by another import or by a previous import of the same asset
+            filesystem::remove(tmpPath).value_or(false);
+        }
+        else
+        {
+            log::warn("Artifact {} has the same content hash as another one, but different data", artifactId);
+
+            contentMeta.contentHash = 0;
+            m_impl->make_artifact_data_path(dataPath, artifactId, 0);
+
+            if (!filesystem::rename(tmpPath, dataPath))
+            {
+                return false;
+            }
+        }
+
+        if (!save_artifact_meta(contentMeta, artifactMetaPath))
+        {
+            return false;
+        }
+
+        if (contentMeta.contentHash != 0)
+        {
+            ++m_impl->contentRefs[contentMeta.contentHash];
+        }
+
+        if (hasPreviousMeta && previousContentHash != 0)
+        {
+            m_impl->release_content(previousContentHash);
+        }
+        else if (hasPreviousMeta && contentMeta.contentHash != 0)
+        {
+            // The data was stored by id, since nobody else can reference it the file is deleted right away
+            m_impl->make_artifact_data_path(dataPath, artifactId, 0);
+            filesystem::remove(dataPath).value_or(false);
+        }
+
+        return true;
     }
 
     bool asset_registry::save_asset(string_view destination,
@@ -437,7 +1645,14 @@ namespace oblo
 
         if (!insertedAsset)
         {
-            return false;
+            if (policy == write_policy::no_overwrite)
+            {
+                return false;
+            }
+
+            // When reimporting, the asset keeps its id but the meta and the artifacts might change
+            assetIt->second.meta = meta;
+            assetIt->second.artifacts.assign(artifacts.begin(), artifacts.end());
         }
 
         string_builder fullPath;
@@ -448,7 +1663,18 @@ namespace oblo
             return false;
         }
 
-        return save_asset_meta(assetIt->second.meta, artifacts, fullPath);
+        if (!save_asset_meta(assetIt->second.meta, artifacts, fullPath))
+        {
+            return false;
+        }
+
+        if (string_builder indexPath; m_impl->make_index_path(indexPath, fullPath))
+        {
+            m_impl->set_asset_path(meta.id, indexPath);
+            m_impl->track_meta_write(indexPath, fullPath);
+        }
+
+        return true;
     }
 
     bool asset_registry::create_source_files_dir(string_builder& importDir, uuid importId)
@@ -490,45 +1716,94 @@ namespace oblo
 
     bool asset_registry::find_asset_by_meta_path(cstring_view path, uuid& id, asset_meta& assetMeta) const
     {
-        if (!load_asset_id_from_meta(path, id))
+        string_builder indexPath;
+
+        if (!m_impl->make_index_path(indexPath, path))
         {
             return false;
         }
 
+        const auto it = m_impl->pathToId.find(indexPath.view());
+
+        if (it == m_impl->pathToId.end())
+        {
+            return false;
+        }
+
+        id = it->second;
         return find_asset_by_id(id, assetMeta);
     }
 
-    bool asset_registry::find_asset_artifacts(const uuid& id, dynamic_array<uuid>& artifacts) const
+    bool asset_registry::find_asset_path(const uuid& id, string_builder& path) const
     {
         const auto it = m_impl->assets.find(id);
 
-        if (it == m_impl->assets.end())
+        if (it == m_impl->assets.end() || it->second.path.empty())
         {
             return false;
         }
 
-        artifacts.assign(it->second.artifacts.begin(), it->second.artifacts.end());
+        const string_view indexPath{it->second.path};
+        path.clear().append(indexPath.substr(0, indexPath.size() - AssetMetaExtension.size()));
+
         return true;
     }
 
-    bool asset_registry::load_artifact_meta(const uuid& id, artifact_meta& artifact) const
+    bool asset_registry::move_asset(const uuid& id, string_view destination)
     {
-        char uuidBuffer[36];
+        const auto it = m_impl->assets.find(id);
+
+        if (it == m_impl->assets.end() || it->second.path.empty())
+        {
+            return false;
+        }
+
+        string_builder target;
+        m_impl->make_asset_path(target, destination).append(AssetMetaExtension);
+
+        string_builder indexPath;
+
+        if (!m_impl->make_index_path(indexPath, target) || m_impl->pathToId.contains(indexPath.view()))
+        {
+            return false;
+        }
+
+        string_builder source;
+        source.append(m_impl->assetsDir).append_path(it->second.path);
+
+        string_builder targetDirectory;
+        targetDirectory.append(filesystem::parent_path(target));
 
-        const auto& artifactsDir = m_impl->artifactsDir;
+        if (!ensure_directories(targetDirectory) || !filesystem::rename(source, target))
+        {
+            return false;
+        }
+
+        m_impl->set_asset_path(id, indexPath);
+        m_impl->track_meta_write(indexPath, target);
 
-        string_builder resourceFile;
-        resourceFile.append(artifactsDir).append_path(id.format_to(uuidBuffer));
+        return true;
+    }
+
+    bool asset_registry::find_asset_artifacts(const uuid& id, dynamic_array<uuid>& artifacts) const
+    {
+        const auto it = m_impl->assets.find(id);
 
-        if (filesystem::exists(resourceFile).value_or(false))
+        if (it == m_impl->assets.end())
         {
             return false;
         }
 
-        auto resourceMeta = resourceFile;
-        resourceMeta.append(ArtifactMetaExtension);
+        artifacts.assign(it->second.artifacts.begin(), it->second.artifacts.end());
+        return true;
+    }
+
+    bool asset_registry::load_artifact_meta(const uuid& id, artifact_meta& artifact) const
+    {
+        string_builder artifactMetaPath;
+        m_impl->make_artifact_meta_path(artifactMetaPath, id);
 
-        return oblo::load_artifact_meta(resourceMeta, m_impl->assetTypes, artifact);
+        return oblo::load_artifact_meta(artifactMetaPath, m_impl->assetTypes, artifact);
     }
 
     cstring_view asset_registry::get_asset_directory() const
@@ -539,31 +1814,23 @@ namespace oblo
     bool asset_registry::find_artifact_resource(
         const uuid& id, type_id& outType, string& outName, string& outPath, const void* userdata)
     {
-        char uuidBuffer[36];
-
         auto* const self = static_cast<const asset_registry*>(userdata);
-        const auto& artifactsDir = self->m_impl->artifactsDir;
-
-        string_builder resourceFile;
-        resourceFile.append(artifactsDir).append_path(id.format_to(uuidBuffer));
-
-        if (!filesystem::exists(resourceFile).value_or(false))
-        {
-            return false;
-        }
 
-        auto resourceMeta = resourceFile;
-        resourceMeta.append(ArtifactMetaExtension);
+        // The meta maps the id to the content, a missing meta means the artifact doesn't exist
+        string_builder path;
+        self->m_impl->make_artifact_meta_path(path, id);
 
         artifact_meta meta;
 
-        if (!oblo::load_artifact_meta(resourceMeta, self->m_impl->assetTypes, meta))
+        if (!oblo::load_artifact_meta(path, self->m_impl->assetTypes, meta))
         {
             return false;
         }
 
+        self->m_impl->make_artifact_data_path(path, id, meta.contentHash);
+
         outType = meta.type;
-        outPath = resourceFile.as<string>();
+        outPath = path.as<string>();
         outName = std::move(meta.importName);
 
         return true;
@@ -571,6 +1838,64 @@ namespace oblo
 
     void asset_registry::discover_assets()
     {
+        OBLO_MEMORY_TAG_SCOPE("assets");
+
+        struct discovered_asset
+        {
+            string_builder path;
+            usize relativePathOffset{};
+            file_stamp stamp{};
+            asset_entry entry{};
+            string typeHint;
+            bool isValid{};
+
+            string_view get_relative_path() const
+            {
+                return string_view{path}.substr(relativePathOffset);
+            }
+        };
+
+        const auto& assetTypes = m_impl->assetTypes;
+
+        {
+            // Artifacts might have changed on disk, so references to the content are counted again, without holding the
+            // lock while parsing the metas
+            u64 savesCount;
+
+            {
+                const std::lock_guard lock{m_impl->contentMutex};
+                savesCount = m_impl->contentSavesCount;
+            }
+
+            auto contentRefs = m_impl->count_content_refs();
+
+            const std::lock_guard lock{m_impl->contentMutex};
+
+            // If an artifact was saved in the meantime the counts might be off, so they are left to the next save
+            m_impl->hasContentRefs = savesCount == m_impl->contentSavesCount;
+
+            if (m_impl->hasContentRefs)
+            {
+                m_impl->contentRefs = std::move(contentRefs);
+            }
+        }
+
+        string_builder databasePath;
+        databasePath.append(m_impl->artifactsDir).append_path(AssetDatabaseFileName);
+
+        // The database is just a cache, if it's missing or invalid all metas are parsed
+        asset_database_reader database;
+
+        if (!database.open(databasePath))
+        {
+            log::debug("The asset database is missing or outdated, all asset metas will be parsed");
+        }
+
+        dynamic_array<discovered_asset> discovered;
+        dynamic_array<u32> modified;
+
+        // Walking the directory is serial, but it's cheap compared to reading the files, which we only do for metas
+        // that changed since they were last cached
         std::error_code ec;
 
         for (auto&& entry :
@@ -578,16 +1903,125 @@ namespace oblo
         {
             const auto& p = entry.path();
 
-            asset_meta meta{};
-            std::vector<uuid> artifacts;
+            if (!entry.is_regular_file(ec) || p.extension() != AssetMetaExtension.c_str())
+            {
+                continue;
+            }
+
+            auto& asset = discovered.emplace_back();
+            asset.path.append(p.u8string().c_str());
+
+            asset.stamp = {
+                .lastWriteTime = entry.last_write_time(ec).time_since_epoch().count(),
+                .size = entry.file_size(ec),
+            };
+
+            // Paths are stored relative to the assets directory, so the database survives moving the project
+            const string_view fullPath{asset.path};
+            asset.relativePathOffset = m_impl->assetsDir.size();
+
+            while (asset.relativePathOffset < fullPath.size() &&
+                (fullPath.at(asset.relativePathOffset) == '/' || fullPath.at(asset.relativePathOffset) == '\\'))
+            {
+                ++asset.relativePathOffset;
+            }
+
+            asset_database_record record;
+
+            if (database.find(asset.get_relative_path(), record) && record.stamp == asset.stamp)
+            {
+                asset.entry.meta = {
+                    .id = record.id,
+                    .mainArtifactHint = record.mainArtifactHint,
+                    .typeHint = find_type_hint(assetTypes, record.typeHint),
+                    .isImported = record.isImported,
+                };
+
+                asset.entry.artifacts.assign(record.artifacts.begin(), record.artifacts.end());
+                asset.typeHint = record.typeHint;
+                asset.isValid = true;
+            }
+            else
+            {
+                modified.push_back(u32(discovered.size() - 1));
+            }
+        }
+
+        const auto cachedCount = database.get_entries_count();
+        database.close();
+
+        const auto loadMetas = [&discovered, &modified, &assetTypes](const job_range range)
+        {
+            string_builder buffer;
+
+            for (u32 i = range.begin; i < range.end; ++i)
+            {
+                auto& asset = discovered[modified[i]];
+
+                asset.isValid = load_asset_meta(asset.entry.meta,
+                    asset.entry.artifacts,
+                    asset.typeHint,
+                    assetTypes,
+                    asset.path,
+                    buffer);
+            }
+        };
+
+        const job_range modifiedAssets{0, u32(modified.size())};
+
+        if (job_manager::get())
+        {
+            constexpr u32 granularity{16};
+            parallel_for(loadMetas, modifiedAssets, granularity);
+        }
+        else
+        {
+            loadMetas(modifiedAssets);
+        }
 
-            if (load_asset_meta(meta, artifacts, m_impl->assetTypes, p))
+        asset_database_writer databaseWriter;
+        u32 validCount{};
+
+        m_impl->assets.reserve(m_impl->assets.size() + discovered.size());
+
+        for (auto& asset : discovered)
+        {
+            if (asset.isValid)
             {
-                m_impl->assets.emplace(meta.id, asset_entry{meta, std::move(artifacts)});
+                databaseWriter.add(asset.get_relative_path(),
+                    {
+                        .id = asset.entry.meta.id,
+                        .mainArtifactHint = asset.entry.meta.mainArtifactHint,
+                        .stamp = asset.stamp,
+                        .typeHint = asset.typeHint,
+                        .isImported = asset.entry.meta.isImported,
+                        .artifacts = asset.entry.artifacts,
+                    });
+
+                ++validCount;
+
+                const auto id = asset.entry.meta.id;
+
+                if (m_impl->assets.emplace(id, std::move(asset.entry)).second)
+                {
+                    if (string_builder indexPath; m_impl->make_index_path(indexPath, asset.path))
+                    {
+                        m_impl->set_asset_path(id, indexPath);
+                    }
+                }
             }
             else
             {
-                log::warn("Failed to load asset meta {}", p.string());
+                log::warn("Failed to load asset meta {}", asset.path);
+            }
+        }
+
+        // Only rewrite the database when something was added, modified or removed
+        if (!modified.empty() || cachedCount != validCount)
+        {
+            if (!databaseWriter.write(databasePath))
+            {
+                log::warn("Failed to write the asset database {}", databasePath);
             }
         }
     }
@@ -0,0 +1,226 @@
+#include <oblo/asset/batch_importer.hpp>
+
+#include <oblo/asset/asset_registry.hpp>
+#include <oblo/core/debug.hpp>
+#include <oblo/core/filesystem/filesystem.hpp>
+#include <oblo/core/formatters/uuid_formatter.hpp>
+#include <oblo/core/memory_tracking.hpp>
+#include <oblo/log/log.hpp>
+#include <oblo/thread/job_manager.hpp>
+
+namespace oblo
+{
+    batch_importer::batch_importer(asset_registry& registry) : m_registry{&registry} {}
+
+    batch_importer::~batch_importer()
+    {
+        cancel();
+        wait();
+    }
+
+    bool batch_importer::add(cstring_view sourceFile, string_view destinationDir, data_document importSettings)
+    {
+        if (m_started)
+        {
+            return false;
+        }
+
+        auto fileImporter = m_registry->create_importer(sourceFile);
+
+        if (!fileImporter.is_valid())
+        {
+            return false;
+        }
+
+        m_files.push_back({
+            .fileImporter = std::move(fileImporter),
+            .destinationDir = destinationDir.as<string>(),
+            .importSettings = std::move(importSettings),
+            .status = batch_import_status::pending,
+        });
+
+        return true;
+    }
+
+    bool batch_importer::start()
+    {
+        if (m_started)
+        {
+            return false;
+        }
+
+        m_started = true;
+
+        // The uuid generator of the registry is not thread-safe, so all ids are generated upfront
+        for (auto& file : m_files)
+        {
+            file.importId = m_registry->generate_uuid();
+            file.importUuid = m_registry->generate_uuid();
+        }
+
+        auto* const jm = job_manager::get();
+
+        if (!jm || m_files.empty())
+        {
+            for (usize i = 0; i < m_files.size(); ++i)
+            {
+                import_file(i);
+            }
+
+            update();
+            return true;
+        }
+
+        // The first file is the parent of all others, waiting for it waits for the whole batch
+        m_job = jm->push_waitable([this] { import_file(0); });
+
+        for (usize i = 1; i < m_files.size(); ++i)
+        {
+            jm->push_child(m_job, [this, i] { import_file(i); });
+        }
+
+        return true;
+    }
+
+    void batch_importer::cancel()
+    {
+        m_cancel.store(true, std::memory_order_relaxed);
+    }
+
+    void batch_importer::update()
+    {
+        dynamic_array<usize> imported;
+
+        {
+            const std::lock_guard lock{m_importedMutex};
+            imported.swap(m_imported);
+        }
+
+        for (const usize index : imported)
+        {
+            finalize_file(m_files[index]);
+        }
+    }
+
+    void batch_importer::wait()
+    {
+        if (m_job)
+        {
+            auto* const jm = job_manager::get();
+            OBLO_ASSERT(jm);
+
+            jm->wait(m_job);
+            m_job = {};
+        }
+
+        update();
+    }
+
+    bool batch_importer::is_done() const
+    {
+        return m_started && m_completed.load(std::memory_order_acquire) == m_files.size();
+    }
+
+    batch_import_progress batch_importer::get_progress() const
+    {
+        return {
+            .total = u32(m_files.size()),
+            .completed = m_completed.load(std::memory_order_acquire),
+            .failed = m_failed.load(std::memory_order_relaxed),
+            .canceled = m_canceled.load(std::memory_order_relaxed),
+        };
+    }
+
+    usize batch_importer::get_files_count() const
+    {
+        return m_files.size();
+    }
+
+    cstring_view batch_importer::get_source_file(usize index) const
+    {
+        return m_files[index].fileImporter.get_config().sourceFile;
+    }
+
+    batch_import_status batch_importer::get_status(usize index) const
+    {
+        // Atomic references to const objects are not supported, but loading doesn't modify the status anyway
+        auto& status = const_cast<batch_import_status&>(m_files[index].status);
+        return std::atomic_ref{status}.load(std::memory_order_acquire);
+    }
+
+    uuid batch_importer::get_import_id(usize index) const
+    {
+        return m_files[index].importId;
+    }
+
+    void batch_importer::import_file(usize index)
+    {
+        OBLO_MEMORY_TAG_SCOPE("assets");
+
+        auto& file = m_files[index];
+
+        if (m_cancel.load(std::memory_order_relaxed))
+        {
+            complete_file(file, batch_import_status::canceled);
+            return;
+        }
+
+        std::atomic_ref{file.status}.store(batch_import_status::importing, std::memory_order_release);
+
+        auto& fileImporter = file.fileImporter;
+
+        if (!fileImporter.init() || !fileImporter.run_import(file.importId, file.importUuid, file.importSettings))
+        {
+            log::error("Import of '{}' failed", fileImporter.get_config().sourceFile);
+            complete_file(file, batch_import_status::failed);
+            return;
+        }
+
+        // The registry is not thread-safe, the results are saved by the thread that owns it
+        const std::lock_guard lock{m_importedMutex};
+        m_imported.push_back(index);
+    }
+
+    void batch_importer::finalize_file(file_import& file)
+    {
+        OBLO_MEMORY_TAG_SCOPE("assets");
+
+        // Last chance to cancel, nothing was written to the registry yet
+        if (m_cancel.load(std::memory_order_relaxed))
+        {
+            complete_file(file, batch_import_status::canceled);
+            return;
+        }
+
+        auto& fileImporter = file.fileImporter;
+
+        const bool success = fileImporter.finalize_import(*m_registry,
+            file.destinationDir,
+            filesystem::stem(fileImporter.get_config().sourceFile),
+            file.importSettings,
+            false);
+
+        if (!success)
+        {
+            log::error("Import {} of '{}' failed while saving", file.importId, fileImporter.get_config().sourceFile);
+        }
+
+        complete_file(file, success ? batch_import_status::succeeded : batch_import_status::failed);
+    }
+
+    void batch_importer::complete_file(file_import& file, batch_import_status status)
+    {
+        std::atomic_ref{file.status}.store(status, std::memory_order_release);
+
+        if (status == batch_import_status::failed)
+        {
+            m_failed.fetch_add(1, std::memory_order_relaxed);
+        }
+        else if (status == batch_import_status::canceled)
+        {
+            m_canceled.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        m_completed.fetch_add(1, std::memory_order_release);
+    }
+}
\ No newline at end of file
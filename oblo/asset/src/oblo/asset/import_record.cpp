@@ -0,0 +1,158 @@
+#include <oblo/asset/import_record.hpp>
+
+#include <oblo/core/filesystem/filesystem.hpp>
+#include <oblo/core/filesystem/mapped_file.hpp>
+#include <oblo/core/hash.hpp>
+#include <oblo/core/string/string_builder.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <filesystem>
+#include <fstream>
+
+namespace oblo
+{
+    namespace
+    {
+        std::filesystem::path make_absolute_normal(string_view path)
+        {
+            std::error_code ec;
+            const auto p = std::filesystem::absolute(std::u8string_view{path.u8data(), path.size()}, ec);
+            return p.lexically_normal();
+        }
+    }
+
+    string_builder& make_import_record_path(string_builder& out, string_view sourceFile, string_view baseDirectory)
+    {
+        const auto source = make_absolute_normal(sourceFile);
+        const auto relative = source.lexically_relative(make_absolute_normal(baseDirectory));
+
+        return out.clear().append((relative.empty() ? source : relative).generic_u8string().c_str());
+    }
+
+    string_builder& resolve_import_record_path(string_builder& out, string_view recordPath, string_view baseDirectory)
+    {
+        const std::filesystem::path p{std::u8string_view{recordPath.u8data(), recordPath.size()}};
+
+        if (p.is_absolute())
+        {
+            return out.clear().append(recordPath);
+        }
+
+        const auto resolved = (make_absolute_normal(baseDirectory) / p).lexically_normal();
+        return out.clear().append(resolved.generic_u8string().c_str());
+    }
+
+    expected<u64> hash_file_content(cstring_view path)
+    {
+        filesystem::mapped_file file;
+
+        if (!file.open(path))
+        {
+            return unspecified_error;
+        }
+
+        file.advise(filesystem::mapped_file_advice::sequential);
+
+        const auto bytes = file.get_bytes();
+        return hash_xxh64(bytes.data(), bytes.size());
+    }
+
+    bool write_import_record(const import_record& record, cstring_view destination)
+    {
+        nlohmann::ordered_json json;
+
+        if (!record.importer.empty())
+        {
+            json["importer"] = record.importer.as<std::string_view>();
+        }
+
+        json["importerVersion"] = record.importerVersion;
+        json["filename"] = filesystem::filename(record.source).as<std::string_view>();
+        json["source"] = record.source.as<std::string_view>();
+        json["settingsHash"] = record.settingsHash;
+
+        auto&& sourcesJson = json["sources"];
+        sourcesJson = nlohmann::ordered_json::array();
+
+        for (const auto& source : record.sources)
+        {
+            sourcesJson.push_back({
+                {"path", source.path.as<std::string_view>()},
+                {"hash", source.hash},
+            });
+        }
+
+        std::ofstream ofs{destination.as<std::string>()};
+
+        if (!ofs)
+        {
+            return false;
+        }
+
+        ofs << json.dump(1, '\t');
+        return !ofs.bad();
+    }
+
+    bool read_import_record(import_record& record, cstring_view source)
+    {
+        filesystem::mapped_file file;
+
+        if (!file.open(source))
+        {
+            return false;
+        }
+
+        const auto bytes = file.get_bytes();
+        const auto* const begin = reinterpret_cast<const char*>(bytes.data());
+
+        const auto json = nlohmann::json::parse(begin, begin + bytes.size(), nullptr, false);
+
+        if (!json.is_object())
+        {
+            return false;
+        }
+
+        const auto importerIt = json.find("importer");
+        const auto versionIt = json.find("importerVersion");
+        const auto sourceIt = json.find("source");
+        const auto settingsHashIt = json.find("settingsHash");
+        const auto sourcesIt = json.find("sources");
+
+        // Imports that predate the import records are missing most of these, they can't be refreshed
+        if (importerIt == json.end() || !importerIt->is_string() || versionIt == json.end() ||
+            !versionIt->is_number_unsigned() || sourceIt == json.end() || !sourceIt->is_string() ||
+            settingsHashIt == json.end() || !settingsHashIt->is_number_unsigned() || sourcesIt == json.end() ||
+            !sourcesIt->is_array())
+        {
+            return false;
+        }
+
+        record.importer = importerIt->get<std::string_view>();
+        record.importerVersion = versionIt->get<u32>();
+        record.source = sourceIt->get<std::string_view>();
+        record.settingsHash = settingsHashIt->get<u64>();
+
+        record.sources.clear();
+        record.sources.reserve(sourcesIt->size());
+
+        for (const auto& sourceJson : *sourcesIt)
+        {
+            const auto pathIt = sourceJson.find("path");
+            const auto hashIt = sourceJson.find("hash");
+
+            if (pathIt == sourceJson.end() || !pathIt->is_string() || hashIt == sourceJson.end() ||
+                !hashIt->is_number_unsigned())
+            {
+                return false;
+            }
+
+            record.sources.push_back({
+                .path = string_view{pathIt->get<std::string_view>()}.as<string>(),
+                .hash = hashIt->get<u64>(),
+            });
+        }
+
+        return true;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <oblo/core/dynamic_array.hpp>
+#include <oblo/core/expected.hpp>
+#include <oblo/core/string/cstring_view.hpp>
+#include <oblo/core/string/string.hpp>
+#include <oblo/core/string/string_view.hpp>
+#include <oblo/core/types.hpp>
+
+namespace oblo
+{
+    class string_builder;
+
+    constexpr string_view ImportRecordFilename{"import.json"};
+    constexpr string_view ImportSettingsFilename{"settings.json"};
+
+    struct import_source_record
+    {
+        string path;
+        u64 hash;
+    };
+
+    /// @brief Describes the inputs of an import, it's stored in the source files directory of the import and used to
+    /// detect whether the import is stale.
+    struct import_record
+    {
+        string importer;
+        u32 importerVersion;
+        string source;
+        /// @brief Hash of the serialized import settings, 0 if the import used no settings.
+        u64 settingsHash;
+        dynamic_array<import_source_record> sources;
+    };
+
+    /// @brief Makes the path of a source file relative to the base directory, so the record stays valid when the
+    /// project is moved or used on another machine.
+    /// @remarks Paths that can't be made relative, e.g. because they are on another drive, are kept absolute.
+    string_builder& make_import_record_path(string_builder& out, string_view sourceFile, string_view baseDirectory);
+
+    /// @brief Resolves a path stored in an import record, relative paths are relative to the base directory.
+    string_builder& resolve_import_record_path(string_builder& out, string_view recordPath, string_view baseDirectory);
+
+    /// @brief Computes the xxh64 hash of the content of a file.
+    expected<u64> hash_file_content(cstring_view path);
+
+    bool write_import_record(const import_record& record, cstring_view destination);
+    bool read_import_record(import_record& record, cstring_view source);
+}
\ No newline at end of file
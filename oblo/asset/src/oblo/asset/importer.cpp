@@ -3,56 +3,29 @@
 #include <oblo/asset/asset_meta.hpp>
 #include <oblo/asset/asset_registry.hpp>
 #include <oblo/asset/import_artifact.hpp>
+#include <oblo/asset/import_record.hpp>
 #include <oblo/core/array_size.hpp>
 #include <oblo/core/filesystem/filesystem.hpp>
 #include <oblo/core/formatters/uuid_formatter.hpp>
+#include <oblo/core/memory_tracking.hpp>
 #include <oblo/log/log.hpp>
 #include <oblo/core/string/string_builder.hpp>
 #include <oblo/core/uuid.hpp>
 #include <oblo/core/uuid_generator.hpp>
-
-#include <nlohmann/json.hpp>
-
-#include <fstream>
+#include <oblo/properties/serialization/json.hpp>
 
 namespace oblo
 {
-    namespace
-    {
-        constexpr string_view ImportConfigFilename{"import.json"};
-
-        bool write_import_config(const importer_config& config, const type_id& importer, cstring_view destination)
-        {
-            nlohmann::ordered_json json;
-
-            if (!importer.name.empty())
-            {
-                json["importer"] = importer.name;
-            }
-
-            json["filename"] = filesystem::filename(config.sourceFile).as<std::string_view>();
-            json["source"] = config.sourceFile.as<std::string_view>();
-
-            std::ofstream ofs{destination.as<std::string>()};
-
-            if (!ofs)
-            {
-                return false;
-            }
-
-            ofs << json.dump(1, '\t');
-            return !ofs.bad();
-        }
-    }
-
     importer::importer() = default;
 
     importer::importer(importer&&) noexcept = default;
 
-    importer::importer(
-        importer_config config, const type_id& importerType, std::unique_ptr<file_importer> fileImporter) :
+    importer::importer(importer_config config,
+        const type_id& importerType,
+        u32 importerVersion,
+        std::unique_ptr<file_importer> fileImporter) :
         m_config{std::move(config)},
-        m_importer{std::move(fileImporter)}, m_importerType{importerType}
+        m_importer{std::move(fileImporter)}, m_importerType{importerType}, m_importerVersion{importerVersion}
     {
     }
 
@@ -78,12 +51,47 @@ namespace oblo
 
     bool importer::execute(string_view destinationDir, const data_document& importSettings)
     {
-        if (!begin_import(*m_config.registry, m_importNodesConfig))
+        return execute_impl(m_config.registry->generate_uuid(),
+            destinationDir,
+            filesystem::stem(m_config.sourceFile),
+            importSettings,
+            false);
+    }
+
+    bool importer::reimport(const uuid& assetId, string_view assetPath, const data_document& importSettings)
+    {
+        return execute_impl(assetId,
+            filesystem::parent_path(assetPath),
+            filesystem::filename(assetPath),
+            importSettings,
+            true);
+    }
+
+    bool importer::execute_impl(const uuid& importId,
+        string_view destinationDir,
+        string_view assetName,
+        const data_document& importSettings,
+        bool overwrite)
+    {
+        OBLO_MEMORY_TAG_SCOPE("assets");
+
+        if (!run_import(importId, m_config.registry->generate_uuid(), importSettings))
         {
             return false;
         }
 
-        const auto importUuid = m_config.registry->generate_uuid();
+        // TODO: Cleanup if finalize_import fails too, e.g. remove the saved artifacts, if any
+        return finalize_import(*m_config.registry, destinationDir, assetName, importSettings, overwrite);
+    }
+
+    bool importer::run_import(const uuid& importId, const uuid& importUuid, const data_document& importSettings)
+    {
+        m_importId = importId;
+
+        if (!begin_import(*m_config.registry, m_importNodesConfig))
+        {
+            return false;
+        }
 
         const import_context context{
             .registry = *m_config.registry,
@@ -99,15 +107,11 @@ namespace oblo
             return false;
         }
 
-        // TODO: Cleanup if finalize_import fails too, e.g. remove the saved artifacts, if any
-        return finalize_import(*m_config.registry, destinationDir);
+        return true;
     }
 
     bool importer::begin_import(asset_registry& registry, std::span<import_node_config> importNodesConfig)
     {
-        // TODO: Could maybe create the folder here to ensure it's unique
-        m_importId = registry.generate_uuid();
-
         if (importNodesConfig.size() != m_preview.nodes.size())
         {
             return false;
@@ -127,7 +131,7 @@ namespace oblo
             // TODO: Ensure that names are unique
             auto& config = importNodesConfig[i];
             const auto h = hash_all<hash>(node.name, node.type, i);
-            config.id = uuidGenerator.generate(std::as_bytes(std::span{&h, sizeof(h)}));
+            config.id = uuidGenerator.generate(std::as_bytes(std::span{&h, 1}));
 
             const auto [artifactIt, artifactInserted] = m_artifacts.emplace(config.id,
                 artifact_meta{
@@ -143,8 +147,15 @@ namespace oblo
         return true;
     }
 
-    bool importer::finalize_import(asset_registry& registry, string_view destination)
+    bool importer::finalize_import(asset_registry& registry,
+        string_view destination,
+        string_view assetName,
+        const data_document& importSettings,
+        bool overwrite)
     {
+        const auto policy =
+            overwrite ? asset_registry::write_policy::overwrite : asset_registry::write_policy::no_overwrite;
+
         if (!registry.create_directories(destination))
         {
             return false;
@@ -202,7 +213,7 @@ namespace oblo
                 .importName = artifact.name,
             };
 
-            if (!registry.save_artifact(artifact.id, artifact.data.get_type(), artifactPtr, meta))
+            if (!registry.save_artifact(artifact.id, artifact.data.get_type(), artifactPtr, meta, policy))
             {
                 log::error("Artifact {} ({}) will be skipped due to an error occurring while saving to disk",
                     artifact.id,
@@ -221,10 +232,8 @@ namespace oblo
             }
         }
 
-        const auto assetFileName = filesystem::stem(m_config.sourceFile);
-
-        allSucceeded &= registry.save_asset(destination, assetFileName, std::move(assetMeta), importedArtifacts);
-        allSucceeded &= write_source_files(results.sourceFiles);
+        allSucceeded &= registry.save_asset(destination, assetName, std::move(assetMeta), importedArtifacts, policy);
+        allSucceeded &= write_source_files(results.sourceFiles, importSettings);
 
         return allSucceeded;
     }
@@ -244,7 +253,7 @@ namespace oblo
         return m_importId;
     }
 
-    bool importer::write_source_files(std::span<const string> sourceFiles)
+    bool importer::write_source_files(std::span<const string> sourceFiles, const data_document& importSettings)
     {
         string_builder importDir;
 
@@ -255,16 +264,67 @@ namespace oblo
 
         bool allSucceeded = true;
 
-        string_builder pathBuilder = importDir;
+        // Paths are stored relative to the assets directory, so that the project can be moved
+        const auto baseDirectory = m_config.registry->get_asset_directory();
+
+        string_builder pathBuilder;
+
+        import_record record{
+            .importer = m_importerType.name.as<string>(),
+            .importerVersion = m_importerVersion,
+            .source = make_import_record_path(pathBuilder, m_config.sourceFile, baseDirectory).as<string>(),
+        };
+
+        record.sources.reserve(sourceFiles.size());
 
         for (const auto& sourceFile : sourceFiles)
         {
-            pathBuilder.clear().append(importDir).append(filesystem::filename(sourceFile));
-            allSucceeded &= filesystem::copy_file(sourceFile, pathBuilder).value_or(false);
+            const auto hash = hash_file_content(sourceFile);
+
+            if (!hash)
+            {
+                log::error("Failed to read source file {} of import {}", sourceFile, m_importId);
+                allSucceeded = false;
+                continue;
+            }
+
+            record.sources.push_back({
+                .path = make_import_record_path(pathBuilder, sourceFile, baseDirectory).as<string>(),
+                .hash = *hash,
+            });
+
+            pathBuilder.clear().append(importDir).append_path(filesystem::filename(sourceFile));
+            allSucceeded &= filesystem::copy_file(sourceFile, pathBuilder, filesystem::copy_policy::overwrite)
+                                 .value_or(false);
+        }
+
+        // The settings are stored along with the import, to import again with the same settings when sources change
+        pathBuilder.clear().append(importDir).append_path(ImportSettingsFilename);
+
+        if (importSettings.is_initialized())
+        {
+            expected<u64> settingsHash{unspecified_error};
+
+            if (json::write(importSettings, pathBuilder))
+            {
+                settingsHash = hash_file_content(pathBuilder);
+            }
+
+            if (settingsHash)
+            {
+                record.settingsHash = *settingsHash;
+            }
+            else
+            {
+                log::error("Failed to save the settings of import {}", m_importId);
+                allSucceeded = false;
+            }
         }
 
-        pathBuilder.clear().append(importDir).append(ImportConfigFilename);
-        allSucceeded &= write_import_config(m_config, m_importerType, pathBuilder);
+        pathBuilder.clear().append(importDir).append_path(ImportRecordFilename);
+        allSucceeded &= write_import_record(record, pathBuilder);
+
+        m_config.registry->watch_import_sources(m_importId, sourceFiles);
 
         return allSucceeded;
     }
@@ -0,0 +1,842 @@
+#include <gtest/gtest.h>
+
+#include <oblo/asset/asset_meta.hpp>
+#include <oblo/asset/asset_registry.hpp>
+#include <oblo/asset/asset_type_desc.hpp>
+#include <oblo/asset/batch_importer.hpp>
+#include <oblo/asset/import_artifact.hpp>
+#include <oblo/asset/importer.hpp>
+#include <oblo/core/dynamic_array.hpp>
+#include <oblo/core/filesystem/file.hpp>
+#include <oblo/core/filesystem/filesystem.hpp>
+#include <oblo/core/string/string_builder.hpp>
+#include <oblo/core/uuid.hpp>
+#include <oblo/core/uuid_generator.hpp>
+#include <oblo/thread/job_manager.hpp>
+
+#include <atomic>
+#include <filesystem>
+#include <thread>
+
+namespace oblo
+{
+    namespace
+    {
+        bool write_file(cstring_view path, string_view content)
+        {
+            const filesystem::file_ptr f{filesystem::open_file(path, "w")};
+            return f && std::fwrite(content.data(), 1, content.size(), f.get()) == content.size();
+        }
+
+        struct test_asset
+        {
+            uuid id;
+            uuid mainArtifact;
+            dynamic_array<uuid> artifacts;
+        };
+
+        string_builder& make_test_asset_path(string_builder& path, cstring_view assetsDir, u32 i)
+        {
+            return path.clear()
+                .append(assetsDir)
+                .append_path(i % 2 == 0 ? "even" : "odd")
+                .append_path_separator()
+                .format("asset_{}", i)
+                .append(AssetMetaExtension);
+        }
+
+        bool write_test_asset_meta(cstring_view path, const test_asset& asset)
+        {
+            char uuidBuffer[36];
+            string_builder json;
+
+            json.format("{{\n\t\"id\": \"{}\",\n", asset.id.format_to(uuidBuffer));
+            json.format("\t\"mainArtifactHint\": \"{}\",\n", asset.mainArtifact.format_to(uuidBuffer));
+            // Unknown fields, including nested ones, should be skipped
+            json.append("\t\"unknown\": { \"id\": 42, \"artifacts\": [ \"not-a-uuid\" ] },\n");
+            json.append("\t\"typeHint\": \"oblo::unknown_type\",\n");
+            json.append("\t\"isImported\": true,\n");
+            json.append("\t\"artifacts\": [");
+
+            for (usize j = 0; j < asset.artifacts.size(); ++j)
+            {
+                json.format("{}\"{}\"", j == 0 ? "" : ", ", asset.artifacts[j].format_to(uuidBuffer));
+            }
+
+            json.append("]\n}");
+
+            return write_file(path, json);
+        }
+
+        void write_test_assets(cstring_view assetsDir, dynamic_array<test_asset>& assets)
+        {
+            constexpr u32 assetsCount{100};
+
+            uuid_random_generator gen;
+
+            string_builder path;
+
+            for (u32 i = 0; i < assetsCount; ++i)
+            {
+                auto& asset = assets.emplace_back();
+                asset.id = gen.generate();
+
+                for (u32 j = 0; j < i % 4; ++j)
+                {
+                    asset.artifacts.emplace_back(gen.generate());
+                }
+
+                asset.mainArtifact = asset.artifacts.empty() ? uuid{} : asset.artifacts[0];
+
+                path.clear().append(assetsDir).append_path(i % 2 == 0 ? "even" : "odd");
+                ASSERT_TRUE(filesystem::create_directories(path));
+
+                ASSERT_TRUE(write_test_asset_meta(make_test_asset_path(path, assetsDir, i), asset));
+            }
+
+            // Files that are not metas, or are malformed, should not end up in the registry
+            path.clear().append(assetsDir).append_path("readme.txt");
+            ASSERT_TRUE(write_file(path, "{ \"id\": \"not an asset\" }"));
+
+            path.clear().append(assetsDir).append_path("malformed").append(AssetMetaExtension);
+            ASSERT_TRUE(write_file(path, "{ \"id\": "));
+        }
+
+        struct test_text
+        {
+            string content;
+        };
+
+        // Imports text files as they are, counting the imports to tell when they actually happened
+        class test_text_importer final : public file_importer
+        {
+        public:
+            static inline std::atomic<u32> s_importsCount{0};
+
+        public:
+            bool init(const importer_config& config, import_preview& preview) override
+            {
+                m_source = config.sourceFile;
+                preview.nodes.push_back({.type = get_type_id<test_text>(), .name = "text"});
+                return true;
+            }
+
+            bool import(const import_context& context) override
+            {
+                string_builder content;
+
+                if (!filesystem::load_text_file_into_memory(content, m_source))
+                {
+                    return false;
+                }
+
+                ++s_importsCount;
+
+                m_artifact = {
+                    .id = context.importNodesConfig[0].id,
+                    .data = any_asset{test_text{.content = content.view().as<string>()}},
+                    .name = "text",
+                };
+
+                return true;
+            }
+
+            file_import_results get_results() override
+            {
+                return {
+                    .artifacts = {&m_artifact, 1},
+                    .sourceFiles = {&m_source, 1},
+                    .mainArtifactHint = m_artifact.id,
+                };
+            }
+
+        private:
+            string m_source;
+            import_artifact m_artifact;
+        };
+
+        void register_test_text(asset_registry& registry, u32 importerVersion)
+        {
+            static constexpr string_view extensions[] = {".txt"};
+
+            asset_type_desc typeDesc{};
+            typeDesc.type = get_type_id<test_text>();
+            typeDesc.create = []() -> void* { return new test_text{}; };
+            typeDesc.destroy = [](void* ptr) { delete static_cast<test_text*>(ptr); };
+            typeDesc.load = [](void*, cstring_view) { return false; };
+            typeDesc.save = [](const void* ptr, cstring_view destination)
+            { return write_file(destination, static_cast<const test_text*>(ptr)->content); };
+
+            registry.register_type(typeDesc);
+
+            registry.register_file_importer({
+                .type = get_type_id<test_text_importer>(),
+                .create = []() -> std::unique_ptr<file_importer> { return std::make_unique<test_text_importer>(); },
+                .extensions = extensions,
+                .version = importerVersion,
+            });
+        }
+
+        bool read_artifact_text(const asset_registry& registry, const uuid& artifactId, string_builder& content)
+        {
+            type_id type;
+            string name, path;
+
+            return asset_registry::find_artifact_resource(artifactId, type, name, path, &registry) &&
+                filesystem::load_text_file_into_memory(content, path);
+        }
+
+        void check_discovered_assets(const asset_registry& registry, const dynamic_array<test_asset>& assets)
+        {
+            dynamic_array<uuid> artifacts;
+
+            for (const auto& asset : assets)
+            {
+                asset_meta meta;
+                ASSERT_TRUE(registry.find_asset_by_id(asset.id, meta));
+
+                ASSERT_EQ(meta.id, asset.id);
+                ASSERT_EQ(meta.mainArtifactHint, asset.mainArtifact);
+                ASSERT_EQ(meta.typeHint, type_id{});
+                ASSERT_TRUE(meta.isImported);
+
+                ASSERT_TRUE(registry.find_asset_artifacts(asset.id, artifacts));
+                ASSERT_EQ(artifacts.size(), asset.artifacts.size());
+
+                for (usize i = 0; i < artifacts.size(); ++i)
+                {
+                    ASSERT_EQ(artifacts[i], asset.artifacts[i]);
+                }
+            }
+        }
+    }
+
+    TEST(asset_registry, discover_assets)
+    {
+        constexpr cstring_view testDir{"./test/asset_registry_discover/"};
+
+        filesystem::remove_all(testDir).assert_value();
+
+        string_builder assetsDir, artifactsDir, sourceFilesDir;
+        assetsDir.append(testDir).append_path("assets");
+        artifactsDir.append(testDir).append_path("artifacts");
+        sourceFilesDir.append(testDir).append_path("sources");
+
+        dynamic_array<test_asset> assets;
+
+        {
+            asset_registry registry;
+            ASSERT_TRUE(registry.initialize(assetsDir, artifactsDir, sourceFilesDir));
+
+            write_test_assets(assetsDir, assets);
+
+            // Without a job manager the metas are loaded on the calling thread
+            registry.discover_assets();
+            check_discovered_assets(registry, assets);
+        }
+
+        {
+            job_manager jm;
+            ASSERT_TRUE(jm.init());
+
+            asset_registry registry;
+            ASSERT_TRUE(registry.initialize(assetsDir, artifactsDir, sourceFilesDir));
+
+            registry.discover_assets();
+            check_discovered_assets(registry, assets);
+
+            jm.shutdown();
+        }
+    }
+
+    TEST(asset_registry, asset_database)
+    {
+        constexpr cstring_view testDir{"./test/asset_registry_database/"};
+
+        filesystem::remove_all(testDir).assert_value();
+
+        string_builder assetsDir, artifactsDir, sourceFilesDir;
+        assetsDir.append(testDir).append_path("assets");
+        artifactsDir.append(testDir).append_path("artifacts");
+        sourceFilesDir.append(testDir).append_path("sources");
+
+        dynamic_array<test_asset> assets;
+
+        {
+            asset_registry registry;
+            ASSERT_TRUE(registry.initialize(assetsDir, artifactsDir, sourceFilesDir));
+
+            write_test_assets(assetsDir, assets);
+
+            registry.discover_assets();
+            check_discovered_assets(registry, assets);
+        }
+
+        string_builder databasePath;
+        databasePath.append(artifactsDir).append_path("assets.odb");
+        ASSERT_TRUE(filesystem::exists(databasePath).value_or(false));
+
+        uuid_random_generator gen;
+        string_builder path;
+
+        // Rewrite the first meta with a different id, but restore size and time, so the cached meta is used
+        const test_asset original = assets[0];
+        test_asset tampered = original;
+        tampered.id = gen.generate();
+
+        make_test_asset_path(path, assetsDir, 0);
+
+        const std::filesystem::path firstAssetPath{path.view().as<std::string>()};
+        const auto firstAssetTime = std::filesystem::last_write_time(firstAssetPath);
+
+        ASSERT_TRUE(write_test_asset_meta(path, tampered));
+        std::filesystem::last_write_time(firstAssetPath, firstAssetTime);
+
+        // Modify one meta, remove another and add a new one, these have to be picked up
+        assets[1].artifacts.emplace_back(gen.generate());
+        ASSERT_TRUE(write_test_asset_meta(make_test_asset_path(path, assetsDir, 1), assets[1]));
+
+        const test_asset removed = assets[2];
+        ASSERT_TRUE(filesystem::remove(make_test_asset_path(path, assetsDir, 2)));
+        assets.erase(assets.begin() + 2);
+
+        auto& added = assets.emplace_back();
+        added.id = gen.generate();
+        ASSERT_TRUE(write_test_asset_meta(make_test_asset_path(path, assetsDir, 1000), added));
+
+        {
+            asset_registry registry;
+            ASSERT_TRUE(registry.initialize(assetsDir, artifactsDir, sourceFilesDir));
+
+            registry.discover_assets();
+            check_discovered_assets(registry, assets);
+
+            asset_meta meta;
+            ASSERT_FALSE(registry.find_asset_by_id(removed.id, meta));
+            ASSERT_FALSE(registry.find_asset_by_id(tampered.id, meta));
+        }
+
+        // A corrupted database is ignored, so all metas are parsed again
+        ASSERT_TRUE(write_file(databasePath, "OADB"));
+
+        {
+            asset_registry registry;
+            ASSERT_TRUE(registry.initialize(assetsDir, artifactsDir, sourceFilesDir));
+
+            registry.discover_assets();
+
+            asset_meta meta;
+            ASSERT_TRUE(registry.find_asset_by_id(tampered.id, meta));
+            ASSERT_FALSE(registry.find_asset_by_id(original.id, meta));
+        }
+    }
+
+    TEST(asset_registry, path_index)
+    {
+        constexpr cstring_view testDir{"./test/asset_registry_path_index/"};
+
+        filesystem::remove_all(testDir).assert_value();
+
+        string_builder assetsDir, artifactsDir, sourceFilesDir;
+        assetsDir.append(testDir).append_path("assets");
+        artifactsDir.append(testDir).append_path("artifacts");
+        sourceFilesDir.append(testDir).append_path("sources");
+
+        asset_registry registry;
+        ASSERT_TRUE(registry.initialize(assetsDir, artifactsDir, sourceFilesDir));
+
+        dynamic_array<test_asset> assets;
+        write_test_assets(assetsDir, assets);
+
+        registry.discover_assets();
+
+        uuid id;
+        asset_meta meta;
+        string_builder path;
+
+        ASSERT_TRUE(registry.find_asset_by_path("even/asset_0", id, meta));
+        ASSERT_EQ(id, assets[0].id);
+
+        ASSERT_TRUE(registry.find_asset_by_path("./odd/../odd/asset_1", id, meta));
+        ASSERT_EQ(id, assets[1].id);
+
+        ASSERT_FALSE(registry.find_asset_by_path("even/asset_1", id, meta));
+
+        // Absolute paths to the meta, like the ones used by the asset browser, also work
+        make_test_asset_path(path, registry.get_asset_directory(), 2);
+        ASSERT_TRUE(registry.find_asset_by_meta_path(path, id, meta));
+        ASSERT_EQ(id, assets[2].id);
+
+        ASSERT_TRUE(registry.find_asset_path(assets[3].id, path));
+        ASSERT_EQ(path.view(), "odd/asset_3");
+
+        ASSERT_TRUE(registry.move_asset(assets[3].id, "moved/asset_3"));
+
+        ASSERT_FALSE(registry.find_asset_by_path("odd/asset_3", id, meta));
+        ASSERT_TRUE(registry.find_asset_by_path("moved/asset_3", id, meta));
+        ASSERT_EQ(id, assets[3].id);
+
+        ASSERT_TRUE(registry.find_asset_path(assets[3].id, path));
+        ASSERT_EQ(path.view(), "moved/asset_3");
+
+        path.clear().append(assetsDir).append_path("moved/asset_3").append(AssetMetaExtension);
+        ASSERT_TRUE(filesystem::exists(path).value_or(false));
+
+        // Moving on top of another asset is not allowed
+        ASSERT_FALSE(registry.move_asset(assets[4].id, "moved/asset_3"));
+
+        // Lookups don't read the metas, they keep working until the next discovery
+        ASSERT_TRUE(filesystem::remove(path));
+        ASSERT_TRUE(registry.find_asset_by_path("moved/asset_3", id, meta));
+    }
+
+#ifdef _WIN32
+    TEST(asset_registry, path_index_ignores_case)
+    {
+        constexpr cstring_view testDir{"./test/asset_registry_path_index_case/"};
+
+        filesystem::remove_all(testDir).assert_value();
+
+        string_builder assetsDir, artifactsDir, sourceFilesDir;
+        assetsDir.append(testDir).append_path("assets");
+        artifactsDir.append(testDir).append_path("artifacts");
+        sourceFilesDir.append(testDir).append_path("sources");
+
+        asset_registry registry;
+        ASSERT_TRUE(registry.initialize(assetsDir, artifactsDir, sourceFilesDir));
+
+        dynamic_array<test_asset> assets;
+        write_test_assets(assetsDir, assets);
+
+        registry.discover_assets();
+
+        uuid id;
+        asset_meta meta;
+        string_builder path;
+
+        // File names are case-insensitive on Windows, so are lookups
+        ASSERT_TRUE(registry.find_asset_by_path("Even/ASSET_0", id, meta));
+        ASSERT_EQ(id, assets[0].id);
+
+        // The case of the path on disk is preserved
+        ASSERT_TRUE(registry.find_asset_path(assets[0].id, path));
+        ASSERT_EQ(path.view(), "even/asset_0");
+
+        // A drive letter with a different case still refers to the assets directory
+        make_test_asset_path(path, registry.get_asset_directory(), 2);
+        ASSERT_EQ(path.view().at(1), ':');
+
+        string_builder otherDrive;
+        otherDrive.append(char(path.view().at(0) ^ 0x20)).append(path.view().substr(1));
+
+        ASSERT_TRUE(registry.find_asset_by_meta_path(otherDrive, id, meta));
+        ASSERT_EQ(id, assets[2].id);
+
+        // Paths that only differ in case refer to the same file, so this would overwrite another asset
+        ASSERT_FALSE(registry.move_asset(assets[3].id, "ODD/asset_1"));
+    }
+#endif
+
+    TEST(asset_registry, reimport_if_stale)
+    {
+        constexpr cstring_view testDir{"./test/asset_registry_reimport/"};
+
+        filesystem::remove_all(testDir).assert_value();
+
+        string_builder assetsDir, artifactsDir, sourceFilesDir, sourceFile;
+        assetsDir.append(testDir).append_path("assets");
+        artifactsDir.append(testDir).append_path("artifacts");
+        sourceFilesDir.append(testDir).append_path("sources");
+        sourceFile.append(testDir).append_path("text.txt");
+
+        asset_registry registry;
+        ASSERT_TRUE(registry.initialize(assetsDir, artifactsDir, sourceFilesDir));
+
+        register_test_text(registry, 1);
+
+        ASSERT_TRUE(write_file(sourceFile, "first"));
+
+        {
+            auto importer = registry.create_importer(sourceFile);
+            ASSERT_TRUE(importer.is_valid());
+            ASSERT_TRUE(importer.init());
+            ASSERT_TRUE(importer.execute("imported", data_document{}));
+        }
+
+        uuid id;
+        asset_meta meta;
+        ASSERT_TRUE(registry.find_asset_by_path("imported/text", id, meta));
+
+        dynamic_array<uuid> artifacts;
+        ASSERT_TRUE(registry.find_asset_artifacts(id, artifacts));
+        ASSERT_EQ(artifacts.size(), 1);
+
+        const uuid artifactId = artifacts[0];
+
+        string_builder artifactContent;
+
+        test_text_importer::s_importsCount = 0;
+
+        // Nothing changed since the import
+        ASSERT_EQ(registry.reimport_if_stale(id), reimport_result::up_to_date);
+        ASSERT_EQ(test_text_importer::s_importsCount.load(), 0);
+
+        // Changing the content of the source triggers the reimport, which keeps the ids stable
+        ASSERT_TRUE(write_file(sourceFile, "second"));
+        ASSERT_EQ(registry.reimport_if_stale(id), reimport_result::reimported);
+        ASSERT_EQ(test_text_importer::s_importsCount.load(), 1);
+
+        ASSERT_TRUE(registry.find_asset_by_path("imported/text", id, meta));
+        ASSERT_TRUE(registry.find_asset_artifacts(id, artifacts));
+        ASSERT_EQ(artifacts.size(), 1);
+        ASSERT_EQ(artifacts[0], artifactId);
+
+        ASSERT_TRUE(read_artifact_text(registry, artifactId, artifactContent));
+        ASSERT_EQ(artifactContent.view(), "second");
+
+        // Rewriting the same content doesn't make the import stale
+        ASSERT_TRUE(write_file(sourceFile, "second"));
+
+        auto result = registry.refresh_imports();
+        ASSERT_EQ(result.upToDate, 1);
+        ASSERT_EQ(result.reimported, 0);
+        ASSERT_EQ(result.failed, 0);
+        ASSERT_EQ(test_text_importer::s_importsCount.load(), 1);
+
+        // A new version of the importer makes all its imports stale
+        registry.unregister_file_importer(get_type_id<test_text_importer>());
+        register_test_text(registry, 2);
+
+        result = registry.refresh_imports();
+        ASSERT_EQ(result.upToDate, 0);
+        ASSERT_EQ(result.reimported, 1);
+        ASSERT_EQ(result.failed, 0);
+        ASSERT_EQ(test_text_importer::s_importsCount.load(), 2);
+
+        ASSERT_EQ(registry.reimport_if_stale(id), reimport_result::up_to_date);
+
+        // When the original source is gone, the copy stored with the import is checked instead
+        ASSERT_TRUE(filesystem::remove(sourceFile));
+        ASSERT_EQ(registry.reimport_if_stale(id), reimport_result::up_to_date);
+
+        // Imports whose sources are gone can't be refreshed
+        ASSERT_TRUE(filesystem::remove_all(sourceFilesDir));
+        ASSERT_EQ(registry.reimport_if_stale(id), reimport_result::failed);
+    }
+
+    TEST(asset_registry, reimport_moved_project)
+    {
+        constexpr cstring_view testDir{"./test/asset_registry_moved_project/"};
+
+        filesystem::remove_all(testDir).assert_value();
+
+        string_builder projectDir, assetsDir, artifactsDir, sourceFilesDir, sourceFile;
+
+        const auto makeProjectPaths = [&](string_view project)
+        {
+            projectDir.clear().append(testDir).append_path(project);
+            assetsDir.clear().append(projectDir).append_path("assets");
+            artifactsDir.clear().append(projectDir).append_path("artifacts");
+            sourceFilesDir.clear().append(projectDir).append_path("sources");
+            sourceFile.clear().append(projectDir).append_path("raw").append_path("text.txt");
+        };
+
+        makeProjectPaths("before");
+
+        {
+            asset_registry registry;
+            ASSERT_TRUE(registry.initialize(assetsDir, artifactsDir, sourceFilesDir));
+
+            register_test_text(registry, 1);
+
+            string_builder rawDir;
+            rawDir.append(projectDir).append_path("raw");
+            filesystem::create_directories(rawDir).assert_value();
+            ASSERT_TRUE(write_file(sourceFile, "first"));
+
+            auto importer = registry.create_importer(sourceFile);
+            ASSERT_TRUE(importer.is_valid());
+            ASSERT_TRUE(importer.init());
+            ASSERT_TRUE(importer.execute("imported", data_document{}));
+        }
+
+        // Moving the whole project, like checking it out on another machine, keeps the sources of the imports
+        string_builder previousDir = projectDir;
+        makeProjectPaths("after");
+        ASSERT_TRUE(filesystem::rename(previousDir, projectDir));
+
+        asset_registry registry;
+        ASSERT_TRUE(registry.initialize(assetsDir, artifactsDir, sourceFilesDir));
+
+        register_test_text(registry, 1);
+        registry.discover_assets();
+
+        test_text_importer::s_importsCount = 0;
+
+        auto result = registry.refresh_imports();
+        ASSERT_EQ(result.upToDate, 1);
+        ASSERT_EQ(result.reimported, 0);
+        ASSERT_EQ(result.failed, 0);
+
+        // Changes to the source in the new location are picked up
+        ASSERT_TRUE(write_file(sourceFile, "second"));
+
+        result = registry.refresh_imports();
+        ASSERT_EQ(result.upToDate, 0);
+        ASSERT_EQ(result.reimported, 1);
+        ASSERT_EQ(result.failed, 0);
+        ASSERT_EQ(test_text_importer::s_importsCount.load(), 1);
+
+        uuid id;
+        asset_meta meta;
+        ASSERT_TRUE(registry.find_asset_by_path("imported/text", id, meta));
+
+        dynamic_array<uuid> artifacts;
+        ASSERT_TRUE(registry.find_asset_artifacts(id, artifacts));
+        ASSERT_EQ(artifacts.size(), 1);
+
+        string_builder artifactContent;
+        ASSERT_TRUE(read_artifact_text(registry, artifacts[0], artifactContent));
+        ASSERT_EQ(artifactContent.view(), "second");
+    }
+
+    TEST(asset_registry, batch_import)
+    {
+        constexpr cstring_view testDir{"./test/asset_registry_batch_import/"};
+        constexpr u32 filesCount{64};
+
+        filesystem::remove_all(testDir).assert_value();
+
+        string_builder assetsDir, artifactsDir, sourceFilesDir, sourcesDir;
+        assetsDir.append(testDir).append_path("assets");
+        artifactsDir.append(testDir).append_path("artifacts");
+        sourceFilesDir.append(testDir).append_path("sources");
+        sourcesDir.append(testDir).append_path("texts");
+
+        ASSERT_TRUE(filesystem::create_directories(sourcesDir));
+
+        string_builder path, content;
+
+        for (u32 i = 0; i < filesCount; ++i)
+        {
+            path.clear().append(sourcesDir).append_path_separator().format("text_{}.txt", i);
+            content.clear().format("content_{}", i);
+            ASSERT_TRUE(write_file(path, content));
+        }
+
+        job_manager jm;
+        ASSERT_TRUE(jm.init());
+
+        {
+            asset_registry registry;
+            ASSERT_TRUE(registry.initialize(assetsDir, artifactsDir, sourceFilesDir));
+
+            register_test_text(registry, 1);
+
+            batch_importer batch{registry};
+
+            for (u32 i = 0; i < filesCount; ++i)
+            {
+                path.clear().append(sourcesDir).append_path_separator().format("text_{}.txt", i);
+                ASSERT_TRUE(batch.add(path, "batch"));
+            }
+
+            // Files without a registered importer are rejected upfront
+            path.clear().append(sourcesDir).append_path("unknown.bin");
+            ASSERT_FALSE(batch.add(path, "batch"));
+
+            ASSERT_TRUE(batch.start());
+            ASSERT_FALSE(batch.add(path, "batch"));
+
+            // Results are saved to the registry by update, on this thread
+            while (!batch.is_done())
+            {
+                batch.update();
+                std::this_thread::yield();
+            }
+
+            const auto progress = batch.get_progress();
+            ASSERT_EQ(progress.total, filesCount);
+            ASSERT_EQ(progress.completed, filesCount);
+            ASSERT_EQ(progress.failed, 0);
+            ASSERT_EQ(progress.canceled, 0);
+
+            dynamic_array<uuid> artifacts;
+
+            for (u32 i = 0; i < filesCount; ++i)
+            {
+                ASSERT_EQ(batch.get_status(i), batch_import_status::succeeded);
+
+                uuid id;
+                asset_meta meta;
+
+                path.clear().format("batch/text_{}", i);
+                ASSERT_TRUE(registry.find_asset_by_path(path, id, meta));
+                ASSERT_EQ(id, batch.get_import_id(i));
+
+                ASSERT_TRUE(registry.find_asset_artifacts(id, artifacts));
+                ASSERT_EQ(artifacts.size(), 1);
+
+                ASSERT_TRUE(read_artifact_text(registry, artifacts[0], content));
+                ASSERT_EQ(content.view(), string_builder{}.format("content_{}", i).view());
+            }
+
+            // Importing the same files again fails, since the assets already exist
+            batch_importer again{registry};
+
+            for (u32 i = 0; i < 4; ++i)
+            {
+                path.clear().append(sourcesDir).append_path_separator().format("text_{}.txt", i);
+                ASSERT_TRUE(again.add(path, "batch"));
+            }
+
+            ASSERT_TRUE(again.start());
+            again.wait();
+
+            ASSERT_EQ(again.get_progress().failed, 4);
+
+            // Canceling before the jobs run skips all files
+            batch_importer canceled{registry};
+
+            for (u32 i = 0; i < filesCount; ++i)
+            {
+                path.clear().append(sourcesDir).append_path_separator().format("text_{}.txt", i);
+                ASSERT_TRUE(canceled.add(path, "canceled"));
+            }
+
+            canceled.cancel();
+            ASSERT_TRUE(canceled.start());
+            canceled.wait();
+
+            ASSERT_EQ(canceled.get_progress().canceled, filesCount);
+
+            uuid id;
+            asset_meta meta;
+            ASSERT_FALSE(registry.find_asset_by_path("canceled/text_0", id, meta));
+        }
+
+        jm.shutdown();
+    }
+
+    TEST(asset_registry, content_addressed_artifacts)
+    {
+        constexpr cstring_view testDir{"./test/asset_registry_content_addressed/"};
+
+        filesystem::remove_all(testDir).assert_value();
+
+        string_builder assetsDir, artifactsDir, sourceFilesDir, contentDir;
+        assetsDir.append(testDir).append_path("assets");
+        artifactsDir.append(testDir).append_path("artifacts");
+        sourceFilesDir.append(testDir).append_path("sources");
+        contentDir.append(artifactsDir).append_path("content");
+
+        asset_registry registry;
+        ASSERT_TRUE(registry.initialize(assetsDir, artifactsDir, sourceFilesDir));
+
+        register_test_text(registry, 1);
+
+        constexpr string_view names[] = {"a", "b", "c"};
+        constexpr string_view contents[] = {"same", "same", "other"};
+
+        uuid assetIds[3];
+        uuid artifactIds[3];
+        string artifactPaths[3];
+
+        string_builder path;
+
+        for (u32 i = 0; i < 3; ++i)
+        {
+            path.clear().append(testDir).append_path(names[i]).append(".txt");
+            ASSERT_TRUE(write_file(path, contents[i]));
+
+            auto importer = registry.create_importer(path);
+            ASSERT_TRUE(importer.is_valid());
+            ASSERT_TRUE(importer.init());
+            ASSERT_TRUE(importer.execute("dedup", data_document{}));
+
+            asset_meta meta;
+            path.clear().append("dedup").append_path(names[i]);
+            ASSERT_TRUE(registry.find_asset_by_path(path, assetIds[i], meta));
+
+            dynamic_array<uuid> artifacts;
+            ASSERT_TRUE(registry.find_asset_artifacts(assetIds[i], artifacts));
+            ASSERT_EQ(artifacts.size(), 1);
+            artifactIds[i] = artifacts[0];
+
+            type_id type;
+            string name;
+            ASSERT_TRUE(
+                asset_registry::find_artifact_resource(artifactIds[i], type, name, artifactPaths[i], &registry));
+        }
+
+        const auto countContentFiles = [&contentDir]
+        {
+            u32 count{};
+
+            for (const auto& entry : std::filesystem::directory_iterator{contentDir.as<std::string>()})
+            {
+                count += entry.is_regular_file();
+            }
+
+            return count;
+        };
+
+        // Identical artifacts keep their own ids, but share the data
+        ASSERT_NE(artifactIds[0], artifactIds[1]);
+        ASSERT_EQ(artifactPaths[0], artifactPaths[1]);
+        ASSERT_NE(artifactPaths[0], artifactPaths[2]);
+        ASSERT_EQ(countContentFiles(), 2);
+
+        string_builder content;
+        ASSERT_TRUE(read_artifact_text(registry, artifactIds[1], content));
+        ASSERT_EQ(content.view(), "same");
+
+        // Reimporting with the same output doesn't store anything new
+        registry.unregister_file_importer(get_type_id<test_text_importer>());
+        register_test_text(registry, 2);
+
+        ASSERT_EQ(registry.reimport_if_stale(assetIds[0]), reimport_result::reimported);
+
+        type_id type;
+        string name, reimportedPath;
+        ASSERT_TRUE(asset_registry::find_artifact_resource(artifactIds[0], type, name, reimportedPath, &registry));
+        ASSERT_EQ(reimportedPath, artifactPaths[0]);
+        ASSERT_EQ(countContentFiles(), 2);
+
+        artifact_meta artifactMeta;
+        ASSERT_TRUE(registry.load_artifact_meta(artifactIds[0], artifactMeta));
+        ASSERT_EQ(artifactMeta.id, artifactIds[0]);
+        ASSERT_NE(artifactMeta.contentHash, 0);
+
+        const auto reimportWith = [&](asset_registry& r, u32 index, string_view newContent)
+        {
+            path.clear().append(testDir).append_path(names[index]).append(".txt");
+            return write_file(path, newContent) && r.reimport_if_stale(assetIds[index]) == reimport_result::reimported;
+        };
+
+        // The shared data is kept as long as any artifact references it
+        ASSERT_TRUE(reimportWith(registry, 0, "changed"));
+        ASSERT_EQ(countContentFiles(), 3);
+
+        ASSERT_TRUE(reimportWith(registry, 1, "other"));
+        ASSERT_EQ(countContentFiles(), 2);
+
+        ASSERT_TRUE(read_artifact_text(registry, artifactIds[2], content));
+        ASSERT_EQ(content.view(), "other");
+
+        // References are counted from the artifacts on disk when a registry is created again
+        asset_registry other;
+        ASSERT_TRUE(other.initialize(assetsDir, artifactsDir, sourceFilesDir));
+        register_test_text(other, 2);
+        other.discover_assets();
+
+        ASSERT_TRUE(reimportWith(other, 2, "new"));
+        ASSERT_EQ(countContentFiles(), 3);
+
+        ASSERT_TRUE(reimportWith(other, 1, "last"));
+        ASSERT_EQ(countContentFiles(), 3);
+
+        ASSERT_TRUE(read_artifact_text(other, artifactIds[1], content));
+        ASSERT_EQ(content.view(), "last");
+    }
+}
\ No newline at end of file
@@ -0,0 +1,165 @@
+#include <benchmark/benchmark.h>
+
+#include <oblo/core/dynamic_array.hpp>
+#include <oblo/math/batch_transform.hpp>
+#include <oblo/math/mat4.hpp>
+#include <oblo/math/transform.hpp>
+
+#include <random>
+
+namespace oblo
+{
+    namespace
+    {
+        struct trs_soa
+        {
+            dynamic_array<f32> p[3];
+            dynamic_array<f32> r[4];
+            dynamic_array<f32> s[3];
+
+            vec3_soa_view positions() const
+            {
+                return {p[0].data(), p[1].data(), p[2].data()};
+            }
+
+            quaternion_soa_view rotations() const
+            {
+                return {r[0].data(), r[1].data(), r[2].data(), r[3].data()};
+            }
+
+            vec3_soa_view scales() const
+            {
+                return {s[0].data(), s[1].data(), s[2].data()};
+            }
+        };
+
+        trs_soa make_trs(usize count)
+        {
+            std::mt19937 rng{42};
+            std::uniform_real_distribution<f32> dist{-1.f, 1.f};
+
+            trs_soa trs;
+
+            for (auto* const arrays : {trs.p, trs.s})
+            {
+                for (u32 c = 0; c < 3; ++c)
+                {
+                    arrays[c].resize(count);
+
+                    for (auto& v : arrays[c])
+                    {
+                        v = dist(rng);
+                    }
+                }
+            }
+
+            for (auto& component : trs.r)
+            {
+                component.resize(count);
+            }
+
+            for (usize i = 0; i < count; ++i)
+            {
+                const auto q = normalize(quaternion{dist(rng), dist(rng), dist(rng), dist(rng)});
+
+                trs.r[0][i] = q.x;
+                trs.r[1][i] = q.y;
+                trs.r[2][i] = q.z;
+                trs.r[3][i] = q.w;
+            }
+
+            return trs;
+        }
+
+        void make_transform_matrix_single(benchmark::State& state)
+        {
+            const auto count = usize(state.range(0));
+            const auto trs = make_trs(count);
+
+            dynamic_array<mat4> out;
+            out.resize(count);
+
+            for (auto _ : state)
+            {
+                for (usize i = 0; i < count; ++i)
+                {
+                    out[i] = make_transform_matrix({trs.p[0][i], trs.p[1][i], trs.p[2][i]},
+                        {trs.r[0][i], trs.r[1][i], trs.r[2][i], trs.r[3][i]},
+                        {trs.s[0][i], trs.s[1][i], trs.s[2][i]});
+                }
+
+                benchmark::DoNotOptimize(out.data());
+            }
+
+            state.SetItemsProcessed(state.iterations() * state.range(0));
+        }
+
+        void make_transform_matrix_batch(benchmark::State& state)
+        {
+            const auto count = usize(state.range(0));
+            const auto trs = make_trs(count);
+
+            dynamic_array<mat4> out;
+            out.resize(count);
+
+            for (auto _ : state)
+            {
+                make_transform_matrices(trs.positions(), trs.rotations(), trs.scales(), out);
+                benchmark::DoNotOptimize(out.data());
+            }
+
+            state.SetItemsProcessed(state.iterations() * state.range(0));
+        }
+
+        void inverse_transpose_single(benchmark::State& state)
+        {
+            const auto count = usize(state.range(0));
+            const auto trs = make_trs(count);
+
+            dynamic_array<mat4> matrices;
+            matrices.resize(count);
+            make_transform_matrices(trs.positions(), trs.rotations(), trs.scales(), matrices);
+
+            dynamic_array<mat4> out;
+            out.resize(count);
+
+            for (auto _ : state)
+            {
+                for (usize i = 0; i < count; ++i)
+                {
+                    out[i] = transpose(inverse(matrices[i]).value_or(mat4::identity()));
+                }
+
+                benchmark::DoNotOptimize(out.data());
+            }
+
+            state.SetItemsProcessed(state.iterations() * state.range(0));
+        }
+
+        void inverse_transpose_batch(benchmark::State& state)
+        {
+            const auto count = usize(state.range(0));
+            const auto trs = make_trs(count);
+
+            dynamic_array<mat4> matrices;
+            matrices.resize(count);
+            make_transform_matrices(trs.positions(), trs.rotations(), trs.scales(), matrices);
+
+            dynamic_array<mat4> out;
+            out.resize(count);
+
+            for (auto _ : state)
+            {
+                inverse_transpose(matrices, out);
+                benchmark::DoNotOptimize(out.data());
+            }
+
+            state.SetItemsProcessed(state.iterations() * state.range(0));
+        }
+    }
+
+    BENCHMARK(make_transform_matrix_single)->RangeMultiplier(8)->Range(64, 1 << 16);
+    BENCHMARK(make_transform_matrix_batch)->RangeMultiplier(8)->Range(64, 1 << 16);
+    BENCHMARK(inverse_transpose_single)->RangeMultiplier(8)->Range(64, 1 << 16);
+    BENCHMARK(inverse_transpose_batch)->RangeMultiplier(8)->Range(64, 1 << 16);
+}
\ No newline at end of file
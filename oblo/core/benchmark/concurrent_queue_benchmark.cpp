@@ -0,0 +1,138 @@
+#include <benchmark/benchmark.h>
+
+#include <oblo/core/mpsc_linked_queue.hpp>
+#include <oblo/core/mpsc_queue.hpp>
+#include <oblo/core/spsc_queue.hpp>
+
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace oblo
+{
+    namespace
+    {
+        constexpr u32 ElementsPerProducer{1u << 18};
+        constexpr usize Capacity{1024};
+
+        // Baseline to compare against, what we would use without a dedicated queue
+        template <typename T>
+        class mutex_queue
+        {
+        public:
+            bool try_push(const T& value)
+            {
+                const std::lock_guard lock{m_mutex};
+                m_queue.push_back(value);
+                return true;
+            }
+
+            bool try_pop(T& out)
+            {
+                const std::lock_guard lock{m_mutex};
+
+                if (m_queue.empty())
+                {
+                    return false;
+                }
+
+                out = m_queue.front();
+                m_queue.pop_front();
+                return true;
+            }
+
+        private:
+            std::mutex m_mutex;
+            std::deque<T> m_queue;
+        };
+
+        template <typename Queue>
+        Queue* make_queue()
+        {
+            if constexpr (std::is_constructible_v<Queue, usize>)
+            {
+                return new Queue{Capacity};
+            }
+            else
+            {
+                return new Queue{};
+            }
+        }
+
+        template <typename Queue>
+        bool push(Queue& queue, u64 value)
+        {
+            if constexpr (requires { queue.try_push(value); })
+            {
+                return queue.try_push(value);
+            }
+            else
+            {
+                queue.push(value);
+                return true;
+            }
+        }
+
+        template <typename Queue>
+        void queue_throughput(benchmark::State& state)
+        {
+            const auto producersCount = u32(state.range(0));
+
+            for (auto _ : state)
+            {
+                auto* const queue = make_queue<Queue>();
+
+                std::vector<std::thread> producers;
+
+                for (u32 p = 0; p < producersCount; ++p)
+                {
+                    producers.emplace_back(
+                        [queue]
+                        {
+                            for (u64 i = 0; i < ElementsPerProducer; ++i)
+                            {
+                                while (!push(*queue, i))
+                                {
+                                    std::this_thread::yield();
+                                }
+                            }
+                        });
+                }
+
+                const u64 total = u64{producersCount} * ElementsPerProducer;
+                u64 sum = 0;
+
+                for (u64 received = 0; received < total;)
+                {
+                    u64 value;
+
+                    if (queue->try_pop(value))
+                    {
+                        sum += value;
+                        ++received;
+                    }
+                    else
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+
+                for (auto& producer : producers)
+                {
+                    producer.join();
+                }
+
+                benchmark::DoNotOptimize(sum);
+                delete queue;
+            }
+
+            state.SetItemsProcessed(state.iterations() * state.range(0) * ElementsPerProducer);
+        }
+    }
+
+    BENCHMARK(queue_throughput<mutex_queue<u64>>)->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
+    BENCHMARK(queue_throughput<spsc_queue<u64>>)->Arg(1)->UseRealTime();
+    BENCHMARK(queue_throughput<mpsc_queue<u64>>)->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
+    BENCHMARK(queue_throughput<mpsc_linked_queue<u64>>)->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
+}
\ No newline at end of file
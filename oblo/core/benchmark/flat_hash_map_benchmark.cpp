@@ -0,0 +1,181 @@
+#include <benchmark/benchmark.h>
+
+#include <oblo/core/dynamic_array.hpp>
+#include <oblo/core/flat_hash_map.hpp>
+#include <oblo/core/uuid.hpp>
+
+#include <random>
+#include <unordered_map>
+
+namespace oblo
+{
+    namespace
+    {
+        template <typename K>
+        dynamic_array<K> make_keys(usize count, u32 seed)
+        {
+            std::mt19937_64 rng{seed};
+
+            dynamic_array<K> keys;
+            keys.reserve(count);
+
+            for (usize i = 0; i < count; ++i)
+            {
+                if constexpr (std::is_same_v<K, uuid>)
+                {
+                    const u64 parts[2] = {rng(), rng()};
+
+                    uuid id;
+                    std::memcpy(id.data, parts, sizeof(parts));
+
+                    keys.push_back(id);
+                }
+                else
+                {
+                    keys.push_back(K(rng()));
+                }
+            }
+
+            return keys;
+        }
+
+        template <typename Map, typename K>
+        void hash_map_insert(benchmark::State& state)
+        {
+            const auto keys = make_keys<K>(usize(state.range(0)), 42);
+
+            for (auto _ : state)
+            {
+                Map map;
+
+                for (const auto& k : keys)
+                {
+                    map.emplace(k, u32{});
+                }
+
+                benchmark::DoNotOptimize(map);
+            }
+
+            state.SetItemsProcessed(state.iterations() * state.range(0));
+        }
+
+        template <typename Map, typename K>
+        void hash_map_find_hit(benchmark::State& state)
+        {
+            const auto keys = make_keys<K>(usize(state.range(0)), 42);
+
+            Map map;
+
+            for (const auto& k : keys)
+            {
+                map.emplace(k, u32{});
+            }
+
+            for (auto _ : state)
+            {
+                for (const auto& k : keys)
+                {
+                    benchmark::DoNotOptimize(map.find(k));
+                }
+            }
+
+            state.SetItemsProcessed(state.iterations() * state.range(0));
+        }
+
+        template <typename Map, typename K>
+        void hash_map_find_miss(benchmark::State& state)
+        {
+            const auto keys = make_keys<K>(usize(state.range(0)), 42);
+            const auto misses = make_keys<K>(usize(state.range(0)), 1337);
+
+            Map map;
+
+            for (const auto& k : keys)
+            {
+                map.emplace(k, u32{});
+            }
+
+            for (auto _ : state)
+            {
+                for (const auto& k : misses)
+                {
+                    benchmark::DoNotOptimize(map.find(k));
+                }
+            }
+
+            state.SetItemsProcessed(state.iterations() * state.range(0));
+        }
+
+        template <typename Map, typename K>
+        void hash_map_erase_insert_churn(benchmark::State& state)
+        {
+            const auto keys = make_keys<K>(usize(state.range(0)), 42);
+
+            Map map;
+
+            for (const auto& k : keys)
+            {
+                map.emplace(k, u32{});
+            }
+
+            for (auto _ : state)
+            {
+                for (const auto& k : keys)
+                {
+                    map.erase(k);
+                    map.emplace(k, u32{});
+                }
+            }
+
+            state.SetItemsProcessed(state.iterations() * state.range(0));
+        }
+
+        template <typename Map, typename K>
+        void hash_map_iterate(benchmark::State& state)
+        {
+            const auto keys = make_keys<K>(usize(state.range(0)), 42);
+
+            Map map;
+
+            for (const auto& k : keys)
+            {
+                map.emplace(k, u32{1});
+            }
+
+            for (auto _ : state)
+            {
+                u32 sum{};
+
+                for (const auto& [k, v] : map)
+                {
+                    sum += v;
+                }
+
+                benchmark::DoNotOptimize(sum);
+            }
+
+            state.SetItemsProcessed(state.iterations() * state.range(0));
+        }
+
+        template <typename K>
+        using std_map = std::unordered_map<K, u32, hash<K>>;
+
+        template <typename K>
+        using flat_map = flat_hash_map<K, u32>;
+    }
+
+#define OBLO_HASH_MAP_BENCHMARK(Name, Key)                                                                             \
+    BENCHMARK(Name<std_map<Key>, Key>)->RangeMultiplier(8)->Range(64, 1 << 20);                                       \
+    BENCHMARK(Name<flat_map<Key>, Key>)->RangeMultiplier(8)->Range(64, 1 << 20);
+
+    OBLO_HASH_MAP_BENCHMARK(hash_map_insert, u64)
+    OBLO_HASH_MAP_BENCHMARK(hash_map_insert, uuid)
+    OBLO_HASH_MAP_BENCHMARK(hash_map_find_hit, u64)
+    OBLO_HASH_MAP_BENCHMARK(hash_map_find_hit, uuid)
+    OBLO_HASH_MAP_BENCHMARK(hash_map_find_miss, u64)
+    OBLO_HASH_MAP_BENCHMARK(hash_map_find_miss, uuid)
+    OBLO_HASH_MAP_BENCHMARK(hash_map_erase_insert_churn, u64)
+    OBLO_HASH_MAP_BENCHMARK(hash_map_iterate, u64)
+
+#undef OBLO_HASH_MAP_BENCHMARK
+}
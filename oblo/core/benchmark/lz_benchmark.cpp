@@ -0,0 +1,102 @@
+#include <benchmark/benchmark.h>
+
+#include <oblo/core/compression/lz.hpp>
+
+#include <cstring>
+#include <random>
+
+namespace oblo::lz
+{
+    namespace
+    {
+        // Vertex-like data: smooth floats with repeated attributes, which is typical for our artifacts
+        dynamic_array<byte> make_benchmark_data(usize size)
+        {
+            std::mt19937 rng{42};
+            std::uniform_real_distribution<f32> noise{-0.01f, 0.01f};
+
+            dynamic_array<byte> data;
+            data.reserve(size + 64);
+
+            f32 position[3]{};
+            const f32 normal[3]{0.f, 1.f, 0.f};
+
+            while (data.size() < size)
+            {
+                for (auto& p : position)
+                {
+                    p += noise(rng);
+                }
+
+                const auto* const p = reinterpret_cast<const byte*>(position);
+                const auto* const n = reinterpret_cast<const byte*>(normal);
+
+                data.append(p, p + sizeof(position));
+                data.append(n, n + sizeof(normal));
+            }
+
+            data.resize(size);
+            return data;
+        }
+
+        constexpr usize DataSize{16u << 20};
+    }
+
+    void lz_compress_frame(benchmark::State& state)
+    {
+        const auto data = make_benchmark_data(DataSize);
+
+        dynamic_array<byte> frame;
+        frame.resize(frame_compress_bound(data.size()));
+
+        usize compressedSize{};
+
+        for (auto _ : state)
+        {
+            compressedSize = compress_frame(data, frame).value_or(0);
+            benchmark::DoNotOptimize(frame.data());
+        }
+
+        state.SetBytesProcessed(state.iterations() * data.size());
+        state.counters["ratio"] = f64(data.size()) / f64(compressedSize);
+    }
+
+    void lz_decompress_frame(benchmark::State& state)
+    {
+        const auto data = make_benchmark_data(DataSize);
+
+        dynamic_array<byte> frame;
+        compress_frame(data, frame).assert_value();
+
+        dynamic_array<byte> decompressed;
+        decompressed.resize(data.size());
+
+        for (auto _ : state)
+        {
+            decompress_frame(frame, decompressed).assert_value();
+            benchmark::DoNotOptimize(decompressed.data());
+        }
+
+        state.SetBytesProcessed(state.iterations() * data.size());
+    }
+
+    void memcpy_baseline(benchmark::State& state)
+    {
+        const auto data = make_benchmark_data(DataSize);
+
+        dynamic_array<byte> copy;
+        copy.resize(data.size());
+
+        for (auto _ : state)
+        {
+            std::memcpy(copy.data(), data.data(), data.size());
+            benchmark::DoNotOptimize(copy.data());
+        }
+
+        state.SetBytesProcessed(state.iterations() * data.size());
+    }
+
+    BENCHMARK(lz_compress_frame);
+    BENCHMARK(lz_decompress_frame);
+    BENCHMARK(memcpy_baseline);
+}
\ No newline at end of file
@@ -0,0 +1,121 @@
+#include <benchmark/benchmark.h>
+
+#include <oblo/core/pool_allocator.hpp>
+
+#include <memory_resource>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace oblo
+{
+    namespace
+    {
+        constexpr u32 LiveBlocks{1024};
+        constexpr u32 OperationsPerThread{1u << 16};
+
+        class pmr_synchronized_adapter
+        {
+        public:
+            byte* allocate(usize size, usize alignment)
+            {
+                return static_cast<byte*>(m_resource.allocate(size, alignment));
+            }
+
+            void deallocate(byte* ptr, usize size, usize alignment)
+            {
+                m_resource.deallocate(ptr, size, alignment);
+            }
+
+        private:
+            std::pmr::synchronized_pool_resource m_resource;
+        };
+
+        class pmr_unsynchronized_adapter
+        {
+        public:
+            byte* allocate(usize size, usize alignment)
+            {
+                return static_cast<byte*>(m_resource.allocate(size, alignment));
+            }
+
+            void deallocate(byte* ptr, usize size, usize alignment)
+            {
+                m_resource.deallocate(ptr, size, alignment);
+            }
+
+        private:
+            std::pmr::unsynchronized_pool_resource m_resource;
+        };
+
+        // Keeps a window of live blocks of mixed sizes, replacing a random one at each step
+        template <typename Allocator>
+        void churn(Allocator& allocator, u32 seed)
+        {
+            struct block
+            {
+                byte* ptr;
+                usize size;
+            };
+
+            std::mt19937 rng{seed};
+            std::vector<block> blocks(LiveBlocks);
+
+            for (auto& b : blocks)
+            {
+                b.size = 16 + rng() % 256;
+                b.ptr = allocator.allocate(b.size, 16);
+            }
+
+            for (u32 i = 0; i < OperationsPerThread; ++i)
+            {
+                auto& b = blocks[rng() % LiveBlocks];
+                allocator.deallocate(b.ptr, b.size, 16);
+
+                b.size = 16 + rng() % 256;
+                b.ptr = allocator.allocate(b.size, 16);
+                benchmark::DoNotOptimize(b.ptr);
+            }
+
+            for (auto& b : blocks)
+            {
+                allocator.deallocate(b.ptr, b.size, 16);
+            }
+        }
+
+        template <typename Allocator>
+        void allocator_churn(benchmark::State& state)
+        {
+            const auto threadsCount = u32(state.range(0));
+
+            for (auto _ : state)
+            {
+                Allocator allocator;
+
+                if (threadsCount == 1)
+                {
+                    churn(allocator, 0);
+                    continue;
+                }
+
+                std::vector<std::thread> threads;
+
+                for (u32 t = 0; t < threadsCount; ++t)
+                {
+                    threads.emplace_back([&allocator, t] { churn(allocator, t); });
+                }
+
+                for (auto& thread : threads)
+                {
+                    thread.join();
+                }
+            }
+
+            state.SetItemsProcessed(state.iterations() * state.range(0) * OperationsPerThread);
+        }
+    }
+
+    BENCHMARK(allocator_churn<pmr_unsynchronized_adapter>)->Arg(1);
+    BENCHMARK(allocator_churn<pmr_synchronized_adapter>)->Arg(1)->Arg(4)->UseRealTime();
+    BENCHMARK(allocator_churn<pool_allocator>)->Arg(1)->Arg(4)->UseRealTime();
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include <benchmark/benchmark.h>
+
+#include <oblo/core/dynamic_array.hpp>
+#include <oblo/core/iterator/zip_range.hpp>
+#include <oblo/core/radix_sort.hpp>
+
+#include <algorithm>
+#include <random>
+
+namespace oblo
+{
+    namespace
+    {
+        template <typename Key>
+        struct sort_input
+        {
+            dynamic_array<Key> keys;
+            dynamic_array<u32> payloads;
+
+            explicit sort_input(usize count)
+            {
+                std::mt19937_64 rng{42};
+
+                keys.resize(count);
+                payloads.resize(count);
+
+                for (usize i = 0; i < count; ++i)
+                {
+                    keys[i] = Key(rng());
+                    payloads[i] = u32(i);
+                }
+            }
+        };
+
+        template <typename Key>
+        void sort_std_zip(benchmark::State& state)
+        {
+            const sort_input<Key> input{usize(state.range(0))};
+
+            dynamic_array<Key> keys;
+            dynamic_array<u32> payloads;
+
+            for (auto _ : state)
+            {
+                state.PauseTiming();
+                keys = input.keys;
+                payloads = input.payloads;
+                state.ResumeTiming();
+
+                auto&& range = zip_range(keys, payloads);
+                std::sort(range.begin(),
+                    range.end(),
+                    [](const auto& lhs, const auto& rhs) { return std::get<0>(lhs) < std::get<0>(rhs); });
+
+                benchmark::DoNotOptimize(payloads.data());
+            }
+
+            state.SetItemsProcessed(state.iterations() * state.range(0));
+        }
+
+        template <typename Key>
+        void sort_std_pairs(benchmark::State& state)
+        {
+            const sort_input<Key> input{usize(state.range(0))};
+
+            dynamic_array<std::pair<Key, u32>> pairs;
+            pairs.resize(input.keys.size());
+
+            for (auto _ : state)
+            {
+                state.PauseTiming();
+
+                for (usize i = 0; i < pairs.size(); ++i)
+                {
+                    pairs[i] = {input.keys[i], input.payloads[i]};
+                }
+
+                state.ResumeTiming();
+
+                std::sort(pairs.begin(),
+                    pairs.end(),
+                    [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+                benchmark::DoNotOptimize(pairs.data());
+            }
+
+            state.SetItemsProcessed(state.iterations() * state.range(0));
+        }
+
+        template <typename Key>
+        void sort_radix(benchmark::State& state)
+        {
+            const sort_input<Key> input{usize(state.range(0))};
+
+            dynamic_array<Key> keys;
+            dynamic_array<u32> payloads;
+
+            dynamic_array<Key> keysScratch;
+            dynamic_array<u32> payloadsScratch;
+            keysScratch.resize(input.keys.size());
+            payloadsScratch.resize(input.keys.size());
+
+            for (auto _ : state)
+            {
+                state.PauseTiming();
+                keys = input.keys;
+                payloads = input.payloads;
+                state.ResumeTiming();
+
+                radix_sort(std::span<Key>{keys},
+                    std::span<u32>{payloads},
+                    std::span<Key>{keysScratch},
+                    std::span<u32>{payloadsScratch});
+
+                benchmark::DoNotOptimize(payloads.data());
+            }
+
+            state.SetItemsProcessed(state.iterations() * state.range(0));
+        }
+    }
+
+    BENCHMARK(sort_std_zip<u32>)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+    BENCHMARK(sort_std_pairs<u32>)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+    BENCHMARK(sort_radix<u32>)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+    BENCHMARK(sort_std_pairs<u64>)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+    BENCHMARK(sort_radix<u64>)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+}
\ No newline at end of file
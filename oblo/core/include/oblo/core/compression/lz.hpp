@@ -0,0 +1,141 @@
+#pragma once
+
+#include <oblo/core/dynamic_array.hpp>
+#include <oblo/core/expected.hpp>
+#include <oblo/core/types.hpp>
+
+#include <cstdio>
+#include <span>
+
+namespace oblo::lz
+{
+    /// @brief Blocks are compressed independently, so they can be processed in parallel, matches are limited to a
+    /// 64KB window within the block.
+    constexpr u32 DefaultBlockSize{1u << 18};
+
+    /// @brief Largest block size supported by the frame format, since block sizes are encoded in 31 bits.
+    constexpr u32 MaxBlockSize{1u << 30};
+
+    constexpr u32 FrameMagic{0x5A4C424F}; // OBLZ
+
+    struct frame_header
+    {
+        u32 magic;
+        u32 blockSize;
+    };
+
+    /// @brief Precedes the data of each block in a frame, a block header with compressedSize 0 terminates the frame.
+    struct block_header
+    {
+        static constexpr u32 StoredFlag{1u << 31};
+
+        /// @brief Size of the data following the header, with StoredFlag set when the data is not compressed.
+        u32 compressedSize;
+        u32 uncompressedSize;
+    };
+
+    struct frame_info
+    {
+        u64 uncompressedSize;
+        u32 blocksCount;
+        u32 blockSize;
+    };
+
+    /// @brief Worst case size of a compressed block, for incompressible data.
+    constexpr usize compress_bound(usize size)
+    {
+        return size + size / 255 + 16;
+    }
+
+    /// @brief Worst case size of a frame, assuming incompressible blocks are stored rather than compressed.
+    constexpr usize frame_compress_bound(usize size, u32 blockSize = DefaultBlockSize)
+    {
+        const usize blocksCount = (size + blockSize - 1) / blockSize;
+        return sizeof(frame_header) + blocksCount * sizeof(block_header) + size + sizeof(u32);
+    }
+
+    /// @brief Compresses the source in the LZ4 block format.
+    /// @param dst The destination buffer, which is required to be at least compress_bound(src.size()) bytes.
+    /// @return The compressed size, or an error if the destination is too small.
+    expected<usize> compress_block(std::span<const byte> src, std::span<byte> dst);
+
+    /// @brief Decompresses a block in the LZ4 block format, validating it against the size of the buffers.
+    /// @return The decompressed size, or an error if the block is malformed or does not fit the destination.
+    expected<usize> decompress_block(std::span<const byte> src, std::span<byte> dst);
+
+    /// @brief Compresses the source into a frame, splitting it in blocks of the given size.
+    /// @param dst The destination buffer, which is required to be at least frame_compress_bound bytes.
+    /// @return The size of the frame.
+    expected<usize> compress_frame(std::span<const byte> src, std::span<byte> dst, u32 blockSize = DefaultBlockSize);
+
+    /// @brief Validates the headers of a frame, without decompressing the blocks.
+    expected<frame_info> read_frame_info(std::span<const byte> frame);
+
+    /// @brief Decompresses a whole frame, the destination needs to be at least frame_info::uncompressedSize bytes.
+    /// @return The decompressed size.
+    expected<usize> decompress_frame(std::span<const byte> frame, std::span<byte> dst);
+
+    /// @brief Compresses a frame to the end of the output array, growing it as necessary.
+    expected<usize> compress_frame(
+        std::span<const byte> src, dynamic_array<byte>& out, u32 blockSize = DefaultBlockSize);
+
+    /// @brief Compresses one block of the frame, writing the block header followed by the data.
+    /// @param dst The destination buffer, at least sizeof(block_header) + compress_bound(src.size()) bytes.
+    /// @return The size of header and data.
+    usize write_frame_block(std::span<const byte> src, std::span<byte> dst);
+
+    /// @brief Writes a frame incrementally to file, compressing a block every time enough data is accumulated.
+    class frame_writer
+    {
+    public:
+        frame_writer() = default;
+        frame_writer(const frame_writer&) = delete;
+        frame_writer& operator=(const frame_writer&) = delete;
+        ~frame_writer() = default;
+
+        /// @brief Writes the frame header to the file, which has to stay open until finish is called.
+        expected<> init(FILE* file, u32 blockSize = DefaultBlockSize);
+
+        expected<> write(std::span<const byte> data);
+
+        /// @brief Compresses the remaining data and terminates the frame.
+        expected<> finish();
+
+    private:
+        expected<> flush_block();
+
+    private:
+        FILE* m_file{};
+        u32 m_blockSize{};
+        dynamic_array<byte> m_block;
+        dynamic_array<byte> m_compressed;
+    };
+
+    /// @brief Reads a frame incrementally from file, decompressing one block at a time.
+    class frame_reader
+    {
+    public:
+        frame_reader() = default;
+        frame_reader(const frame_reader&) = delete;
+        frame_reader& operator=(const frame_reader&) = delete;
+        ~frame_reader() = default;
+
+        /// @brief Reads and validates the frame header, the file has to stay open while reading.
+        expected<> init(FILE* file);
+
+        /// @brief Reads up to dst.size() bytes of decompressed data.
+        /// @return The number of bytes read, which is less than requested only when the end of the frame is reached.
+        expected<usize> read(std::span<byte> dst);
+
+    private:
+        expected<> read_block();
+
+    private:
+        FILE* m_file{};
+        u32 m_blockSize{};
+        u32 m_blockOffset{};
+        bool m_isFinished{};
+        dynamic_array<byte> m_block;
+        dynamic_array<byte> m_compressed;
+    };
+}
\ No newline at end of file
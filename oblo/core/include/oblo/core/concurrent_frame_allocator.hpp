@@ -0,0 +1,81 @@
+#pragma once
+
+#include <oblo/core/allocator.hpp>
+#include <oblo/core/types.hpp>
+
+#include <atomic>
+#include <mutex>
+
+namespace oblo
+{
+    struct concurrent_frame_allocator_stats
+    {
+        /// @brief The bytes allocated in the current frame so far.
+        usize currentUsage;
+
+        /// @brief The bytes allocated in the last frame, before it was restored.
+        usize lastFrameHighWaterMark;
+
+        /// @brief The highest water mark over all the frames.
+        usize peakHighWaterMark;
+
+        /// @brief The sum of the water marks of all the frames, to compute the average.
+        u64 totalHighWaterMark;
+
+        /// @brief The number of frames that were restored.
+        u64 framesCount;
+
+        usize committedMemory;
+    };
+
+    /// @brief A frame allocator that can be used from multiple threads concurrently, e.g. by jobs.
+    /// @remarks Allocating is a lock-free bump of an atomic offset, a lock is only taken when committing more memory.
+    /// Restoring and freeing unused memory are not thread-safe, and are meant to be done at the end of the frame, when
+    /// no other thread is allocating.
+    class concurrent_frame_allocator final : public allocator
+    {
+    public:
+        concurrent_frame_allocator() = default;
+        concurrent_frame_allocator(const concurrent_frame_allocator&) = delete;
+        concurrent_frame_allocator(concurrent_frame_allocator&&) noexcept = delete;
+        concurrent_frame_allocator& operator=(const concurrent_frame_allocator&) = delete;
+        concurrent_frame_allocator& operator=(concurrent_frame_allocator&&) noexcept = delete;
+        ~concurrent_frame_allocator();
+
+        bool init(usize maxSize, usize chunkSize = 4u << 20, usize startingChunks = 0, bool useHugePages = false);
+        void shutdown();
+
+        byte* allocate(usize size, usize alignment) noexcept override;
+        void deallocate(byte*, usize, usize) noexcept override {}
+
+        /// @brief Releases all the allocations and updates the per-frame statistics.
+        void restore_all();
+
+        /// @brief Decommits the memory above the last frame high water mark.
+        void free_unused();
+
+        concurrent_frame_allocator_stats get_stats() const;
+
+        bool contains(const void* ptr) const;
+
+    private:
+        bool commit(usize newSize) noexcept;
+
+    private:
+        u8* m_reservation{nullptr};
+        usize m_reservationSize{0};
+        u8* m_virtualMemory{nullptr};
+        usize m_maxSize{0};
+        usize m_chunkSize{0};
+
+        alignas(64) std::atomic<usize> m_offset{0};
+        alignas(64) std::atomic<usize> m_committed{0};
+
+        std::mutex m_commitMutex;
+
+        usize m_lastFrameHighWaterMark{0};
+        usize m_peakHighWaterMark{0};
+        u64 m_totalHighWaterMark{0};
+        u64 m_framesCount{0};
+    };
+}
@@ -0,0 +1,747 @@
+#pragma once
+
+#include <oblo/core/allocator.hpp>
+#include <oblo/core/debug.hpp>
+#include <oblo/core/types.hpp>
+
+#include <bit>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define OBLO_FLAT_HASH_SSE2 1
+    #include <emmintrin.h>
+#else
+    #define OBLO_FLAT_HASH_SSE2 0
+#endif
+
+namespace oblo::detail::flat_hash
+{
+    // Control bytes, a full slot stores the 7 lowest bits of the hash, so it's always positive
+    using ctrl_t = i8;
+
+    inline constexpr ctrl_t Empty{-128};
+    inline constexpr ctrl_t Deleted{-2};
+
+    inline constexpr usize GroupWidth{16};
+    inline constexpr usize MinCapacity{GroupWidth};
+
+    inline constexpr usize npos{~usize{}};
+
+    constexpr bool is_full(ctrl_t c)
+    {
+        return c >= 0;
+    }
+
+    /// @brief Mixes the bits of the hash, since we can't rely on hash functions (e.g. std::hash on integers) to spread
+    /// them well enough for us to split the hash in two parts.
+    constexpr u64 mix(u64 h)
+    {
+        h ^= h >> 32;
+        h *= 0x9e3779b97f4a7c15ull;
+        h ^= h >> 29;
+        return h;
+    }
+
+    constexpr usize h1(u64 h)
+    {
+        return usize(h >> 7);
+    }
+
+    constexpr ctrl_t h2(u64 h)
+    {
+        return ctrl_t(h & 0x7f);
+    }
+
+    constexpr usize capacity_to_growth(usize capacity)
+    {
+        // Max load factor of 7/8
+        return capacity - capacity / 8;
+    }
+
+    constexpr usize growth_to_capacity(usize growth)
+    {
+        usize capacity = MinCapacity;
+
+        while (capacity_to_growth(capacity) < growth)
+        {
+            capacity *= 2;
+        }
+
+        return capacity;
+    }
+
+    /// @brief A bitmask with one bit per slot in a group.
+    using group_mask = u32;
+
+    class group
+    {
+    public:
+        explicit group(const ctrl_t* ctrl)
+        {
+#if OBLO_FLAT_HASH_SSE2
+            m_ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+#else
+            std::memcpy(m_ctrl, ctrl, GroupWidth);
+#endif
+        }
+
+        group_mask match(ctrl_t h) const
+        {
+#if OBLO_FLAT_HASH_SSE2
+            return group_mask(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h), m_ctrl)));
+#else
+            group_mask mask{};
+
+            for (usize i = 0; i < GroupWidth; ++i)
+            {
+                mask |= group_mask{m_ctrl[i] == h} << i;
+            }
+
+            return mask;
+#endif
+        }
+
+        group_mask match_empty() const
+        {
+            return match(Empty);
+        }
+
+        group_mask match_empty_or_deleted() const
+        {
+#if OBLO_FLAT_HASH_SSE2
+            // Both empty and deleted have the sign bit set, full slots don't
+            return group_mask(_mm_movemask_epi8(m_ctrl));
+#else
+            group_mask mask{};
+
+            for (usize i = 0; i < GroupWidth; ++i)
+            {
+                mask |= group_mask{m_ctrl[i] < 0} << i;
+            }
+
+            return mask;
+#endif
+        }
+
+    private:
+#if OBLO_FLAT_HASH_SSE2
+        __m128i m_ctrl;
+#else
+        ctrl_t m_ctrl[GroupWidth];
+#endif
+    };
+
+    /// @brief Triangular probing over groups, which visits every group once when the capacity is a power of two.
+    class probe_sequence
+    {
+    public:
+        probe_sequence(usize hash, usize mask) : m_offset{hash & mask}, m_mask{mask} {}
+
+        usize offset() const
+        {
+            return m_offset;
+        }
+
+        usize offset(usize i) const
+        {
+            return (m_offset + i) & m_mask;
+        }
+
+        void next()
+        {
+            m_index += GroupWidth;
+            m_offset = (m_offset + m_index) & m_mask;
+        }
+
+    private:
+        usize m_offset;
+        usize m_index{0};
+        usize m_mask;
+    };
+
+    /// @brief Open addressing hash table, with SIMD probing of control bytes (i.e. a SwissTable).
+    /// @remarks The control bytes array has GroupWidth extra bytes at the end, mirroring the first ones, to allow
+    /// loading a group at any position without wrapping around. Elements are not stable, they move when rehashing.
+    /// @tparam Policy Defines the types and how to extract the key from a slot.
+    template <typename Policy, typename Hash, typename KeyEqual>
+    class table
+    {
+    public:
+        using key_type = typename Policy::key_type;
+        using value_type = typename Policy::value_type;
+        using slot_type = typename Policy::slot_type;
+        using size_type = usize;
+        using difference_type = ptrdiff;
+        using hasher = Hash;
+        using key_equal = KeyEqual;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+
+        template <bool Const>
+        class iterator_impl;
+
+        using iterator = iterator_impl<false>;
+        using const_iterator = iterator_impl<true>;
+
+        template <typename K>
+        static constexpr bool is_transparent_key = std::is_convertible_v<const K&, const key_type&> ||
+            (requires { typename Hash::is_transparent; } && requires { typename KeyEqual::is_transparent; });
+
+    public:
+        table() : m_allocator{select_global_allocator<alignof(slot_type)>()} {}
+
+        explicit table(allocator* allocator) : m_allocator{allocator} {}
+
+        table(const table& other) : m_allocator{other.m_allocator}, m_hash{other.m_hash}, m_eq{other.m_eq}
+        {
+            copy_from(other);
+        }
+
+        table(table&& other) noexcept :
+            m_ctrl{other.m_ctrl}, m_slots{other.m_slots}, m_size{other.m_size}, m_capacity{other.m_capacity},
+            m_growthLeft{other.m_growthLeft}, m_allocator{other.m_allocator}, m_hash{std::move(other.m_hash)},
+            m_eq{std::move(other.m_eq)}
+        {
+            other.reset_empty();
+        }
+
+        table& operator=(const table& other)
+        {
+            if (this != &other)
+            {
+                destroy_and_free();
+                m_hash = other.m_hash;
+                m_eq = other.m_eq;
+                copy_from(other);
+            }
+
+            return *this;
+        }
+
+        table& operator=(table&& other) noexcept
+        {
+            if (this != &other)
+            {
+                destroy_and_free();
+
+                m_ctrl = other.m_ctrl;
+                m_slots = other.m_slots;
+                m_size = other.m_size;
+                m_capacity = other.m_capacity;
+                m_growthLeft = other.m_growthLeft;
+                m_allocator = other.m_allocator;
+                m_hash = std::move(other.m_hash);
+                m_eq = std::move(other.m_eq);
+
+                other.reset_empty();
+            }
+
+            return *this;
+        }
+
+        ~table()
+        {
+            destroy_and_free();
+        }
+
+        iterator begin()
+        {
+            return iterator{m_ctrl, m_slots, m_ctrl + m_capacity}.skip_empty();
+        }
+
+        const_iterator begin() const
+        {
+            return const_iterator{m_ctrl, m_slots, m_ctrl + m_capacity}.skip_empty();
+        }
+
+        const_iterator cbegin() const
+        {
+            return begin();
+        }
+
+        iterator end()
+        {
+            return iterator{m_ctrl + m_capacity, m_slots + m_capacity, m_ctrl + m_capacity};
+        }
+
+        const_iterator end() const
+        {
+            return const_iterator{m_ctrl + m_capacity, m_slots + m_capacity, m_ctrl + m_capacity};
+        }
+
+        const_iterator cend() const
+        {
+            return end();
+        }
+
+        usize size() const
+        {
+            return m_size;
+        }
+
+        bool empty() const
+        {
+            return m_size == 0;
+        }
+
+        usize capacity() const
+        {
+            return m_capacity;
+        }
+
+        allocator* get_allocator() const
+        {
+            return m_allocator;
+        }
+
+        void clear()
+        {
+            if (m_size == 0)
+            {
+                return;
+            }
+
+            destroy_slots();
+
+            std::memset(m_ctrl, Empty, m_capacity + GroupWidth);
+            m_size = 0;
+            m_growthLeft = capacity_to_growth(m_capacity);
+        }
+
+        /// @brief Makes sure count elements can be inserted without rehashing.
+        void reserve(usize count)
+        {
+            if (count > m_size + m_growthLeft)
+            {
+                resize(growth_to_capacity(count));
+            }
+        }
+
+        template <typename K = key_type>
+            requires is_transparent_key<K>
+        iterator find(const K& key)
+        {
+            const usize index = find_index(key, hash_key(key));
+            return index == npos ? end() : make_iterator(index);
+        }
+
+        template <typename K = key_type>
+            requires is_transparent_key<K>
+        const_iterator find(const K& key) const
+        {
+            const usize index = find_index(key, hash_key(key));
+            return index == npos ? end() : make_iterator(index);
+        }
+
+        template <typename K = key_type>
+            requires is_transparent_key<K>
+        bool contains(const K& key) const
+        {
+            return find_index(key, hash_key(key)) != npos;
+        }
+
+        template <typename K = key_type>
+            requires is_transparent_key<K>
+        usize count(const K& key) const
+        {
+            return contains(key) ? 1 : 0;
+        }
+
+        template <typename K = key_type>
+            requires is_transparent_key<K>
+        usize erase(const K& key)
+        {
+            const usize index = find_index(key, hash_key(key));
+
+            if (index == npos)
+            {
+                return 0;
+            }
+
+            erase_at(index);
+            return 1;
+        }
+
+        iterator erase(const_iterator it)
+        {
+            const usize index = usize(it.m_ctrl - m_ctrl);
+            erase_at(index);
+
+            // Erasing never moves elements, so we can just continue from here
+            return iterator{m_ctrl + index, m_slots + index, m_ctrl + m_capacity}.skip_empty();
+        }
+
+        iterator erase(iterator it)
+        {
+            return erase(const_iterator{it});
+        }
+
+    protected:
+        /// @brief Finds the key, or prepares a slot for it. In the latter case the caller has to construct the slot.
+        template <typename K>
+        std::pair<usize, bool> find_or_prepare_insert(const K& key)
+        {
+            const u64 hash = hash_key(key);
+
+            if (const usize index = find_index(key, hash); index != npos)
+            {
+                return {index, false};
+            }
+
+            return {prepare_insert(hash), true};
+        }
+
+        slot_type* get_slot(usize index) const
+        {
+            return m_slots + index;
+        }
+
+        iterator make_iterator(usize index)
+        {
+            return iterator{m_ctrl + index, m_slots + index, m_ctrl + m_capacity};
+        }
+
+        const_iterator make_iterator(usize index) const
+        {
+            return const_iterator{m_ctrl + index, m_slots + index, m_ctrl + m_capacity};
+        }
+
+        /// @brief Used when the slot for a prepared insertion could not be constructed, e.g. due to an exception.
+        void cancel_insert(usize index)
+        {
+            set_ctrl(index, Deleted);
+            --m_size;
+        }
+
+    private:
+        template <typename K>
+        u64 hash_key(const K& key) const
+        {
+            return mix(u64(m_hash(key)));
+        }
+
+        template <typename K>
+        usize find_index(const K& key, u64 hash) const
+        {
+            if (m_capacity == 0)
+            {
+                return npos;
+            }
+
+            const ctrl_t h = h2(hash);
+            probe_sequence seq{h1(hash), m_capacity - 1};
+
+            while (true)
+            {
+                const group g{m_ctrl + seq.offset()};
+
+                for (group_mask m = g.match(h); m != 0; m &= m - 1)
+                {
+                    const usize index = seq.offset(usize(std::countr_zero(m)));
+
+                    if (m_eq(Policy::key(m_slots[index]), key)) [[likely]]
+                    {
+                        return index;
+                    }
+                }
+
+                if (g.match_empty() != 0) [[likely]]
+                {
+                    return npos;
+                }
+
+                seq.next();
+            }
+        }
+
+        usize find_first_non_full(u64 hash) const
+        {
+            probe_sequence seq{h1(hash), m_capacity - 1};
+
+            while (true)
+            {
+                const group g{m_ctrl + seq.offset()};
+
+                if (const group_mask m = g.match_empty_or_deleted(); m != 0)
+                {
+                    return seq.offset(usize(std::countr_zero(m)));
+                }
+
+                seq.next();
+            }
+        }
+
+        usize prepare_insert(u64 hash)
+        {
+            usize index = m_capacity == 0 ? npos : find_first_non_full(hash);
+
+            // We can always reuse a tombstone, otherwise we might need to make room
+            if (index == npos || (m_growthLeft == 0 && m_ctrl[index] != Deleted))
+            {
+                rehash_and_grow();
+                index = find_first_non_full(hash);
+            }
+
+            m_growthLeft -= m_ctrl[index] == Empty;
+            set_ctrl(index, h2(hash));
+            ++m_size;
+
+            return index;
+        }
+
+        void erase_at(usize index)
+        {
+            OBLO_ASSERT(is_full(m_ctrl[index]));
+
+            std::destroy_at(m_slots + index);
+            --m_size;
+
+            // If no probe sequence ever went past this slot (i.e. there's an empty slot in every window containing
+            // it), we can mark it as empty rather than leaving a tombstone
+            const usize mask = m_capacity - 1;
+            const group_mask emptyBefore = group{m_ctrl + ((index - GroupWidth) & mask)}.match_empty();
+            const group_mask emptyAfter = group{m_ctrl + index}.match_empty();
+
+            const bool wasNeverFull = emptyBefore != 0 && emptyAfter != 0 &&
+                usize(std::countr_zero(emptyAfter) + std::countl_zero(u16(emptyBefore))) < GroupWidth;
+
+            set_ctrl(index, wasNeverFull ? Empty : Deleted);
+            m_growthLeft += wasNeverFull;
+        }
+
+        void set_ctrl(usize index, ctrl_t h)
+        {
+            m_ctrl[index] = h;
+
+            if (index < GroupWidth)
+            {
+                m_ctrl[m_capacity + index] = h;
+            }
+        }
+
+        void rehash_and_grow()
+        {
+            if (m_capacity == 0)
+            {
+                resize(MinCapacity);
+            }
+            else if (m_size <= capacity_to_growth(m_capacity) / 2)
+            {
+                // Mostly tombstones, rehashing at the same capacity is enough to clean them up
+                resize(m_capacity);
+            }
+            else
+            {
+                resize(m_capacity * 2);
+            }
+        }
+
+        static usize get_allocation_size(usize capacity)
+        {
+            return capacity * sizeof(slot_type) + capacity + GroupWidth;
+        }
+
+        void resize(usize newCapacity)
+        {
+            OBLO_ASSERT(std::has_single_bit(newCapacity) && newCapacity >= MinCapacity);
+
+            ctrl_t* const oldCtrl = m_ctrl;
+            slot_type* const oldSlots = m_slots;
+            const usize oldCapacity = m_capacity;
+
+            byte* const memory = m_allocator->allocate(get_allocation_size(newCapacity), alignof(slot_type));
+
+            m_slots = reinterpret_cast<slot_type*>(memory);
+            m_ctrl = reinterpret_cast<ctrl_t*>(memory + newCapacity * sizeof(slot_type));
+            m_capacity = newCapacity;
+            m_growthLeft = capacity_to_growth(newCapacity) - m_size;
+
+            std::memset(m_ctrl, Empty, newCapacity + GroupWidth);
+
+            for (usize i = 0; i < oldCapacity; ++i)
+            {
+                if (!is_full(oldCtrl[i]))
+                {
+                    continue;
+                }
+
+                slot_type* const src = oldSlots + i;
+
+                const u64 hash = hash_key(Policy::key(*src));
+                const usize index = find_first_non_full(hash);
+
+                set_ctrl(index, h2(hash));
+
+                new (m_slots + index) slot_type{std::move(*src)};
+                std::destroy_at(src);
+            }
+
+            if (oldCapacity != 0)
+            {
+                m_allocator->deallocate(reinterpret_cast<byte*>(oldSlots),
+                    get_allocation_size(oldCapacity),
+                    alignof(slot_type));
+            }
+        }
+
+        void copy_from(const table& other)
+        {
+            OBLO_ASSERT(m_size == 0 && m_capacity == 0);
+
+            if (other.m_size == 0)
+            {
+                return;
+            }
+
+            reserve(other.m_size);
+
+            for (usize i = 0; i < other.m_capacity; ++i)
+            {
+                if (!is_full(other.m_ctrl[i]))
+                {
+                    continue;
+                }
+
+                const slot_type& src = other.m_slots[i];
+
+                const u64 hash = hash_key(Policy::key(src));
+                const usize index = find_first_non_full(hash);
+
+                new (m_slots + index) slot_type{src};
+
+                set_ctrl(index, h2(hash));
+                --m_growthLeft;
+                ++m_size;
+            }
+        }
+
+        void destroy_slots()
+        {
+            if constexpr (!std::is_trivially_destructible_v<slot_type>)
+            {
+                for (usize i = 0; i < m_capacity; ++i)
+                {
+                    if (is_full(m_ctrl[i]))
+                    {
+                        std::destroy_at(m_slots + i);
+                    }
+                }
+            }
+        }
+
+        void destroy_and_free()
+        {
+            if (m_capacity == 0)
+            {
+                return;
+            }
+
+            destroy_slots();
+
+            m_allocator->deallocate(reinterpret_cast<byte*>(m_slots),
+                get_allocation_size(m_capacity),
+                alignof(slot_type));
+
+            reset_empty();
+        }
+
+        void reset_empty()
+        {
+            m_ctrl = nullptr;
+            m_slots = nullptr;
+            m_size = 0;
+            m_capacity = 0;
+            m_growthLeft = 0;
+        }
+
+    private:
+        ctrl_t* m_ctrl{};
+        slot_type* m_slots{};
+        usize m_size{};
+        usize m_capacity{};
+        usize m_growthLeft{};
+        allocator* m_allocator{};
+        [[no_unique_address]] Hash m_hash{};
+        [[no_unique_address]] KeyEqual m_eq{};
+    };
+
+    template <typename Policy, typename Hash, typename KeyEqual>
+    template <bool Const>
+    class table<Policy, Hash, KeyEqual>::iterator_impl
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename Policy::value_type;
+        using difference_type = ptrdiff;
+        using reference =
+            std::conditional_t<Const, const value_type&, decltype(Policy::element(std::declval<slot_type*>()))>;
+        using pointer = std::remove_reference_t<reference>*;
+
+    public:
+        iterator_impl() = default;
+        iterator_impl(const iterator_impl&) = default;
+        iterator_impl& operator=(const iterator_impl&) = default;
+
+        iterator_impl(const iterator_impl<false>& other)
+            requires Const
+            : m_ctrl{other.m_ctrl}, m_slot{other.m_slot}, m_end{other.m_end}
+        {
+        }
+
+        reference operator*() const
+        {
+            return Policy::element(m_slot);
+        }
+
+        pointer operator->() const
+        {
+            return &Policy::element(m_slot);
+        }
+
+        iterator_impl& operator++()
+        {
+            ++m_ctrl;
+            ++m_slot;
+            return skip_empty();
+        }
+
+        iterator_impl operator++(int)
+        {
+            auto it = *this;
+            ++*this;
+            return it;
+        }
+
+        bool operator==(const iterator_impl& other) const
+        {
+            return m_ctrl == other.m_ctrl;
+        }
+
+    private:
+        friend class table;
+        friend class iterator_impl<!Const>;
+
+        iterator_impl(ctrl_t* ctrl, slot_type* slot, ctrl_t* end) : m_ctrl{ctrl}, m_slot{slot}, m_end{end} {}
+
+        iterator_impl& skip_empty()
+        {
+            while (m_ctrl != m_end && !is_full(*m_ctrl))
+            {
+                ++m_ctrl;
+                ++m_slot;
+            }
+
+            return *this;
+        }
+
+    private:
+        ctrl_t* m_ctrl{};
+        slot_type* m_slot{};
+        ctrl_t* m_end{};
+    };
+}
@@ -742,6 +742,7 @@ namespace oblo
         }
 
         m_data = nullptr;
+        m_capacity = 0;
     }
 
     template <typename T>
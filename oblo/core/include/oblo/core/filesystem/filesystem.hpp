@@ -13,7 +13,17 @@ namespace oblo::filesystem
 
     expected<bool> remove_all(cstring_view path);
 
-    expected<bool> copy_file(cstring_view source, cstring_view destination);
+    enum class copy_policy : u8
+    {
+        no_overwrite,
+        overwrite,
+    };
+
+    expected<bool> copy_file(
+        cstring_view source, cstring_view destination, copy_policy policy = copy_policy::no_overwrite);
+
+    /// @brief Moves or renames a file, replacing the destination if it exists.
+    expected<> rename(cstring_view source, cstring_view destination);
 
     expected<bool> create_directories(cstring_view path);
 
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <oblo/core/expected.hpp>
+#include <oblo/core/string/cstring_view.hpp>
+#include <oblo/core/types.hpp>
+
+#include <span>
+
+namespace oblo::filesystem
+{
+    enum class mapped_file_access : u8
+    {
+        read,
+        read_write,
+    };
+
+    enum class mapped_file_advice : u8
+    {
+        normal,
+        sequential,
+        random,
+        will_need,
+        dont_need,
+    };
+
+    /// @brief Maps a file into memory, allowing to read (or write) it in place without copying it to a buffer.
+    /// @remarks The mapping is released when the object is destroyed, any span obtained from it becomes invalid.
+    class mapped_file
+    {
+    public:
+        mapped_file() = default;
+        mapped_file(const mapped_file&) = delete;
+        mapped_file(mapped_file&& other) noexcept;
+        mapped_file& operator=(const mapped_file&) = delete;
+        mapped_file& operator=(mapped_file&& other) noexcept;
+        ~mapped_file();
+
+        /// @brief Maps an existing file.
+        /// @remarks Empty files are opened successfully, but the mapping is empty.
+        expected<> open(cstring_view path, mapped_file_access access = mapped_file_access::read);
+
+        /// @brief Creates or truncates the file to the given size, then maps it for writing.
+        expected<> create(cstring_view path, usize size);
+
+        void close();
+
+        bool is_open() const;
+
+        /// @brief Hints the system about the expected access pattern for a range of the mapping.
+        /// @remarks Hints might be ignored, depending on the platform.
+        bool advise(mapped_file_advice advice, usize offset = 0, usize size = ~usize{});
+
+        /// @brief Writes modified pages back to the file.
+        bool flush();
+
+        std::span<const byte> get_bytes() const;
+
+        /// @brief Returns the mapped bytes, only valid when the file was opened with write access.
+        std::span<byte> get_writable_bytes() const;
+
+        usize size() const;
+
+        mapped_file_access get_access() const;
+
+    private:
+        expected<> map(cstring_view path, mapped_file_access access, bool create, usize size);
+
+    private:
+        byte* m_data{};
+        usize m_size{};
+        mapped_file_access m_access{};
+        bool m_isOpen{};
+    };
+}
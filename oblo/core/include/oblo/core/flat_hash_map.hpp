@@ -0,0 +1,142 @@
+#pragma once
+
+#include <oblo/core/detail/flat_hash_table.hpp>
+#include <oblo/core/hash.hpp>
+
+#include <functional>
+#include <tuple>
+
+namespace oblo
+{
+    namespace detail::flat_hash
+    {
+        template <typename K, typename V>
+        struct map_policy
+        {
+            using key_type = K;
+            using mapped_type = V;
+            using value_type = std::pair<const K, V>;
+            using slot_type = std::pair<K, V>;
+
+            static const K& key(const slot_type& slot)
+            {
+                return slot.first;
+            }
+
+            static value_type& element(slot_type* slot)
+            {
+                // The key is only mutable internally, when moving slots around during a rehash
+                return *std::launder(reinterpret_cast<value_type*>(slot));
+            }
+        };
+    }
+
+    /// @brief An open addressing hash map, which stores keys and values inline in a single allocation.
+    /// @remarks Meant as a replacement for std::unordered_map, it does not provide reference stability: pointers and
+    /// iterators are invalidated when inserting. Heterogeneous lookup is enabled when both Hash and KeyEqual define
+    /// is_transparent.
+    template <typename K, typename V, typename Hash = hash<K>, typename KeyEqual = std::equal_to<K>>
+    class flat_hash_map : public detail::flat_hash::table<detail::flat_hash::map_policy<K, V>, Hash, KeyEqual>
+    {
+        using base = detail::flat_hash::table<detail::flat_hash::map_policy<K, V>, Hash, KeyEqual>;
+
+    public:
+        using mapped_type = V;
+        using typename base::const_iterator;
+        using typename base::iterator;
+        using typename base::key_type;
+        using typename base::value_type;
+
+    public:
+        using base::base;
+
+        flat_hash_map(std::initializer_list<value_type> values) : base{}
+        {
+            base::reserve(values.size());
+
+            for (const auto& v : values)
+            {
+                insert(v);
+            }
+        }
+
+        template <typename Key, typename... Args>
+            requires base::template is_transparent_key<std::remove_cvref_t<Key>>
+        std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args)
+        {
+            const auto [index, inserted] = base::find_or_prepare_insert(key);
+
+            if (inserted)
+            {
+                try
+                {
+                    new (base::get_slot(index)) typename base::slot_type{std::piecewise_construct,
+                        std::forward_as_tuple(std::forward<Key>(key)),
+                        std::forward_as_tuple(std::forward<Args>(args)...)};
+                }
+                catch (...)
+                {
+                    base::cancel_insert(index);
+                    throw;
+                }
+            }
+
+            return {base::make_iterator(index), inserted};
+        }
+
+        /// @brief Same as try_emplace, the value is only constructed when the key is not present.
+        template <typename Key, typename... Args>
+        std::pair<iterator, bool> emplace(Key&& key, Args&&... args)
+        {
+            return try_emplace(std::forward<Key>(key), std::forward<Args>(args)...);
+        }
+
+        std::pair<iterator, bool> insert(const value_type& value)
+        {
+            return try_emplace(value.first, value.second);
+        }
+
+        std::pair<iterator, bool> insert(value_type&& value)
+        {
+            return try_emplace(std::move(const_cast<K&>(value.first)), std::move(value.second));
+        }
+
+        template <typename Key, typename M>
+        std::pair<iterator, bool> insert_or_assign(Key&& key, M&& value)
+        {
+            auto r = try_emplace(std::forward<Key>(key), std::forward<M>(value));
+
+            if (!r.second)
+            {
+                r.first->second = std::forward<M>(value);
+            }
+
+            return r;
+        }
+
+        template <typename Key>
+            requires base::template is_transparent_key<std::remove_cvref_t<Key>>
+        V& operator[](Key&& key)
+        {
+            return try_emplace(std::forward<Key>(key)).first->second;
+        }
+
+        template <typename Key>
+            requires base::template is_transparent_key<Key>
+        V& at(const Key& key)
+        {
+            const auto it = base::find(key);
+            OBLO_ASSERT(it != base::end());
+            return it->second;
+        }
+
+        template <typename Key>
+            requires base::template is_transparent_key<Key>
+        const V& at(const Key& key) const
+        {
+            const auto it = base::find(key);
+            OBLO_ASSERT(it != base::end());
+            return it->second;
+        }
+    };
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <oblo/core/detail/flat_hash_table.hpp>
+#include <oblo/core/hash.hpp>
+
+#include <functional>
+
+namespace oblo
+{
+    namespace detail::flat_hash
+    {
+        template <typename K>
+        struct set_policy
+        {
+            using key_type = K;
+            using value_type = K;
+            using slot_type = K;
+
+            static const K& key(const slot_type& slot)
+            {
+                return slot;
+            }
+
+            static const K& element(slot_type* slot)
+            {
+                return *slot;
+            }
+        };
+    }
+
+    /// @brief An open addressing hash set, which stores keys inline in a single allocation.
+    /// @remarks Meant as a replacement for std::unordered_set, it does not provide reference stability.
+    template <typename K, typename Hash = hash<K>, typename KeyEqual = std::equal_to<K>>
+    class flat_hash_set : public detail::flat_hash::table<detail::flat_hash::set_policy<K>, Hash, KeyEqual>
+    {
+        using base = detail::flat_hash::table<detail::flat_hash::set_policy<K>, Hash, KeyEqual>;
+
+    public:
+        using typename base::const_iterator;
+        using typename base::iterator;
+        using typename base::key_type;
+        using typename base::value_type;
+
+    public:
+        using base::base;
+
+        flat_hash_set(std::initializer_list<K> values) : base{}
+        {
+            base::reserve(values.size());
+
+            for (const auto& v : values)
+            {
+                emplace(v);
+            }
+        }
+
+        template <typename Key>
+            requires base::template is_transparent_key<std::remove_cvref_t<Key>>
+        std::pair<iterator, bool> emplace(Key&& key)
+        {
+            const auto [index, inserted] = base::find_or_prepare_insert(key);
+
+            if (inserted)
+            {
+                try
+                {
+                    new (base::get_slot(index)) K(std::forward<Key>(key));
+                }
+                catch (...)
+                {
+                    base::cancel_insert(index);
+                    throw;
+                }
+            }
+
+            return {base::make_iterator(index), inserted};
+        }
+
+        std::pair<iterator, bool> insert(const K& key)
+        {
+            return emplace(key);
+        }
+
+        std::pair<iterator, bool> insert(K&& key)
+        {
+            return emplace(std::move(key));
+        }
+    };
+}
@@ -17,7 +17,10 @@ namespace oblo
         frame_allocator& operator=(frame_allocator&&) noexcept = delete;
         ~frame_allocator();
 
-        bool init(usize maxSize, usize chunkSize = 4u << 20, usize startingChunks = 0);
+        /// @brief Reserves the virtual memory, which is committed a chunk at a time as needed.
+        /// @param useHugePages Hints the system to back the memory with huge pages, only honored when the chunk size is
+        /// a multiple of the huge page size.
+        bool init(usize maxSize, usize chunkSize = 4u << 20, usize startingChunks = 0, bool useHugePages = false);
         void shutdown();
 
         byte* allocate(usize size, usize alignment) noexcept;
@@ -37,9 +40,12 @@ namespace oblo
         bool contains(const void* ptr) const;
 
     private:
+        u8* m_reservation{nullptr};
+        usize m_reservationSize{0};
         u8* m_virtualMemory{nullptr};
         u8* m_end{nullptr};
         u8* m_commitEnd{nullptr};
+        u8* m_reservedEnd{nullptr};
         usize m_chunkSize{0};
     };
 
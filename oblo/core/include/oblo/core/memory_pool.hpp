@@ -1,24 +1,19 @@
 #pragma once
 
+#include <oblo/core/pool_allocator.hpp>
 #include <oblo/core/types.hpp>
 
 #include <memory>
-#include <memory_resource>
 
 namespace oblo
 {
-    class memory_pool : std::pmr::unsynchronized_pool_resource
+    class memory_pool
     {
-        std::pmr::unsynchronized_pool_resource& resource()
-        {
-            return *static_cast<std::pmr::unsynchronized_pool_resource*>(this);
-        }
-
     public:
         template <typename T>
         T* create_array_uninitialized(usize count)
         {
-            void* vptr = resource().allocate(sizeof(T) * count, alignof(T));
+            void* vptr = m_allocator.allocate(sizeof(T) * count, alignof(T));
             return new (vptr) T[count];
         }
 
@@ -31,38 +26,61 @@ namespace oblo
         template <typename T>
         void* allocate()
         {
-            return resource().allocate(sizeof(T), alignof(T));
+            return m_allocator.allocate(sizeof(T), alignof(T));
         }
 
         template <typename T>
         void* allocate(usize count)
         {
-            return resource().allocate(sizeof(T) * count, alignof(T));
+            return m_allocator.allocate(sizeof(T) * count, alignof(T));
         }
 
         template <typename T>
         void deallocate(T* ptr)
         {
-            resource().deallocate(ptr, sizeof(T), alignof(T));
+            m_allocator.deallocate(reinterpret_cast<byte*>(ptr), sizeof(T), alignof(T));
         }
 
         template <typename T>
         void destroy(T* ptr)
         {
             ptr->~T();
-            resource().deallocate(ptr, sizeof(T), alignof(T));
+            m_allocator.deallocate(reinterpret_cast<byte*>(ptr), sizeof(T), alignof(T));
         }
 
         template <typename T>
         void deallocate_array(T* ptr, usize count)
         {
-            resource().deallocate(ptr, sizeof(T) * count, alignof(T));
+            m_allocator.deallocate(reinterpret_cast<byte*>(ptr), sizeof(T) * count, alignof(T));
+        }
+
+        void* allocate_bytes(usize size, usize alignment)
+        {
+            return m_allocator.allocate(size, alignment);
+        }
+
+        void deallocate_bytes(void* ptr, usize size, usize alignment)
+        {
+            m_allocator.deallocate(reinterpret_cast<byte*>(ptr), size, alignment);
         }
 
         template <typename T>
         T* create_uninitialized()
         {
-            return new (resource().allocate(sizeof(T), alignof(T))) T;
+            return new (m_allocator.allocate(sizeof(T), alignof(T))) T;
+        }
+
+        allocator* get_allocator()
+        {
+            return &m_allocator;
         }
+
+        pool_allocator_stats get_stats() const
+        {
+            return m_allocator.get_stats();
+        }
+
+    private:
+        pool_allocator m_allocator;
     };
 }
\ No newline at end of file
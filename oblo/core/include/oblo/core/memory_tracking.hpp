@@ -0,0 +1,112 @@
+#pragma once
+
+#include <oblo/core/allocator.hpp>
+#include <oblo/core/expected.hpp>
+#include <oblo/core/string/cstring_view.hpp>
+#include <oblo/core/string/string_view.hpp>
+#include <oblo/core/types.hpp>
+
+namespace oblo
+{
+    /// @brief Identifies the subsystem an allocation is attributed to.
+    /// @remarks The first tag is reserved for untagged allocations.
+    struct memory_tag
+    {
+        u32 value;
+
+        constexpr bool operator==(const memory_tag&) const = default;
+    };
+
+    inline constexpr u32 MaxMemoryTags{64};
+    inline constexpr u32 MaxMemoryTagNameLength{31};
+    inline constexpr u32 MemoryTagHistogramBuckets{32};
+
+    inline constexpr memory_tag UntaggedMemory{0};
+
+    struct memory_tag_stats
+    {
+        string_view name;
+        usize liveBytes;
+        usize peakBytes;
+        u64 allocations;
+        u64 deallocations;
+
+        /// @brief Allocations count by size, the bucket i counts allocations of size in [2^(i-1), 2^i).
+        u64 sizeHistogram[MemoryTagHistogramBuckets];
+    };
+
+    /// @brief Finds or registers a tag by name.
+    /// @remarks Names longer than MaxMemoryTagNameLength are truncated. When all tags are taken, the untagged one is
+    /// returned instead.
+    memory_tag register_memory_tag(string_view name);
+
+    u32 get_memory_tags_count();
+
+    memory_tag get_current_memory_tag();
+
+    /// @brief Pushes a tag on the tag stack of the calling thread, following allocations will be attributed to it.
+    void push_memory_tag(memory_tag tag);
+
+    void pop_memory_tag();
+
+    /// @brief Reads the counters of a tag.
+    /// @remarks Counters are updated with relaxed atomics, so values read while other threads allocate might be
+    /// slightly out of sync with each other.
+    bool get_memory_tag_stats(memory_tag tag, memory_tag_stats& outStats);
+
+    /// @brief Writes the stats of all tags to a JSON file.
+    expected<> dump_memory_tag_stats(cstring_view path);
+
+    /// @brief Checks whether the global allocators track allocations, i.e. OBLO_MEMORY_TRACKING is defined.
+    bool is_global_memory_tracking_enabled();
+
+    class memory_tag_scope
+    {
+    public:
+        explicit memory_tag_scope(memory_tag tag)
+        {
+            push_memory_tag(tag);
+        }
+
+        memory_tag_scope(const memory_tag_scope&) = delete;
+        memory_tag_scope& operator=(const memory_tag_scope&) = delete;
+
+        ~memory_tag_scope()
+        {
+            pop_memory_tag();
+        }
+    };
+
+    /// @brief Wraps an allocator, attributing each allocation to the current memory tag of the calling thread.
+    /// @remarks A small header is prepended to each allocation to remember its tag, so that deallocations are accounted
+    /// correctly even when they happen under a different tag.
+    class tracking_allocator final : public allocator
+    {
+    public:
+        constexpr explicit tracking_allocator(allocator* upstream) : m_upstream{upstream} {}
+
+        byte* allocate(usize size, usize alignment) noexcept override;
+        void deallocate(byte* ptr, usize size, usize alignment) noexcept override;
+
+        allocator* get_upstream() const
+        {
+            return m_upstream;
+        }
+
+    private:
+        allocator* m_upstream;
+    };
+}
+
+#ifdef OBLO_MEMORY_TRACKING
+    #define OBLO_MEMORY_TAG_SCOPE_IMPL_CONCAT(A, B) A##B
+    #define OBLO_MEMORY_TAG_SCOPE_IMPL(Name, Line)                                                                     \
+        static const ::oblo::memory_tag OBLO_MEMORY_TAG_SCOPE_IMPL_CONCAT(_memory_tag_, Line){                        \
+            ::oblo::register_memory_tag(Name)};                                                                        \
+        const ::oblo::memory_tag_scope OBLO_MEMORY_TAG_SCOPE_IMPL_CONCAT(_memory_tag_scope_, Line){                   \
+            OBLO_MEMORY_TAG_SCOPE_IMPL_CONCAT(_memory_tag_, Line)};
+
+    #define OBLO_MEMORY_TAG_SCOPE(Name) OBLO_MEMORY_TAG_SCOPE_IMPL(Name, __LINE__)
+#else
+    #define OBLO_MEMORY_TAG_SCOPE(Name)
+#endif
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <oblo/core/allocator.hpp>
+#include <oblo/core/types.hpp>
+
+#include <atomic>
+#include <new>
+#include <utility>
+
+namespace oblo
+{
+    /// @brief Unbounded queue for multiple producers and a single consumer thread, implemented as a linked list.
+    /// @remarks Pushing is wait-free: a single atomic exchange on the head, followed by linking the previous node.
+    /// Each push allocates a node from the allocator, prefer mpsc_queue when an upper bound is known.
+    /// A pop can fail while a producer is between the exchange and the link, even if other elements were pushed after.
+    template <typename T>
+    class mpsc_linked_queue
+    {
+    public:
+        explicit mpsc_linked_queue(allocator* allocator = select_global_allocator<alignof(node)>()) :
+            m_allocator{allocator}
+        {
+            node* const stub = allocate_node();
+            m_head.store(stub, std::memory_order_relaxed);
+            m_tail = stub;
+        }
+
+        mpsc_linked_queue(const mpsc_linked_queue&) = delete;
+        mpsc_linked_queue(mpsc_linked_queue&&) noexcept = delete;
+        mpsc_linked_queue& operator=(const mpsc_linked_queue&) = delete;
+        mpsc_linked_queue& operator=(mpsc_linked_queue&&) noexcept = delete;
+
+        ~mpsc_linked_queue()
+        {
+            // The tail is always the stub, its value was already moved out
+            node* n = m_tail->next.load(std::memory_order_relaxed);
+            free_node(m_tail);
+
+            while (n)
+            {
+                node* const next = n->next.load(std::memory_order_relaxed);
+                n->get()->~T();
+                free_node(n);
+                n = next;
+            }
+        }
+
+        /// @brief Constructs an element at the end of the queue, can be called from any thread.
+        template <typename... Args>
+        void emplace(Args&&... args)
+        {
+            node* const n = allocate_node();
+            new (n->storage) T(std::forward<Args>(args)...);
+
+            node* const prev = m_head.exchange(n, std::memory_order_acq_rel);
+            prev->next.store(n, std::memory_order_release);
+        }
+
+        void push(const T& value)
+        {
+            emplace(value);
+        }
+
+        void push(T&& value)
+        {
+            emplace(std::move(value));
+        }
+
+        /// @brief Moves the first element out of the queue, only to be called from the consumer thread.
+        bool try_pop(T& out)
+        {
+            node* const tail = m_tail;
+            node* const next = tail->next.load(std::memory_order_acquire);
+
+            if (!next)
+            {
+                return false;
+            }
+
+            // The next node becomes the new stub, once its value is moved out
+            T* const element = next->get();
+            out = std::move(*element);
+            element->~T();
+
+            m_tail = next;
+            free_node(tail);
+
+            return true;
+        }
+
+        /// @brief Checks whether there is anything to pop, only to be called from the consumer thread.
+        bool empty_approx() const
+        {
+            return m_tail->next.load(std::memory_order_acquire) == nullptr;
+        }
+
+    private:
+        struct node
+        {
+            std::atomic<node*> next;
+            alignas(T) byte storage[sizeof(T)];
+
+            T* get()
+            {
+                return std::launder(reinterpret_cast<T*>(storage));
+            }
+        };
+
+    private:
+        node* allocate_node()
+        {
+            auto* const n = new (m_allocator->allocate(sizeof(node), alignof(node))) node;
+            n->next.store(nullptr, std::memory_order_relaxed);
+            return n;
+        }
+
+        void free_node(node* n)
+        {
+            n->~node();
+            m_allocator->deallocate(reinterpret_cast<byte*>(n), sizeof(node), alignof(node));
+        }
+
+    private:
+        allocator* m_allocator;
+
+        // Contended by producers
+        alignas(64) std::atomic<node*> m_head;
+
+        // Only accessed by the consumer
+        alignas(64) node* m_tail;
+    };
+}
\ No newline at end of file
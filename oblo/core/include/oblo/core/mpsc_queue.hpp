@@ -0,0 +1,199 @@
+#pragma once
+
+#include <oblo/core/allocator.hpp>
+#include <oblo/core/debug.hpp>
+#include <oblo/core/types.hpp>
+#include <oblo/math/power_of_two.hpp>
+
+#include <atomic>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace oblo
+{
+    /// @brief Bounded lock-free queue for multiple producers and a single consumer thread.
+    /// @remarks The capacity is rounded up to a power of two. Each slot has a sequence number, which tells producers
+    /// whether the slot is free for the current lap, and the consumer whether the slot has been published.
+    /// Producers only contend on the tail index, the consumer never writes to shared indices other than the slots.
+    template <typename T>
+    class mpsc_queue
+    {
+    public:
+        mpsc_queue() = default;
+
+        explicit mpsc_queue(usize capacity, allocator* allocator = select_global_allocator<alignof(slot)>())
+        {
+            init(capacity, allocator);
+        }
+
+        mpsc_queue(const mpsc_queue&) = delete;
+        mpsc_queue(mpsc_queue&&) noexcept = delete;
+        mpsc_queue& operator=(const mpsc_queue&) = delete;
+        mpsc_queue& operator=(mpsc_queue&&) noexcept = delete;
+
+        ~mpsc_queue()
+        {
+            shutdown();
+        }
+
+        void init(usize capacity, allocator* allocator = select_global_allocator<alignof(slot)>())
+        {
+            OBLO_ASSERT(!m_slots);
+            OBLO_ASSERT(capacity > 0);
+
+            m_allocator = allocator;
+            m_capacity = round_up_power_of_two(capacity);
+            m_mask = m_capacity - 1;
+            m_slots = reinterpret_cast<slot*>(m_allocator->allocate(sizeof(slot) * m_capacity, alignof(slot)));
+
+            for (usize i = 0; i < m_capacity; ++i)
+            {
+                new (m_slots + i) slot{};
+                m_slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+
+            m_head = 0;
+            m_tail.store(0, std::memory_order_relaxed);
+        }
+
+        void shutdown()
+        {
+            if (!m_slots)
+            {
+                return;
+            }
+
+            if constexpr (!std::is_trivially_destructible_v<T>)
+            {
+                const usize tail = m_tail.load(std::memory_order_relaxed);
+
+                for (usize i = m_head; i != tail; ++i)
+                {
+                    m_slots[i & m_mask].get()->~T();
+                }
+            }
+
+            for (usize i = 0; i < m_capacity; ++i)
+            {
+                m_slots[i].~slot();
+            }
+
+            m_allocator->deallocate(reinterpret_cast<byte*>(m_slots), sizeof(slot) * m_capacity, alignof(slot));
+            m_slots = nullptr;
+        }
+
+        /// @brief Constructs an element at the end of the queue, can be called from any thread.
+        /// @return false if the queue is full, in which case the arguments are left untouched.
+        template <typename... Args>
+        bool try_emplace(Args&&... args)
+        {
+            usize pos = m_tail.load(std::memory_order_relaxed);
+            slot* s;
+
+            for (;;)
+            {
+                s = m_slots + (pos & m_mask);
+
+                const usize sequence = s->sequence.load(std::memory_order_acquire);
+                const auto diff = ptrdiff(sequence) - ptrdiff(pos);
+
+                if (diff == 0)
+                {
+                    // The slot is free for this lap, try to claim it
+                    if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    // The consumer did not release this slot from the previous lap yet
+                    return false;
+                }
+                else
+                {
+                    pos = m_tail.load(std::memory_order_relaxed);
+                }
+            }
+
+            new (s->storage) T(std::forward<Args>(args)...);
+            s->sequence.store(pos + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        bool try_push(const T& value)
+        {
+            return try_emplace(value);
+        }
+
+        bool try_push(T&& value)
+        {
+            return try_emplace(std::move(value));
+        }
+
+        /// @brief Moves the first element out of the queue, only to be called from the consumer thread.
+        /// @return false if the queue is empty, or if the producer that claimed the first slot did not publish yet.
+        bool try_pop(T& out)
+        {
+            slot* const s = m_slots + (m_head & m_mask);
+
+            if (s->sequence.load(std::memory_order_acquire) != m_head + 1)
+            {
+                return false;
+            }
+
+            T* const element = s->get();
+            out = std::move(*element);
+            element->~T();
+
+            // Makes the slot available to producers on the next lap
+            s->sequence.store(m_head + m_capacity, std::memory_order_release);
+            ++m_head;
+
+            return true;
+        }
+
+        /// @brief The number of elements in the queue, only to be called from the consumer thread.
+        /// @remarks It includes elements that were claimed by producers but are not published yet.
+        usize size_approx() const
+        {
+            return m_tail.load(std::memory_order_acquire) - m_head;
+        }
+
+        bool empty_approx() const
+        {
+            return size_approx() == 0;
+        }
+
+        usize capacity() const
+        {
+            return m_capacity;
+        }
+
+    private:
+        struct slot
+        {
+            std::atomic<usize> sequence;
+            alignas(T) byte storage[sizeof(T)];
+
+            T* get()
+            {
+                return std::launder(reinterpret_cast<T*>(storage));
+            }
+        };
+
+    private:
+        slot* m_slots{};
+        usize m_capacity{};
+        usize m_mask{};
+        allocator* m_allocator{};
+
+        // Only accessed by the consumer
+        alignas(64) usize m_head{0};
+
+        // Contended by producers
+        alignas(64) std::atomic<usize> m_tail{0};
+    };
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <oblo/core/types.hpp>
+
+namespace oblo::platform
+{
+    /// @brief The size of the huge pages used by virtual_memory_advise_huge_pages, ranges have to be aligned to it.
+    constexpr usize HugePageSize{2u << 20};
+
+    struct virtual_memory_reservation
+    {
+        /// @brief The range to pass to virtual_memory_release.
+        void* base;
+        usize size;
+
+        /// @brief The start of the usable range, aligned to HugePageSize when huge pages were requested.
+        void* begin;
+    };
+
+    /// @brief Returns the granularity of commit and decommit operations.
+    usize virtual_memory_page_size();
+
+    /// @brief Reserves a range of address space, without committing any physical memory.
+    /// @return The start of the range, or nullptr on failure.
+    void* virtual_memory_reserve(usize size);
+
+    /// @brief Releases a range previously returned by virtual_memory_reserve.
+    /// @param size Has to match the size that was reserved.
+    void virtual_memory_release(void* ptr, usize size);
+
+    /// @brief Makes the pages in the range readable and writable.
+    bool virtual_memory_commit(void* ptr, usize size);
+
+    /// @brief Returns the physical memory of the range to the system, the content is lost.
+    bool virtual_memory_decommit(void* ptr, usize size);
+
+    /// @brief Hints the system to back the range with huge pages, when supported.
+    /// @remarks Currently only implemented through transparent huge pages on Linux, it returns false elsewhere.
+    bool virtual_memory_advise_huge_pages(void* ptr, usize size);
+
+    /// @brief Reserves a range of address space, optionally aligned to HugePageSize and advised to use huge pages.
+    /// @remarks The range is over-reserved to align its start when using huge pages, the advice is only a hint and it's
+    /// not an error if the system ignores it.
+    bool virtual_memory_reserve(usize size, bool useHugePages, virtual_memory_reservation& out);
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <oblo/core/allocator.hpp>
+#include <oblo/core/types.hpp>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+namespace oblo
+{
+    struct pool_allocator_stats
+    {
+        /// @brief The bytes requested from the upstream allocator for slabs.
+        usize reservedBytes;
+
+        /// @brief The bytes of the size class blocks currently allocated, including the rounding to the class size.
+        usize usedBytes;
+
+        /// @brief The bytes of the allocations forwarded to the upstream allocator because they are too large.
+        usize largeBytes;
+
+        u64 allocations;
+        u64 deallocations;
+    };
+
+    /// @brief A thread-safe pool of fixed size blocks, grouped in size classes.
+    /// @remarks Blocks are carved from slabs requested to the upstream allocator, and are only returned upstream when
+    /// the pool is released. Each thread caches up to two magazines of free blocks per size class, so that most
+    /// allocations and deallocations don't touch any shared state. Full and empty magazines are exchanged with a
+    /// depot, which has a mutex per size class. Allocations larger than MaxSize or more aligned than MaxAlignment are
+    /// forwarded to the upstream allocator, which has to support MaxAlignment. Allocations never return null, the
+    /// process is terminated when the upstream allocator runs out of memory.
+    class pool_allocator final : public allocator
+    {
+    public:
+        static constexpr usize MaxSize{4096};
+        static constexpr usize MaxAlignment{64};
+        static constexpr usize SlabSize{64u << 10};
+
+    public:
+        explicit pool_allocator(allocator* upstream = get_global_aligned_allocator());
+        pool_allocator(const pool_allocator&) = delete;
+        pool_allocator(pool_allocator&&) noexcept = delete;
+        pool_allocator& operator=(const pool_allocator&) = delete;
+        pool_allocator& operator=(pool_allocator&&) noexcept = delete;
+        ~pool_allocator();
+
+        byte* allocate(usize size, usize alignment) noexcept override;
+        void deallocate(byte* ptr, usize size, usize alignment) noexcept override;
+
+        /// @brief Frees all blocks at once and returns the slabs to the upstream allocator.
+        /// @remarks Large allocations still have to be deallocated individually. It's not thread-safe, no other thread
+        /// can use the pool while releasing.
+        void release_all();
+
+        pool_allocator_stats get_stats() const;
+
+        allocator* get_upstream() const
+        {
+            return m_upstream;
+        }
+
+    private:
+        struct magazine;
+        struct thread_cache;
+        struct size_class_depot;
+
+    private:
+        thread_cache* get_thread_cache();
+        thread_cache* create_thread_cache();
+
+        byte* allocate_from_class(thread_cache& cache, u32 sizeClass);
+        void deallocate_to_class(thread_cache& cache, u32 sizeClass, byte* ptr);
+
+        void refill(thread_cache& cache, u32 sizeClass);
+        void flush(thread_cache& cache, u32 sizeClass);
+
+        magazine* allocate_magazine();
+
+    private:
+        allocator* m_upstream;
+
+        std::unique_ptr<size_class_depot[]> m_depots;
+        std::unique_ptr<std::atomic<thread_cache*>[]> m_threadCaches;
+
+        // Used by threads that don't get a cache of their own, once all thread indices are taken
+        std::mutex m_sharedCacheMutex;
+        thread_cache* m_sharedCache{};
+
+        std::atomic<usize> m_reservedBytes{};
+        std::atomic<usize> m_largeBytes{};
+        std::atomic<u64> m_largeAllocations{};
+        std::atomic<u64> m_largeDeallocations{};
+    };
+}
\ No newline at end of file
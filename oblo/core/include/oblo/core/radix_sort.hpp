@@ -0,0 +1,253 @@
+#pragma once
+
+#include <oblo/core/allocator.hpp>
+#include <oblo/core/debug.hpp>
+#include <oblo/core/dynamic_array.hpp>
+#include <oblo/core/types.hpp>
+
+#include <concepts>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace oblo
+{
+    template <typename T>
+    concept radix_sort_key = std::same_as<T, u32> || std::same_as<T, u64>;
+
+    /// @brief Number of bits sorted by each pass of the radix sort.
+    inline constexpr u32 RadixSortDigitBits{8};
+
+    /// @brief Number of buckets of each pass of the radix sort.
+    inline constexpr u32 RadixSortBuckets{1u << RadixSortDigitBits};
+
+    namespace detail
+    {
+        struct radix_no_payload
+        {
+        };
+
+        template <typename Payload>
+        inline constexpr bool radix_has_payload = !std::is_same_v<Payload, radix_no_payload>;
+
+        // Below this size insertion sort beats the fixed cost of clearing and scanning the histograms
+        inline constexpr usize RadixSortInsertionThreshold{64};
+
+        template <radix_sort_key Key>
+        constexpr u32 radix_passes_count()
+        {
+            return u32{sizeof(Key) * 8 / RadixSortDigitBits};
+        }
+
+        template <radix_sort_key Key>
+        u32 radix_digit(Key key, u32 pass)
+        {
+            return u32(key >> (pass * RadixSortDigitBits)) & (RadixSortBuckets - 1);
+        }
+
+        template <radix_sort_key Key, typename Payload>
+        void insertion_sort(Key* keys, Payload* payloads, usize count)
+        {
+            for (usize i = 1; i < count; ++i)
+            {
+                const Key key = keys[i];
+                usize j = i;
+
+                if constexpr (radix_has_payload<Payload>)
+                {
+                    Payload payload = std::move(payloads[i]);
+
+                    for (; j > 0 && keys[j - 1] > key; --j)
+                    {
+                        keys[j] = keys[j - 1];
+                        payloads[j] = std::move(payloads[j - 1]);
+                    }
+
+                    payloads[j] = std::move(payload);
+                }
+                else
+                {
+                    for (; j > 0 && keys[j - 1] > key; --j)
+                    {
+                        keys[j] = keys[j - 1];
+                    }
+                }
+
+                keys[j] = key;
+            }
+        }
+
+        template <radix_sort_key Key, typename Payload>
+        void radix_sort_impl(Key* keys, Payload* payloads, Key* keysScratch, Payload* payloadsScratch, usize count)
+        {
+            if (count < RadixSortInsertionThreshold)
+            {
+                insertion_sort(keys, payloads, count);
+                return;
+            }
+
+            OBLO_ASSERT(count <= ~u32{}, "Counts are stored in 32 bits");
+
+            constexpr u32 passesCount = radix_passes_count<Key>();
+
+            // All histograms are built with a single read of the keys, the digit counts don't depend on the order
+            u32 histograms[passesCount][RadixSortBuckets] = {};
+
+            for (usize i = 0; i < count; ++i)
+            {
+                const Key key = keys[i];
+
+                for (u32 pass = 0; pass < passesCount; ++pass)
+                {
+                    ++histograms[pass][radix_digit(key, pass)];
+                }
+            }
+
+            Key* srcKeys = keys;
+            Key* dstKeys = keysScratch;
+            Payload* srcPayloads = payloads;
+            Payload* dstPayloads = payloadsScratch;
+
+            for (u32 pass = 0; pass < passesCount; ++pass)
+            {
+                u32* const histogram = histograms[pass];
+
+                // When all keys share the same digit the pass would be an identity permutation
+                if (histogram[radix_digit(srcKeys[0], pass)] == count)
+                {
+                    continue;
+                }
+
+                u32 offset = 0;
+
+                for (u32 d = 0; d < RadixSortBuckets; ++d)
+                {
+                    const u32 n = histogram[d];
+                    histogram[d] = offset;
+                    offset += n;
+                }
+
+                for (usize i = 0; i < count; ++i)
+                {
+                    const u32 dst = histogram[radix_digit(srcKeys[i], pass)]++;
+                    dstKeys[dst] = srcKeys[i];
+
+                    if constexpr (radix_has_payload<Payload>)
+                    {
+                        dstPayloads[dst] = std::move(srcPayloads[i]);
+                    }
+                }
+
+                std::swap(srcKeys, dstKeys);
+                std::swap(srcPayloads, dstPayloads);
+            }
+
+            if (srcKeys != keys)
+            {
+                std::memcpy(keys, srcKeys, count * sizeof(Key));
+
+                if constexpr (radix_has_payload<Payload>)
+                {
+                    for (usize i = 0; i < count; ++i)
+                    {
+                        payloads[i] = std::move(srcPayloads[i]);
+                    }
+                }
+            }
+        }
+    }
+
+    /// @brief Sorts the keys in ascending order, applying the same permutation to the payloads.
+    /// @remarks This is a stable LSD radix sort on 8-bit digits, passes where all keys share the same digit are
+    /// skipped. The scratch arrays must be as large as the input, the result is always written back to keys and
+    /// payloads.
+    template <radix_sort_key Key, typename Payload>
+    void radix_sort(std::span<Key> keys,
+        std::span<Payload> payloads,
+        std::span<Key> keysScratch,
+        std::span<Payload> payloadsScratch)
+    {
+        OBLO_ASSERT(keys.size() == payloads.size());
+        OBLO_ASSERT(keysScratch.size() >= keys.size());
+        OBLO_ASSERT(payloadsScratch.size() >= keys.size());
+
+        detail::radix_sort_impl(keys.data(), payloads.data(), keysScratch.data(), payloadsScratch.data(), keys.size());
+    }
+
+    /// @brief Sorts the keys in ascending order, applying the same permutation to the payloads.
+    /// @remarks The scratch space is allocated from the given allocator.
+    template <radix_sort_key Key, typename Payload>
+    void radix_sort(std::span<Key> keys, std::span<Payload> payloads, allocator* allocator = get_global_allocator())
+    {
+        OBLO_ASSERT(keys.size() == payloads.size());
+
+        if (keys.size() < detail::RadixSortInsertionThreshold)
+        {
+            detail::insertion_sort(keys.data(), payloads.data(), keys.size());
+            return;
+        }
+
+        dynamic_array<Key> keysScratch{allocator};
+        dynamic_array<Payload> payloadsScratch{allocator};
+
+        keysScratch.resize(keys.size());
+        payloadsScratch.resize(keys.size());
+
+        radix_sort(keys, payloads, std::span<Key>{keysScratch}, std::span<Payload>{payloadsScratch});
+    }
+
+    /// @brief Sorts the keys in ascending order, the scratch array must be as large as the input.
+    template <radix_sort_key Key>
+    void radix_sort_keys(std::span<Key> keys, std::span<Key> keysScratch)
+    {
+        OBLO_ASSERT(keysScratch.size() >= keys.size());
+
+        detail::radix_sort_impl(keys.data(),
+            static_cast<detail::radix_no_payload*>(nullptr),
+            keysScratch.data(),
+            static_cast<detail::radix_no_payload*>(nullptr),
+            keys.size());
+    }
+
+    /// @brief Sorts the keys in ascending order, allocating the scratch space from the given allocator.
+    template <radix_sort_key Key>
+    void radix_sort_keys(std::span<Key> keys, allocator* allocator = get_global_allocator())
+    {
+        if (keys.size() < detail::RadixSortInsertionThreshold)
+        {
+            detail::insertion_sort(keys.data(), static_cast<detail::radix_no_payload*>(nullptr), keys.size());
+            return;
+        }
+
+        dynamic_array<Key> keysScratch{allocator};
+        keysScratch.resize(keys.size());
+
+        radix_sort_keys(keys, std::span<Key>{keysScratch});
+    }
+
+    /// @brief Counts the keys by the value of the bits in [shift, shift + bits).
+    /// @remarks The histogram needs 2^bits entries, it's accumulated into, so that it can be reused across batches.
+    template <radix_sort_key Key>
+    void compute_key_histogram(std::span<const Key> keys, u32 shift, u32 bits, std::span<u32> histogram)
+    {
+        OBLO_ASSERT(bits > 0 && bits < 32 && shift + bits <= sizeof(Key) * 8);
+        OBLO_ASSERT(histogram.size() >= (usize{1} << bits));
+
+        const Key mask = (Key{1} << bits) - 1;
+
+        for (const Key key : keys)
+        {
+            ++histogram[usize((key >> shift) & mask)];
+        }
+    }
+
+    /// @brief Counts the keys by their most significant prefixBits bits.
+    /// @remarks With Morton codes, each entry is the number of elements in a cell of the grid at the corresponding
+    /// level. Once the keys are sorted, the exclusive prefix sum of the histogram gives the start of each cell.
+    template <radix_sort_key Key>
+    void compute_key_prefix_histogram(std::span<const Key> keys, u32 prefixBits, std::span<u32> histogram)
+    {
+        compute_key_histogram(keys, u32{sizeof(Key) * 8} - prefixBits, prefixBits, histogram);
+    }
+}
\ No newline at end of file
@@ -1,9 +1,9 @@
 #pragma once
 
 #include <oblo/core/dynamic_array.hpp>
+#include <oblo/core/flat_hash_map.hpp>
 #include <oblo/core/type_id.hpp>
 
-#include <unordered_map>
 #include <utility>
 
 namespace oblo
@@ -46,7 +46,7 @@ namespace oblo
         };
 
     private:
-        std::unordered_map<type_id, void*> m_map;
+        flat_hash_map<type_id, void*> m_map;
         std::vector<service> m_services;
     };
 
@@ -0,0 +1,307 @@
+#pragma once
+
+#include <oblo/core/debug.hpp>
+#include <oblo/core/types.hpp>
+#include <oblo/core/utility.hpp>
+#include <oblo/math/simd.hpp>
+
+#include <bit>
+#include <compare>
+
+namespace oblo
+{
+    /// @brief Fixed size bitset, stored in 256-bit lanes to process set operations with AVX2 when available.
+    /// @remarks The storage only requires the alignment of u64, since it can be embedded in tightly packed data (e.g.
+    /// ECS chunks), unaligned loads are used instead.
+    template <u32 Bits>
+    struct simd_bitset
+    {
+        static constexpr u32 BitsPerBlock{64u};
+        static constexpr u32 BlocksPerLane{4u};
+        static constexpr u32 LanesCount{round_up_div(Bits, BitsPerBlock * BlocksPerLane)};
+        static constexpr u32 BlocksCount{LanesCount * BlocksPerLane};
+
+        void set(u32 index)
+        {
+            OBLO_ASSERT(index < Bits);
+            blocks[index / BitsPerBlock] |= u64(1) << (index % BitsPerBlock);
+        }
+
+        void reset(u32 index)
+        {
+            OBLO_ASSERT(index < Bits);
+            blocks[index / BitsPerBlock] &= ~(u64(1) << (index % BitsPerBlock));
+        }
+
+        bool test(u32 index) const
+        {
+            OBLO_ASSERT(index < Bits);
+            return (blocks[index / BitsPerBlock] & (u64(1) << (index % BitsPerBlock))) != 0;
+        }
+
+        /// @brief Sets all the bits that are set in the other bitset.
+        void add(const simd_bitset& other);
+
+        /// @brief Clears all the bits that are set in the other bitset.
+        void remove(const simd_bitset& other);
+
+        [[nodiscard]] simd_bitset intersection(const simd_bitset& other) const;
+
+        bool is_empty() const;
+
+        /// @brief Checks whether all the bits set in the other bitset are also set in this one.
+        bool includes(const simd_bitset& other) const;
+
+        /// @brief Checks whether at least one bit is set in both bitsets.
+        bool intersects(const simd_bitset& other) const;
+
+        /// @brief Fused test for includes(required) && !intersects(forbidden), in a single pass.
+        bool matches(const simd_bitset& required, const simd_bitset& forbidden) const;
+
+        /// @brief Folds the blocks into 64 bits with a bitwise or.
+        /// @remarks The signature of a subset is a subset of the signature, so checking (s(a) & ~s(b)) != 0 rejects
+        /// most of the cases where a is not a subset of b; different signatures also imply different bitsets.
+        u64 signature() const;
+
+        u32 count() const
+        {
+            u32 r{0};
+
+            for (const u64 block : blocks)
+            {
+                r += u32(std::popcount(block));
+            }
+
+            return r;
+        }
+
+        /// @brief Calls the function with the index of each set bit, in ascending order.
+        template <typename F>
+        void for_each_set_bit(F&& f) const
+        {
+            for (u32 i = 0; i < BlocksCount; ++i)
+            {
+                for (u64 v = blocks[i]; v != 0; v &= v - 1)
+                {
+                    f(i * BitsPerBlock + u32(std::countr_zero(v)));
+                }
+            }
+        }
+
+        bool operator==(const simd_bitset& other) const;
+
+        constexpr auto operator<=>(const simd_bitset&) const = default;
+
+        u64 blocks[BlocksCount];
+    };
+
+#if OBLO_MATH_AVX2
+    namespace detail
+    {
+        inline __m256i load_lane(const u64* blocks)
+        {
+            return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(blocks));
+        }
+
+        inline void store_lane(u64* blocks, __m256i v)
+        {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(blocks), v);
+        }
+    }
+#endif
+
+    template <u32 Bits>
+    void simd_bitset<Bits>::add(const simd_bitset& other)
+    {
+#if OBLO_MATH_AVX2
+        for (u32 i = 0; i < BlocksCount; i += BlocksPerLane)
+        {
+            const __m256i v = _mm256_or_si256(detail::load_lane(blocks + i), detail::load_lane(other.blocks + i));
+            detail::store_lane(blocks + i, v);
+        }
+#else
+        for (u32 i = 0; i < BlocksCount; ++i)
+        {
+            blocks[i] |= other.blocks[i];
+        }
+#endif
+    }
+
+    template <u32 Bits>
+    void simd_bitset<Bits>::remove(const simd_bitset& other)
+    {
+#if OBLO_MATH_AVX2
+        for (u32 i = 0; i < BlocksCount; i += BlocksPerLane)
+        {
+            // _mm256_andnot_si256 negates the first operand
+            const __m256i v = _mm256_andnot_si256(detail::load_lane(other.blocks + i), detail::load_lane(blocks + i));
+            detail::store_lane(blocks + i, v);
+        }
+#else
+        for (u32 i = 0; i < BlocksCount; ++i)
+        {
+            blocks[i] &= ~other.blocks[i];
+        }
+#endif
+    }
+
+    template <u32 Bits>
+    simd_bitset<Bits> simd_bitset<Bits>::intersection(const simd_bitset& other) const
+    {
+        simd_bitset r;
+
+#if OBLO_MATH_AVX2
+        for (u32 i = 0; i < BlocksCount; i += BlocksPerLane)
+        {
+            const __m256i v = _mm256_and_si256(detail::load_lane(blocks + i), detail::load_lane(other.blocks + i));
+            detail::store_lane(r.blocks + i, v);
+        }
+#else
+        for (u32 i = 0; i < BlocksCount; ++i)
+        {
+            r.blocks[i] = blocks[i] & other.blocks[i];
+        }
+#endif
+
+        return r;
+    }
+
+    template <u32 Bits>
+    bool simd_bitset<Bits>::is_empty() const
+    {
+#if OBLO_MATH_AVX2
+        __m256i acc = _mm256_setzero_si256();
+
+        for (u32 i = 0; i < BlocksCount; i += BlocksPerLane)
+        {
+            acc = _mm256_or_si256(acc, detail::load_lane(blocks + i));
+        }
+
+        return _mm256_testz_si256(acc, acc) != 0;
+#else
+        u64 acc{0};
+
+        for (u32 i = 0; i < BlocksCount; ++i)
+        {
+            acc |= blocks[i];
+        }
+
+        return acc == 0;
+#endif
+    }
+
+    template <u32 Bits>
+    bool simd_bitset<Bits>::includes(const simd_bitset& other) const
+    {
+#if OBLO_MATH_AVX2
+        __m256i missing = _mm256_setzero_si256();
+
+        for (u32 i = 0; i < BlocksCount; i += BlocksPerLane)
+        {
+            const __m256i v = _mm256_andnot_si256(detail::load_lane(blocks + i), detail::load_lane(other.blocks + i));
+            missing = _mm256_or_si256(missing, v);
+        }
+
+        return _mm256_testz_si256(missing, missing) != 0;
+#else
+        u64 missing{0};
+
+        for (u32 i = 0; i < BlocksCount; ++i)
+        {
+            missing |= other.blocks[i] & ~blocks[i];
+        }
+
+        return missing == 0;
+#endif
+    }
+
+    template <u32 Bits>
+    bool simd_bitset<Bits>::intersects(const simd_bitset& other) const
+    {
+#if OBLO_MATH_AVX2
+        for (u32 i = 0; i < BlocksCount; i += BlocksPerLane)
+        {
+            if (!_mm256_testz_si256(detail::load_lane(blocks + i), detail::load_lane(other.blocks + i)))
+            {
+                return true;
+            }
+        }
+
+        return false;
+#else
+        u64 common{0};
+
+        for (u32 i = 0; i < BlocksCount; ++i)
+        {
+            common |= blocks[i] & other.blocks[i];
+        }
+
+        return common != 0;
+#endif
+    }
+
+    template <u32 Bits>
+    bool simd_bitset<Bits>::matches(const simd_bitset& required, const simd_bitset& forbidden) const
+    {
+#if OBLO_MATH_AVX2
+        __m256i failed = _mm256_setzero_si256();
+
+        for (u32 i = 0; i < BlocksCount; i += BlocksPerLane)
+        {
+            const __m256i v = detail::load_lane(blocks + i);
+            const __m256i missing = _mm256_andnot_si256(v, detail::load_lane(required.blocks + i));
+            const __m256i common = _mm256_and_si256(v, detail::load_lane(forbidden.blocks + i));
+            failed = _mm256_or_si256(failed, _mm256_or_si256(missing, common));
+        }
+
+        return _mm256_testz_si256(failed, failed) != 0;
+#else
+        u64 failed{0};
+
+        for (u32 i = 0; i < BlocksCount; ++i)
+        {
+            failed |= (required.blocks[i] & ~blocks[i]) | (forbidden.blocks[i] & blocks[i]);
+        }
+
+        return failed == 0;
+#endif
+    }
+
+    template <u32 Bits>
+    u64 simd_bitset<Bits>::signature() const
+    {
+        u64 r{0};
+
+        for (u32 i = 0; i < BlocksCount; ++i)
+        {
+            r |= blocks[i];
+        }
+
+        return r;
+    }
+
+    template <u32 Bits>
+    bool simd_bitset<Bits>::operator==(const simd_bitset& other) const
+    {
+#if OBLO_MATH_AVX2
+        __m256i diff = _mm256_setzero_si256();
+
+        for (u32 i = 0; i < BlocksCount; i += BlocksPerLane)
+        {
+            const __m256i v = _mm256_xor_si256(detail::load_lane(blocks + i), detail::load_lane(other.blocks + i));
+            diff = _mm256_or_si256(diff, v);
+        }
+
+        return _mm256_testz_si256(diff, diff) != 0;
+#else
+        u64 diff{0};
+
+        for (u32 i = 0; i < BlocksCount; ++i)
+        {
+            diff |= blocks[i] ^ other.blocks[i];
+        }
+
+        return diff == 0;
+#endif
+    }
+}
\ No newline at end of file
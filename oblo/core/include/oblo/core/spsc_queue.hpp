@@ -0,0 +1,166 @@
+#pragma once
+
+#include <oblo/core/allocator.hpp>
+#include <oblo/core/debug.hpp>
+#include <oblo/core/types.hpp>
+#include <oblo/math/power_of_two.hpp>
+
+#include <atomic>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace oblo
+{
+    /// @brief Bounded lock-free queue for a single producer and a single consumer thread.
+    /// @remarks The capacity is rounded up to a power of two. Each side keeps a cached copy of the other side's index,
+    /// so that the shared cache lines are only touched when the queue looks full or empty.
+    template <typename T>
+    class spsc_queue
+    {
+    public:
+        spsc_queue() = default;
+
+        explicit spsc_queue(usize capacity, allocator* allocator = select_global_allocator<alignof(T)>())
+        {
+            init(capacity, allocator);
+        }
+
+        spsc_queue(const spsc_queue&) = delete;
+        spsc_queue(spsc_queue&&) noexcept = delete;
+        spsc_queue& operator=(const spsc_queue&) = delete;
+        spsc_queue& operator=(spsc_queue&&) noexcept = delete;
+
+        ~spsc_queue()
+        {
+            shutdown();
+        }
+
+        void init(usize capacity, allocator* allocator = select_global_allocator<alignof(T)>())
+        {
+            OBLO_ASSERT(!m_buffer);
+            OBLO_ASSERT(capacity > 0);
+
+            m_allocator = allocator;
+            m_capacity = round_up_power_of_two(capacity);
+            m_mask = m_capacity - 1;
+            m_buffer = reinterpret_cast<T*>(m_allocator->allocate(sizeof(T) * m_capacity, alignof(T)));
+        }
+
+        void shutdown()
+        {
+            if (!m_buffer)
+            {
+                return;
+            }
+
+            if constexpr (!std::is_trivially_destructible_v<T>)
+            {
+                const usize tail = m_tail.load(std::memory_order_relaxed);
+
+                for (usize i = m_head.load(std::memory_order_relaxed); i != tail; ++i)
+                {
+                    m_buffer[i & m_mask].~T();
+                }
+            }
+
+            m_allocator->deallocate(reinterpret_cast<byte*>(m_buffer), sizeof(T) * m_capacity, alignof(T));
+
+            m_buffer = nullptr;
+            m_head.store(0, std::memory_order_relaxed);
+            m_tail.store(0, std::memory_order_relaxed);
+            m_cachedHead = 0;
+            m_cachedTail = 0;
+        }
+
+        /// @brief Constructs an element at the end of the queue, only to be called from the producer thread.
+        /// @return false if the queue is full, in which case the arguments are left untouched.
+        template <typename... Args>
+        bool try_emplace(Args&&... args)
+        {
+            const usize tail = m_tail.load(std::memory_order_relaxed);
+
+            if (tail - m_cachedHead == m_capacity)
+            {
+                m_cachedHead = m_head.load(std::memory_order_acquire);
+
+                if (tail - m_cachedHead == m_capacity)
+                {
+                    return false;
+                }
+            }
+
+            new (m_buffer + (tail & m_mask)) T(std::forward<Args>(args)...);
+            m_tail.store(tail + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        bool try_push(const T& value)
+        {
+            return try_emplace(value);
+        }
+
+        bool try_push(T&& value)
+        {
+            return try_emplace(std::move(value));
+        }
+
+        /// @brief Moves the first element out of the queue, only to be called from the consumer thread.
+        /// @return false if the queue is empty.
+        bool try_pop(T& out)
+        {
+            const usize head = m_head.load(std::memory_order_relaxed);
+
+            if (head == m_cachedTail)
+            {
+                m_cachedTail = m_tail.load(std::memory_order_acquire);
+
+                if (head == m_cachedTail)
+                {
+                    return false;
+                }
+            }
+
+            T* const element = m_buffer + (head & m_mask);
+            out = std::move(*element);
+            element->~T();
+
+            m_head.store(head + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        /// @brief The number of elements in the queue, which might already be outdated when called concurrently.
+        usize size_approx() const
+        {
+            const usize head = m_head.load(std::memory_order_acquire);
+            const usize tail = m_tail.load(std::memory_order_acquire);
+            return tail - head;
+        }
+
+        bool empty_approx() const
+        {
+            return size_approx() == 0;
+        }
+
+        usize capacity() const
+        {
+            return m_capacity;
+        }
+
+    private:
+        T* m_buffer{};
+        usize m_capacity{};
+        usize m_mask{};
+        allocator* m_allocator{};
+
+        // Consumer side
+        alignas(64) std::atomic<usize> m_head{0};
+        usize m_cachedTail{0};
+
+        // Producer side
+        alignas(64) std::atomic<usize> m_tail{0};
+        usize m_cachedHead{0};
+    };
+}
\ No newline at end of file
@@ -8,6 +8,10 @@ namespace oblo
 {
     class string;
 
+    /// @brief Maps strings to unique handles, storing each string only once.
+    /// @remarks get_or_add and get can be called concurrently from any thread, insertions are serialized on a small
+    /// number of shards. Looking up strings by handle is wait-free, and the returned views are stable until shutdown.
+    /// Calling freeze turns the table into a read-only perfect hash table, which makes get lock-free as well.
     class string_interner
     {
     public:
@@ -24,9 +28,20 @@ namespace oblo
         void init(u32 estimatedStringsCount);
         void shutdown();
 
+        /// @brief Interns the string, returning the handle of the existing one if it was already present.
+        /// @remarks After freeze, no new string can be added and an invalid handle is returned for unknown strings.
         h32<string> get_or_add(string_view str);
         h32<string> get(string_view str) const;
 
+        /// @brief Builds a perfect hash table of all the interned strings and releases the insertion tables.
+        /// @remarks It must not be called concurrently with any other function on the interner.
+        /// @return False if no perfect hash table could be built, the interner is left unfrozen in that case.
+        bool freeze();
+        bool is_frozen() const;
+
+        /// @brief Returns the number of interned strings, which does not include the invalid handle.
+        u32 get_strings_count() const;
+
         cstring_view str(h32<string> handle) const;
         const char* c_str(h32<string> handle) const;
 
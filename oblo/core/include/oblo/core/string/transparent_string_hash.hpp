@@ -0,0 +1,67 @@
+#pragma once
+
+#include <oblo/core/hash.hpp>
+#include <oblo/core/string/cstring_view.hpp>
+#include <oblo/core/string/hashed_string_view.hpp>
+#include <oblo/core/string/string.hpp>
+#include <oblo/core/string/string_view.hpp>
+
+namespace oblo
+{
+    /// @brief Hash function for containers with string keys, which allows lookups with any string type without
+    /// creating a temporary string.
+    struct transparent_string_hash
+    {
+        using is_transparent = void;
+
+        usize operator()(string_view str) const
+        {
+            return hash<string_view>{}(str);
+        }
+
+        usize operator()(const string& str) const
+        {
+            return hash<string>{}(str);
+        }
+
+        usize operator()(cstring_view str) const
+        {
+            return hash<string_view>{}(string_view{str.data(), str.size()});
+        }
+
+        usize operator()(hashed_string_view str) const
+        {
+            // The precomputed hash matches the one of string_view
+            return str.hash();
+        }
+
+        usize operator()(const char* str) const
+        {
+            return hash<string_view>{}(string_view{str});
+        }
+    };
+
+    /// @brief Equality comparison to use together with transparent_string_hash.
+    struct transparent_string_equal
+    {
+        using is_transparent = void;
+
+        template <typename L, typename R>
+        bool operator()(const L& lhs, const R& rhs) const
+        {
+            return as_view(lhs) == as_view(rhs);
+        }
+
+    private:
+        static string_view as_view(const char* str)
+        {
+            return string_view{str};
+        }
+
+        template <typename T>
+        static string_view as_view(const T& str)
+        {
+            return string_view{str.data(), str.size()};
+        }
+    };
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <oblo/core/types.hpp>
+
+#include <span>
+
+namespace oblo
+{
+    struct mat4;
+
+    /// @brief Non-owning view of vec3 values stored as structure of arrays.
+    struct vec3_soa_view
+    {
+        const f32* x;
+        const f32* y;
+        const f32* z;
+    };
+
+    /// @brief Non-owning view of quaternion values stored as structure of arrays.
+    struct quaternion_soa_view
+    {
+        const f32* x;
+        const f32* y;
+        const f32* z;
+        const f32* w;
+    };
+
+    /// @brief Computes make_transform_matrix for each element, the number of elements is given by the size of out.
+    void make_transform_matrices(
+        vec3_soa_view positions, quaternion_soa_view rotations, vec3_soa_view scales, std::span<mat4> out);
+
+    /// @brief Computes transpose(inverse(m)) for each matrix, non-invertible matrices are replaced by the identity.
+    /// @remarks The output must have the same size as the input, it can be the same span as the input.
+    void inverse_transpose(std::span<const mat4> matrices, std::span<mat4> out);
+}
\ No newline at end of file
@@ -3,8 +3,11 @@
 #include <oblo/core/expected.hpp>
 #include <oblo/core/types.hpp>
 #include <oblo/math/constants.hpp>
+#include <oblo/math/simd.hpp>
 #include <oblo/math/vec4.hpp>
 
+#include <type_traits>
+
 namespace oblo
 {
     struct mat4
@@ -27,10 +30,151 @@ namespace oblo
         }
     };
 
+#if OBLO_MATH_SSE2
+    namespace detail
+    {
+        inline __m128 mat4_mul_sse(const mat4& lhs, __m128 v)
+        {
+            __m128 r = _mm_mul_ps(_mm_loadu_ps(&lhs.columns[0].x), broadcast_ps<0>(v));
+            r = madd_ps(_mm_loadu_ps(&lhs.columns[1].x), broadcast_ps<1>(v), r);
+            r = madd_ps(_mm_loadu_ps(&lhs.columns[2].x), broadcast_ps<2>(v), r);
+            r = madd_ps(_mm_loadu_ps(&lhs.columns[3].x), broadcast_ps<3>(v), r);
+            return r;
+        }
+
+        inline void mat4_mul_sse(const mat4& lhs, const mat4& rhs, mat4& out)
+        {
+            // Columns are loaded before storing, in case out aliases one of the inputs
+            const __m128 c0 = mat4_mul_sse(lhs, _mm_loadu_ps(&rhs.columns[0].x));
+            const __m128 c1 = mat4_mul_sse(lhs, _mm_loadu_ps(&rhs.columns[1].x));
+            const __m128 c2 = mat4_mul_sse(lhs, _mm_loadu_ps(&rhs.columns[2].x));
+            const __m128 c3 = mat4_mul_sse(lhs, _mm_loadu_ps(&rhs.columns[3].x));
+
+            _mm_storeu_ps(&out.columns[0].x, c0);
+            _mm_storeu_ps(&out.columns[1].x, c1);
+            _mm_storeu_ps(&out.columns[2].x, c2);
+            _mm_storeu_ps(&out.columns[3].x, c3);
+        }
+
+        inline void mat4_transpose_sse(const mat4& m, mat4& out)
+        {
+            __m128 c0 = _mm_loadu_ps(&m.columns[0].x);
+            __m128 c1 = _mm_loadu_ps(&m.columns[1].x);
+            __m128 c2 = _mm_loadu_ps(&m.columns[2].x);
+            __m128 c3 = _mm_loadu_ps(&m.columns[3].x);
+
+            _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+            _mm_storeu_ps(&out.columns[0].x, c0);
+            _mm_storeu_ps(&out.columns[1].x, c1);
+            _mm_storeu_ps(&out.columns[2].x, c2);
+            _mm_storeu_ps(&out.columns[3].x, c3);
+        }
+
+        // 2x2 matrix operations for the block inverse, the matrices are stored as (m00, m01, m10, m11)
+        inline __m128 mat2_mul(__m128 a, __m128 b)
+        {
+            const __m128 a1032 = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1));
+            const __m128 b0303 = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 3, 0));
+            const __m128 b2121 = _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2));
+            return _mm_add_ps(_mm_mul_ps(a, b0303), _mm_mul_ps(a1032, b2121));
+        }
+
+        // Computes adj(a) * b
+        inline __m128 mat2_adj_mul(__m128 a, __m128 b)
+        {
+            const __m128 a3300 = _mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 3, 3));
+            const __m128 a1122 = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 1, 1));
+            const __m128 b2301 = _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2));
+            return _mm_sub_ps(_mm_mul_ps(a3300, b), _mm_mul_ps(a1122, b2301));
+        }
+
+        // Computes a * adj(b)
+        inline __m128 mat2_mul_adj(__m128 a, __m128 b)
+        {
+            const __m128 a1032 = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1));
+            const __m128 b3030 = _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 3, 0, 3));
+            const __m128 b2121 = _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2));
+            return _mm_sub_ps(_mm_mul_ps(a, b3030), _mm_mul_ps(a1032, b2121));
+        }
+
+        /// @brief Inverts the matrix by splitting it in 2x2 blocks.
+        /// @remarks The inverse is only written when the determinant is larger than epsilon. The algorithm works on
+        /// rows, but since inverse(transpose(m)) = transpose(inverse(m)) we can feed it columns directly.
+        inline f32 mat4_inverse_sse(const mat4& m, mat4& out)
+        {
+            const __m128 c0 = _mm_loadu_ps(&m.columns[0].x);
+            const __m128 c1 = _mm_loadu_ps(&m.columns[1].x);
+            const __m128 c2 = _mm_loadu_ps(&m.columns[2].x);
+            const __m128 c3 = _mm_loadu_ps(&m.columns[3].x);
+
+            const __m128 a = _mm_movelh_ps(c0, c1);
+            const __m128 b = _mm_movehl_ps(c1, c0);
+            const __m128 c = _mm_movelh_ps(c2, c3);
+            const __m128 d = _mm_movehl_ps(c3, c2);
+
+            // Determinants of the blocks as (|A|, |B|, |C|, |D|)
+            const __m128 even02 = _mm_shuffle_ps(c0, c2, _MM_SHUFFLE(2, 0, 2, 0));
+            const __m128 odd02 = _mm_shuffle_ps(c0, c2, _MM_SHUFFLE(3, 1, 3, 1));
+            const __m128 even13 = _mm_shuffle_ps(c1, c3, _MM_SHUFFLE(2, 0, 2, 0));
+            const __m128 odd13 = _mm_shuffle_ps(c1, c3, _MM_SHUFFLE(3, 1, 3, 1));
+            const __m128 detSub = _mm_sub_ps(_mm_mul_ps(even02, odd13), _mm_mul_ps(odd02, even13));
+
+            const __m128 detA = broadcast_ps<0>(detSub);
+            const __m128 detB = broadcast_ps<1>(detSub);
+            const __m128 detC = broadcast_ps<2>(detSub);
+            const __m128 detD = broadcast_ps<3>(detSub);
+
+            const __m128 dc = mat2_adj_mul(d, c);
+            const __m128 ab = mat2_adj_mul(a, b);
+
+            __m128 x = _mm_sub_ps(_mm_mul_ps(detD, a), mat2_mul(b, dc));
+            __m128 w = _mm_sub_ps(_mm_mul_ps(detA, d), mat2_mul(c, ab));
+            __m128 y = _mm_sub_ps(_mm_mul_ps(detB, c), mat2_mul_adj(d, ab));
+            __m128 z = _mm_sub_ps(_mm_mul_ps(detC, b), mat2_mul_adj(a, dc));
+
+            // |M| = |A| |D| + |B| |C| - tr(adj(A) B adj(D) C)
+            __m128 tr = _mm_mul_ps(ab, _mm_shuffle_ps(dc, dc, _MM_SHUFFLE(3, 1, 2, 0)));
+            tr = _mm_add_ps(tr, _mm_shuffle_ps(tr, tr, _MM_SHUFFLE(2, 3, 0, 1)));
+            tr = _mm_add_ps(tr, _mm_shuffle_ps(tr, tr, _MM_SHUFFLE(1, 0, 3, 2)));
+
+            const __m128 detM = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), tr);
+            const f32 det = _mm_cvtss_f32(detM);
+
+            if (det <= epsilon && det >= -epsilon)
+            {
+                return det;
+            }
+
+            const __m128 rcpDet = _mm_div_ps(_mm_setr_ps(1.f, -1.f, -1.f, 1.f), detM);
+
+            x = _mm_mul_ps(x, rcpDet);
+            y = _mm_mul_ps(y, rcpDet);
+            z = _mm_mul_ps(z, rcpDet);
+            w = _mm_mul_ps(w, rcpDet);
+
+            _mm_storeu_ps(&out.columns[0].x, _mm_shuffle_ps(x, y, _MM_SHUFFLE(1, 3, 1, 3)));
+            _mm_storeu_ps(&out.columns[1].x, _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2)));
+            _mm_storeu_ps(&out.columns[2].x, _mm_shuffle_ps(z, w, _MM_SHUFFLE(1, 3, 1, 3)));
+            _mm_storeu_ps(&out.columns[3].x, _mm_shuffle_ps(z, w, _MM_SHUFFLE(0, 2, 0, 2)));
+
+            return det;
+        }
+    }
+#endif
+
     constexpr mat4 operator*(const mat4& lhs, const mat4& rhs)
     {
         mat4 r;
 
+#if OBLO_MATH_SSE2
+        if (!std::is_constant_evaluated())
+        {
+            detail::mat4_mul_sse(lhs, rhs, r);
+            return r;
+        }
+#endif
+
         for (u32 i = 0; i < 4; ++i)
         {
             for (u32 j = 0; j < 4; ++j)
@@ -53,6 +197,14 @@ namespace oblo
     {
         vec4 r;
 
+#if OBLO_MATH_SSE2
+        if (!std::is_constant_evaluated())
+        {
+            _mm_storeu_ps(&r.x, detail::mat4_mul_sse(lhs, _mm_loadu_ps(&rhs.x)));
+            return r;
+        }
+#endif
+
         for (u32 i = 0; i < 4; ++i)
         {
             r[i] = lhs.columns[0][i] * rhs[0] + lhs.columns[1][i] * rhs[1] + lhs.columns[2][i] * rhs[2] +
@@ -83,6 +235,14 @@ namespace oblo
     {
         mat4 r;
 
+#if OBLO_MATH_SSE2
+        if (!std::is_constant_evaluated())
+        {
+            detail::mat4_transpose_sse(m, r);
+            return r;
+        }
+#endif
+
         for (u32 i = 0; i < 4; ++i)
         {
             for (u32 j = 0; j < 4; ++j)
@@ -98,6 +258,25 @@ namespace oblo
     {
         mat4 inv;
 
+#if OBLO_MATH_SSE2
+        if (!std::is_constant_evaluated())
+        {
+            const f32 det = detail::mat4_inverse_sse(m, inv);
+
+            if (det <= epsilon && det >= -epsilon)
+            {
+                return unspecified_error;
+            }
+
+            if (outDeterminant)
+            {
+                *outDeterminant = det;
+            }
+
+            return inv;
+        }
+#endif
+
         inv.at(0, 0) = m.at(1, 1) * m.at(2, 2) * m.at(3, 3) - m.at(1, 1) * m.at(2, 3) * m.at(3, 2) -
             m.at(2, 1) * m.at(1, 2) * m.at(3, 3) + m.at(2, 1) * m.at(1, 3) * m.at(3, 2) +
             m.at(3, 1) * m.at(1, 2) * m.at(2, 3) - m.at(3, 1) * m.at(1, 3) * m.at(2, 2);
@@ -2,9 +2,11 @@
 
 #include <oblo/core/types.hpp>
 #include <oblo/math/angle.hpp>
+#include <oblo/math/simd.hpp>
 #include <oblo/math/vec3.hpp>
 
 #include <cmath>
+#include <type_traits>
 
 namespace oblo
 {
@@ -36,8 +38,68 @@ namespace oblo
         static vec3 to_euler_zyx_intrinsic(degrees_tag, const quaternion& q);
     };
 
+#if OBLO_MATH_SSE2
+    namespace detail
+    {
+        inline __m128 quaternion_mul_sse(__m128 lhs, __m128 rhs)
+        {
+            // Each lane of rhs is multiplied by the matching component of lhs, the shuffles and sign flips lay out
+            // the Hamilton product so the 4 components are computed together
+            const __m128 rhsWZYX = _mm_xor_ps(
+                _mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(0, 1, 2, 3)), _mm_set_ps(-0.f, 0.f, -0.f, 0.f));
+
+            const __m128 rhsZWXY = _mm_xor_ps(
+                _mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(1, 0, 3, 2)), _mm_set_ps(-0.f, -0.f, 0.f, 0.f));
+
+            const __m128 rhsYXWZ = _mm_xor_ps(
+                _mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(2, 3, 0, 1)), _mm_set_ps(-0.f, 0.f, 0.f, -0.f));
+
+            __m128 r = _mm_mul_ps(broadcast_ps<3>(lhs), rhs);
+            r = madd_ps(broadcast_ps<0>(lhs), rhsWZYX, r);
+            r = madd_ps(broadcast_ps<1>(lhs), rhsZWXY, r);
+            r = madd_ps(broadcast_ps<2>(lhs), rhsYXWZ, r);
+
+            return r;
+        }
+
+        /// @brief Cross product of the xyz components, the w lane of the result is 0.
+        inline __m128 cross3_sse(__m128 a, __m128 b)
+        {
+            const __m128 aYZX = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+            const __m128 bYZX = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+            const __m128 c = _mm_sub_ps(_mm_mul_ps(a, bYZX), _mm_mul_ps(aYZX, b));
+            return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+        }
+
+        inline vec3 quaternion_transform_sse(__m128 q, const vec3& v)
+        {
+            const __m128 p = _mm_set_ps(0.f, v.z, v.y, v.x);
+
+            const __m128 uv = cross3_sse(q, p);
+            const __m128 uv2 = _mm_add_ps(uv, uv);
+
+            __m128 r = madd_ps(broadcast_ps<3>(q), uv2, p);
+            r = _mm_add_ps(r, cross3_sse(q, uv2));
+
+            alignas(16) f32 out[4];
+            _mm_store_ps(out, r);
+
+            return {out[0], out[1], out[2]};
+        }
+    }
+#endif
+
     constexpr quaternion operator*(const quaternion& lhs, const quaternion& rhs)
     {
+#if OBLO_MATH_SSE2
+        if (!std::is_constant_evaluated())
+        {
+            quaternion r;
+            _mm_storeu_ps(&r.x, detail::quaternion_mul_sse(_mm_loadu_ps(&lhs.x), _mm_loadu_ps(&rhs.x)));
+            return r;
+        }
+#endif
+
         return {
             .x = lhs.x * rhs.w + lhs.w * rhs.x + lhs.y * rhs.z - lhs.z * rhs.y,
             .y = lhs.w * rhs.y - lhs.x * rhs.z + lhs.y * rhs.w + lhs.z * rhs.x,
@@ -80,6 +142,13 @@ namespace oblo
 
     constexpr vec3 transform(const quaternion& q, const vec3& v)
     {
+#if OBLO_MATH_SSE2
+        if (!std::is_constant_evaluated())
+        {
+            return detail::quaternion_transform_sse(_mm_loadu_ps(&q.x), v);
+        }
+#endif
+
         const vec3 u{q.x, q.y, q.z};
         const vec3 uv = 2.f * cross(u, v);
         return v + q.w * uv + cross(u, uv);
@@ -0,0 +1,49 @@
+#pragma once
+
+// Instruction sets are selected at compile time, depending on the target architecture flags.
+// SSE2 is always available on x64, AVX2 requires the respective /arch (or -m) flags, see OBLO_ENABLE_AVX2.
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define OBLO_MATH_SSE2 1
+    #include <emmintrin.h>
+    #include <xmmintrin.h>
+#else
+    #define OBLO_MATH_SSE2 0
+#endif
+
+#if OBLO_MATH_SSE2 && defined(__AVX2__)
+    #define OBLO_MATH_AVX2 1
+    #include <immintrin.h>
+#else
+    #define OBLO_MATH_AVX2 0
+#endif
+
+// MSVC does not define a macro for FMA, but it's enabled together with AVX2
+#if OBLO_MATH_AVX2 && (defined(__FMA__) || defined(_MSC_VER))
+    #define OBLO_MATH_FMA 1
+#else
+    #define OBLO_MATH_FMA 0
+#endif
+
+#if OBLO_MATH_SSE2
+
+namespace oblo::detail
+{
+    /// @brief Computes a * b + c, using a fused multiply-add when available.
+    inline __m128 madd_ps(__m128 a, __m128 b, __m128 c)
+    {
+    #if OBLO_MATH_FMA
+        return _mm_fmadd_ps(a, b, c);
+    #else
+        return _mm_add_ps(_mm_mul_ps(a, b), c);
+    #endif
+    }
+
+    template <int I>
+    inline __m128 broadcast_ps(__m128 v)
+    {
+        return _mm_shuffle_ps(v, v, _MM_SHUFFLE(I, I, I, I));
+    }
+}
+
+#endif
\ No newline at end of file
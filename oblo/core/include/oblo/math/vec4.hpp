@@ -4,6 +4,8 @@
 #include <oblo/core/types.hpp>
 #include <oblo/core/utility.hpp>
 
+#include <type_traits>
+
 namespace oblo
 {
     struct vec4
@@ -15,11 +17,23 @@ namespace oblo
 
         constexpr f32& operator[](u32 index)
         {
+            if (std::is_constant_evaluated())
+            {
+                // Pointer arithmetic across members is not allowed in constant expressions
+                return index == 0 ? x : index == 1 ? y : index == 2 ? z : w;
+            }
+
             return *(&x + index);
         }
 
         constexpr const f32& operator[](u32 index) const
         {
+            if (std::is_constant_evaluated())
+            {
+                // Pointer arithmetic across members is not allowed in constant expressions
+                return index == 0 ? x : index == 1 ? y : index == 2 ? z : w;
+            }
+
             return *(&x + index);
         }
 
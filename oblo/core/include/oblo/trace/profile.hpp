@@ -1,12 +1,6 @@
 #pragma once
 
-#ifdef TRACY_ENABLE
-
-    #include <oblo/core/string/string_view.hpp>
-
-    #include <source_location>
-
-    #include <tracy/Tracy.hpp>
+#include <source_location>
 
 namespace oblo::trace
 {
@@ -21,6 +15,12 @@ namespace oblo::trace
     }
 }
 
+#ifdef TRACY_ENABLE
+
+    #include <oblo/core/string/string_view.hpp>
+
+    #include <tracy/Tracy.hpp>
+
     #define OBLO_PROFILE_FRAME_BEGIN()
     #define OBLO_PROFILE_FRAME_END() FrameMark
     #define OBLO_PROFILE_SCOPE(...) ZoneScopedN(oblo::trace::make_scope_name(__VA_ARGS__))
@@ -38,6 +38,26 @@ namespace oblo::trace
             ZoneTextV(Name, _trace_tag.data(), _trace_tag.size());                                                     \
         }
 
+#elif defined(OBLO_BUILTIN_PROFILER)
+
+    #include <oblo/trace/profiler.hpp>
+
+    #define OBLO_PROFILE_IMPL_CONCAT_INNER(A, B) A##B
+    #define OBLO_PROFILE_IMPL_CONCAT(A, B) OBLO_PROFILE_IMPL_CONCAT_INNER(A, B)
+
+    #define OBLO_PROFILE_FRAME_BEGIN()
+    #define OBLO_PROFILE_FRAME_END() ::oblo::trace::mark_frame_end()
+    #define OBLO_PROFILE_SCOPE(...)                                                                                    \
+        OBLO_PROFILE_SCOPE_NAMED(OBLO_PROFILE_IMPL_CONCAT(_oblo_profile_scope_, __LINE__), __VA_ARGS__)
+    #define OBLO_PROFILE_SCOPE_NAMED(Name, ...)                                                                        \
+        static constexpr ::oblo::trace::zone_source OBLO_PROFILE_IMPL_CONCAT(Name, _source){                          \
+            ::oblo::trace::make_scope_name(__VA_ARGS__)};                                                              \
+        const ::oblo::trace::profile_scope Name{&OBLO_PROFILE_IMPL_CONCAT(Name, _source)}
+
+    // Tags are not recorded by the built-in profiler
+    #define OBLO_PROFILE_TAG(Text)
+    #define OBLO_PROFILE_TAG_NAMED(Name, Text)
+
 #else
 
     #define OBLO_PROFILE_FRAME_BEGIN()
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <oblo/core/dynamic_array.hpp>
+#include <oblo/core/expected.hpp>
+#include <oblo/core/string/cstring_view.hpp>
+#include <oblo/core/string/string_view.hpp>
+#include <oblo/core/types.hpp>
+
+#include <atomic>
+
+namespace oblo::trace
+{
+    /// @brief Static description of a profiled scope, one for each use of the profiling macros.
+    struct zone_source
+    {
+        const char* name;
+    };
+
+    struct zone_stats
+    {
+        const zone_source* source;
+        u64 count;
+        f64 totalMs;
+        f64 meanMs;
+        f64 p99Ms;
+        f64 maxMs;
+    };
+
+    struct capture_info
+    {
+        u32 framesCount;
+        u32 threadsCount;
+        u64 eventsCount;
+
+        /// @brief Events that were discarded because the buffer of a thread was full.
+        u64 droppedEventsCount;
+    };
+
+    namespace detail
+    {
+        extern std::atomic<bool> g_isCapturing;
+
+        u64 get_timestamp() noexcept;
+        void record_zone(const zone_source* source, u64 begin, u64 end) noexcept;
+    }
+
+    /// @brief Checks whether profiling events are being recorded, which is the only cost of a scope when it's not.
+    inline bool is_capturing() noexcept
+    {
+        return detail::g_isCapturing.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Starts recording events, discarding the ones of the previous capture.
+    void start_capture();
+
+    void stop_capture();
+
+    /// @brief Records the end of a frame, it's a no-op when not capturing.
+    void mark_frame_end();
+
+    /// @brief Sets the name of the calling thread, as it will appear in the trace.
+    void set_thread_name(string_view name);
+
+    capture_info get_capture_info();
+
+    /// @brief Aggregates the events of the current capture by zone, sorted by total time in descending order.
+    /// @remarks It can be called while capturing, in which case only the events recorded so far are considered.
+    void get_zone_stats(dynamic_array<zone_stats>& out);
+
+    /// @brief Writes the current capture in the Chrome trace event format, which can be loaded by Perfetto too.
+    expected<> dump_chrome_trace(cstring_view path);
+
+    /// @brief Records the time spent in a scope as a zone, if a capture was running when the scope was entered.
+    class profile_scope
+    {
+    public:
+        explicit profile_scope(const zone_source* source) noexcept
+        {
+            if (is_capturing())
+            {
+                m_source = source;
+                m_begin = detail::get_timestamp();
+            }
+        }
+
+        profile_scope(const profile_scope&) = delete;
+        profile_scope& operator=(const profile_scope&) = delete;
+
+        ~profile_scope()
+        {
+            if (m_source)
+            {
+                detail::record_zone(m_source, m_begin, detail::get_timestamp());
+            }
+        }
+
+    private:
+        const zone_source* m_source{};
+        u64 m_begin{};
+    };
+}
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include <oblo/core/allocator.hpp>
 
 #include <oblo/core/debug.hpp>
+#include <oblo/core/memory_tracking.hpp>
 
 #include <cstdlib>
 #include <memory>
@@ -38,15 +39,29 @@ namespace oblo
 
         global_allocator g_allocator;
         global_aligned_allocator g_alignedAllocator;
+
+#ifdef OBLO_MEMORY_TRACKING
+        // Constant initialized, so they can be used by other static objects regardless of the initialization order
+        constinit tracking_allocator g_trackingAllocator{&g_allocator};
+        constinit tracking_allocator g_trackingAlignedAllocator{&g_alignedAllocator};
+#endif
     }
 
     allocator* get_global_allocator() noexcept
     {
+#ifdef OBLO_MEMORY_TRACKING
+        return &g_trackingAllocator;
+#else
         return &g_allocator;
+#endif
     }
 
     allocator* get_global_aligned_allocator() noexcept
     {
+#ifdef OBLO_MEMORY_TRACKING
+        return &g_trackingAlignedAllocator;
+#else
         return &g_alignedAllocator;
+#endif
     }
 }
\ No newline at end of file
@@ -0,0 +1,734 @@
+#include <oblo/core/compression/lz.hpp>
+
+#include <oblo/core/debug.hpp>
+#include <oblo/core/utility.hpp>
+
+#include <bit>
+#include <cstring>
+
+namespace oblo::lz
+{
+    namespace
+    {
+        constexpr u32 MinMatch{4};
+        constexpr u32 LastLiterals{5};
+        constexpr u32 MatchFindLimit{12};
+        constexpr u32 MaxOffset{65535};
+
+        constexpr u32 HashLog{13};
+
+        // Fast copies can write up to this amount of bytes past the end of the copied range
+        constexpr usize WildCopyLength{16};
+
+        // The search step grows after 2^SkipStrength failed attempts, to skip incompressible data quickly
+        constexpr u32 SkipStrength{6};
+
+        constexpr u32 TokenLiteralsShift{4};
+        constexpr u32 TokenLengthMask{15};
+
+        u32 read_u32(const byte* p)
+        {
+            u32 r;
+            std::memcpy(&r, p, sizeof(r));
+            return r;
+        }
+
+        u64 read_u64(const byte* p)
+        {
+            u64 r;
+            std::memcpy(&r, p, sizeof(r));
+            return r;
+        }
+
+        u16 read_u16(const byte* p)
+        {
+            u16 r;
+            std::memcpy(&r, p, sizeof(r));
+            return r;
+        }
+
+        void write_u16(byte* p, u16 v)
+        {
+            std::memcpy(p, &v, sizeof(v));
+        }
+
+        u32 hash_sequence(u32 sequence)
+        {
+            return (sequence * 2654435761u) >> (32 - HashLog);
+        }
+
+        // Copies 16 bytes at a time, it may write past the end, but never more than WildCopyLength bytes
+        void wild_copy(byte* dst, const byte* src, usize size)
+        {
+            byte* const end = dst + size;
+
+            do
+            {
+                std::memcpy(dst, src, WildCopyLength);
+                dst += WildCopyLength;
+                src += WildCopyLength;
+            } while (dst < end);
+        }
+
+        u32 count_matching(const byte* p, const byte* match, const byte* limit)
+        {
+            const byte* const begin = p;
+
+            while (p + sizeof(u64) <= limit)
+            {
+                const u64 diff = read_u64(p) ^ read_u64(match);
+
+                if (diff != 0)
+                {
+                    return u32(p - begin) + u32(std::countr_zero(diff) / 8);
+                }
+
+                p += sizeof(u64);
+                match += sizeof(u64);
+            }
+
+            while (p < limit && *p == *match)
+            {
+                ++p;
+                ++match;
+            }
+
+            return u32(p - begin);
+        }
+
+        byte* write_length(byte* op, u32 length)
+        {
+            for (; length >= 255; length -= 255)
+            {
+                *op++ = byte{255};
+            }
+
+            *op++ = byte(length);
+            return op;
+        }
+
+        byte* write_literals(byte* op, const byte* literals, u32 literalsCount, u32 matchLength)
+        {
+            byte* const token = op++;
+
+            const u32 literalsToken = min(literalsCount, TokenLengthMask);
+            const u32 matchToken = min(matchLength, TokenLengthMask);
+
+            *token = byte((literalsToken << TokenLiteralsShift) | matchToken);
+
+            if (literalsToken == TokenLengthMask)
+            {
+                op = write_length(op, literalsCount - TokenLengthMask);
+            }
+
+            std::memcpy(op, literals, literalsCount);
+            return op + literalsCount;
+        }
+
+        bool read_length(const byte*& ip, const byte* iend, u32& length)
+        {
+            u32 extra;
+
+            do
+            {
+                if (ip >= iend)
+                {
+                    return false;
+                }
+
+                extra = u32(*ip++);
+                length += extra;
+            } while (extra == 255);
+
+            return true;
+        }
+
+        bool is_valid_block_size(usize size)
+        {
+            return size <= MaxBlockSize;
+        }
+    }
+
+    expected<usize> compress_block(std::span<const byte> src, std::span<byte> dst)
+    {
+        if (!is_valid_block_size(src.size()) || dst.size() < compress_bound(src.size()))
+        {
+            return unspecified_error;
+        }
+
+        const byte* const base = src.data();
+        const u32 size = u32(src.size());
+
+        byte* op = dst.data();
+        u32 anchor = 0;
+
+        if (size >= MatchFindLimit + 1)
+        {
+            // Positions in the source, they can be stale or collide, candidates are always verified
+            u32 table[1u << HashLog]{};
+
+            const u32 matchFindLimit = size - MatchFindLimit;
+            const u32 matchLimit = size - LastLiterals;
+
+            u32 ip = 1;
+
+            while (true)
+            {
+                u32 ref{};
+
+                // Find the next match, starting with single steps and accelerating when nothing is found
+                {
+                    u32 attempts = 1u << SkipStrength;
+                    bool found = false;
+
+                    while (ip <= matchFindLimit)
+                    {
+                        const u32 sequence = read_u32(base + ip);
+                        const u32 h = hash_sequence(sequence);
+
+                        ref = table[h];
+                        table[h] = ip;
+
+                        if (ip - ref <= MaxOffset && read_u32(base + ref) == sequence)
+                        {
+                            found = true;
+                            break;
+                        }
+
+                        ip += attempts++ >> SkipStrength;
+                    }
+
+                    if (!found)
+                    {
+                        break;
+                    }
+                }
+
+                // Extend the match backwards, stealing bytes from the literals
+                while (ip > anchor && ref > 0 && base[ip - 1] == base[ref - 1])
+                {
+                    --ip;
+                    --ref;
+                }
+
+                const u32 matchLength =
+                    MinMatch + count_matching(base + ip + MinMatch, base + ref + MinMatch, base + matchLimit);
+
+                const u32 encodedLength = matchLength - MinMatch;
+
+                op = write_literals(op, base + anchor, ip - anchor, encodedLength);
+
+                write_u16(op, u16(ip - ref));
+                op += sizeof(u16);
+
+                if (encodedLength >= TokenLengthMask)
+                {
+                    op = write_length(op, encodedLength - TokenLengthMask);
+                }
+
+                ip += matchLength;
+                anchor = ip;
+
+                if (ip > matchFindLimit)
+                {
+                    break;
+                }
+
+                // Fill the table with a position in the match, to improve the chances of finding the next one
+                table[hash_sequence(read_u32(base + ip - 2))] = ip - 2;
+            }
+        }
+
+        // The last sequence only has literals
+        op = write_literals(op, base + anchor, size - anchor, 0);
+
+        return usize(op - dst.data());
+    }
+
+    expected<usize> decompress_block(std::span<const byte> src, std::span<byte> dst)
+    {
+        const byte* ip = src.data();
+        const byte* const iend = ip + src.size();
+
+        byte* const obegin = dst.data();
+        byte* op = obegin;
+        byte* const oend = op + dst.size();
+
+        while (true)
+        {
+            if (ip >= iend)
+            {
+                return unspecified_error;
+            }
+
+            const u32 token = u32(*ip++);
+
+            u32 literalsCount = token >> TokenLiteralsShift;
+
+            if (literalsCount == TokenLengthMask && !read_length(ip, iend, literalsCount))
+            {
+                return unspecified_error;
+            }
+
+            if (usize(iend - ip) < literalsCount || usize(oend - op) < literalsCount)
+            {
+                return unspecified_error;
+            }
+
+            const usize literalsSlack = literalsCount + WildCopyLength;
+
+            if (usize(iend - ip) >= literalsSlack && usize(oend - op) >= literalsSlack)
+            {
+                wild_copy(op, ip, literalsCount);
+            }
+            else
+            {
+                std::memmove(op, ip, literalsCount);
+            }
+
+            ip += literalsCount;
+            op += literalsCount;
+
+            // The last sequence has no match
+            if (ip == iend)
+            {
+                break;
+            }
+
+            if (iend - ip < 2)
+            {
+                return unspecified_error;
+            }
+
+            const u32 offset = read_u16(ip);
+            ip += sizeof(u16);
+
+            if (offset == 0 || offset > usize(op - obegin))
+            {
+                return unspecified_error;
+            }
+
+            u32 matchLength = token & TokenLengthMask;
+
+            if (matchLength == TokenLengthMask && !read_length(ip, iend, matchLength))
+            {
+                return unspecified_error;
+            }
+
+            matchLength += MinMatch;
+
+            if (usize(oend - op) < matchLength)
+            {
+                return unspecified_error;
+            }
+
+            const byte* match = op - offset;
+
+            if (offset >= WildCopyLength && usize(oend - op) >= matchLength + WildCopyLength)
+            {
+                // Each chunk only reads bytes that were written before the chunk itself
+                wild_copy(op, match, matchLength);
+                op += matchLength;
+            }
+            else if (offset >= sizeof(u64) && usize(oend - op) >= matchLength + sizeof(u64))
+            {
+                byte* const matchEnd = op + matchLength;
+
+                for (; op < matchEnd; op += sizeof(u64), match += sizeof(u64))
+                {
+                    std::memcpy(op, match, sizeof(u64));
+                }
+
+                op = matchEnd;
+            }
+            else
+            {
+                // Overlapping copies repeat the last offset bytes, which is how runs are encoded
+                byte* const matchEnd = op + matchLength;
+
+                while (op < matchEnd)
+                {
+                    *op++ = *match++;
+                }
+            }
+        }
+
+        return usize(op - obegin);
+    }
+
+    usize write_frame_block(std::span<const byte> src, std::span<byte> dst)
+    {
+        OBLO_ASSERT(dst.size() >= sizeof(block_header) + compress_bound(src.size()));
+
+        byte* const data = dst.data() + sizeof(block_header);
+        const auto compressed = compress_block(src, dst.subspan(sizeof(block_header)));
+
+        block_header header{
+            .uncompressedSize = u32(src.size()),
+        };
+
+        if (compressed && *compressed < src.size())
+        {
+            header.compressedSize = u32(*compressed);
+        }
+        else
+        {
+            // Incompressible data is stored as is, which also makes decompression faster
+            std::memcpy(data, src.data(), src.size());
+            header.compressedSize = u32(src.size()) | block_header::StoredFlag;
+        }
+
+        std::memcpy(dst.data(), &header, sizeof(header));
+
+        return sizeof(block_header) + (header.compressedSize & ~block_header::StoredFlag);
+    }
+
+    expected<usize> compress_frame(std::span<const byte> src, std::span<byte> dst, u32 blockSize)
+    {
+        if (blockSize == 0 || !is_valid_block_size(blockSize) ||
+            dst.size() < frame_compress_bound(src.size(), blockSize))
+        {
+            return unspecified_error;
+        }
+
+        const frame_header header{.magic = FrameMagic, .blockSize = blockSize};
+        std::memcpy(dst.data(), &header, sizeof(header));
+
+        usize offset = sizeof(header);
+
+        // The frame bound only accounts for stored blocks, while the compressor needs room for the worst case, so
+        // blocks go through a scratch buffer once the destination is almost full
+        dynamic_array<byte> scratch;
+
+        for (usize i = 0; i < src.size(); i += blockSize)
+        {
+            const auto block = src.subspan(i, min(usize{blockSize}, src.size() - i));
+            const usize required = sizeof(block_header) + compress_bound(block.size());
+
+            if (dst.size() - offset >= required)
+            {
+                offset += write_frame_block(block, dst.subspan(offset));
+            }
+            else
+            {
+                scratch.resize_default(required);
+
+                const usize written = write_frame_block(block, scratch);
+                std::memcpy(dst.data() + offset, scratch.data(), written);
+                offset += written;
+            }
+        }
+
+        constexpr u32 endMarker{0};
+        std::memcpy(dst.data() + offset, &endMarker, sizeof(endMarker));
+        offset += sizeof(endMarker);
+
+        return offset;
+    }
+
+    expected<usize> compress_frame(std::span<const byte> src, dynamic_array<byte>& out, u32 blockSize)
+    {
+        if (blockSize == 0)
+        {
+            return unspecified_error;
+        }
+
+        const usize offset = out.size();
+        out.resize_default(offset + frame_compress_bound(src.size(), blockSize));
+
+        const auto r = compress_frame(src, std::span{out}.subspan(offset), blockSize);
+        out.resize(offset + r.value_or(0));
+
+        return r;
+    }
+
+    expected<frame_info> read_frame_info(std::span<const byte> frame)
+    {
+        frame_header header;
+
+        if (frame.size() < sizeof(header))
+        {
+            return unspecified_error;
+        }
+
+        std::memcpy(&header, frame.data(), sizeof(header));
+
+        if (header.magic != FrameMagic || header.blockSize == 0 || !is_valid_block_size(header.blockSize))
+        {
+            return unspecified_error;
+        }
+
+        frame_info info{.blockSize = header.blockSize};
+
+        for (usize offset = sizeof(header);;)
+        {
+            if (frame.size() - offset < sizeof(u32))
+            {
+                return unspecified_error;
+            }
+
+            block_header block;
+            std::memcpy(&block.compressedSize, frame.data() + offset, sizeof(u32));
+
+            if (block.compressedSize == 0)
+            {
+                break;
+            }
+
+            if (frame.size() - offset < sizeof(block))
+            {
+                return unspecified_error;
+            }
+
+            std::memcpy(&block, frame.data() + offset, sizeof(block));
+            offset += sizeof(block);
+
+            const u32 dataSize = block.compressedSize & ~block_header::StoredFlag;
+
+            if (block.uncompressedSize > header.blockSize || frame.size() - offset < dataSize)
+            {
+                return unspecified_error;
+            }
+
+            offset += dataSize;
+
+            info.uncompressedSize += block.uncompressedSize;
+            ++info.blocksCount;
+        }
+
+        return info;
+    }
+
+    expected<usize> decompress_frame(std::span<const byte> frame, std::span<byte> dst)
+    {
+        const auto info = read_frame_info(frame);
+
+        if (!info || dst.size() < info->uncompressedSize)
+        {
+            return unspecified_error;
+        }
+
+        usize offset = sizeof(frame_header);
+        usize outOffset = 0;
+
+        for (u32 i = 0; i < info->blocksCount; ++i)
+        {
+            block_header block;
+            std::memcpy(&block, frame.data() + offset, sizeof(block));
+            offset += sizeof(block);
+
+            const u32 dataSize = block.compressedSize & ~block_header::StoredFlag;
+            const auto data = frame.subspan(offset, dataSize);
+            const auto out = dst.subspan(outOffset, block.uncompressedSize);
+
+            if (block.compressedSize & block_header::StoredFlag)
+            {
+                if (dataSize != block.uncompressedSize)
+                {
+                    return unspecified_error;
+                }
+
+                std::memcpy(out.data(), data.data(), dataSize);
+            }
+            else if (decompress_block(data, out).value_or(~usize{}) != block.uncompressedSize)
+            {
+                return unspecified_error;
+            }
+
+            offset += dataSize;
+            outOffset += block.uncompressedSize;
+        }
+
+        return outOffset;
+    }
+
+    expected<> frame_writer::init(FILE* file, u32 blockSize)
+    {
+        if (!file || blockSize == 0 || !is_valid_block_size(blockSize))
+        {
+            return unspecified_error;
+        }
+
+        m_file = file;
+        m_blockSize = blockSize;
+
+        m_block.clear();
+        m_block.reserve(blockSize);
+        m_compressed.resize_default(sizeof(block_header) + compress_bound(blockSize));
+
+        const frame_header header{.magic = FrameMagic, .blockSize = blockSize};
+
+        if (fwrite(&header, sizeof(header), 1, m_file) != 1)
+        {
+            return unspecified_error;
+        }
+
+        return no_error;
+    }
+
+    expected<> frame_writer::write(std::span<const byte> data)
+    {
+        OBLO_ASSERT(m_file);
+
+        while (!data.empty())
+        {
+            const usize count = min(data.size(), usize{m_blockSize} - m_block.size());
+            m_block.append(data.begin(), data.begin() + count);
+            data = data.subspan(count);
+
+            if (m_block.size() == m_blockSize && !flush_block())
+            {
+                return unspecified_error;
+            }
+        }
+
+        return no_error;
+    }
+
+    expected<> frame_writer::finish()
+    {
+        OBLO_ASSERT(m_file);
+
+        if (!m_block.empty() && !flush_block())
+        {
+            return unspecified_error;
+        }
+
+        constexpr u32 endMarker{0};
+        const bool success = fwrite(&endMarker, sizeof(endMarker), 1, m_file) == 1;
+
+        m_file = nullptr;
+
+        if (!success)
+        {
+            return unspecified_error;
+        }
+
+        return no_error;
+    }
+
+    expected<> frame_writer::flush_block()
+    {
+        const usize size = write_frame_block(m_block, m_compressed);
+        m_block.clear();
+
+        if (fwrite(m_compressed.data(), 1, size, m_file) != size)
+        {
+            return unspecified_error;
+        }
+
+        return no_error;
+    }
+
+    expected<> frame_reader::init(FILE* file)
+    {
+        frame_header header;
+
+        if (!file || fread(&header, sizeof(header), 1, file) != 1)
+        {
+            return unspecified_error;
+        }
+
+        if (header.magic != FrameMagic || header.blockSize == 0 || !is_valid_block_size(header.blockSize))
+        {
+            return unspecified_error;
+        }
+
+        m_file = file;
+        m_blockSize = header.blockSize;
+        m_blockOffset = 0;
+        m_isFinished = false;
+
+        m_block.clear();
+        m_compressed.clear();
+
+        return no_error;
+    }
+
+    expected<usize> frame_reader::read(std::span<byte> dst)
+    {
+        OBLO_ASSERT(m_file);
+
+        usize count = 0;
+
+        while (count < dst.size())
+        {
+            if (m_blockOffset == m_block.size())
+            {
+                if (m_isFinished)
+                {
+                    break;
+                }
+
+                if (!read_block())
+                {
+                    return unspecified_error;
+                }
+
+                continue;
+            }
+
+            const usize n = min(dst.size() - count, m_block.size() - m_blockOffset);
+            std::memcpy(dst.data() + count, m_block.data() + m_blockOffset, n);
+
+            count += n;
+            m_blockOffset += u32(n);
+        }
+
+        return count;
+    }
+
+    expected<> frame_reader::read_block()
+    {
+        m_block.clear();
+        m_blockOffset = 0;
+
+        block_header header;
+
+        if (fread(&header.compressedSize, sizeof(u32), 1, m_file) != 1)
+        {
+            return unspecified_error;
+        }
+
+        if (header.compressedSize == 0)
+        {
+            m_isFinished = true;
+            return no_error;
+        }
+
+        if (fread(&header.uncompressedSize, sizeof(u32), 1, m_file) != 1 || header.uncompressedSize > m_blockSize)
+        {
+            return unspecified_error;
+        }
+
+        const u32 dataSize = header.compressedSize & ~block_header::StoredFlag;
+        const bool isStored = (header.compressedSize & block_header::StoredFlag) != 0;
+
+        if (isStored ? dataSize != header.uncompressedSize : dataSize > compress_bound(m_blockSize))
+        {
+            return unspecified_error;
+        }
+
+        m_block.resize_default(header.uncompressedSize);
+
+        if (isStored)
+        {
+            if (fread(m_block.data(), 1, dataSize, m_file) != dataSize)
+            {
+                return unspecified_error;
+            }
+
+            return no_error;
+        }
+
+        m_compressed.resize_default(dataSize);
+
+        if (fread(m_compressed.data(), 1, dataSize, m_file) != dataSize ||
+            decompress_block(m_compressed, m_block).value_or(~usize{}) != header.uncompressedSize)
+        {
+            return unspecified_error;
+        }
+
+        return no_error;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,170 @@
+#include <oblo/core/concurrent_frame_allocator.hpp>
+
+#include <oblo/core/debug.hpp>
+#include <oblo/core/platform/virtual_memory.hpp>
+#include <oblo/core/utility.hpp>
+
+namespace oblo
+{
+    concurrent_frame_allocator::~concurrent_frame_allocator()
+    {
+        shutdown();
+    }
+
+    bool concurrent_frame_allocator::init(usize maxSize, usize chunkSize, usize startingChunks, bool useHugePages)
+    {
+        if (m_reservation)
+        {
+            return false;
+        }
+
+        if (chunkSize == 0 || chunkSize % platform::virtual_memory_page_size() != 0)
+        {
+            return false;
+        }
+
+        if (maxSize < chunkSize * startingChunks)
+        {
+            return false;
+        }
+
+        maxSize = round_up_multiple(maxSize, chunkSize);
+
+        const bool alignToHugePages = useHugePages && chunkSize % platform::HugePageSize == 0;
+
+        platform::virtual_memory_reservation reservation;
+
+        if (!platform::virtual_memory_reserve(maxSize, alignToHugePages, reservation))
+        {
+            return false;
+        }
+
+        m_reservation = static_cast<u8*>(reservation.base);
+        m_reservationSize = reservation.size;
+        m_virtualMemory = static_cast<u8*>(reservation.begin);
+
+        m_maxSize = maxSize;
+        m_chunkSize = chunkSize;
+
+        m_offset.store(0, std::memory_order_relaxed);
+        m_committed.store(0, std::memory_order_relaxed);
+
+        if (startingChunks > 0)
+        {
+            commit(chunkSize * startingChunks);
+        }
+
+        return true;
+    }
+
+    void concurrent_frame_allocator::shutdown()
+    {
+        if (m_reservation)
+        {
+            platform::virtual_memory_release(m_reservation, m_reservationSize);
+
+            m_reservation = nullptr;
+            m_reservationSize = 0;
+            m_virtualMemory = nullptr;
+            m_maxSize = 0;
+
+            m_offset.store(0, std::memory_order_relaxed);
+            m_committed.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    byte* concurrent_frame_allocator::allocate(usize size, usize alignment) noexcept
+    {
+        OBLO_ASSERT(size != 0);
+        OBLO_ASSERT(alignment != 0);
+
+        const auto base = reinterpret_cast<uintptr>(m_virtualMemory);
+
+        usize offset = m_offset.load(std::memory_order_relaxed);
+        usize alignedOffset;
+        usize newOffset;
+
+        do
+        {
+            alignedOffset = round_up_multiple(base + offset, uintptr{alignment}) - base;
+            newOffset = alignedOffset + size;
+
+            if (newOffset > m_maxSize)
+            {
+                return nullptr;
+            }
+        } while (!m_offset.compare_exchange_weak(offset, newOffset, std::memory_order_relaxed));
+
+        // The acquire pairs with the release in commit, making sure the memory is accessible to this thread
+        if (newOffset > m_committed.load(std::memory_order_acquire) && !commit(newOffset))
+        {
+            return nullptr;
+        }
+
+        return reinterpret_cast<byte*>(m_virtualMemory + alignedOffset);
+    }
+
+    bool concurrent_frame_allocator::commit(usize newSize) noexcept
+    {
+        const std::lock_guard lock{m_commitMutex};
+
+        // Another thread might have committed while we were waiting
+        const usize committed = m_committed.load(std::memory_order_relaxed);
+
+        if (newSize <= committed)
+        {
+            return true;
+        }
+
+        const usize newCommitted = round_up_multiple(newSize, m_chunkSize);
+
+        if (!platform::virtual_memory_commit(m_virtualMemory + committed, newCommitted - committed))
+        {
+            return false;
+        }
+
+        m_committed.store(newCommitted, std::memory_order_release);
+        return true;
+    }
+
+    void concurrent_frame_allocator::restore_all()
+    {
+        const usize highWaterMark = m_offset.exchange(0, std::memory_order_relaxed);
+
+        m_lastFrameHighWaterMark = highWaterMark;
+        m_peakHighWaterMark = max(m_peakHighWaterMark, highWaterMark);
+        m_totalHighWaterMark += highWaterMark;
+        ++m_framesCount;
+    }
+
+    void concurrent_frame_allocator::free_unused()
+    {
+        const std::lock_guard lock{m_commitMutex};
+
+        const usize inUse = max(m_offset.load(std::memory_order_relaxed), m_lastFrameHighWaterMark);
+        const usize committed = m_committed.load(std::memory_order_relaxed);
+        const usize needed = round_up_multiple(inUse, m_chunkSize);
+
+        if (needed < committed && platform::virtual_memory_decommit(m_virtualMemory + needed, committed - needed))
+        {
+            m_committed.store(needed, std::memory_order_release);
+        }
+    }
+
+    concurrent_frame_allocator_stats concurrent_frame_allocator::get_stats() const
+    {
+        return {
+            .currentUsage = m_offset.load(std::memory_order_relaxed),
+            .lastFrameHighWaterMark = m_lastFrameHighWaterMark,
+            .peakHighWaterMark = m_peakHighWaterMark,
+            .totalHighWaterMark = m_totalHighWaterMark,
+            .framesCount = m_framesCount,
+            .committedMemory = m_committed.load(std::memory_order_relaxed),
+        };
+    }
+
+    bool concurrent_frame_allocator::contains(const void* ptr) const
+    {
+        return ptr >= m_virtualMemory && ptr < m_virtualMemory + m_committed.load(std::memory_order_relaxed);
+    }
+}
@@ -192,14 +192,17 @@ namespace oblo::filesystem
         return r;
     }
 
-    expected<bool> copy_file(cstring_view source, cstring_view destination)
+    expected<bool> copy_file(cstring_view source, cstring_view destination, copy_policy policy)
     {
         std::filesystem::path p1{std::u8string_view{source.u8data(), source.size()}};
         std::filesystem::path p2{std::u8string_view{destination.u8data(), destination.size()}};
 
+        const auto options = policy == copy_policy::overwrite ? std::filesystem::copy_options::overwrite_existing
+                                                              : std::filesystem::copy_options::none;
+
         std::error_code ec;
 
-        const auto r = std::filesystem::copy_file(p1, p2, ec);
+        const auto r = std::filesystem::copy_file(p1, p2, options, ec);
 
         if (ec)
         {
@@ -209,6 +212,23 @@ namespace oblo::filesystem
         return r;
     }
 
+    expected<> rename(cstring_view source, cstring_view destination)
+    {
+        std::filesystem::path p1{std::u8string_view{source.u8data(), source.size()}};
+        std::filesystem::path p2{std::u8string_view{destination.u8data(), destination.size()}};
+
+        std::error_code ec;
+
+        std::filesystem::rename(p1, p2, ec);
+
+        if (ec)
+        {
+            return unspecified_error;
+        }
+
+        return no_error;
+    }
+
     expected<bool> create_directories(cstring_view path)
     {
         std::filesystem::path p{std::u8string_view{path.u8data(), path.size()}};
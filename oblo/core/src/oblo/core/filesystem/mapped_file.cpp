@@ -0,0 +1,330 @@
+#include <oblo/core/filesystem/mapped_file.hpp>
+
+#include <oblo/core/debug.hpp>
+#include <oblo/core/utility.hpp>
+
+#include <utility>
+
+#if defined(WIN32)
+    #include <oblo/core/platform/platform_win32.hpp>
+
+    #define NOMINMAX
+    #include <Windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace oblo::filesystem
+{
+    namespace
+    {
+#if defined(WIN32)
+        usize get_mapping_granularity()
+        {
+            SYSTEM_INFO info;
+            GetSystemInfo(&info);
+            return usize(info.dwPageSize);
+        }
+#else
+        usize get_mapping_granularity()
+        {
+            return usize(sysconf(_SC_PAGESIZE));
+        }
+
+        int to_madvise(mapped_file_advice advice)
+        {
+            switch (advice)
+            {
+            case mapped_file_advice::sequential:
+                return MADV_SEQUENTIAL;
+            case mapped_file_advice::random:
+                return MADV_RANDOM;
+            case mapped_file_advice::will_need:
+                return MADV_WILLNEED;
+            case mapped_file_advice::dont_need:
+                return MADV_DONTNEED;
+            default:
+                return MADV_NORMAL;
+            }
+        }
+#endif
+    }
+
+    mapped_file::mapped_file(mapped_file&& other) noexcept :
+        m_data{std::exchange(other.m_data, nullptr)}, m_size{std::exchange(other.m_size, 0)},
+        m_access{other.m_access}, m_isOpen{std::exchange(other.m_isOpen, false)}
+    {
+    }
+
+    mapped_file& mapped_file::operator=(mapped_file&& other) noexcept
+    {
+        if (this != &other)
+        {
+            close();
+
+            m_data = std::exchange(other.m_data, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+            m_access = other.m_access;
+            m_isOpen = std::exchange(other.m_isOpen, false);
+        }
+
+        return *this;
+    }
+
+    mapped_file::~mapped_file()
+    {
+        close();
+    }
+
+    expected<> mapped_file::open(cstring_view path, mapped_file_access access)
+    {
+        return map(path, access, false, 0);
+    }
+
+    expected<> mapped_file::create(cstring_view path, usize size)
+    {
+        return map(path, mapped_file_access::read_write, true, size);
+    }
+
+    bool mapped_file::is_open() const
+    {
+        return m_isOpen;
+    }
+
+    std::span<const byte> mapped_file::get_bytes() const
+    {
+        return {m_data, m_size};
+    }
+
+    std::span<byte> mapped_file::get_writable_bytes() const
+    {
+        OBLO_ASSERT(m_access == mapped_file_access::read_write);
+        return {m_data, m_size};
+    }
+
+    usize mapped_file::size() const
+    {
+        return m_size;
+    }
+
+    mapped_file_access mapped_file::get_access() const
+    {
+        return m_access;
+    }
+
+    bool mapped_file::advise(mapped_file_advice advice, usize offset, usize size)
+    {
+        if (!m_data || offset >= m_size)
+        {
+            return false;
+        }
+
+        // The range has to start at a page boundary, we extend it to the left if necessary
+        const usize pageSize = get_mapping_granularity();
+        const usize alignedOffset = offset - offset % pageSize;
+        const usize alignedSize = min(size, m_size - offset) + (offset - alignedOffset);
+
+#if defined(WIN32)
+        if (advice != mapped_file_advice::will_need)
+        {
+            // There's no equivalent for other hints, the OS will just do its own thing
+            return true;
+        }
+
+        WIN32_MEMORY_RANGE_ENTRY range{
+            .VirtualAddress = m_data + alignedOffset,
+            .NumberOfBytes = alignedSize,
+        };
+
+        return PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0) != 0;
+#else
+        return madvise(m_data + alignedOffset, alignedSize, to_madvise(advice)) == 0;
+#endif
+    }
+
+#if defined(WIN32)
+    expected<> mapped_file::map(cstring_view path, mapped_file_access access, bool create, usize size)
+    {
+        close();
+
+        wchar_t buf[win32::MaxPath];
+        win32::convert_path(path, buf);
+
+        const bool write = access == mapped_file_access::read_write;
+
+        const HANDLE file = CreateFileW(buf,
+            write ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ,
+            FILE_SHARE_READ,
+            nullptr,
+            create ? CREATE_ALWAYS : OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL,
+            nullptr);
+
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return unspecified_error;
+        }
+
+        LARGE_INTEGER fileSize{};
+
+        if (create)
+        {
+            fileSize.QuadPart = LONGLONG(size);
+
+            if (!SetFilePointerEx(file, fileSize, nullptr, FILE_BEGIN) || !SetEndOfFile(file))
+            {
+                CloseHandle(file);
+                return unspecified_error;
+            }
+        }
+        else if (!GetFileSizeEx(file, &fileSize))
+        {
+            CloseHandle(file);
+            return unspecified_error;
+        }
+
+        m_size = usize(fileSize.QuadPart);
+        m_access = access;
+        m_isOpen = true;
+
+        if (m_size == 0)
+        {
+            // Empty files cannot be mapped, but we consider them successfully opened
+            CloseHandle(file);
+            return no_error;
+        }
+
+        const HANDLE mapping =
+            CreateFileMappingW(file, nullptr, write ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+
+        // The mapping keeps the file alive, and the view keeps the mapping alive
+        CloseHandle(file);
+
+        if (!mapping)
+        {
+            close();
+            return unspecified_error;
+        }
+
+        void* const view = MapViewOfFile(mapping, write ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+
+        if (!view)
+        {
+            close();
+            return unspecified_error;
+        }
+
+        m_data = static_cast<byte*>(view);
+
+        return no_error;
+    }
+
+    void mapped_file::close()
+    {
+        if (m_data)
+        {
+            [[maybe_unused]] const auto success = UnmapViewOfFile(m_data);
+            OBLO_ASSERT(success);
+        }
+
+        m_data = nullptr;
+        m_size = 0;
+        m_isOpen = false;
+    }
+
+    bool mapped_file::flush()
+    {
+        return !m_data || FlushViewOfFile(m_data, 0) != 0;
+    }
+#else
+    expected<> mapped_file::map(cstring_view path, mapped_file_access access, bool create, usize size)
+    {
+        close();
+
+        const bool write = access == mapped_file_access::read_write;
+
+        int flags = write ? O_RDWR : O_RDONLY;
+
+        if (create)
+        {
+            flags |= O_CREAT | O_TRUNC;
+        }
+
+        const int fd = ::open(path.c_str(), flags | O_CLOEXEC, 0644);
+
+        if (fd < 0)
+        {
+            return unspecified_error;
+        }
+
+        if (create)
+        {
+            if (ftruncate(fd, off_t(size)) != 0)
+            {
+                ::close(fd);
+                return unspecified_error;
+            }
+        }
+        else
+        {
+            struct stat st;
+
+            if (fstat(fd, &st) != 0)
+            {
+                ::close(fd);
+                return unspecified_error;
+            }
+
+            size = usize(st.st_size);
+        }
+
+        m_size = size;
+        m_access = access;
+        m_isOpen = true;
+
+        if (m_size == 0)
+        {
+            // Empty files cannot be mapped, but we consider them successfully opened
+            ::close(fd);
+            return no_error;
+        }
+
+        void* const ptr = mmap(nullptr, m_size, write ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+
+        // The mapping keeps a reference to the file, we don't need the descriptor anymore
+        ::close(fd);
+
+        if (ptr == MAP_FAILED)
+        {
+            close();
+            return unspecified_error;
+        }
+
+        m_data = static_cast<byte*>(ptr);
+
+        return no_error;
+    }
+
+    void mapped_file::close()
+    {
+        if (m_data)
+        {
+            [[maybe_unused]] const auto r = munmap(m_data, m_size);
+            OBLO_ASSERT(r == 0);
+        }
+
+        m_data = nullptr;
+        m_size = 0;
+        m_isOpen = false;
+    }
+
+    bool mapped_file::flush()
+    {
+        return !m_data || msync(m_data, m_size, MS_SYNC) == 0;
+    }
+#endif
+}
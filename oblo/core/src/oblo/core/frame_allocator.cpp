@@ -1,28 +1,21 @@
 #include <oblo/core/frame_allocator.hpp>
 
 #include <oblo/core/debug.hpp>
+#include <oblo/core/platform/virtual_memory.hpp>
 #include <oblo/core/utility.hpp>
 
 #include <bit>
 
 namespace oblo
 {
-    namespace
-    {
-        // Could consider reading the actual page size through system calls
-        constexpr auto PageSize{16u << 10};
-
-        void* virtual_memory_allocate(usize size);
-        void virtual_memory_free(void* ptr);
-        bool virtual_memory_commit(void* ptr, usize size);
-        bool virtual_memory_decommit(void* ptr, usize size);
-    }
-
     frame_allocator::frame_allocator(frame_allocator&& other) noexcept
     {
+        std::swap(m_reservation, other.m_reservation);
+        std::swap(m_reservationSize, other.m_reservationSize);
         std::swap(m_virtualMemory, other.m_virtualMemory);
         std::swap(m_end, other.m_end);
         std::swap(m_commitEnd, other.m_commitEnd);
+        std::swap(m_reservedEnd, other.m_reservedEnd);
         std::swap(m_chunkSize, other.m_chunkSize);
     }
 
@@ -31,14 +24,14 @@ namespace oblo
         shutdown();
     }
 
-    bool frame_allocator::init(usize maxSize, usize chunkSize, usize startingChunks)
+    bool frame_allocator::init(usize maxSize, usize chunkSize, usize startingChunks, bool useHugePages)
     {
         if (m_virtualMemory)
         {
             return false;
         }
 
-        if (chunkSize % PageSize != 0)
+        if (chunkSize == 0 || chunkSize % platform::virtual_memory_page_size() != 0)
         {
             return false;
         }
@@ -48,11 +41,28 @@ namespace oblo
             return false;
         }
 
-        m_virtualMemory = static_cast<u8*>(virtual_memory_allocate(maxSize));
+        // Keeping the whole range a multiple of the chunk size simplifies commit and decommit
+        maxSize = round_up_multiple(maxSize, chunkSize);
+
+        // Huge pages can only back aligned ranges, so chunks have to be made of whole huge pages
+        const bool alignToHugePages = useHugePages && chunkSize % platform::HugePageSize == 0;
+
+        platform::virtual_memory_reservation reservation;
+
+        if (!platform::virtual_memory_reserve(maxSize, alignToHugePages, reservation))
+        {
+            return false;
+        }
+
+        m_reservation = static_cast<u8*>(reservation.base);
+        m_reservationSize = reservation.size;
+        m_virtualMemory = static_cast<u8*>(reservation.begin);
+
         m_end = m_virtualMemory;
+        m_reservedEnd = m_virtualMemory + maxSize;
 
         if (const auto initialCommit = chunkSize * startingChunks;
-            m_virtualMemory && startingChunks > 0 && virtual_memory_commit(m_virtualMemory, initialCommit))
+            startingChunks > 0 && platform::virtual_memory_commit(m_virtualMemory, initialCommit))
         {
             m_commitEnd = m_virtualMemory + initialCommit;
         }
@@ -63,15 +73,20 @@ namespace oblo
 
         m_chunkSize = chunkSize;
 
-        return m_virtualMemory != nullptr;
+        return true;
     }
 
     void frame_allocator::shutdown()
     {
-        if (m_virtualMemory)
+        if (m_reservation)
         {
-            virtual_memory_free(m_virtualMemory);
+            platform::virtual_memory_release(m_reservation, m_reservationSize);
+            m_reservation = nullptr;
+            m_reservationSize = 0;
             m_virtualMemory = nullptr;
+            m_end = nullptr;
+            m_commitEnd = nullptr;
+            m_reservedEnd = nullptr;
         }
     }
 
@@ -86,6 +101,11 @@ namespace oblo
         auto* const ptr = m_end + alignmentOffset;
         const auto newEnd = ptr + size;
 
+        if (newEnd > m_reservedEnd)
+        {
+            return nullptr;
+        }
+
         if (newEnd > m_commitEnd)
         {
             const auto prevCommittedSize = get_committed_memory_size();
@@ -99,7 +119,7 @@ namespace oblo
 
             const auto bytesToCommit = (newChunksCount - prevChunksCount) * m_chunkSize;
 
-            if (virtual_memory_commit(m_commitEnd, bytesToCommit))
+            if (platform::virtual_memory_commit(m_commitEnd, bytesToCommit))
             {
                 m_commitEnd += bytesToCommit;
             }
@@ -127,7 +147,8 @@ namespace oblo
         {
             const auto bytesToDecommit = (prevChunksCount - newChunksCount) * m_chunkSize;
 
-            if (const auto newEnd = m_commitEnd - bytesToDecommit; virtual_memory_decommit(newEnd, bytesToDecommit))
+            if (const auto newEnd = m_commitEnd - bytesToDecommit;
+                platform::virtual_memory_decommit(newEnd, bytesToDecommit))
             {
                 m_commitEnd = newEnd;
             }
@@ -160,36 +181,3 @@ namespace oblo
         return ptr >= m_virtualMemory && ptr < m_commitEnd;
     }
 }
-
-#ifdef WIN32
-
-    #include <Windows.h>
-
-namespace oblo
-{
-    namespace
-    {
-        void* virtual_memory_allocate(usize size)
-        {
-            return VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS);
-        }
-
-        void virtual_memory_free(void* ptr)
-        {
-            [[maybe_unused]] const auto success = VirtualFree(ptr, 0, MEM_RELEASE);
-            OBLO_ASSERT(success);
-        }
-
-        bool virtual_memory_commit(void* ptr, usize size)
-        {
-            return VirtualAlloc(ptr, size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
-        }
-
-        bool virtual_memory_decommit(void* ptr, usize size)
-        {
-            return VirtualFree(ptr, size, MEM_DECOMMIT) != FALSE;
-        }
-    }
-}
-
-#endif
\ No newline at end of file
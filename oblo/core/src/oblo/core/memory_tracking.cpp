@@ -0,0 +1,265 @@
+#include <oblo/core/memory_tracking.hpp>
+
+#include <oblo/core/debug.hpp>
+#include <oblo/core/filesystem/file.hpp>
+#include <oblo/core/string/json_string.hpp>
+#include <oblo/core/string/string_builder.hpp>
+#include <oblo/core/utility.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <mutex>
+
+namespace oblo
+{
+    namespace
+    {
+        constexpr u32 MaxTagStackDepth{32};
+
+        struct alignas(64) tag_counters
+        {
+            std::atomic<usize> liveBytes;
+            std::atomic<usize> peakBytes;
+            std::atomic<u64> allocations;
+            std::atomic<u64> deallocations;
+            std::atomic<u64> sizeHistogram[MemoryTagHistogramBuckets];
+            char name[MaxMemoryTagNameLength + 1];
+        };
+
+        // Stored right before the pointer returned to the user
+        struct allocation_header
+        {
+            u32 tag;
+        };
+
+        tag_counters g_tags[MaxMemoryTags]{};
+        std::atomic<u32> g_tagsCount{1};
+        std::mutex g_registrationMutex;
+
+        thread_local memory_tag t_tagStack[MaxTagStackDepth];
+        thread_local u32 t_tagStackDepth{0};
+
+        u32 get_histogram_bucket(usize size)
+        {
+            return min(u32(std::bit_width(size)), MemoryTagHistogramBuckets - 1);
+        }
+
+        usize get_header_size(usize alignment)
+        {
+            // We keep the alignment of the user pointer by reserving a whole alignment unit for the header
+            return max(alignment, alignof(std::max_align_t));
+        }
+
+        void on_allocate(tag_counters& counters, usize size)
+        {
+            const usize live = counters.liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+
+            usize peak = counters.peakBytes.load(std::memory_order_relaxed);
+
+            while (live > peak && !counters.peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+            {
+            }
+
+            counters.allocations.fetch_add(1, std::memory_order_relaxed);
+            counters.sizeHistogram[get_histogram_bucket(size)].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void on_deallocate(tag_counters& counters, usize size)
+        {
+            counters.liveBytes.fetch_sub(size, std::memory_order_relaxed);
+            counters.deallocations.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    memory_tag register_memory_tag(string_view name)
+    {
+        name = name.substr(0, MaxMemoryTagNameLength);
+
+        const std::lock_guard lock{g_registrationMutex};
+
+        const u32 count = g_tagsCount.load(std::memory_order_relaxed);
+
+        for (u32 i = 1; i < count; ++i)
+        {
+            if (string_view{g_tags[i].name} == name)
+            {
+                return memory_tag{i};
+            }
+        }
+
+        if (count == MaxMemoryTags)
+        {
+            return UntaggedMemory;
+        }
+
+        std::memcpy(g_tags[count].name, name.data(), name.size());
+        g_tags[count].name[name.size()] = '\0';
+
+        g_tagsCount.store(count + 1, std::memory_order_release);
+
+        return memory_tag{count};
+    }
+
+    u32 get_memory_tags_count()
+    {
+        return g_tagsCount.load(std::memory_order_acquire);
+    }
+
+    memory_tag get_current_memory_tag()
+    {
+        // The depth keeps counting past the end of the stack, the innermost tags we could store are used in that case
+        const u32 depth = min(t_tagStackDepth, MaxTagStackDepth);
+        return depth == 0 ? UntaggedMemory : t_tagStack[depth - 1];
+    }
+
+    void push_memory_tag(memory_tag tag)
+    {
+        OBLO_ASSERT(t_tagStackDepth < MaxTagStackDepth);
+        OBLO_ASSERT(tag.value < MaxMemoryTags);
+
+        // We keep counting the depth when overflowing, so that push and pop stay balanced
+        if (t_tagStackDepth < MaxTagStackDepth)
+        {
+            t_tagStack[t_tagStackDepth] = tag;
+        }
+
+        ++t_tagStackDepth;
+    }
+
+    void pop_memory_tag()
+    {
+        OBLO_ASSERT(t_tagStackDepth > 0);
+        --t_tagStackDepth;
+    }
+
+    bool get_memory_tag_stats(memory_tag tag, memory_tag_stats& outStats)
+    {
+        if (tag.value >= get_memory_tags_count())
+        {
+            return false;
+        }
+
+        const auto& counters = g_tags[tag.value];
+
+        outStats.name = tag == UntaggedMemory ? string_view{"untagged"} : string_view{counters.name};
+        outStats.liveBytes = counters.liveBytes.load(std::memory_order_relaxed);
+        outStats.peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+        outStats.allocations = counters.allocations.load(std::memory_order_relaxed);
+        outStats.deallocations = counters.deallocations.load(std::memory_order_relaxed);
+
+        for (u32 i = 0; i < MemoryTagHistogramBuckets; ++i)
+        {
+            outStats.sizeHistogram[i] = counters.sizeHistogram[i].load(std::memory_order_relaxed);
+        }
+
+        return true;
+    }
+
+    expected<> dump_memory_tag_stats(cstring_view path)
+    {
+        // The dump itself allocates, so we use a separate tag to avoid polluting the stats of the caller
+        const memory_tag_scope scope{register_memory_tag("memory_tracking")};
+
+        string_builder json;
+        json.append("{\n\t\"tags\": [");
+
+        const u32 count = get_memory_tags_count();
+
+        for (u32 i = 0; i < count; ++i)
+        {
+            memory_tag_stats stats;
+            get_memory_tag_stats(memory_tag{i}, stats);
+
+            json.append(i == 0 ? "\n" : ",\n");
+
+            json.append("\t\t{\"name\": ");
+            append_json_string(json, stats.name);
+
+            json.format(", \"liveBytes\": {}, \"peakBytes\": {}, \"allocations\": {}, \"deallocations\": {}, "
+                        "\"sizeHistogram\": [",
+                stats.liveBytes,
+                stats.peakBytes,
+                stats.allocations,
+                stats.deallocations);
+
+            // Trailing empty buckets are omitted to keep the file readable
+            const auto lastBucket = std::find_if(std::rbegin(stats.sizeHistogram),
+                std::rend(stats.sizeHistogram),
+                [](u64 n) { return n != 0; });
+
+            const auto bucketsCount = u32(std::rend(stats.sizeHistogram) - lastBucket);
+
+            for (u32 b = 0; b < bucketsCount; ++b)
+            {
+                if (b != 0)
+                {
+                    json.append(", ");
+                }
+
+                json.format("{}", stats.sizeHistogram[b]);
+            }
+
+            json.append("]}");
+        }
+
+        json.append("\n\t]\n}\n");
+
+        const filesystem::file_ptr f{filesystem::open_file(path, "w")};
+
+        if (!f || fwrite(json.data(), 1, json.size(), f.get()) != json.size())
+        {
+            return unspecified_error;
+        }
+
+        return no_error;
+    }
+
+    bool is_global_memory_tracking_enabled()
+    {
+#ifdef OBLO_MEMORY_TRACKING
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    byte* tracking_allocator::allocate(usize size, usize alignment) noexcept
+    {
+        const usize headerSize = get_header_size(alignment);
+        byte* const block = m_upstream->allocate(size + headerSize, alignment);
+
+        if (!block)
+        {
+            return nullptr;
+        }
+
+        const memory_tag tag = get_current_memory_tag();
+
+        byte* const ptr = block + headerSize;
+        new (ptr - sizeof(allocation_header)) allocation_header{tag.value};
+
+        on_allocate(g_tags[tag.value], size);
+
+        return ptr;
+    }
+
+    void tracking_allocator::deallocate(byte* ptr, usize size, usize alignment) noexcept
+    {
+        if (!ptr)
+        {
+            return;
+        }
+
+        const usize headerSize = get_header_size(alignment);
+
+        allocation_header header;
+        std::memcpy(&header, ptr - sizeof(allocation_header), sizeof(allocation_header));
+
+        on_deallocate(g_tags[header.tag], size);
+
+        m_upstream->deallocate(ptr - headerSize, size + headerSize, alignment);
+    }
+}
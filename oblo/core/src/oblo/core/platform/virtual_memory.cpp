@@ -0,0 +1,114 @@
+#include <oblo/core/platform/virtual_memory.hpp>
+
+#include <oblo/core/debug.hpp>
+#include <oblo/core/utility.hpp>
+
+#if defined(WIN32)
+    #define NOMINMAX
+    #include <Windows.h>
+#else
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+namespace oblo::platform
+{
+#if defined(WIN32)
+    usize virtual_memory_page_size()
+    {
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return usize(info.dwPageSize);
+    }
+
+    void* virtual_memory_reserve(usize size)
+    {
+        return VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS);
+    }
+
+    void virtual_memory_release(void* ptr, usize)
+    {
+        [[maybe_unused]] const auto success = VirtualFree(ptr, 0, MEM_RELEASE);
+        OBLO_ASSERT(success);
+    }
+
+    bool virtual_memory_commit(void* ptr, usize size)
+    {
+        return VirtualAlloc(ptr, size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+    }
+
+    bool virtual_memory_decommit(void* ptr, usize size)
+    {
+        return VirtualFree(ptr, size, MEM_DECOMMIT) != FALSE;
+    }
+
+    bool virtual_memory_advise_huge_pages(void*, usize)
+    {
+        // Large pages on Windows require privileges and have to be committed upfront, which defeats the purpose
+        return false;
+    }
+#else
+    usize virtual_memory_page_size()
+    {
+        static const usize pageSize = usize(sysconf(_SC_PAGESIZE));
+        return pageSize;
+    }
+
+    void* virtual_memory_reserve(usize size)
+    {
+        void* const ptr = mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        return ptr == MAP_FAILED ? nullptr : ptr;
+    }
+
+    void virtual_memory_release(void* ptr, usize size)
+    {
+        [[maybe_unused]] const auto result = munmap(ptr, size);
+        OBLO_ASSERT(result == 0);
+    }
+
+    bool virtual_memory_commit(void* ptr, usize size)
+    {
+        return mprotect(ptr, size, PROT_READ | PROT_WRITE) == 0;
+    }
+
+    bool virtual_memory_decommit(void* ptr, usize size)
+    {
+        // MADV_DONTNEED drops the pages immediately, accessing them again would give zero-filled pages
+        return madvise(ptr, size, MADV_DONTNEED) == 0 && mprotect(ptr, size, PROT_NONE) == 0;
+    }
+
+    bool virtual_memory_advise_huge_pages([[maybe_unused]] void* ptr, [[maybe_unused]] usize size)
+    {
+    #ifdef MADV_HUGEPAGE
+        return madvise(ptr, size, MADV_HUGEPAGE) == 0;
+    #else
+        return false;
+    #endif
+    }
+#endif
+
+    bool virtual_memory_reserve(usize size, bool useHugePages, virtual_memory_reservation& out)
+    {
+        const usize reservationSize = useHugePages ? size + HugePageSize : size;
+        void* const base = virtual_memory_reserve(reservationSize);
+
+        if (!base)
+        {
+            return false;
+        }
+
+        out.base = base;
+        out.size = reservationSize;
+        out.begin = base;
+
+        if (useHugePages)
+        {
+            out.begin =
+                reinterpret_cast<void*>(round_up_multiple(reinterpret_cast<uintptr>(base), uintptr{HugePageSize}));
+
+            virtual_memory_advise_huge_pages(out.begin, size);
+        }
+
+        return true;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,637 @@
+#include <oblo/core/pool_allocator.hpp>
+
+#include <oblo/core/debug.hpp>
+
+#include <array>
+#include <exception>
+#include <new>
+#include <utility>
+
+namespace oblo
+{
+    namespace
+    {
+        constexpr u32 SizeClassesCount{28};
+
+        constexpr u32 SizeClasses[SizeClassesCount] = {
+            16,
+            32,
+            48,
+            64,
+            80,
+            96,
+            112,
+            128,
+            160,
+            192,
+            224,
+            256,
+            320,
+            384,
+            448,
+            512,
+            640,
+            768,
+            896,
+            1024,
+            1280,
+            1536,
+            1792,
+            2048,
+            2560,
+            3072,
+            3584,
+            4096,
+        };
+
+        static_assert(SizeClasses[SizeClassesCount - 1] == pool_allocator::MaxSize);
+
+        constexpr u32 NoSizeClass{~0u};
+
+        constexpr u32 SizeClassGranularity{16};
+
+        // Slabs are aligned to MaxAlignment, with a header of the same size, so each block is aligned to the largest
+        // power of two that divides the class size
+        constexpr usize SlabHeaderSize{pool_allocator::MaxAlignment};
+
+        constexpr u32 MagazineCapacity{32};
+
+        // Assigns an index to each thread, indices are recycled when threads exit
+        constexpr u32 MaxThreadCaches{128};
+
+        constexpr auto make_size_class_lookup()
+        {
+            std::array<u8, pool_allocator::MaxSize / SizeClassGranularity + 1> lookup{};
+
+            u32 sizeClass = 0;
+
+            for (u32 i = 0; i < lookup.size(); ++i)
+            {
+                while (SizeClasses[sizeClass] < i * SizeClassGranularity)
+                {
+                    ++sizeClass;
+                }
+
+                lookup[i] = u8(sizeClass);
+            }
+
+            return lookup;
+        }
+
+        constexpr auto make_size_class_alignments()
+        {
+            std::array<u32, SizeClassesCount> alignments{};
+
+            for (u32 i = 0; i < SizeClassesCount; ++i)
+            {
+                const u32 size = SizeClasses[i];
+                const u32 lowestBit = size & (~size + 1);
+                constexpr u32 maxAlignment = u32{pool_allocator::MaxAlignment};
+                alignments[i] = lowestBit < maxAlignment ? lowestBit : maxAlignment;
+            }
+
+            return alignments;
+        }
+
+        constexpr auto g_sizeClassLookup = make_size_class_lookup();
+        constexpr auto g_sizeClassAlignments = make_size_class_alignments();
+
+        u32 find_size_class(usize size, usize alignment)
+        {
+            if (size > pool_allocator::MaxSize || alignment > pool_allocator::MaxAlignment)
+            {
+                return NoSizeClass;
+            }
+
+            u32 sizeClass = g_sizeClassLookup[(size + SizeClassGranularity - 1) / SizeClassGranularity];
+
+            // Only a few classes are not aligned to 16 bytes, so we rarely need more than one step
+            while (g_sizeClassAlignments[sizeClass] < alignment)
+            {
+                if (++sizeClass == SizeClassesCount)
+                {
+                    return NoSizeClass;
+                }
+            }
+
+            return sizeClass;
+        }
+
+        class thread_index_registry
+        {
+        public:
+            u32 acquire()
+            {
+                const std::lock_guard lock{m_mutex};
+
+                if (m_freeCount > 0)
+                {
+                    return m_free[--m_freeCount];
+                }
+
+                return m_next < MaxThreadCaches ? m_next++ : MaxThreadCaches;
+            }
+
+            void release(u32 index)
+            {
+                if (index < MaxThreadCaches)
+                {
+                    const std::lock_guard lock{m_mutex};
+                    m_free[m_freeCount++] = index;
+                }
+            }
+
+        private:
+            std::mutex m_mutex;
+            u32 m_next{};
+            u32 m_freeCount{};
+            u32 m_free[MaxThreadCaches];
+        };
+
+        thread_index_registry& get_thread_index_registry()
+        {
+            static thread_index_registry registry;
+            return registry;
+        }
+
+        struct thread_index
+        {
+            thread_index() : value{get_thread_index_registry().acquire()} {}
+
+            ~thread_index()
+            {
+                get_thread_index_registry().release(value);
+
+                // Static objects destroyed after this point fall back to the shared cache
+                value = MaxThreadCaches;
+            }
+
+            u32 value;
+        };
+
+        thread_local thread_index t_threadIndex;
+
+        // Users of the pool, e.g. memory_pool or the job manager, don't handle failures, so running out of memory is
+        // fatal, as it is with the global aligned allocator
+        [[noreturn]] void out_of_memory()
+        {
+            OBLO_ASSERT(false, "The upstream allocator of the pool ran out of memory");
+            std::terminate();
+        }
+    }
+
+    struct pool_allocator::magazine
+    {
+        magazine* next;
+        u32 count;
+        byte* blocks[MagazineCapacity];
+    };
+
+    struct pool_allocator::thread_cache
+    {
+        // The previous magazine is always either full or empty, the loaded one can be partially filled
+        struct size_class_cache
+        {
+            magazine* loaded;
+            magazine* previous;
+        };
+
+        size_class_cache sizeClasses[SizeClassesCount]{};
+
+        // Only written by the owning thread, but read by others when gathering stats
+        std::atomic<u64> allocations[SizeClassesCount]{};
+        std::atomic<u64> deallocations[SizeClassesCount]{};
+    };
+
+    struct alignas(64) pool_allocator::size_class_depot
+    {
+        std::mutex mutex;
+
+        magazine* full{};
+        magazine* empty{};
+
+        // Slabs are linked through their header
+        byte* slabs{};
+        byte* slabCursor{};
+        byte* slabEnd{};
+    };
+
+    namespace
+    {
+        void increment_relaxed(std::atomic<u64>& counter)
+        {
+            // There's a single writer, no need for an atomic read-modify-write
+            counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+    }
+
+    pool_allocator::pool_allocator(allocator* upstream) :
+        m_upstream{upstream}, m_depots{std::make_unique<size_class_depot[]>(SizeClassesCount)},
+        m_threadCaches{std::make_unique<std::atomic<thread_cache*>[]>(MaxThreadCaches)}
+    {
+        m_sharedCache = create_thread_cache();
+    }
+
+    pool_allocator::~pool_allocator()
+    {
+        release_all();
+
+        const auto freeCache = [this](thread_cache* cache)
+        {
+            if (cache)
+            {
+                cache->~thread_cache();
+                m_upstream->deallocate(reinterpret_cast<byte*>(cache), sizeof(thread_cache), alignof(thread_cache));
+            }
+        };
+
+        for (u32 i = 0; i < MaxThreadCaches; ++i)
+        {
+            freeCache(m_threadCaches[i].load(std::memory_order_relaxed));
+        }
+
+        freeCache(m_sharedCache);
+    }
+
+    byte* pool_allocator::allocate(usize size, usize alignment) noexcept
+    {
+        const u32 sizeClass = find_size_class(size, alignment);
+
+        if (sizeClass == NoSizeClass)
+        {
+            byte* const ptr = m_upstream->allocate(size, alignment);
+
+            if (!ptr)
+            {
+                out_of_memory();
+            }
+
+            m_largeBytes.fetch_add(size, std::memory_order_relaxed);
+            m_largeAllocations.fetch_add(1, std::memory_order_relaxed);
+            return ptr;
+        }
+
+        byte* ptr;
+
+        if (thread_cache* const cache = get_thread_cache())
+        {
+            ptr = allocate_from_class(*cache, sizeClass);
+        }
+        else
+        {
+            const std::lock_guard lock{m_sharedCacheMutex};
+            ptr = allocate_from_class(*m_sharedCache, sizeClass);
+        }
+
+        if (!ptr)
+        {
+            out_of_memory();
+        }
+
+        return ptr;
+    }
+
+    void pool_allocator::deallocate(byte* ptr, usize size, usize alignment) noexcept
+    {
+        if (!ptr)
+        {
+            return;
+        }
+
+        const u32 sizeClass = find_size_class(size, alignment);
+
+        if (sizeClass == NoSizeClass)
+        {
+            m_largeBytes.fetch_sub(size, std::memory_order_relaxed);
+            m_largeDeallocations.fetch_add(1, std::memory_order_relaxed);
+            m_upstream->deallocate(ptr, size, alignment);
+            return;
+        }
+
+        if (thread_cache* const cache = get_thread_cache())
+        {
+            deallocate_to_class(*cache, sizeClass, ptr);
+            return;
+        }
+
+        const std::lock_guard lock{m_sharedCacheMutex};
+        deallocate_to_class(*m_sharedCache, sizeClass, ptr);
+    }
+
+    void pool_allocator::release_all()
+    {
+        const auto freeMagazine = [this](magazine* m)
+        { m_upstream->deallocate(reinterpret_cast<byte*>(m), sizeof(magazine), alignof(magazine)); };
+
+        const auto releaseCache = [&freeMagazine](thread_cache* cache)
+        {
+            if (!cache)
+            {
+                return;
+            }
+
+            for (u32 i = 0; i < SizeClassesCount; ++i)
+            {
+                auto& sizeClass = cache->sizeClasses[i];
+
+                if (sizeClass.loaded)
+                {
+                    freeMagazine(sizeClass.loaded);
+                }
+
+                if (sizeClass.previous)
+                {
+                    freeMagazine(sizeClass.previous);
+                }
+
+                sizeClass = {};
+
+                cache->allocations[i].store(0, std::memory_order_relaxed);
+                cache->deallocations[i].store(0, std::memory_order_relaxed);
+            }
+        };
+
+        for (u32 i = 0; i < MaxThreadCaches; ++i)
+        {
+            releaseCache(m_threadCaches[i].load(std::memory_order_relaxed));
+        }
+
+        releaseCache(m_sharedCache);
+
+        for (u32 i = 0; i < SizeClassesCount; ++i)
+        {
+            auto& depot = m_depots[i];
+
+            for (magazine* list : {depot.full, depot.empty})
+            {
+                while (list)
+                {
+                    magazine* const next = list->next;
+                    freeMagazine(list);
+                    list = next;
+                }
+            }
+
+            for (byte* slab = depot.slabs; slab;)
+            {
+                byte* const next = *reinterpret_cast<byte**>(slab);
+                m_upstream->deallocate(slab, SlabSize, MaxAlignment);
+                slab = next;
+            }
+
+            depot.full = nullptr;
+            depot.empty = nullptr;
+            depot.slabs = nullptr;
+            depot.slabCursor = nullptr;
+            depot.slabEnd = nullptr;
+        }
+
+        m_reservedBytes.store(0, std::memory_order_relaxed);
+    }
+
+    pool_allocator_stats pool_allocator::get_stats() const
+    {
+        pool_allocator_stats stats{
+            .reservedBytes = m_reservedBytes.load(std::memory_order_relaxed),
+            .largeBytes = m_largeBytes.load(std::memory_order_relaxed),
+            .allocations = m_largeAllocations.load(std::memory_order_relaxed),
+            .deallocations = m_largeDeallocations.load(std::memory_order_relaxed),
+        };
+
+        u64 allocations[SizeClassesCount]{};
+        u64 deallocations[SizeClassesCount]{};
+
+        const auto gather = [&](const thread_cache* cache)
+        {
+            if (!cache)
+            {
+                return;
+            }
+
+            for (u32 i = 0; i < SizeClassesCount; ++i)
+            {
+                allocations[i] += cache->allocations[i].load(std::memory_order_relaxed);
+                deallocations[i] += cache->deallocations[i].load(std::memory_order_relaxed);
+            }
+        };
+
+        for (u32 i = 0; i < MaxThreadCaches; ++i)
+        {
+            gather(m_threadCaches[i].load(std::memory_order_acquire));
+        }
+
+        gather(m_sharedCache);
+
+        for (u32 i = 0; i < SizeClassesCount; ++i)
+        {
+            // Blocks can be freed by a different thread, so only the sum over all caches is meaningful
+            stats.usedBytes += usize(allocations[i] - deallocations[i]) * SizeClasses[i];
+            stats.allocations += allocations[i];
+            stats.deallocations += deallocations[i];
+        }
+
+        return stats;
+    }
+
+    pool_allocator::thread_cache* pool_allocator::get_thread_cache()
+    {
+        const u32 index = t_threadIndex.value;
+
+        if (index >= MaxThreadCaches)
+        {
+            return nullptr;
+        }
+
+        // Only the thread holding the index can create the cache, so there's no race on creation
+        thread_cache* cache = m_threadCaches[index].load(std::memory_order_acquire);
+
+        if (!cache)
+        {
+            cache = create_thread_cache();
+            m_threadCaches[index].store(cache, std::memory_order_release);
+        }
+
+        return cache;
+    }
+
+    pool_allocator::thread_cache* pool_allocator::create_thread_cache()
+    {
+        byte* const memory = m_upstream->allocate(sizeof(thread_cache), alignof(thread_cache));
+
+        if (!memory)
+        {
+            out_of_memory();
+        }
+
+        return new (memory) thread_cache{};
+    }
+
+    byte* pool_allocator::allocate_from_class(thread_cache& cache, u32 sizeClass)
+    {
+        auto& classCache = cache.sizeClasses[sizeClass];
+
+        if (!classCache.loaded || classCache.loaded->count == 0)
+        {
+            if (classCache.previous && classCache.previous->count > 0)
+            {
+                std::swap(classCache.loaded, classCache.previous);
+            }
+            else
+            {
+                refill(cache, sizeClass);
+
+                if (!classCache.loaded || classCache.loaded->count == 0)
+                {
+                    // The upstream allocator failed
+                    return nullptr;
+                }
+            }
+        }
+
+        increment_relaxed(cache.allocations[sizeClass]);
+
+        magazine* const loaded = classCache.loaded;
+        return loaded->blocks[--loaded->count];
+    }
+
+    void pool_allocator::deallocate_to_class(thread_cache& cache, u32 sizeClass, byte* ptr)
+    {
+        auto& classCache = cache.sizeClasses[sizeClass];
+
+        if (!classCache.loaded || classCache.loaded->count == MagazineCapacity)
+        {
+            if (classCache.previous && classCache.previous->count == 0)
+            {
+                std::swap(classCache.loaded, classCache.previous);
+            }
+            else
+            {
+                flush(cache, sizeClass);
+
+                if (!classCache.loaded)
+                {
+                    // We failed to allocate a magazine, the block is leaked until the pool is released
+                    return;
+                }
+            }
+        }
+
+        increment_relaxed(cache.deallocations[sizeClass]);
+
+        magazine* const loaded = classCache.loaded;
+        loaded->blocks[loaded->count++] = ptr;
+    }
+
+    void pool_allocator::refill(thread_cache& cache, u32 sizeClass)
+    {
+        auto& classCache = cache.sizeClasses[sizeClass];
+        auto& depot = m_depots[sizeClass];
+
+        const std::lock_guard lock{depot.mutex};
+
+        if (magazine* const full = depot.full)
+        {
+            depot.full = full->next;
+
+            // Both magazines are empty at this point, we keep one and give the other back
+            if (classCache.previous)
+            {
+                classCache.previous->next = depot.empty;
+                depot.empty = classCache.previous;
+            }
+
+            classCache.previous = classCache.loaded;
+            classCache.loaded = full;
+
+            return;
+        }
+
+        if (!classCache.loaded)
+        {
+            if (depot.empty)
+            {
+                classCache.loaded = depot.empty;
+                depot.empty = depot.empty->next;
+            }
+            else if (magazine* const m = allocate_magazine())
+            {
+                classCache.loaded = m;
+            }
+            else
+            {
+                return;
+            }
+        }
+
+        // No free blocks anywhere, we carve new ones from the slab
+        const usize blockSize = SizeClasses[sizeClass];
+        magazine* const loaded = classCache.loaded;
+
+        while (loaded->count < MagazineCapacity)
+        {
+            if (usize(depot.slabEnd - depot.slabCursor) < blockSize)
+            {
+                byte* const slab = m_upstream->allocate(SlabSize, MaxAlignment);
+
+                if (!slab)
+                {
+                    break;
+                }
+
+                *reinterpret_cast<byte**>(slab) = depot.slabs;
+                depot.slabs = slab;
+                depot.slabCursor = slab + SlabHeaderSize;
+                depot.slabEnd = slab + SlabSize;
+
+                m_reservedBytes.fetch_add(SlabSize, std::memory_order_relaxed);
+            }
+
+            loaded->blocks[loaded->count++] = depot.slabCursor;
+            depot.slabCursor += blockSize;
+        }
+    }
+
+    void pool_allocator::flush(thread_cache& cache, u32 sizeClass)
+    {
+        auto& classCache = cache.sizeClasses[sizeClass];
+        auto& depot = m_depots[sizeClass];
+
+        const std::lock_guard lock{depot.mutex};
+
+        // The previous magazine is full at this point, otherwise we would have swapped it with the loaded one
+        if (classCache.previous)
+        {
+            OBLO_ASSERT(classCache.previous->count == MagazineCapacity);
+            classCache.previous->next = depot.full;
+            depot.full = classCache.previous;
+        }
+
+        classCache.previous = classCache.loaded;
+
+        if (depot.empty)
+        {
+            classCache.loaded = depot.empty;
+            depot.empty = depot.empty->next;
+        }
+        else
+        {
+            classCache.loaded = allocate_magazine();
+        }
+    }
+
+    pool_allocator::magazine* pool_allocator::allocate_magazine()
+    {
+        byte* const memory = m_upstream->allocate(sizeof(magazine), alignof(magazine));
+
+        if (!memory)
+        {
+            return nullptr;
+        }
+
+        auto* const m = new (memory) magazine;
+        m->next = nullptr;
+        m->count = 0;
+
+        return m;
+    }
+}
\ No newline at end of file
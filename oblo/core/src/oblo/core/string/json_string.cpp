@@ -0,0 +1,48 @@
+#include <oblo/core/string/json_string.hpp>
+
+#include <oblo/core/string/string_builder.hpp>
+
+namespace oblo
+{
+    void append_json_string(string_builder& builder, string_view str)
+    {
+        builder.append('"');
+
+        for (const char c : str)
+        {
+            switch (c)
+            {
+            case '"':
+            case '\\':
+                builder.append('\\').append(c);
+                break;
+
+            case '\n':
+                builder.append("\\n");
+                break;
+
+            case '\r':
+                builder.append("\\r");
+                break;
+
+            case '\t':
+                builder.append("\\t");
+                break;
+
+            default:
+                if (u8(c) < 0x20)
+                {
+                    builder.format("\\u{:04x}", u32(u8(c)));
+                }
+                else
+                {
+                    builder.append(c);
+                }
+
+                break;
+            }
+        }
+
+        builder.append('"');
+    }
+}
\ No newline at end of file
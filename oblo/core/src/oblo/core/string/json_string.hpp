@@ -0,0 +1,11 @@
+#pragma once
+
+#include <oblo/core/string/string_view.hpp>
+
+namespace oblo
+{
+    class string_builder;
+
+    /// @brief Appends the string between quotes, escaping quotes, backslashes and control characters.
+    void append_json_string(string_builder& builder, string_view str);
+}
\ No newline at end of file
@@ -2,9 +2,15 @@
 
 #include <oblo/core/debug.hpp>
 #include <oblo/core/dynamic_array.hpp>
+#include <oblo/core/flat_hash_map.hpp>
 #include <oblo/core/hash.hpp>
+#include <oblo/core/radix_sort.hpp>
+#include <oblo/core/string/hashed_string_view.hpp>
+#include <oblo/core/string/transparent_string_hash.hpp>
 
-#include <unordered_map>
+#include <atomic>
+#include <cstring>
+#include <mutex>
 
 namespace oblo
 {
@@ -16,14 +22,135 @@ namespace oblo
             char buf[Size];
             string_chunk* next;
         };
+
+        constexpr u32 ShardsBits{4};
+        constexpr u32 ShardsCount{1u << ShardsBits};
+
+        // Limits the seed search of each bucket in freeze, which would never end e.g. if two strings share a hash
+        constexpr u32 MaxSeedAttempts{1u << 16};
+
+        constexpr u32 PageBits{12};
+        constexpr u32 PageSize{1u << PageBits};
+        constexpr u32 PageMask{PageSize - 1};
+        constexpr u32 MaxPages{4096};
+
+        // Each shard owns the storage for its strings, so a new string only requires taking the lock of its shard
+        struct alignas(64) string_shard
+        {
+            std::mutex mutex;
+            flat_hash_map<hashed_string_view, u32, transparent_string_hash, transparent_string_equal> sparse;
+            string_chunk* chunks{nullptr};
+            u16 firstFree{string_chunk::Size};
+        };
+
+        // Pages are never moved once published, which is what allows looking up strings without synchronization
+        struct string_page
+        {
+            cstring_view strings[PageSize];
+        };
+
+        // Read-only table built by freeze, using the hash and displace scheme: keys are first distributed in buckets,
+        // then each bucket looks for a seed that places all its keys in free slots
+        struct perfect_hash_table
+        {
+            dynamic_array<u32> seeds;
+            dynamic_array<u32> slots;
+        };
+
+        usize hash_string(string_view str)
+        {
+            return hash<string_view>{}(str);
+        }
+
+        u32 get_shard_index(usize hash)
+        {
+            return u32(hash >> (sizeof(usize) * 8 - ShardsBits));
+        }
+
+        u32 reduce(u64 hash, usize n)
+        {
+            return u32(hash % n);
+        }
+
+        u64 displace(u64 hash, u32 seed)
+        {
+            u64 x = hash ^ (u64{seed} * 0x9e3779b97f4a7c15ull);
+            x ^= x >> 33;
+            x *= 0xff51afd7ed558ccdull;
+            x ^= x >> 33;
+            x *= 0xc4ceb9fe1a85ec53ull;
+            x ^= x >> 33;
+            return x;
+        }
     }
 
     struct string_interner::impl
     {
-        std::unordered_map<string_view, u32, hash<string_view>> sparse;
-        dynamic_array<cstring_view> strings;
-        string_chunk* chunks;
-        u16 firstFree{string_chunk::Size};
+        string_shard shards[ShardsCount];
+        std::atomic<string_page*> pages[MaxPages];
+        std::atomic<u32> nextIndex{1};
+        perfect_hash_table frozen;
+        bool isFrozen{false};
+
+        cstring_view get_string(u32 index) const
+        {
+            const auto* const page = pages[index >> PageBits].load(std::memory_order_acquire);
+            return page->strings[index & PageMask];
+        }
+
+        string_page* ensure_page(u32 pageIndex)
+        {
+            OBLO_ASSERT(pageIndex < MaxPages);
+
+            auto* page = pages[pageIndex].load(std::memory_order_acquire);
+
+            if (!page)
+            {
+                auto* const newPage = new string_page{};
+
+                if (pages[pageIndex].compare_exchange_strong(page,
+                        newPage,
+                        std::memory_order_acq_rel,
+                        std::memory_order_acquire))
+                {
+                    page = newPage;
+                }
+                else
+                {
+                    // Another thread published the page first
+                    delete newPage;
+                }
+            }
+
+            return page;
+        }
+
+        char* allocate_storage(string_shard& shard, usize storageLength)
+        {
+            const auto oldFirstFree = shard.firstFree;
+            const auto newFirstFree = oldFirstFree + storageLength;
+
+            if (newFirstFree > string_chunk::Size)
+            {
+                auto* const newChunk = new string_chunk;
+                newChunk->next = shard.chunks;
+                shard.chunks = newChunk;
+                shard.firstFree = u16(storageLength);
+                return newChunk->buf;
+            }
+
+            shard.firstFree = u16(newFirstFree);
+            return shard.chunks->buf + oldFirstFree;
+        }
+
+        u32 find_frozen(string_view str, usize hash) const
+        {
+            const auto bucket = reduce(hash, frozen.seeds.size());
+            const auto slot = reduce(displace(hash, frozen.seeds[bucket]), frozen.slots.size());
+            const auto index = frozen.slots[slot];
+
+            return index != 0 && get_string(index) == str ? index : 0u;
+        }
     };
 
     string_interner::string_interner(string_interner&& other) noexcept
@@ -49,23 +176,38 @@ namespace oblo
     {
         OBLO_ASSERT(!m_impl);
         m_impl = new impl{};
-        m_impl->sparse.reserve(estimatedStringsCount);
-        m_impl->strings.reserve(estimatedStringsCount);
-        m_impl->chunks = nullptr;
 
-        // This deals with handle 0 being invalid (it will return an empty string)
-        m_impl->strings.emplace_back();
+        for (auto& shard : m_impl->shards)
+        {
+            shard.sparse.reserve(estimatedStringsCount / ShardsCount + 1);
+        }
+
+        // Handle 0 is invalid, it lives in the first page and returns an empty string
+        const u32 pagesCount = (estimatedStringsCount + 1 + PageMask) >> PageBits;
+
+        for (u32 i = 0; i < pagesCount && i < MaxPages; ++i)
+        {
+            m_impl->ensure_page(i);
+        }
     }
 
     void string_interner::shutdown()
     {
         if (m_impl)
         {
-            for (auto* chunk = m_impl->chunks; chunk != nullptr;)
+            for (auto& shard : m_impl->shards)
+            {
+                for (auto* chunk = shard.chunks; chunk != nullptr;)
+                {
+                    auto* next = chunk->next;
+                    delete chunk;
+                    chunk = next;
+                }
+            }
+
+            for (auto& page : m_impl->pages)
             {
-                auto* next = chunk->next;
-                delete chunk;
-                chunk = next;
+                delete page.load(std::memory_order_relaxed);
             }
 
             delete m_impl;
@@ -76,66 +218,214 @@ namespace oblo
     h32<string> string_interner::get_or_add(string_view str)
     {
         OBLO_ASSERT(str.size() <= MaxStringLength);
-        auto& sparse = m_impl->sparse;
-        const auto it = sparse.find(str);
 
-        if (it == sparse.end())
+        const auto h = hash_string(str);
+
+        if (m_impl->isFrozen)
         {
-            auto& strings = m_impl->strings;
-            const auto stringIndex = u32(strings.size());
+            return {m_impl->find_frozen(str, h)};
+        }
 
-            const auto stringLength = str.size();
-            const auto storageLength = stringLength + 1;
+        auto& shard = m_impl->shards[get_shard_index(h)];
 
-            char* newStringPtr;
+        const std::lock_guard lock{shard.mutex};
 
-            const auto oldFirstFree = m_impl->firstFree;
-            const auto newFirstFree = oldFirstFree + storageLength;
+        const auto it = shard.sparse.find(hashed_string_view{str, h});
 
-            if (newFirstFree > string_chunk::Size)
+        if (it != shard.sparse.end())
+        {
+            return {it->second};
+        }
+
+        const auto stringIndex = m_impl->nextIndex.fetch_add(1, std::memory_order_relaxed);
+
+        const auto stringLength = str.size();
+        char* const newStringPtr = m_impl->allocate_storage(shard, stringLength + 1);
+
+        std::memcpy(newStringPtr, str.data(), stringLength);
+        newStringPtr[stringLength] = '\0';
+
+        // The string is written before the handle is published in the map, other threads can only observe the handle
+        // after acquiring the shard lock or through some other synchronization with this thread
+        auto* const page = m_impl->ensure_page(stringIndex >> PageBits);
+        page->strings[stringIndex & PageMask] = cstring_view{newStringPtr, stringLength};
+
+        shard.sparse.emplace(hashed_string_view{string_view{newStringPtr, stringLength}, h}, stringIndex);
+
+        return {stringIndex};
+    }
+
+    h32<string> string_interner::get(string_view str) const
+    {
+        const auto h = hash_string(str);
+
+        if (m_impl->isFrozen)
+        {
+            return {m_impl->find_frozen(str, h)};
+        }
+
+        auto& shard = m_impl->shards[get_shard_index(h)];
+
+        const std::lock_guard lock{shard.mutex};
+
+        const auto it = shard.sparse.find(hashed_string_view{str, h});
+        return {it == shard.sparse.end() ? 0u : it->second};
+    }
+
+    bool string_interner::freeze()
+    {
+        if (m_impl->isFrozen)
+        {
+            return true;
+        }
+
+        const u32 stringsCount = get_strings_count();
+
+        // Roughly 4 keys per bucket and a load factor of 0.8 keep the seed search short
+        const u32 bucketsCount = stringsCount / 4 + 1;
+        const u32 slotsCount = stringsCount + stringsCount / 4 + 1;
+
+        dynamic_array<u64> hashes;
+        hashes.resize(stringsCount + 1);
+
+        // Sort the keys by bucket with a counting sort, we keep the offsets of each bucket in bucketStart
+        dynamic_array<u32> bucketStart;
+        bucketStart.assign(bucketsCount + 1, 0u);
+
+        for (u32 i = 1; i <= stringsCount; ++i)
+        {
+            const auto str = m_impl->get_string(i);
+            hashes[i] = hash_string(string_view{str.data(), str.size()});
+            ++bucketStart[reduce(hashes[i], bucketsCount) + 1];
+        }
+
+        for (u32 b = 0; b < bucketsCount; ++b)
+        {
+            bucketStart[b + 1] += bucketStart[b];
+        }
+
+        dynamic_array<u32> bucketKeys;
+        bucketKeys.resize(stringsCount);
+
+        {
+            dynamic_array<u32> offsets;
+            offsets.assign(bucketStart.begin(), bucketStart.end() - 1);
+
+            for (u32 i = 1; i <= stringsCount; ++i)
             {
-                auto* const newChunk = new string_chunk;
-                newChunk->next = m_impl->chunks;
-                m_impl->chunks = newChunk;
-                m_impl->firstFree = u16(storageLength);
-                newStringPtr = m_impl->chunks->buf;
+                bucketKeys[offsets[reduce(hashes[i], bucketsCount)]++] = i;
             }
-            else
+        }
+
+        // Placing the largest buckets first, while most slots are still free
+        dynamic_array<u32> bucketsOrder;
+        bucketsOrder.resize(bucketsCount);
+
+        {
+            // Sorting by the complement of the size gives descending sizes, the radix sort is stable
+            dynamic_array<u32> bucketsSizeKeys;
+            bucketsSizeKeys.resize(bucketsCount);
+
+            for (u32 b = 0; b < bucketsCount; ++b)
             {
-                newStringPtr = m_impl->chunks->buf + oldFirstFree;
-                m_impl->firstFree = u16(newFirstFree);
+                bucketsOrder[b] = b;
+                bucketsSizeKeys[b] = ~(bucketStart[b + 1] - bucketStart[b]);
             }
 
-            std::memcpy(newStringPtr, str.data(), stringLength);
-            newStringPtr[stringLength] = '\0';
+            radix_sort(std::span<u32>{bucketsSizeKeys}, std::span<u32>{bucketsOrder});
+        }
+
+        auto& frozen = m_impl->frozen;
+        frozen.seeds.assign(bucketsCount, 0u);
+        frozen.slots.assign(slotsCount, 0u);
 
-            strings.emplace_back(newStringPtr, stringLength);
-            m_impl->sparse.emplace(string_view{newStringPtr, stringLength}, stringIndex);
+        dynamic_array<u32> candidateSlots;
 
-            return {stringIndex};
+        for (const u32 b : bucketsOrder)
+        {
+            const u32 begin = bucketStart[b];
+            const u32 end = bucketStart[b + 1];
+
+            if (begin == end)
+            {
+                break;
+            }
+
+            candidateSlots.resize(end - begin);
+
+            bool foundSeed = false;
+
+            for (u32 seed = 1; seed <= MaxSeedAttempts; ++seed)
+            {
+                bool success = true;
+                u32 placed = 0;
+
+                for (; placed < end - begin; ++placed)
+                {
+                    const auto key = bucketKeys[begin + placed];
+                    const auto slot = reduce(displace(hashes[key], seed), slotsCount);
+
+                    if (frozen.slots[slot] != 0)
+                    {
+                        success = false;
+                        break;
+                    }
+
+                    // Tentatively occupy the slot, to detect collisions within the same bucket
+                    frozen.slots[slot] = key;
+                    candidateSlots[placed] = slot;
+                }
+
+                if (success)
+                {
+                    frozen.seeds[b] = seed;
+                    foundSeed = true;
+                    break;
+                }
+
+                for (u32 i = 0; i < placed; ++i)
+                {
+                    frozen.slots[candidateSlots[i]] = 0;
+                }
+            }
+
+            if (!foundSeed)
+            {
+                // We keep the insertion tables, the interner keeps working as if freeze was never called
+                frozen = {};
+                return false;
+            }
         }
-        else
+
+        // The insertion tables are not needed anymore, the string storage is kept alive until shutdown
+        for (auto& shard : m_impl->shards)
         {
-            return {it->second};
+            shard.sparse = {};
         }
+
+        m_impl->isFrozen = true;
+        return true;
     }
 
-    h32<string> string_interner::get(string_view str) const
+    bool string_interner::is_frozen() const
+    {
+        return m_impl->isFrozen;
+    }
+
+    u32 string_interner::get_strings_count() const
     {
-        auto& sparse = m_impl->sparse;
-        const auto it = sparse.find(str);
-        return {it == sparse.end() ? 0u : it->second};
+        return m_impl->nextIndex.load(std::memory_order_acquire) - 1;
     }
 
     cstring_view string_interner::str(h32<string> handle) const
     {
-        OBLO_ASSERT(handle && handle.value < m_impl->strings.size());
-        return m_impl->strings[handle.value];
+        OBLO_ASSERT(handle && handle.value < m_impl->nextIndex.load(std::memory_order_relaxed));
+        return m_impl->get_string(handle.value);
     }
 
     const char* string_interner::c_str(h32<string> handle) const
     {
-        OBLO_ASSERT(handle && handle.value < m_impl->strings.size());
-        return m_impl->strings[handle.value].data();
+        OBLO_ASSERT(handle && handle.value < m_impl->nextIndex.load(std::memory_order_relaxed));
+        return m_impl->get_string(handle.value).data();
     }
 }
\ No newline at end of file
@@ -0,0 +1,386 @@
+#include <oblo/math/batch_transform.hpp>
+
+#include <oblo/core/debug.hpp>
+#include <oblo/math/mat4.hpp>
+#include <oblo/math/simd.hpp>
+#include <oblo/math/transform.hpp>
+
+namespace oblo
+{
+    namespace
+    {
+#if OBLO_MATH_SSE2
+        // Thin wrappers that give operators to the SIMD registers, so that the kernels can be written once for any
+        // width, as if they were operating on scalars
+        struct f32x4
+        {
+            static constexpr u32 width{4};
+
+            __m128 v;
+
+            static f32x4 splat(f32 value)
+            {
+                return {_mm_set1_ps(value)};
+            }
+
+            static f32x4 load(const f32* p)
+            {
+                return {_mm_loadu_ps(p)};
+            }
+
+            friend f32x4 operator+(f32x4 lhs, f32x4 rhs)
+            {
+                return {_mm_add_ps(lhs.v, rhs.v)};
+            }
+
+            friend f32x4 operator-(f32x4 lhs, f32x4 rhs)
+            {
+                return {_mm_sub_ps(lhs.v, rhs.v)};
+            }
+
+            friend f32x4 operator*(f32x4 lhs, f32x4 rhs)
+            {
+                return {_mm_mul_ps(lhs.v, rhs.v)};
+            }
+
+            friend f32x4 operator*(f32 lhs, f32x4 rhs)
+            {
+                return {_mm_mul_ps(_mm_set1_ps(lhs), rhs.v)};
+            }
+
+            friend f32x4 operator-(f32 lhs, f32x4 rhs)
+            {
+                return {_mm_sub_ps(_mm_set1_ps(lhs), rhs.v)};
+            }
+
+            friend f32x4 operator-(f32x4 v)
+            {
+                return {_mm_xor_ps(v.v, _mm_set1_ps(-0.f))};
+            }
+
+            friend f32x4 operator/(f32 lhs, f32x4 rhs)
+            {
+                return {_mm_div_ps(_mm_set1_ps(lhs), rhs.v)};
+            }
+
+        };
+
+        // Transposes 4 registers holding one element of 4 different matrices into 4 columns, and stores them
+        void store_columns(f32x4 x, f32x4 y, f32x4 z, f32x4 w, mat4* out, u32 column)
+        {
+            _MM_TRANSPOSE4_PS(x.v, y.v, z.v, w.v);
+            _mm_storeu_ps(&out[0].columns[column].x, x.v);
+            _mm_storeu_ps(&out[1].columns[column].x, y.v);
+            _mm_storeu_ps(&out[2].columns[column].x, z.v);
+            _mm_storeu_ps(&out[3].columns[column].x, w.v);
+        }
+
+        void load_column(const mat4* in, u32 column, f32x4& x, f32x4& y, f32x4& z, f32x4& w)
+        {
+            x.v = _mm_loadu_ps(&in[0].columns[column].x);
+            y.v = _mm_loadu_ps(&in[1].columns[column].x);
+            z.v = _mm_loadu_ps(&in[2].columns[column].x);
+            w.v = _mm_loadu_ps(&in[3].columns[column].x);
+            _MM_TRANSPOSE4_PS(x.v, y.v, z.v, w.v);
+        }
+#endif
+
+#if OBLO_MATH_AVX2
+        struct f32x8
+        {
+            static constexpr u32 width{8};
+
+            __m256 v;
+
+            static f32x8 splat(f32 value)
+            {
+                return {_mm256_set1_ps(value)};
+            }
+
+            static f32x8 load(const f32* p)
+            {
+                return {_mm256_loadu_ps(p)};
+            }
+
+            friend f32x8 operator+(f32x8 lhs, f32x8 rhs)
+            {
+                return {_mm256_add_ps(lhs.v, rhs.v)};
+            }
+
+            friend f32x8 operator-(f32x8 lhs, f32x8 rhs)
+            {
+                return {_mm256_sub_ps(lhs.v, rhs.v)};
+            }
+
+            friend f32x8 operator*(f32x8 lhs, f32x8 rhs)
+            {
+                return {_mm256_mul_ps(lhs.v, rhs.v)};
+            }
+
+            friend f32x8 operator*(f32 lhs, f32x8 rhs)
+            {
+                return {_mm256_mul_ps(_mm256_set1_ps(lhs), rhs.v)};
+            }
+
+            friend f32x8 operator-(f32 lhs, f32x8 rhs)
+            {
+                return {_mm256_sub_ps(_mm256_set1_ps(lhs), rhs.v)};
+            }
+
+            friend f32x8 operator-(f32x8 v)
+            {
+                return {_mm256_xor_ps(v.v, _mm256_set1_ps(-0.f))};
+            }
+
+            friend f32x8 operator/(f32 lhs, f32x8 rhs)
+            {
+                return {_mm256_div_ps(_mm256_set1_ps(lhs), rhs.v)};
+            }
+
+            static f32x8 select_abs_greater(f32x8 v, f32 threshold, f32x8 a, f32x8 b)
+            {
+                const __m256 abs = _mm256_andnot_ps(_mm256_set1_ps(-0.f), v.v);
+                const __m256 mask = _mm256_cmp_ps(abs, _mm256_set1_ps(threshold), _CMP_GT_OQ);
+                return {_mm256_blendv_ps(b.v, a.v, mask)};
+            }
+
+            f32x4 low() const
+            {
+                return {_mm256_castps256_ps128(v)};
+            }
+
+            f32x4 high() const
+            {
+                return {_mm256_extractf128_ps(v, 1)};
+            }
+
+            static f32x8 combine(f32x4 lo, f32x4 hi)
+            {
+                return {_mm256_insertf128_ps(_mm256_castps128_ps256(lo.v), hi.v, 1)};
+            }
+        };
+
+        // The 8-wide version works on two groups of 4 matrices, to reuse the 4x4 transposition
+        void store_columns(f32x8 x, f32x8 y, f32x8 z, f32x8 w, mat4* out, u32 column)
+        {
+            store_columns(x.low(), y.low(), z.low(), w.low(), out, column);
+            store_columns(x.high(), y.high(), z.high(), w.high(), out + 4, column);
+        }
+
+        void load_column(const mat4* in, u32 column, f32x8& x, f32x8& y, f32x8& z, f32x8& w)
+        {
+            f32x4 lo[4], hi[4];
+            load_column(in, column, lo[0], lo[1], lo[2], lo[3]);
+            load_column(in + 4, column, hi[0], hi[1], hi[2], hi[3]);
+
+            x = f32x8::combine(lo[0], hi[0]);
+            y = f32x8::combine(lo[1], hi[1]);
+            z = f32x8::combine(lo[2], hi[2]);
+            w = f32x8::combine(lo[3], hi[3]);
+        }
+#endif
+
+#if OBLO_MATH_SSE2
+        template <typename V>
+        void make_transform_matrices_kernel(
+            vec3_soa_view positions, quaternion_soa_view rotations, vec3_soa_view scales, mat4* out, u32 offset)
+        {
+            const V px = V::load(positions.x + offset);
+            const V py = V::load(positions.y + offset);
+            const V pz = V::load(positions.z + offset);
+
+            const V rx = V::load(rotations.x + offset);
+            const V ry = V::load(rotations.y + offset);
+            const V rz = V::load(rotations.z + offset);
+            const V rw = V::load(rotations.w + offset);
+
+            const V sx = V::load(scales.x + offset);
+            const V sy = V::load(scales.y + offset);
+            const V sz = V::load(scales.z + offset);
+
+            const V rx2 = rx * rx;
+            const V ry2 = ry * ry;
+            const V rz2 = rz * rz;
+
+            const V xy = 2.f * (rx * ry);
+            const V xz = 2.f * (rx * rz);
+            const V yz = 2.f * (ry * rz);
+            const V xw = 2.f * (rx * rw);
+            const V yw = 2.f * (ry * rw);
+            const V zw = 2.f * (rz * rw);
+
+            const V zero = V::splat(0.f);
+            const V one = V::splat(1.f);
+
+            mat4* const dst = out + offset;
+
+            store_columns(sx * (1.f - 2.f * ry2 - 2.f * rz2), sx * (xy + zw), sx * (xz - yw), zero, dst, 0);
+            store_columns(sy * (xy - zw), sy * (1.f - 2.f * rx2 - 2.f * rz2), sy * (yz + xw), zero, dst, 1);
+            store_columns(sz * (xz + yw), sz * (yz - xw), sz * (1.f - 2.f * rx2 - 2.f * ry2), zero, dst, 2);
+            store_columns(px, py, pz, one, dst, 3);
+        }
+#endif
+
+#if OBLO_MATH_AVX2
+        // With 8 lanes the cofactor expansion is faster than inverting one matrix at a time with the block method
+        template <typename V>
+        void inverse_transpose_kernel(const mat4* in, mat4* out)
+        {
+            // m[j * 4 + i] holds the element at row i and column j for each lane
+            V m[16];
+
+            for (u32 j = 0; j < 4; ++j)
+            {
+                load_column(in, j, m[j * 4 + 0], m[j * 4 + 1], m[j * 4 + 2], m[j * 4 + 3]);
+            }
+
+            V inv[16];
+
+            // Same cofactor expansion as the scalar inverse
+            inv[0] = m[5] * m[10] * m[15] - m[5] * m[14] * m[11] -
+                m[6] * m[9] * m[15] + m[6] * m[13] * m[11] +
+                m[7] * m[9] * m[14] - m[7] * m[13] * m[10];
+
+            inv[1] = -m[1] * m[10] * m[15] + m[1] * m[14] * m[11] +
+                m[2] * m[9] * m[15] - m[2] * m[13] * m[11] -
+                m[3] * m[9] * m[14] + m[3] * m[13] * m[10];
+
+            inv[2] = m[1] * m[6] * m[15] - m[1] * m[14] * m[7] -
+                m[2] * m[5] * m[15] + m[2] * m[13] * m[7] +
+                m[3] * m[5] * m[14] - m[3] * m[13] * m[6];
+
+            inv[3] = -m[1] * m[6] * m[11] + m[1] * m[10] * m[7] +
+                m[2] * m[5] * m[11] - m[2] * m[9] * m[7] -
+                m[3] * m[5] * m[10] + m[3] * m[9] * m[6];
+
+            inv[4] = -m[4] * m[10] * m[15] + m[4] * m[14] * m[11] +
+                m[6] * m[8] * m[15] - m[6] * m[12] * m[11] -
+                m[7] * m[8] * m[14] + m[7] * m[12] * m[10];
+
+            inv[5] = m[0] * m[10] * m[15] - m[0] * m[14] * m[11] -
+                m[2] * m[8] * m[15] + m[2] * m[12] * m[11] +
+                m[3] * m[8] * m[14] - m[3] * m[12] * m[10];
+
+            inv[6] = -m[0] * m[6] * m[15] + m[0] * m[14] * m[7] +
+                m[2] * m[4] * m[15] - m[2] * m[12] * m[7] -
+                m[3] * m[4] * m[14] + m[3] * m[12] * m[6];
+
+            inv[7] = m[0] * m[6] * m[11] - m[0] * m[10] * m[7] -
+                m[2] * m[4] * m[11] + m[2] * m[8] * m[7] +
+                m[3] * m[4] * m[10] - m[3] * m[8] * m[6];
+
+            inv[8] = m[4] * m[9] * m[15] - m[4] * m[13] * m[11] -
+                m[5] * m[8] * m[15] + m[5] * m[12] * m[11] +
+                m[7] * m[8] * m[13] - m[7] * m[12] * m[9];
+
+            inv[9] = -m[0] * m[9] * m[15] + m[0] * m[13] * m[11] +
+                m[1] * m[8] * m[15] - m[1] * m[12] * m[11] -
+                m[3] * m[8] * m[13] + m[3] * m[12] * m[9];
+
+            inv[10] = m[0] * m[5] * m[15] - m[0] * m[13] * m[7] -
+                m[1] * m[4] * m[15] + m[1] * m[12] * m[7] +
+                m[3] * m[4] * m[13] - m[3] * m[12] * m[5];
+
+            inv[11] = -m[0] * m[5] * m[11] + m[0] * m[9] * m[7] +
+                m[1] * m[4] * m[11] - m[1] * m[8] * m[7] -
+                m[3] * m[4] * m[9] + m[3] * m[8] * m[5];
+
+            inv[12] = -m[4] * m[9] * m[14] + m[4] * m[13] * m[10] +
+                m[5] * m[8] * m[14] - m[5] * m[12] * m[10] -
+                m[6] * m[8] * m[13] + m[6] * m[12] * m[9];
+
+            inv[13] = m[0] * m[9] * m[14] - m[0] * m[13] * m[10] -
+                m[1] * m[8] * m[14] + m[1] * m[12] * m[10] +
+                m[2] * m[8] * m[13] - m[2] * m[12] * m[9];
+
+            inv[14] = -m[0] * m[5] * m[14] + m[0] * m[13] * m[6] +
+                m[1] * m[4] * m[14] - m[1] * m[12] * m[6] -
+                m[2] * m[4] * m[13] + m[2] * m[12] * m[5];
+
+            inv[15] = m[0] * m[5] * m[10] - m[0] * m[9] * m[6] -
+                m[1] * m[4] * m[10] + m[1] * m[8] * m[6] +
+                m[2] * m[4] * m[9] - m[2] * m[8] * m[5];
+
+            const V det = m[0] * inv[0] + m[4] * inv[1] + m[8] * inv[2] + m[12] * inv[3];
+            const V invDet = 1.f / det;
+
+            const V zero = V::splat(0.f);
+            const V one = V::splat(1.f);
+
+            // Storing row j of the inverse as column j, which gives the transpose
+            for (u32 j = 0; j < 4; ++j)
+            {
+                V r[4];
+
+                for (u32 i = 0; i < 4; ++i)
+                {
+                    r[i] = V::select_abs_greater(det, epsilon, inv[i * 4 + j] * invDet, i == j ? one : zero);
+                }
+
+                store_columns(r[0], r[1], r[2], r[3], out, j);
+            }
+        }
+#endif
+    }
+
+    void make_transform_matrices(
+        vec3_soa_view positions, quaternion_soa_view rotations, vec3_soa_view scales, std::span<mat4> out)
+    {
+        const u32 count = u32(out.size());
+        u32 i = 0;
+
+#if OBLO_MATH_AVX2
+        for (; i + f32x8::width <= count; i += f32x8::width)
+        {
+            make_transform_matrices_kernel<f32x8>(positions, rotations, scales, out.data(), i);
+        }
+#endif
+
+#if OBLO_MATH_SSE2
+        for (; i + f32x4::width <= count; i += f32x4::width)
+        {
+            make_transform_matrices_kernel<f32x4>(positions, rotations, scales, out.data(), i);
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+            out[i] = make_transform_matrix({positions.x[i], positions.y[i], positions.z[i]},
+                {rotations.x[i], rotations.y[i], rotations.z[i], rotations.w[i]},
+                {scales.x[i], scales.y[i], scales.z[i]});
+        }
+    }
+
+    void inverse_transpose(std::span<const mat4> matrices, std::span<mat4> out)
+    {
+        OBLO_ASSERT(matrices.size() == out.size());
+
+        const u32 count = u32(out.size());
+        u32 i = 0;
+
+#if OBLO_MATH_AVX2
+        for (; i + f32x8::width <= count; i += f32x8::width)
+        {
+            inverse_transpose_kernel<f32x8>(matrices.data() + i, out.data() + i);
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+#if OBLO_MATH_SSE2
+            // Since inverse(transpose(m)) = transpose(inverse(m)), we can transpose first and skip the second shuffle
+            mat4 t;
+            detail::mat4_transpose_sse(matrices[i], t);
+
+            const f32 det = detail::mat4_inverse_sse(t, out[i]);
+
+            if (det <= epsilon && det >= -epsilon)
+            {
+                out[i] = mat4::identity();
+            }
+#else
+            out[i] = transpose(inverse(matrices[i]).value_or(mat4::identity()));
+#endif
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,465 @@
+#include <oblo/trace/profiler.hpp>
+
+#include <oblo/core/filesystem/file.hpp>
+#include <oblo/core/string/json_string.hpp>
+#include <oblo/core/string/string_builder.hpp>
+#include <oblo/core/utility.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+namespace oblo::trace
+{
+    namespace
+    {
+        constexpr u32 EventsPerBlock{4096};
+
+        // Caps the memory used by each thread to about 6 MB, events are dropped once it's reached
+        constexpr u32 MaxBlocksPerThread{64};
+
+        constexpr u32 MaxThreadNameLength{63};
+
+        // Flushing the JSON to file once in a while, to avoid keeping huge strings in memory
+        constexpr usize ChromeTraceFlushSize{1u << 20};
+
+        struct event
+        {
+            const zone_source* source;
+            u64 begin;
+            u64 end;
+        };
+
+        struct event_block
+        {
+            event events[EventsPerBlock];
+            std::atomic<u32> count{};
+            std::atomic<event_block*> next{};
+        };
+
+        // Only the owning thread writes events, readers can walk the blocks concurrently, reading the events up to the
+        // published count of each block. Blocks are never freed, the writer resets them when a new capture starts.
+        // When a thread exits its buffer is handed over to the next thread that records events, keeping the events of
+        // the current capture, so the memory is bound by the number of threads alive at the same time.
+        struct thread_buffer
+        {
+            u32 threadId;
+            std::atomic<u32> generation;
+            std::atomic<u64> droppedEvents;
+
+            event_block* first;
+            event_block* current;
+            u32 blocksCount;
+
+            char name[MaxThreadNameLength + 1];
+        };
+
+        constinit zone_source g_frameSource{"frame"};
+
+        // Protects the list of buffers, and serializes starting a capture with reading it
+        std::mutex g_mutex;
+        dynamic_array<thread_buffer*> g_buffers;
+        dynamic_array<thread_buffer*> g_freeBuffers;
+
+        std::atomic<u32> g_generation{0};
+        u64 g_captureBegin{0};
+
+        thread_local thread_buffer* t_buffer{};
+        thread_local bool t_hasExited{};
+
+        // Gives the buffer back when the thread exits, it's kept separate from t_buffer so that recording events
+        // doesn't pay for the initialization check of a thread_local with a destructor
+        struct thread_buffer_release
+        {
+            thread_buffer* buffer{};
+
+            ~thread_buffer_release()
+            {
+                if (buffer)
+                {
+                    const std::lock_guard lock{g_mutex};
+                    g_freeBuffers.push_back(buffer);
+                }
+
+                // Scopes closed by the destructors of other thread_local objects are dropped from now on
+                t_buffer = nullptr;
+                t_hasExited = true;
+            }
+        };
+
+        thread_local thread_buffer_release t_bufferRelease;
+
+        thread_buffer* get_thread_buffer()
+        {
+            if (!t_buffer && !t_hasExited)
+            {
+                thread_buffer* buffer;
+
+                {
+                    const std::lock_guard lock{g_mutex};
+
+                    if (!g_freeBuffers.empty())
+                    {
+                        buffer = g_freeBuffers.back();
+                        g_freeBuffers.pop_back();
+
+                        // The events of the previous thread are kept until the next capture, only the name is reset
+                        buffer->name[0] = '\0';
+                    }
+                    else
+                    {
+                        buffer = new thread_buffer{};
+                        buffer->first = new event_block;
+                        buffer->current = buffer->first;
+                        buffer->blocksCount = 1;
+
+                        buffer->threadId = u32(g_buffers.size());
+                        buffer->generation.store(g_generation.load(std::memory_order_relaxed),
+                            std::memory_order_relaxed);
+                        g_buffers.push_back(buffer);
+                    }
+                }
+
+                t_buffer = buffer;
+                t_bufferRelease.buffer = buffer;
+            }
+
+            return t_buffer;
+        }
+
+        void reset_buffer(thread_buffer& buffer, u32 generation)
+        {
+            for (event_block* block = buffer.first; block; block = block->next.load(std::memory_order_relaxed))
+            {
+                block->count.store(0, std::memory_order_relaxed);
+            }
+
+            buffer.current = buffer.first;
+            buffer.droppedEvents.store(0, std::memory_order_relaxed);
+
+            // Readers check the generation first, so they never see the events of the previous capture
+            buffer.generation.store(generation, std::memory_order_release);
+        }
+
+        void append_event(const event& e)
+        {
+            thread_buffer* const bufferPtr = get_thread_buffer();
+
+            if (!bufferPtr)
+            {
+                return;
+            }
+
+            thread_buffer& buffer = *bufferPtr;
+
+            const u32 generation = g_generation.load(std::memory_order_acquire);
+
+            if (buffer.generation.load(std::memory_order_relaxed) != generation)
+            {
+                reset_buffer(buffer, generation);
+            }
+
+            event_block* block = buffer.current;
+            u32 count = block->count.load(std::memory_order_relaxed);
+
+            if (count == EventsPerBlock)
+            {
+                event_block* next = block->next.load(std::memory_order_relaxed);
+
+                if (!next)
+                {
+                    if (buffer.blocksCount == MaxBlocksPerThread)
+                    {
+                        const u64 dropped = buffer.droppedEvents.load(std::memory_order_relaxed);
+                        buffer.droppedEvents.store(dropped + 1, std::memory_order_relaxed);
+                        return;
+                    }
+
+                    next = new event_block;
+                    ++buffer.blocksCount;
+                    block->next.store(next, std::memory_order_release);
+                }
+
+                buffer.current = next;
+                block = next;
+                count = 0;
+            }
+
+            block->events[count] = e;
+            block->count.store(count + 1, std::memory_order_release);
+        }
+
+        // Calls the function for each event of the current capture, it has to be called while holding the mutex
+        template <typename F>
+        void for_each_event(F&& f)
+        {
+            const u32 generation = g_generation.load(std::memory_order_relaxed);
+
+            for (thread_buffer* const buffer : g_buffers)
+            {
+                if (buffer->generation.load(std::memory_order_acquire) != generation)
+                {
+                    continue;
+                }
+
+                for (event_block* block = buffer->first; block; block = block->next.load(std::memory_order_acquire))
+                {
+                    const u32 count = block->count.load(std::memory_order_acquire);
+
+                    for (u32 i = 0; i < count; ++i)
+                    {
+                        f(*buffer, block->events[i]);
+                    }
+
+                    if (count < EventsPerBlock)
+                    {
+                        break;
+                    }
+                }
+            }
+        }
+
+        f64 to_milliseconds(u64 ns)
+        {
+            return f64(ns) * 1e-6;
+        }
+
+        f64 to_microseconds(u64 ns)
+        {
+            return f64(ns) * 1e-3;
+        }
+
+        f64 to_trace_time(u64 timestamp)
+        {
+            // Zones entered before the capture started have a negative time, which is fine for the viewers
+            return f64(i64(timestamp - g_captureBegin)) * 1e-3;
+        }
+
+        bool flush(string_builder& json, FILE* f)
+        {
+            const bool success = fwrite(json.data(), 1, json.size(), f) == json.size();
+            json.clear();
+            return success;
+        }
+    }
+
+    namespace detail
+    {
+        constinit std::atomic<bool> g_isCapturing{false};
+
+        u64 get_timestamp() noexcept
+        {
+            const auto now = std::chrono::steady_clock::now().time_since_epoch();
+            return u64(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+        }
+
+        void record_zone(const zone_source* source, u64 begin, u64 end) noexcept
+        {
+            append_event({source, begin, end});
+        }
+    }
+
+    void start_capture()
+    {
+        const std::lock_guard lock{g_mutex};
+
+        g_captureBegin = detail::get_timestamp();
+        g_generation.fetch_add(1, std::memory_order_release);
+
+        detail::g_isCapturing.store(true, std::memory_order_relaxed);
+    }
+
+    void stop_capture()
+    {
+        detail::g_isCapturing.store(false, std::memory_order_relaxed);
+    }
+
+    void mark_frame_end()
+    {
+        if (is_capturing())
+        {
+            const u64 now = detail::get_timestamp();
+            append_event({&g_frameSource, now, now});
+        }
+    }
+
+    void set_thread_name(string_view name)
+    {
+        thread_buffer* const buffer = get_thread_buffer();
+
+        if (!buffer)
+        {
+            return;
+        }
+
+        const usize length = min(name.size(), usize{MaxThreadNameLength});
+
+        // Readers might see a partially updated name, which is acceptable since names are usually set at startup
+        std::memcpy(buffer->name, name.data(), length);
+        buffer->name[length] = '\0';
+    }
+
+    capture_info get_capture_info()
+    {
+        const std::lock_guard lock{g_mutex};
+
+        capture_info info{};
+
+        const u32 generation = g_generation.load(std::memory_order_relaxed);
+
+        for (thread_buffer* const buffer : g_buffers)
+        {
+            if (buffer->generation.load(std::memory_order_acquire) == generation)
+            {
+                ++info.threadsCount;
+                info.droppedEventsCount += buffer->droppedEvents.load(std::memory_order_relaxed);
+            }
+        }
+
+        for_each_event(
+            [&info](const thread_buffer&, const event& e)
+            {
+                if (e.source == &g_frameSource)
+                {
+                    ++info.framesCount;
+                }
+                else
+                {
+                    ++info.eventsCount;
+                }
+            });
+
+        return info;
+    }
+
+    void get_zone_stats(dynamic_array<zone_stats>& out)
+    {
+        out.clear();
+
+        std::unordered_map<const zone_source*, dynamic_array<u64>> durations;
+
+        {
+            const std::lock_guard lock{g_mutex};
+
+            for_each_event(
+                [&durations](const thread_buffer&, const event& e)
+                {
+                    if (e.source != &g_frameSource)
+                    {
+                        durations[e.source].push_back(e.end - e.begin);
+                    }
+                });
+        }
+
+        out.reserve(durations.size());
+
+        for (auto& [source, values] : durations)
+        {
+            u64 total = 0;
+            u64 maxDuration = 0;
+
+            for (const u64 d : values)
+            {
+                total += d;
+                maxDuration = oblo::max(maxDuration, d);
+            }
+
+            // Nearest-rank percentile
+            const usize p99Rank = (values.size() * 99 + 99) / 100 - 1;
+            std::nth_element(values.begin(), values.begin() + p99Rank, values.end());
+
+            out.push_back({
+                .source = source,
+                .count = values.size(),
+                .totalMs = to_milliseconds(total),
+                .meanMs = to_milliseconds(total) / f64(values.size()),
+                .p99Ms = to_milliseconds(values[p99Rank]),
+                .maxMs = to_milliseconds(maxDuration),
+            });
+        }
+
+        std::sort(out.begin(),
+            out.end(),
+            [](const zone_stats& lhs, const zone_stats& rhs) { return lhs.totalMs > rhs.totalMs; });
+    }
+
+    expected<> dump_chrome_trace(cstring_view path)
+    {
+        const filesystem::file_ptr f{filesystem::open_file(path, "w")};
+
+        if (!f)
+        {
+            return unspecified_error;
+        }
+
+        string_builder json;
+        json.append("{\"displayTimeUnit\": \"ms\", \"traceEvents\": [");
+
+        bool success = true;
+        bool first = true;
+
+        const auto nextEvent = [&]
+        {
+            json.append(first ? "\n" : ",\n");
+            first = false;
+        };
+
+        const std::lock_guard lock{g_mutex};
+
+        const u32 generation = g_generation.load(std::memory_order_relaxed);
+
+        for (thread_buffer* const buffer : g_buffers)
+        {
+            if (buffer->generation.load(std::memory_order_acquire) != generation || buffer->name[0] == '\0')
+            {
+                continue;
+            }
+
+            nextEvent();
+            json.format(R"({{"ph": "M", "pid": 0, "tid": {}, "name": "thread_name", "args": {{"name": )",
+                buffer->threadId);
+            append_json_string(json, buffer->name);
+            json.append("}}");
+        }
+
+        for_each_event(
+            [&](const thread_buffer& buffer, const event& e)
+            {
+                nextEvent();
+
+                if (e.source == &g_frameSource)
+                {
+                    json.format(R"({{"ph": "i", "s": "g", "pid": 0, "tid": {}, "ts": {:.3f}, "name": "frame"}})",
+                        buffer.threadId,
+                        to_trace_time(e.begin));
+                }
+                else
+                {
+                    json.format(R"({{"ph": "X", "pid": 0, "tid": {}, "ts": {:.3f}, "dur": {:.3f}, "name": )",
+                        buffer.threadId,
+                        to_trace_time(e.begin),
+                        to_microseconds(e.end - e.begin));
+
+                    append_json_string(json, e.source->name);
+                    json.append('}');
+                }
+
+                if (json.size() >= ChromeTraceFlushSize)
+                {
+                    success &= flush(json, f.get());
+                }
+            });
+
+        json.append("\n]}\n");
+        success &= flush(json, f.get());
+
+        if (!success)
+        {
+            return unspecified_error;
+        }
+
+        return no_error;
+    }
+}
\ No newline at end of file
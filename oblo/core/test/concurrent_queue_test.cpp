@@ -0,0 +1,220 @@
+#include <gtest/gtest.h>
+
+#include <oblo/core/mpsc_linked_queue.hpp>
+#include <oblo/core/mpsc_queue.hpp>
+#include <oblo/core/spsc_queue.hpp>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace oblo
+{
+    namespace
+    {
+        constexpr u32 ProducersCount{4};
+        constexpr u32 ElementsPerProducer{1u << 16};
+
+        struct message
+        {
+            u32 producer;
+            u32 sequence;
+        };
+
+        // Checks that no element is lost or duplicated, and that each producer's elements come in order
+        template <typename Pop>
+        void consume_and_check(u32 producersCount, Pop&& pop)
+        {
+            std::vector<u32> next(producersCount, 0);
+            u32 received = 0;
+
+            while (received != producersCount * ElementsPerProducer)
+            {
+                message m;
+
+                if (!pop(m))
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                ASSERT_LT(m.producer, producersCount);
+                ASSERT_EQ(next[m.producer], m.sequence);
+
+                ++next[m.producer];
+                ++received;
+            }
+
+            for (const auto n : next)
+            {
+                ASSERT_EQ(n, ElementsPerProducer);
+            }
+        }
+    }
+
+    TEST(spsc_queue, basic)
+    {
+        spsc_queue<std::unique_ptr<u32>> queue{3};
+
+        ASSERT_EQ(queue.capacity(), 4);
+        ASSERT_TRUE(queue.empty_approx());
+
+        std::unique_ptr<u32> out;
+        ASSERT_FALSE(queue.try_pop(out));
+
+        for (u32 i = 0; i < 4; ++i)
+        {
+            ASSERT_TRUE(queue.try_push(std::make_unique<u32>(i)));
+        }
+
+        auto rejected = std::make_unique<u32>(42);
+        ASSERT_FALSE(queue.try_push(std::move(rejected)));
+
+        // The element is left untouched when the queue is full
+        ASSERT_TRUE(rejected);
+
+        for (u32 i = 0; i < 3; ++i)
+        {
+            ASSERT_TRUE(queue.try_pop(out));
+            ASSERT_EQ(*out, i);
+        }
+
+        // Wrapping around, the last element left is destroyed by the queue
+        ASSERT_TRUE(queue.try_emplace(std::make_unique<u32>(4)));
+        ASSERT_EQ(queue.size_approx(), 2);
+    }
+
+    TEST(spsc_queue, concurrent)
+    {
+        spsc_queue<message> queue{64};
+
+        std::thread producer{[&queue]
+            {
+                for (u32 i = 0; i < ElementsPerProducer; ++i)
+                {
+                    while (!queue.try_push({0, i}))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            }};
+
+        consume_and_check(1, [&queue](message& m) { return queue.try_pop(m); });
+
+        producer.join();
+
+        ASSERT_TRUE(queue.empty_approx());
+    }
+
+    TEST(mpsc_queue, basic)
+    {
+        mpsc_queue<std::unique_ptr<u32>> queue{4};
+
+        std::unique_ptr<u32> out;
+        ASSERT_FALSE(queue.try_pop(out));
+
+        for (u32 lap = 0; lap < 3; ++lap)
+        {
+            for (u32 i = 0; i < 4; ++i)
+            {
+                ASSERT_TRUE(queue.try_push(std::make_unique<u32>(i)));
+            }
+
+            ASSERT_FALSE(queue.try_emplace(std::make_unique<u32>(42)));
+            ASSERT_EQ(queue.size_approx(), 4);
+
+            for (u32 i = 0; i < 4; ++i)
+            {
+                ASSERT_TRUE(queue.try_pop(out));
+                ASSERT_EQ(*out, i);
+            }
+
+            ASSERT_TRUE(queue.empty_approx());
+        }
+
+        // Leftovers are destroyed by the queue
+        ASSERT_TRUE(queue.try_push(std::make_unique<u32>(0)));
+    }
+
+    TEST(mpsc_queue, concurrent)
+    {
+        mpsc_queue<message> queue{256};
+
+        std::vector<std::thread> producers;
+
+        for (u32 p = 0; p < ProducersCount; ++p)
+        {
+            producers.emplace_back(
+                [&queue, p]
+                {
+                    for (u32 i = 0; i < ElementsPerProducer; ++i)
+                    {
+                        while (!queue.try_push({p, i}))
+                        {
+                            std::this_thread::yield();
+                        }
+                    }
+                });
+        }
+
+        consume_and_check(ProducersCount, [&queue](message& m) { return queue.try_pop(m); });
+
+        for (auto& producer : producers)
+        {
+            producer.join();
+        }
+
+        ASSERT_TRUE(queue.empty_approx());
+    }
+
+    TEST(mpsc_linked_queue, basic)
+    {
+        mpsc_linked_queue<std::unique_ptr<u32>> queue;
+
+        std::unique_ptr<u32> out;
+        ASSERT_FALSE(queue.try_pop(out));
+        ASSERT_TRUE(queue.empty_approx());
+
+        for (u32 i = 0; i < 16; ++i)
+        {
+            queue.push(std::make_unique<u32>(i));
+        }
+
+        for (u32 i = 0; i < 8; ++i)
+        {
+            ASSERT_TRUE(queue.try_pop(out));
+            ASSERT_EQ(*out, i);
+        }
+
+        // Leftovers are destroyed by the queue
+        ASSERT_FALSE(queue.empty_approx());
+    }
+
+    TEST(mpsc_linked_queue, concurrent)
+    {
+        mpsc_linked_queue<message> queue;
+
+        std::vector<std::thread> producers;
+
+        for (u32 p = 0; p < ProducersCount; ++p)
+        {
+            producers.emplace_back(
+                [&queue, p]
+                {
+                    for (u32 i = 0; i < ElementsPerProducer; ++i)
+                    {
+                        queue.push({p, i});
+                    }
+                });
+        }
+
+        consume_and_check(ProducersCount, [&queue](message& m) { return queue.try_pop(m); });
+
+        for (auto& producer : producers)
+        {
+            producer.join();
+        }
+
+        ASSERT_TRUE(queue.empty_approx());
+    }
+}
\ No newline at end of file
@@ -89,6 +89,31 @@ namespace oblo
         ASSERT_EQ(allocator.allocations.size(), 0);
     }
 
+    TEST(dynamic_array, dynamic_array_shrink_empty)
+    {
+        checked_allocator allocator;
+
+        {
+            dynamic_array<i32> array{&allocator};
+            array.assign(64, 42);
+
+            array.clear();
+            array.shrink_to_fit();
+
+            ASSERT_EQ(array.capacity(), 0);
+            ASSERT_EQ(allocator.allocations.size(), 0);
+
+            // The array has to be usable after releasing its memory
+            array.push_back(1);
+
+            ASSERT_EQ(array.size(), 1);
+            ASSERT_EQ(array[0], 1);
+            ASSERT_EQ(allocator.allocations.size(), 1);
+        }
+
+        ASSERT_EQ(allocator.allocations.size(), 0);
+    }
+
     namespace
     {
         class move_only_int
@@ -0,0 +1,293 @@
+#include <gtest/gtest.h>
+
+#include <oblo/core/flat_hash_map.hpp>
+#include <oblo/core/flat_hash_set.hpp>
+#include <oblo/core/string/string.hpp>
+#include <oblo/core/string/transparent_string_hash.hpp>
+
+#include <memory>
+#include <random>
+#include <unordered_map>
+
+namespace oblo
+{
+    namespace
+    {
+        struct counted_value
+        {
+            explicit counted_value(i32 v, i32* counter) : value{v}, counter{counter}
+            {
+                ++*counter;
+            }
+
+            counted_value(const counted_value& other) : value{other.value}, counter{other.counter}
+            {
+                ++*counter;
+            }
+
+            counted_value(counted_value&& other) noexcept : value{other.value}, counter{other.counter}
+            {
+                ++*counter;
+            }
+
+            ~counted_value()
+            {
+                --*counter;
+            }
+
+            i32 value;
+            i32* counter;
+        };
+
+        // Maps all keys to 4 hashes. The table mixes the hash, but keys with the same hash still share both the probe
+        // start and the control byte, so each group fully collides, to test probing and tombstones
+        struct bad_hash
+        {
+            usize operator()(u32 v) const
+            {
+                return usize(v % 4);
+            }
+        };
+    }
+
+    TEST(flat_hash_map, insert_find_erase)
+    {
+        flat_hash_map<u32, u32> map;
+
+        ASSERT_TRUE(map.empty());
+        ASSERT_EQ(map.find(42), map.end());
+        ASSERT_EQ(map.begin(), map.end());
+
+        constexpr u32 N = 10000;
+
+        for (u32 i = 0; i < N; ++i)
+        {
+            const auto [it, inserted] = map.emplace(i, i * 2);
+            ASSERT_TRUE(inserted);
+            ASSERT_EQ(it->first, i);
+            ASSERT_EQ(it->second, i * 2);
+        }
+
+        ASSERT_EQ(map.size(), N);
+
+        for (u32 i = 0; i < N; ++i)
+        {
+            const auto [it, inserted] = map.emplace(i, 0u);
+            ASSERT_FALSE(inserted);
+            ASSERT_EQ(it->second, i * 2);
+        }
+
+        for (u32 i = 0; i < N; i += 2)
+        {
+            ASSERT_EQ(map.erase(i), 1);
+            ASSERT_EQ(map.erase(i), 0);
+        }
+
+        ASSERT_EQ(map.size(), N / 2);
+
+        for (u32 i = 0; i < N; ++i)
+        {
+            const auto it = map.find(i);
+
+            if (i % 2 == 0)
+            {
+                ASSERT_EQ(it, map.end());
+            }
+            else
+            {
+                ASSERT_NE(it, map.end());
+                ASSERT_EQ(it->second, i * 2);
+            }
+        }
+
+        usize count{};
+
+        for (const auto& [k, v] : map)
+        {
+            ASSERT_EQ(k % 2, 1);
+            ASSERT_EQ(v, k * 2);
+            ++count;
+        }
+
+        ASSERT_EQ(count, map.size());
+
+        map.clear();
+
+        ASSERT_TRUE(map.empty());
+        ASSERT_EQ(map.begin(), map.end());
+        ASSERT_FALSE(map.contains(1));
+    }
+
+    TEST(flat_hash_map, randomized_against_std)
+    {
+        flat_hash_map<u32, u32, bad_hash> map;
+        std::unordered_map<u32, u32> expected;
+
+        std::mt19937 rng{42};
+
+        for (u32 i = 0; i < 100000; ++i)
+        {
+            const u32 key = rng() % 512;
+
+            if (rng() % 3 == 0)
+            {
+                ASSERT_EQ(map.erase(key), expected.erase(key));
+            }
+            else
+            {
+                map[key] = i;
+                expected[key] = i;
+            }
+
+            ASSERT_EQ(map.size(), expected.size());
+        }
+
+        for (const auto& [k, v] : expected)
+        {
+            const auto it = map.find(k);
+            ASSERT_NE(it, map.end());
+            ASSERT_EQ(it->second, v);
+        }
+    }
+
+    TEST(flat_hash_map, erase_while_iterating)
+    {
+        flat_hash_map<u32, u32> map;
+
+        for (u32 i = 0; i < 1000; ++i)
+        {
+            map.emplace(i, i);
+        }
+
+        for (auto it = map.begin(); it != map.end();)
+        {
+            if (it->first % 3 == 0)
+            {
+                it = map.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        ASSERT_EQ(map.size(), 666);
+
+        for (u32 i = 0; i < 1000; ++i)
+        {
+            ASSERT_EQ(map.contains(i), i % 3 != 0);
+        }
+    }
+
+    TEST(flat_hash_map, lifetime)
+    {
+        i32 alive{};
+
+        {
+            flat_hash_map<u32, counted_value> map;
+
+            for (u32 i = 0; i < 1000; ++i)
+            {
+                map.try_emplace(i, i32(i), &alive);
+            }
+
+            ASSERT_EQ(alive, 1000);
+
+            for (u32 i = 0; i < 500; ++i)
+            {
+                map.erase(i);
+            }
+
+            ASSERT_EQ(alive, 500);
+
+            auto copy = map;
+            ASSERT_EQ(alive, 1000);
+
+            for (const auto& [k, v] : copy)
+            {
+                ASSERT_EQ(u32(v.value), k);
+            }
+
+            auto moved = std::move(copy);
+            ASSERT_EQ(alive, 1000);
+            ASSERT_TRUE(copy.empty());
+
+            moved.clear();
+            ASSERT_EQ(alive, 500);
+        }
+
+        ASSERT_EQ(alive, 0);
+    }
+
+    TEST(flat_hash_map, move_only_values)
+    {
+        flat_hash_map<u32, std::unique_ptr<u32>> map;
+
+        for (u32 i = 0; i < 100; ++i)
+        {
+            map.emplace(i, std::make_unique<u32>(i));
+        }
+
+        for (u32 i = 0; i < 100; ++i)
+        {
+            ASSERT_EQ(*map.at(i), i);
+        }
+    }
+
+    TEST(flat_hash_map, reserve)
+    {
+        flat_hash_map<u32, u32> map;
+        map.reserve(1000);
+
+        const auto capacity = map.capacity();
+        ASSERT_GE(capacity, 1000);
+
+        for (u32 i = 0; i < 1000; ++i)
+        {
+            map.emplace(i, i);
+        }
+
+        ASSERT_EQ(map.capacity(), capacity);
+    }
+
+    TEST(flat_hash_map, heterogeneous_lookup)
+    {
+        flat_hash_map<string, u32, transparent_string_hash, transparent_string_equal> map;
+
+        map.emplace(string{"hello"}, 1u);
+        map.emplace("world", 2u);
+
+        ASSERT_EQ(map.size(), 2);
+
+        ASSERT_EQ(map.find(string_view{"hello"})->second, 1);
+        ASSERT_EQ(map.find("world")->second, 2);
+        ASSERT_EQ(map.find(hashed_string_view{"world"})->second, 2);
+        ASSERT_EQ(map.find(string{"hello"})->second, 1);
+        ASSERT_FALSE(map.contains(string_view{"hello world"}));
+
+        ASSERT_EQ(map.erase(string_view{"hello"}), 1);
+        ASSERT_EQ(map.size(), 1);
+    }
+
+    TEST(flat_hash_set, insert_erase)
+    {
+        flat_hash_set<u64> set{1, 2, 3};
+
+        ASSERT_EQ(set.size(), 3);
+        ASSERT_FALSE(set.insert(2).second);
+        ASSERT_TRUE(set.insert(4).second);
+
+        ASSERT_TRUE(set.contains(4));
+        ASSERT_EQ(set.erase(1), 1);
+        ASSERT_FALSE(set.contains(1));
+
+        u64 sum{};
+
+        for (const u64 v : set)
+        {
+            sum += v;
+        }
+
+        ASSERT_EQ(sum, 2 + 3 + 4);
+    }
+}
@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+
+#include <oblo/core/concurrent_frame_allocator.hpp>
+#include <oblo/core/frame_allocator.hpp>
+#include <oblo/core/types.hpp>
+
+#include <bit>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace oblo
+{
+    namespace
+    {
+        constexpr usize ChunkSize{64u << 10};
+    }
+
+    TEST(frame_allocator, allocate_and_restore)
+    {
+        frame_allocator allocator;
+        ASSERT_TRUE(allocator.init(16 * ChunkSize, ChunkSize));
+
+        ASSERT_EQ(allocator.get_committed_memory_size(), 0);
+
+        auto* const a = allocator.allocate(100, 1);
+        ASSERT_TRUE(a);
+        ASSERT_TRUE(allocator.contains(a));
+        ASSERT_EQ(allocator.get_committed_memory_size(), ChunkSize);
+
+        std::memset(a, 0xff, 100);
+
+        {
+            const auto restore = allocator.make_scoped_restore();
+
+            auto* const b = allocator.allocate(3 * ChunkSize, 64);
+            ASSERT_TRUE(b);
+            ASSERT_EQ(std::bit_cast<uintptr>(b) % 64, 0);
+            ASSERT_EQ(allocator.get_committed_memory_size(), 4 * ChunkSize);
+
+            // Touch the whole allocation, to make sure it's actually accessible
+            std::memset(b, 0xff, 3 * ChunkSize);
+        }
+
+        ASSERT_EQ(allocator.get_first_unallocated_byte(), a + 100);
+
+        allocator.free_unused();
+        ASSERT_EQ(allocator.get_committed_memory_size(), ChunkSize);
+
+        // Allocations beyond the reserved memory fail
+        ASSERT_FALSE(allocator.allocate(16 * ChunkSize, 1));
+
+        allocator.restore_all();
+
+        auto* const c = allocator.allocate(16 * ChunkSize, 1);
+        ASSERT_EQ(c, a);
+        std::memset(c, 0xff, 16 * ChunkSize);
+    }
+
+    TEST(frame_allocator, huge_pages)
+    {
+        constexpr usize HugeChunkSize{2u << 20};
+
+        frame_allocator allocator;
+        ASSERT_TRUE(allocator.init(4 * HugeChunkSize, HugeChunkSize, 1, true));
+
+        auto* const a = allocator.allocate(HugeChunkSize + 1, 16);
+        ASSERT_TRUE(a);
+
+        // The memory is aligned to the huge page size, whether the system honored the hint or not
+        ASSERT_EQ(std::bit_cast<uintptr>(a) % HugeChunkSize, 0);
+        std::memset(a, 0xff, HugeChunkSize + 1);
+    }
+
+    TEST(concurrent_frame_allocator, concurrent_allocations)
+    {
+        constexpr u32 ThreadsCount{8};
+        constexpr u32 AllocationsPerThread{1024};
+        constexpr usize AllocationSize{48};
+
+        concurrent_frame_allocator allocator;
+        ASSERT_TRUE(allocator.init(64 * ChunkSize, ChunkSize));
+
+        for (u32 frame = 0; frame < 3; ++frame)
+        {
+            std::vector<std::thread> threads;
+            std::vector<std::vector<byte*>> allocations{ThreadsCount};
+
+            for (u32 t = 0; t < ThreadsCount; ++t)
+            {
+                threads.emplace_back(
+                    [&allocator, &allocations, t]
+                    {
+                        auto& results = allocations[t];
+
+                        for (u32 i = 0; i < AllocationsPerThread; ++i)
+                        {
+                            auto* const ptr = allocator.allocate(AllocationSize, 16);
+
+                            if (ptr)
+                            {
+                                std::memset(ptr, int(t), AllocationSize);
+                            }
+
+                            results.push_back(ptr);
+                        }
+                    });
+            }
+
+            for (auto& t : threads)
+            {
+                t.join();
+            }
+
+            // No allocation overlaps with another, so each one still contains the id of the thread
+            for (u32 t = 0; t < ThreadsCount; ++t)
+            {
+                for (auto* const ptr : allocations[t])
+                {
+                    ASSERT_TRUE(ptr);
+                    ASSERT_EQ(std::bit_cast<uintptr>(ptr) % 16, 0);
+                    ASSERT_TRUE(allocator.contains(ptr));
+
+                    for (usize i = 0; i < AllocationSize; ++i)
+                    {
+                        ASSERT_EQ(ptr[i], byte(t));
+                    }
+                }
+            }
+
+            const auto stats = allocator.get_stats();
+            ASSERT_GE(stats.currentUsage, ThreadsCount * AllocationsPerThread * AllocationSize);
+            ASSERT_GE(stats.committedMemory, stats.currentUsage);
+
+            allocator.restore_all();
+        }
+
+        const auto stats = allocator.get_stats();
+
+        ASSERT_EQ(stats.framesCount, 3);
+        ASSERT_EQ(stats.currentUsage, 0);
+        ASSERT_GE(stats.lastFrameHighWaterMark, ThreadsCount * AllocationsPerThread * AllocationSize);
+        ASSERT_EQ(stats.peakHighWaterMark, stats.lastFrameHighWaterMark);
+        ASSERT_EQ(stats.totalHighWaterMark, 3 * stats.lastFrameHighWaterMark);
+    }
+
+    TEST(concurrent_frame_allocator, free_unused)
+    {
+        concurrent_frame_allocator allocator;
+        ASSERT_TRUE(allocator.init(16 * ChunkSize, ChunkSize, 2));
+
+        ASSERT_EQ(allocator.get_stats().committedMemory, 2 * ChunkSize);
+
+        auto* const big = allocator.allocate(8 * ChunkSize, 1);
+        ASSERT_TRUE(big);
+        std::memset(big, 0xff, 8 * ChunkSize);
+
+        ASSERT_EQ(allocator.get_stats().committedMemory, 8 * ChunkSize);
+        ASSERT_FALSE(allocator.allocate(8 * ChunkSize + 1, 1));
+
+        allocator.restore_all();
+
+        // We keep the memory of the last frame around
+        allocator.free_unused();
+        ASSERT_EQ(allocator.get_stats().committedMemory, 8 * ChunkSize);
+
+        auto* const small = allocator.allocate(ChunkSize, 1);
+        ASSERT_EQ(small, big);
+
+        allocator.restore_all();
+        allocator.free_unused();
+
+        ASSERT_EQ(allocator.get_stats().committedMemory, ChunkSize);
+        ASSERT_EQ(allocator.get_stats().peakHighWaterMark, 8 * ChunkSize);
+    }
+}
@@ -0,0 +1,266 @@
+#include <gtest/gtest.h>
+
+#include <oblo/core/compression/lz.hpp>
+#include <oblo/core/filesystem/file.hpp>
+#include <oblo/core/filesystem/file_ptr.hpp>
+#include <oblo/core/filesystem/filesystem.hpp>
+#include <oblo/core/utility.hpp>
+
+#include <cstring>
+#include <random>
+
+namespace oblo::lz
+{
+    namespace
+    {
+        // Mixes text-like repetitions, runs with short offsets and random noise
+        dynamic_array<byte> make_test_data(usize size, u32 seed)
+        {
+            std::mt19937 rng{seed};
+
+            dynamic_array<byte> data;
+            data.reserve(size);
+
+            constexpr const char* words[] = {"oblo ", "entity ", "component ", "archetype ", "mesh ", "texture "};
+
+            while (data.size() < size)
+            {
+                switch (rng() % 4)
+                {
+                case 0: {
+                    const char* const word = words[rng() % std::size(words)];
+                    const auto* const begin = reinterpret_cast<const byte*>(word);
+                    data.append(begin, begin + std::strlen(word));
+                    break;
+                }
+
+                case 1: {
+                    const u32 length = rng() % 64;
+                    const byte value{u8(rng())};
+
+                    for (u32 i = 0; i < length; ++i)
+                    {
+                        data.push_back(value);
+                    }
+
+                    break;
+                }
+
+                case 2: {
+                    const u32 length = rng() % 32;
+
+                    for (u32 i = 0; i < length; ++i)
+                    {
+                        data.push_back(byte(rng()));
+                    }
+
+                    break;
+                }
+
+                default: {
+                    // Copies a previous chunk, with an offset that might exceed the window
+                    if (data.size() > 64)
+                    {
+                        const usize offset = 1 + rng() % min(data.size() - 32, usize{100'000});
+                        const usize begin = data.size() - offset;
+                        const usize length = 4 + rng() % 28;
+
+                        for (usize i = 0; i < length; ++i)
+                        {
+                            const byte value = data[begin + i];
+                            data.push_back(value);
+                        }
+                    }
+
+                    break;
+                }
+                }
+            }
+
+            data.resize(size);
+            return data;
+        }
+
+        void check_block_roundtrip(std::span<const byte> src)
+        {
+            dynamic_array<byte> compressed;
+            compressed.resize(compress_bound(src.size()));
+
+            const auto compressedSize = compress_block(src, compressed);
+            ASSERT_TRUE(compressedSize);
+
+            dynamic_array<byte> decompressed;
+            decompressed.resize(src.size());
+
+            const auto decompressedSize =
+                decompress_block(std::span{compressed}.subspan(0, *compressedSize), decompressed);
+
+            ASSERT_TRUE(decompressedSize);
+            ASSERT_EQ(*decompressedSize, src.size());
+            ASSERT_TRUE(std::equal(src.begin(), src.end(), decompressed.begin()));
+        }
+    }
+
+    TEST(lz, block_roundtrip)
+    {
+        for (const usize size : {usize{0}, usize{1}, usize{12}, usize{13}, usize{100}, usize{65'536}, usize{300'000}})
+        {
+            const auto data = make_test_data(size, u32(size));
+            check_block_roundtrip(data);
+        }
+
+        // Long runs encode matches that overlap with their own output
+        dynamic_array<byte> zeroes;
+        zeroes.resize(100'000, byte{0});
+        check_block_roundtrip(zeroes);
+
+        dynamic_array<byte> compressed;
+        compressed.resize(compress_bound(zeroes.size()));
+        ASSERT_LT(compress_block(zeroes, compressed).value_or(~usize{}), zeroes.size() / 100);
+
+        // Random data is not compressible, but it still has to roundtrip
+        std::mt19937 rng{42};
+        dynamic_array<byte> noise;
+
+        for (u32 i = 0; i < 50'000; ++i)
+        {
+            noise.push_back(byte(rng()));
+        }
+
+        check_block_roundtrip(noise);
+    }
+
+    TEST(lz, block_rejects_malformed)
+    {
+        const auto data = make_test_data(10'000, 0);
+
+        dynamic_array<byte> compressed;
+        compressed.resize(compress_bound(data.size()));
+
+        const usize compressedSize = compress_block(data, compressed).value_or(0);
+        ASSERT_GT(compressedSize, 0);
+
+        dynamic_array<byte> decompressed;
+        decompressed.resize(data.size());
+
+        // The destination is too small
+        ASSERT_FALSE(decompress_block(std::span{compressed}.subspan(0, compressedSize),
+            std::span{decompressed}.subspan(0, data.size() - 1)));
+
+        // Truncated input
+        ASSERT_FALSE(decompress_block(std::span{compressed}.subspan(0, compressedSize / 2), decompressed));
+
+        // Corrupted data must fail or at least never go out of bounds, which the sanitizers would catch
+        std::mt19937 rng{7};
+
+        for (u32 i = 0; i < 1000; ++i)
+        {
+            dynamic_array<byte> corrupted;
+            corrupted.assign(compressed.begin(), compressed.begin() + compressedSize);
+            corrupted[rng() % compressedSize] = byte(rng());
+
+            (void) decompress_block(corrupted, decompressed);
+        }
+
+        // Offset pointing before the beginning of the output
+        const byte invalidOffset[] = {byte{0x10}, byte{'a'}, byte{0x02}, byte{0x00}, byte{0x00}};
+        ASSERT_FALSE(decompress_block(invalidOffset, decompressed));
+    }
+
+    TEST(lz, frame_roundtrip)
+    {
+        const auto data = make_test_data(1'000'000, 1);
+
+        dynamic_array<byte> frame;
+        const auto frameSize = compress_frame(data, frame, 1u << 16);
+
+        ASSERT_TRUE(frameSize);
+        ASSERT_EQ(*frameSize, frame.size());
+        ASSERT_LT(frame.size(), data.size());
+
+        const auto info = read_frame_info(frame);
+        ASSERT_TRUE(info);
+        ASSERT_EQ(info->uncompressedSize, data.size());
+        ASSERT_EQ(info->blocksCount, 16);
+        ASSERT_EQ(info->blockSize, 1u << 16);
+
+        dynamic_array<byte> decompressed;
+        decompressed.resize(data.size());
+
+        ASSERT_EQ(decompress_frame(frame, decompressed).value_or(0), data.size());
+        ASSERT_TRUE(std::equal(data.begin(), data.end(), decompressed.begin()));
+
+        // Truncated frames are rejected while reading the headers
+        ASSERT_FALSE(read_frame_info(std::span{frame}.subspan(0, frame.size() - 1)));
+
+        // Empty frames only have the header and the end marker
+        dynamic_array<byte> empty;
+        ASSERT_EQ(compress_frame({}, empty).value_or(0), sizeof(frame_header) + sizeof(u32));
+        ASSERT_EQ(read_frame_info(empty)->uncompressedSize, 0);
+    }
+
+    TEST(lz, stream_roundtrip)
+    {
+        constexpr cstring_view testDir{"./test/lz/"};
+        filesystem::remove_all(testDir).assert_value();
+        filesystem::create_directories(testDir).assert_value();
+
+        constexpr cstring_view path{"./test/lz/stream.oblz"};
+
+        const auto data = make_test_data(500'000, 2);
+
+        {
+            const filesystem::file_ptr f{filesystem::open_file(path, "wb")};
+            ASSERT_TRUE(f);
+
+            frame_writer writer;
+            ASSERT_TRUE(writer.init(f.get(), 1u << 15));
+
+            // Writing in uneven chunks, which span across blocks
+            for (usize offset = 0; offset < data.size();)
+            {
+                const usize count = min(data.size() - offset, usize{12'345});
+                ASSERT_TRUE(writer.write(std::span{data}.subspan(offset, count)));
+                offset += count;
+            }
+
+            ASSERT_TRUE(writer.finish());
+        }
+
+        // The streamed frame can be decompressed as a whole too
+        dynamic_array<byte> frame;
+        ASSERT_TRUE(filesystem::load_binary_file_into_memory(frame, path));
+
+        dynamic_array<byte> decompressed;
+        decompressed.resize(data.size());
+        ASSERT_EQ(decompress_frame(frame, decompressed).value_or(0), data.size());
+        ASSERT_TRUE(std::equal(data.begin(), data.end(), decompressed.begin()));
+
+        {
+            const filesystem::file_ptr f{filesystem::open_file(path, "rb")};
+            ASSERT_TRUE(f);
+
+            frame_reader reader;
+            ASSERT_TRUE(reader.init(f.get()));
+
+            dynamic_array<byte> streamed;
+            byte buffer[10'000];
+
+            while (true)
+            {
+                const auto n = reader.read(buffer);
+                ASSERT_TRUE(n);
+
+                streamed.append(buffer, buffer + *n);
+
+                if (*n < std::size(buffer))
+                {
+                    break;
+                }
+            }
+
+            ASSERT_EQ(streamed.size(), data.size());
+            ASSERT_TRUE(std::equal(data.begin(), data.end(), streamed.begin()));
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include <oblo/core/filesystem/file.hpp>
+#include <oblo/core/filesystem/filesystem.hpp>
+#include <oblo/core/filesystem/mapped_file.hpp>
+
+namespace oblo
+{
+    namespace
+    {
+        void clear_directory(cstring_view path)
+        {
+            filesystem::remove_all(path).assert_value();
+        }
+    }
+
+    TEST(mapped_file, read_write)
+    {
+        constexpr cstring_view testDir{"./test/mapped_file_read_write/"};
+        clear_directory(testDir);
+
+        filesystem::create_directories(testDir).assert_value();
+
+        constexpr cstring_view path{"./test/mapped_file_read_write/file.bin"};
+        constexpr usize size{3 * 4096 + 17};
+
+        {
+            filesystem::mapped_file file;
+            ASSERT_TRUE(file.create(path, size));
+
+            ASSERT_TRUE(file.is_open());
+            ASSERT_EQ(file.size(), size);
+
+            const auto bytes = file.get_writable_bytes();
+            ASSERT_EQ(bytes.size(), size);
+
+            for (usize i = 0; i < size; ++i)
+            {
+                bytes[i] = byte(i % 251);
+            }
+
+            ASSERT_TRUE(file.flush());
+        }
+
+        {
+            filesystem::mapped_file file;
+            ASSERT_TRUE(file.open(path));
+
+            ASSERT_EQ(file.get_access(), filesystem::mapped_file_access::read);
+            ASSERT_TRUE(file.advise(filesystem::mapped_file_advice::sequential));
+            ASSERT_TRUE(file.advise(filesystem::mapped_file_advice::will_need, 4096 + 5, 100));
+
+            const auto bytes = file.get_bytes();
+            ASSERT_EQ(bytes.size(), size);
+
+            for (usize i = 0; i < size; ++i)
+            {
+                ASSERT_EQ(bytes[i], byte(i % 251));
+            }
+
+            // Moving transfers the ownership of the mapping
+            filesystem::mapped_file moved{std::move(file)};
+
+            ASSERT_FALSE(file.is_open());
+            ASSERT_TRUE(file.get_bytes().empty());
+
+            ASSERT_TRUE(moved.is_open());
+            ASSERT_EQ(moved.get_bytes().data(), bytes.data());
+        }
+
+        {
+            // Writes through a read_write mapping end up in the file
+            filesystem::mapped_file file;
+            ASSERT_TRUE(file.open(path, filesystem::mapped_file_access::read_write));
+
+            file.get_writable_bytes()[42] = byte{0xff};
+        }
+
+        dynamic_array<byte> content;
+        ASSERT_TRUE(filesystem::load_binary_file_into_memory(content, path));
+
+        ASSERT_EQ(content.size(), size);
+        ASSERT_EQ(content[41], byte{41});
+        ASSERT_EQ(content[42], byte{0xff});
+        ASSERT_EQ(content[43], byte{43});
+    }
+
+    TEST(mapped_file, empty_and_missing)
+    {
+        constexpr cstring_view testDir{"./test/mapped_file_empty_and_missing/"};
+        clear_directory(testDir);
+
+        filesystem::create_directories(testDir).assert_value();
+
+        {
+            filesystem::mapped_file file;
+            ASSERT_FALSE(file.open("./test/mapped_file_empty_and_missing/missing.bin"));
+            ASSERT_FALSE(file.is_open());
+        }
+
+        {
+            filesystem::mapped_file file;
+            ASSERT_TRUE(file.create("./test/mapped_file_empty_and_missing/empty.bin", 0));
+        }
+
+        {
+            filesystem::mapped_file file;
+            ASSERT_TRUE(file.open("./test/mapped_file_empty_and_missing/empty.bin"));
+            ASSERT_TRUE(file.is_open());
+            ASSERT_TRUE(file.get_bytes().empty());
+        }
+    }
+}
@@ -1,7 +1,9 @@
 #include <gtest/gtest.h>
 
+#include <oblo/math/batch_transform.hpp>
 #include <oblo/math/mat4.hpp>
 #include <oblo/math/quaternion.hpp>
+#include <oblo/math/transform.hpp>
 
 #include <Eigen/Geometry>
 #include <unsupported/Eigen/EulerAngles>
@@ -153,6 +155,40 @@ namespace oblo
         }
     }
 
+    TEST(quaternion, transform)
+    {
+        std::default_random_engine rng{42};
+        std::uniform_real_distribution<float> f32Dist{-1, 1};
+
+        constexpr u32 N = 1024;
+
+        for (u32 i = 0; i < N; ++i)
+        {
+            const quaternion q = normalize(random_quaternion(rng, f32Dist));
+            const vec3 v = random_vec3(rng, f32Dist);
+
+            const Eigen::Vector3f e = from_oblo(q) * Eigen::Vector3f{v.x, v.y, v.z};
+            const vec3 r = transform(q, v);
+
+            ASSERT_NEAR(r.x, e.x(), Tolerance);
+            ASSERT_NEAR(r.y, e.y(), Tolerance);
+            ASSERT_NEAR(r.z, e.z(), Tolerance);
+        }
+    }
+
+    TEST(quaternion, constexpr_fallback)
+    {
+        constexpr quaternion q{0.f, 0.f, 1.f, 0.f};
+        constexpr quaternion product = q * q;
+        constexpr vec3 v = transform(q, vec3{1.f, 2.f, 3.f});
+
+        static_assert(product.x == 0.f && product.y == 0.f && product.z == 0.f && product.w == -1.f);
+        static_assert(v.x == -1.f && v.y == -2.f && v.z == 3.f);
+
+        ASSERT_EQ(q * q, product);
+        ASSERT_EQ(transform(q, vec3{1.f, 2.f, 3.f}), v);
+    }
+
     TEST(quaternion, rotation)
     {
         std::default_random_engine rng{42};
@@ -268,4 +304,98 @@ namespace oblo
             }
         }
     }
+
+    TEST(mat4, constexpr_fallback)
+    {
+        constexpr mat4 m{{{1, 2, 0, 0}, {0, 1, 0, 0}, {0, 0, 2, 0}, {3, 0, 0, 1}}};
+        constexpr mat4 product = m * mat4::identity();
+        constexpr mat4 t = transpose(m);
+        constexpr vec4 v = m * vec4{1, 1, 1, 1};
+
+        static_assert(product.at(0, 3) == 3.f);
+        static_assert(t.at(3, 0) == 3.f);
+        static_assert(v.x == 4.f && v.y == 3.f && v.z == 2.f && v.w == 1.f);
+
+        ASSERT_EQ(product.at(1, 0), m.at(1, 0));
+    }
+
+    TEST(batch_transform, make_transform_matrices)
+    {
+        std::default_random_engine rng{42};
+        std::uniform_real_distribution<float> f32Dist{-1, 1};
+
+        // Not a multiple of the SIMD width, to also cover the scalar tail
+        constexpr u32 N = 37;
+
+        f32 p[3][N], r[4][N], s[3][N];
+
+        for (u32 i = 0; i < N; ++i)
+        {
+            const auto position = random_vec3(rng, f32Dist);
+            const auto rotation = normalize(random_quaternion(rng, f32Dist));
+            const auto scale = random_vec3(rng, f32Dist);
+
+            for (u32 c = 0; c < 3; ++c)
+            {
+                p[c][i] = position[c];
+                s[c][i] = scale[c];
+            }
+
+            r[0][i] = rotation.x;
+            r[1][i] = rotation.y;
+            r[2][i] = rotation.z;
+            r[3][i] = rotation.w;
+        }
+
+        mat4 out[N];
+        make_transform_matrices({p[0], p[1], p[2]}, {r[0], r[1], r[2], r[3]}, {s[0], s[1], s[2]}, out);
+
+        for (u32 i = 0; i < N; ++i)
+        {
+            const mat4 expected = make_transform_matrix({p[0][i], p[1][i], p[2][i]},
+                {r[0][i], r[1][i], r[2][i], r[3][i]},
+                {s[0][i], s[1][i], s[2][i]});
+
+            assert_near(out[i], from_oblo(expected));
+        }
+    }
+
+    TEST(batch_transform, inverse_transpose)
+    {
+        std::default_random_engine rng{42};
+        std::uniform_real_distribution<float> f32Dist{-1, 1};
+
+        constexpr u32 N = 37;
+
+        mat4 matrices[N];
+
+        for (auto& m : matrices)
+        {
+            for (auto& column : m.columns)
+            {
+                column = random_vec4(rng, f32Dist);
+            }
+        }
+
+        // Non-invertible matrices are replaced by the identity, like the scalar version does
+        matrices[5] = {};
+        matrices[N - 1] = {};
+
+        mat4 out[N];
+        inverse_transpose(matrices, out);
+
+        for (u32 i = 0; i < N; ++i)
+        {
+            const mat4 expected = transpose(inverse(matrices[i]).value_or(mat4::identity()));
+            assert_near_adaptive(out[i], from_oblo(expected));
+        }
+
+        // Also works in place
+        inverse_transpose(matrices, matrices);
+
+        for (u32 i = 0; i < N; ++i)
+        {
+            assert_near(matrices[i], from_oblo(out[i]), 0.f);
+        }
+    }
 }
\ No newline at end of file
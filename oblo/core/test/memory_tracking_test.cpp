@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+
+#include <oblo/core/dynamic_array.hpp>
+#include <oblo/core/filesystem/file.hpp>
+#include <oblo/core/filesystem/filesystem.hpp>
+#include <oblo/core/memory_tracking.hpp>
+
+#include <new>
+
+namespace oblo
+{
+    namespace
+    {
+        // The global allocators might already be tracking allocations, so we use our own upstream
+        struct untracked_allocator final : allocator
+        {
+            byte* allocate(usize size, usize alignment) noexcept override
+            {
+                return static_cast<byte*>(::operator new(size, std::align_val_t(alignment)));
+            }
+
+            void deallocate(byte* ptr, usize, usize alignment) noexcept override
+            {
+                ::operator delete(ptr, std::align_val_t(alignment));
+            }
+        };
+    }
+
+    TEST(memory_tracking, tags)
+    {
+        const auto a = register_memory_tag("memory_tracking_test_a");
+        const auto b = register_memory_tag("memory_tracking_test_b");
+
+        ASSERT_NE(a, UntaggedMemory);
+        ASSERT_NE(a, b);
+        ASSERT_EQ(register_memory_tag("memory_tracking_test_a"), a);
+
+        ASSERT_EQ(get_current_memory_tag(), UntaggedMemory);
+
+        {
+            const memory_tag_scope scopeA{a};
+            ASSERT_EQ(get_current_memory_tag(), a);
+
+            {
+                const memory_tag_scope scopeB{b};
+                ASSERT_EQ(get_current_memory_tag(), b);
+            }
+
+            ASSERT_EQ(get_current_memory_tag(), a);
+        }
+
+        ASSERT_EQ(get_current_memory_tag(), UntaggedMemory);
+    }
+
+    TEST(memory_tracking, tracking_allocator)
+    {
+        untracked_allocator upstream;
+        tracking_allocator allocator{&upstream};
+
+        const auto tag = register_memory_tag("memory_tracking_test_allocator");
+        const auto other = register_memory_tag("memory_tracking_test_other");
+
+        memory_tag_stats before;
+        ASSERT_TRUE(get_memory_tag_stats(tag, before));
+        ASSERT_EQ(before.name, "memory_tracking_test_allocator");
+
+        byte* small;
+        byte* large;
+
+        {
+            const memory_tag_scope scope{tag};
+
+            small = allocator.allocate(24, 8);
+            large = allocator.allocate(5000, 64);
+        }
+
+        ASSERT_EQ(uintptr(large) % 64, 0);
+
+        memory_tag_stats stats;
+        ASSERT_TRUE(get_memory_tag_stats(tag, stats));
+
+        ASSERT_EQ(stats.liveBytes - before.liveBytes, 5024);
+        ASSERT_GE(stats.peakBytes, 5024);
+        ASSERT_EQ(stats.allocations - before.allocations, 2);
+        ASSERT_EQ(stats.sizeHistogram[5] - before.sizeHistogram[5], 1);
+        ASSERT_EQ(stats.sizeHistogram[13] - before.sizeHistogram[13], 1);
+
+        {
+            // The deallocation is accounted to the tag that was active when allocating
+            const memory_tag_scope scope{other};
+
+            allocator.deallocate(small, 24, 8);
+            allocator.deallocate(large, 5000, 64);
+        }
+
+        ASSERT_TRUE(get_memory_tag_stats(tag, stats));
+
+        ASSERT_EQ(stats.liveBytes, before.liveBytes);
+        ASSERT_EQ(stats.deallocations - before.deallocations, 2);
+        ASSERT_GE(stats.peakBytes, 5024);
+
+        memory_tag_stats otherStats;
+        ASSERT_TRUE(get_memory_tag_stats(other, otherStats));
+        ASSERT_EQ(otherStats.deallocations, 0);
+    }
+
+    TEST(memory_tracking, containers)
+    {
+        untracked_allocator upstream;
+        tracking_allocator allocator{&upstream};
+
+        const auto tag = register_memory_tag("memory_tracking_test_containers");
+
+        memory_tag_stats before;
+        ASSERT_TRUE(get_memory_tag_stats(tag, before));
+
+        {
+            const memory_tag_scope scope{tag};
+
+            dynamic_array<u32> array{&allocator};
+
+            for (u32 i = 0; i < 1000; ++i)
+            {
+                array.push_back(i);
+            }
+
+            memory_tag_stats stats;
+            ASSERT_TRUE(get_memory_tag_stats(tag, stats));
+            ASSERT_EQ(stats.liveBytes - before.liveBytes, array.capacity() * sizeof(u32));
+        }
+
+        memory_tag_stats after;
+        ASSERT_TRUE(get_memory_tag_stats(tag, after));
+        ASSERT_EQ(after.liveBytes, before.liveBytes);
+        ASSERT_EQ(after.allocations, after.deallocations);
+    }
+
+    TEST(memory_tracking, dump)
+    {
+        register_memory_tag("memory_tracking_test_dump");
+        register_memory_tag("mt_\"quoted\\tag\"\n");
+
+        constexpr cstring_view testDir{"./test/memory_tracking_dump/"};
+        filesystem::remove_all(testDir).assert_value();
+        filesystem::create_directories(testDir).assert_value();
+
+        constexpr cstring_view path{"./test/memory_tracking_dump/stats.json"};
+        ASSERT_TRUE(dump_memory_tag_stats(path));
+
+        string_builder content;
+        ASSERT_TRUE(filesystem::load_text_file_into_memory(content, path));
+
+        ASSERT_NE(content.view().find("\"memory_tracking_test_dump\""), string_view::npos);
+        ASSERT_NE(content.view().find("\"untagged\""), string_view::npos);
+        ASSERT_NE(content.view().find(R"("mt_\"quoted\\tag\"\n")"), string_view::npos);
+    }
+}
\ No newline at end of file
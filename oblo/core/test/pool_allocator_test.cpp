@@ -0,0 +1,213 @@
+#include <gtest/gtest.h>
+
+#include <oblo/core/pool_allocator.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace oblo
+{
+    namespace
+    {
+        class failing_allocator final : public allocator
+        {
+        public:
+            byte* allocate(usize size, usize alignment) noexcept override
+            {
+                return isFailing ? nullptr : get_global_aligned_allocator()->allocate(size, alignment);
+            }
+
+            void deallocate(byte* ptr, usize size, usize alignment) noexcept override
+            {
+                get_global_aligned_allocator()->deallocate(ptr, size, alignment);
+            }
+
+        public:
+            bool isFailing{};
+        };
+    }
+
+    TEST(pool_allocator, size_classes_and_alignment)
+    {
+        pool_allocator pool;
+
+        for (usize alignment = 1; alignment <= pool_allocator::MaxAlignment; alignment *= 2)
+        {
+            for (usize size = 0; size <= pool_allocator::MaxSize; size += 8)
+            {
+                byte* const ptr = pool.allocate(size, alignment);
+                ASSERT_TRUE(ptr);
+                ASSERT_EQ(reinterpret_cast<uintptr>(ptr) % alignment, 0);
+
+                // The block has to be writable in its entirety
+                std::fill_n(ptr, size, byte{0xcd});
+
+                pool.deallocate(ptr, size, alignment);
+            }
+        }
+
+        const auto stats = pool.get_stats();
+        ASSERT_EQ(stats.usedBytes, 0);
+        ASSERT_EQ(stats.largeBytes, 0);
+        ASSERT_EQ(stats.allocations, stats.deallocations);
+        ASSERT_GT(stats.reservedBytes, 0);
+    }
+
+    TEST(pool_allocator, reuse_and_stats)
+    {
+        pool_allocator pool;
+
+        byte* const first = pool.allocate(40, 8);
+        pool.deallocate(first, 40, 8);
+
+        // The last freed block of the same class is the first to be reused
+        byte* const second = pool.allocate(48, 16);
+        ASSERT_EQ(first, second);
+
+        byte* const large = pool.allocate(pool_allocator::MaxSize + 1, 16);
+        byte* const overaligned = pool.allocate(16, pool_allocator::MaxAlignment * 2);
+
+        ASSERT_EQ(reinterpret_cast<uintptr>(overaligned) % (pool_allocator::MaxAlignment * 2), 0);
+
+        auto stats = pool.get_stats();
+        ASSERT_EQ(stats.usedBytes, 48);
+        ASSERT_EQ(stats.largeBytes, pool_allocator::MaxSize + 1 + 16);
+        ASSERT_EQ(stats.allocations, 4);
+        ASSERT_EQ(stats.deallocations, 1);
+        ASSERT_EQ(stats.reservedBytes, pool_allocator::SlabSize);
+
+        pool.deallocate(large, pool_allocator::MaxSize + 1, 16);
+        pool.deallocate(overaligned, 16, pool_allocator::MaxAlignment * 2);
+
+        // Releasing the pool frees the remaining block without deallocating it explicitly
+        pool.release_all();
+
+        stats = pool.get_stats();
+        ASSERT_EQ(stats.usedBytes, 0);
+        ASSERT_EQ(stats.largeBytes, 0);
+        ASSERT_EQ(stats.reservedBytes, 0);
+
+        // The pool is still usable after being released
+        byte* const third = pool.allocate(48, 16);
+        ASSERT_TRUE(third);
+        pool.deallocate(third, 48, 16);
+    }
+
+    TEST(pool_allocator, many_blocks)
+    {
+        pool_allocator pool;
+
+        constexpr usize N{10'000};
+        constexpr usize Size{96};
+
+        std::vector<byte*> blocks;
+
+        for (usize i = 0; i < N; ++i)
+        {
+            byte* const ptr = pool.allocate(Size, 32);
+            ASSERT_TRUE(ptr);
+            std::fill_n(ptr, Size, byte(i));
+            blocks.push_back(ptr);
+        }
+
+        // No block can be handed out twice
+        std::vector<byte*> sorted = blocks;
+        std::sort(sorted.begin(), sorted.end());
+        ASSERT_EQ(std::adjacent_find(sorted.begin(), sorted.end()), sorted.end());
+
+        for (usize i = 0; i < N; ++i)
+        {
+            ASSERT_EQ(blocks[i][Size - 1], byte(i));
+        }
+
+        std::shuffle(blocks.begin(), blocks.end(), std::mt19937{42});
+
+        for (byte* const ptr : blocks)
+        {
+            pool.deallocate(ptr, Size, 32);
+        }
+
+        ASSERT_EQ(pool.get_stats().usedBytes, 0);
+    }
+
+    TEST(pool_allocator, concurrent_cross_thread_free)
+    {
+        pool_allocator pool;
+
+        constexpr u32 ThreadsCount{4};
+        constexpr u32 Iterations{20'000};
+
+        // Each thread allocates blocks and hands them to the next thread, which frees them
+        std::vector<std::atomic<byte*>> mailboxes(ThreadsCount);
+        std::vector<std::thread> threads;
+
+        for (u32 t = 0; t < ThreadsCount; ++t)
+        {
+            threads.emplace_back(
+                [&, t]
+                {
+                    std::mt19937 rng{t};
+
+                    auto& outbox = mailboxes[t];
+                    auto& inbox = mailboxes[(t + 1) % ThreadsCount];
+
+                    for (u32 i = 0; i < Iterations; ++i)
+                    {
+                        byte* const ptr = pool.allocate(64, 16);
+                        ptr[0] = byte(t);
+
+                        // Only the owner stores blocks in its outbox, only the next thread takes them out
+                        if (outbox.load() == nullptr)
+                        {
+                            outbox.store(ptr);
+                        }
+                        else
+                        {
+                            pool.deallocate(ptr, 64, 16);
+                        }
+
+                        if (byte* const received = inbox.exchange(nullptr))
+                        {
+                            pool.deallocate(received, 64, 16);
+                        }
+
+                        if (rng() % 4 == 0)
+                        {
+                            const usize size = rng() % 1024;
+                            byte* const scratch = pool.allocate(size, 8);
+                            pool.deallocate(scratch, size, 8);
+                        }
+                    }
+                });
+        }
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        for (auto& mailbox : mailboxes)
+        {
+            if (byte* const ptr = mailbox.exchange(nullptr))
+            {
+                pool.deallocate(ptr, 64, 16);
+            }
+        }
+
+        ASSERT_EQ(pool.get_stats().usedBytes, 0);
+    }
+
+    TEST(pool_allocator, out_of_memory_is_fatal)
+    {
+        failing_allocator upstream;
+        pool_allocator pool{&upstream};
+
+        upstream.isFailing = true;
+
+        ASSERT_DEATH(pool.allocate(64, 16), "");
+        ASSERT_DEATH(pool.allocate(pool_allocator::MaxSize + 1, 16), "");
+    }
+}
\ No newline at end of file
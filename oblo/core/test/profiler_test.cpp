@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+
+#include <oblo/core/filesystem/file.hpp>
+#include <oblo/core/filesystem/filesystem.hpp>
+#include <oblo/core/string/string_builder.hpp>
+#include <oblo/trace/profiler.hpp>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace oblo::trace
+{
+    namespace
+    {
+        constexpr zone_source g_outerZone{"outer"};
+        constexpr zone_source g_innerZone{"inner"};
+
+        const zone_stats* find_stats(const dynamic_array<zone_stats>& stats, const zone_source& source)
+        {
+            const auto it = std::find_if(stats.begin(),
+                stats.end(),
+                [&source](const zone_stats& s) { return s.source == &source; });
+
+            return it == stats.end() ? nullptr : &*it;
+        }
+
+        void run_zones(u32 iterations)
+        {
+            for (u32 i = 0; i < iterations; ++i)
+            {
+                const profile_scope outer{&g_outerZone};
+
+                {
+                    const profile_scope inner{&g_innerZone};
+                }
+            }
+        }
+    }
+
+    TEST(profiler, capture_and_stats)
+    {
+        // Nothing is recorded outside of a capture
+        run_zones(10);
+
+        start_capture();
+        stop_capture();
+
+        ASSERT_EQ(get_capture_info().eventsCount, 0);
+
+        start_capture();
+
+        constexpr u32 ThreadsCount{4};
+        constexpr u32 Iterations{10'000};
+
+        std::vector<std::thread> threads;
+
+        for (u32 t = 0; t < ThreadsCount; ++t)
+        {
+            threads.emplace_back(
+                [t]
+                {
+                    set_thread_name(t % 2 == 0 ? "even" : "odd");
+                    run_zones(Iterations);
+                });
+        }
+
+        for (u32 f = 0; f < 3; ++f)
+        {
+            mark_frame_end();
+        }
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        stop_capture();
+
+        // Scopes entered after stopping are not recorded
+        run_zones(10);
+
+        const capture_info info = get_capture_info();
+        ASSERT_EQ(info.framesCount, 3);
+        ASSERT_EQ(info.eventsCount, 2 * ThreadsCount * Iterations);
+        ASSERT_EQ(info.droppedEventsCount, 0);
+
+        dynamic_array<zone_stats> stats;
+        get_zone_stats(stats);
+
+        ASSERT_EQ(stats.size(), 2);
+
+        const zone_stats* const outer = find_stats(stats, g_outerZone);
+        const zone_stats* const inner = find_stats(stats, g_innerZone);
+
+        ASSERT_TRUE(outer);
+        ASSERT_TRUE(inner);
+
+        ASSERT_EQ(outer->count, ThreadsCount * Iterations);
+        ASSERT_EQ(inner->count, ThreadsCount * Iterations);
+
+        // The outer zone contains the inner one, and it's sorted first by total time
+        ASSERT_EQ(&stats[0], outer);
+        ASSERT_GE(outer->totalMs, inner->totalMs);
+        ASSERT_LE(outer->meanMs, outer->maxMs);
+        ASSERT_LE(outer->p99Ms, outer->maxMs);
+
+        // Starting a new capture discards the previous one
+        start_capture();
+        run_zones(5);
+        stop_capture();
+
+        get_zone_stats(stats);
+        ASSERT_EQ(stats.size(), 2);
+        ASSERT_EQ(stats[0].count, 5);
+        ASSERT_EQ(stats[1].count, 5);
+    }
+
+    TEST(profiler, chrome_trace)
+    {
+        start_capture();
+
+        std::thread{[]
+            {
+                set_thread_name("worker \"quoted\"");
+                run_zones(2);
+            }}
+            .join();
+
+        mark_frame_end();
+        stop_capture();
+
+        constexpr cstring_view testDir{"./test/profiler/"};
+        filesystem::remove_all(testDir).assert_value();
+        filesystem::create_directories(testDir).assert_value();
+
+        constexpr cstring_view path{"./test/profiler/trace.json"};
+        ASSERT_TRUE(dump_chrome_trace(path));
+
+        string_builder content;
+        ASSERT_TRUE(filesystem::load_text_file_into_memory(content, path));
+
+        const std::string_view json{content.data(), content.size()};
+
+        ASSERT_TRUE(json.starts_with("{\"displayTimeUnit\": \"ms\", \"traceEvents\": ["));
+        ASSERT_NE(json.find(R"("name": "worker \"quoted\"")"), std::string_view::npos);
+        ASSERT_NE(json.find(R"("ph": "i", "s": "g")"), std::string_view::npos);
+
+        usize completeEvents = 0;
+
+        constexpr std::string_view completeEvent{R"("ph": "X")"};
+
+        for (auto pos = json.find(completeEvent); pos != std::string_view::npos;
+             pos = json.find(completeEvent, pos + 1))
+        {
+            ++completeEvents;
+        }
+
+        ASSERT_EQ(completeEvents, 4);
+    }
+
+    TEST(profiler, thread_buffers_are_reused)
+    {
+        start_capture();
+
+        constexpr u32 ThreadsCount{16};
+
+        for (u32 t = 0; t < ThreadsCount; ++t)
+        {
+            std::thread{[] { run_zones(1); }}.join();
+        }
+
+        stop_capture();
+
+        // Each thread exits before the next one starts, so they all record into the same buffer
+        const capture_info info = get_capture_info();
+        ASSERT_EQ(info.threadsCount, 1);
+        ASSERT_EQ(info.eventsCount, 2 * ThreadsCount);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include <oblo/core/dynamic_array.hpp>
+#include <oblo/core/radix_sort.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+namespace oblo
+{
+    namespace
+    {
+        template <typename Key>
+        void check_sorted_with_payloads(u32 count, Key keyMask)
+        {
+            std::mt19937_64 rng{42};
+
+            dynamic_array<Key> keys;
+            dynamic_array<u32> payloads;
+
+            keys.resize(count);
+            payloads.resize(count);
+
+            for (u32 i = 0; i < count; ++i)
+            {
+                keys[i] = Key(rng()) & keyMask;
+                payloads[i] = i;
+            }
+
+            dynamic_array<u32> expected;
+            expected.assign(payloads.begin(), payloads.end());
+
+            std::stable_sort(expected.begin(),
+                expected.end(),
+                [&keys](u32 lhs, u32 rhs) { return keys[lhs] < keys[rhs]; });
+
+            radix_sort(std::span<Key>{keys}, std::span<u32>{payloads});
+
+            for (u32 i = 0; i < count; ++i)
+            {
+                ASSERT_EQ(payloads[i], expected[i]);
+            }
+
+            ASSERT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+        }
+    }
+
+    TEST(radix_sort, u32_with_payloads)
+    {
+        check_sorted_with_payloads<u32>(10, ~u32{});
+        check_sorted_with_payloads<u32>(100'000, ~u32{});
+
+        // Many duplicates, to check stability
+        check_sorted_with_payloads<u32>(100'000, 0xFFu);
+    }
+
+    TEST(radix_sort, u64_with_payloads)
+    {
+        check_sorted_with_payloads<u64>(63, ~u64{});
+        check_sorted_with_payloads<u64>(100'000, ~u64{});
+
+        // Only the highest and the lowest digits are used, all other passes are skipped
+        check_sorted_with_payloads<u64>(100'000, 0xF0000000'000000F0ull);
+    }
+
+    TEST(radix_sort, keys_only)
+    {
+        std::mt19937 rng{42};
+
+        dynamic_array<u32> keys;
+        keys.resize(50'000);
+
+        std::generate(keys.begin(), keys.end(), rng);
+
+        dynamic_array<u32> expected;
+        expected.assign(keys.begin(), keys.end());
+        std::sort(expected.begin(), expected.end());
+
+        dynamic_array<u32> scratch;
+        scratch.resize(keys.size());
+
+        radix_sort_keys(std::span<u32>{keys}, std::span<u32>{scratch});
+
+        ASSERT_TRUE(std::equal(keys.begin(), keys.end(), expected.begin(), expected.end()));
+
+        // Sorting a sorted array is a no-op, even if all the passes run
+        radix_sort_keys(std::span<u32>{keys});
+
+        ASSERT_TRUE(std::equal(keys.begin(), keys.end(), expected.begin(), expected.end()));
+    }
+
+    TEST(radix_sort, prefix_histogram)
+    {
+        // 3D Morton codes on 30 bits, the top 3 bits of the code select the octant
+        constexpr u32 mortonBits = 30;
+
+        dynamic_array<u32> codes;
+
+        for (u32 octant = 0; octant < 8; ++octant)
+        {
+            for (u32 i = 0; i <= octant; ++i)
+            {
+                codes.push_back((octant << (mortonBits - 3)) | i);
+            }
+        }
+
+        u32 octants[8]{};
+        compute_key_histogram(std::span<const u32>{codes}, mortonBits - 3, 3, octants);
+
+        for (u32 octant = 0; octant < 8; ++octant)
+        {
+            ASSERT_EQ(octants[octant], octant + 1);
+        }
+
+        // With u32 keys, the 2 unused bits on top are the prefix
+        u32 unused[4]{};
+        compute_key_prefix_histogram(std::span<const u32>{codes}, 2, unused);
+
+        ASSERT_EQ(unused[0], codes.size());
+        ASSERT_EQ(std::accumulate(std::begin(unused), std::end(unused), 0u), codes.size());
+    }
+}
\ No newline at end of file
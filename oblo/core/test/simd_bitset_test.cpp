@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+
+#include <oblo/core/simd_bitset.hpp>
+
+#include <bitset>
+#include <random>
+
+namespace oblo
+{
+    namespace
+    {
+        template <u32 Bits>
+        simd_bitset<Bits> make_random(std::mt19937& rng, std::bitset<Bits>& reference, u32 density)
+        {
+            simd_bitset<Bits> r{};
+            reference.reset();
+
+            for (u32 i = 0; i < Bits; ++i)
+            {
+                if (rng() % density == 0)
+                {
+                    r.set(i);
+                    reference.set(i);
+                }
+            }
+
+            return r;
+        }
+
+        template <u32 Bits>
+        void expect_equal(const simd_bitset<Bits>& bitset, const std::bitset<Bits>& reference)
+        {
+            for (u32 i = 0; i < Bits; ++i)
+            {
+                ASSERT_EQ(bitset.test(i), reference.test(i));
+            }
+
+            ASSERT_EQ(bitset.count(), reference.count());
+        }
+    }
+
+    TEST(simd_bitset, set_reset_and_iteration)
+    {
+        simd_bitset<255> bitset{};
+        ASSERT_TRUE(bitset.is_empty());
+
+        constexpr u32 indices[] = {0, 1, 63, 64, 127, 128, 200, 254};
+
+        for (const u32 i : indices)
+        {
+            bitset.set(i);
+        }
+
+        ASSERT_FALSE(bitset.is_empty());
+        ASSERT_EQ(bitset.count(), std::size(indices));
+
+        u32 visited{0};
+
+        bitset.for_each_set_bit(
+            [&](u32 i)
+            {
+                ASSERT_LT(visited, std::size(indices));
+                ASSERT_EQ(i, indices[visited]);
+                ++visited;
+            });
+
+        ASSERT_EQ(visited, std::size(indices));
+
+        for (const u32 i : indices)
+        {
+            bitset.reset(i);
+        }
+
+        ASSERT_TRUE(bitset.is_empty());
+    }
+
+    TEST(simd_bitset, matches_reference)
+    {
+        // Using more than one lane, to cover the loops over lanes too
+        constexpr u32 Bits{500};
+
+        std::mt19937 rng{42};
+        std::bitset<Bits> a, b, c;
+
+        for (u32 iteration = 0; iteration < 1000; ++iteration)
+        {
+            const auto x = make_random<Bits>(rng, a, 2);
+            const auto y = make_random<Bits>(rng, b, 1 + iteration % 16);
+            const auto z = make_random<Bits>(rng, c, 1 + iteration % 64);
+
+            auto added = x;
+            added.add(y);
+            expect_equal<Bits>(added, a | b);
+
+            auto removed = x;
+            removed.remove(y);
+            expect_equal<Bits>(removed, a & ~b);
+
+            expect_equal<Bits>(x.intersection(y), a & b);
+
+            const bool includes = (a & b) == b;
+            const bool intersects = (a & c).any();
+
+            ASSERT_EQ(x.includes(y), includes);
+            ASSERT_EQ(x.intersects(z), intersects);
+            ASSERT_EQ(x.matches(y, z), includes && !intersects);
+
+            ASSERT_EQ(x == y, a == b);
+            ASSERT_TRUE(x == x);
+
+            if (includes)
+            {
+                ASSERT_EQ(y.signature() & ~x.signature(), 0);
+            }
+        }
+    }
+
+    TEST(simd_bitset, fused_matches)
+    {
+        simd_bitset<255> set{};
+        set.set(3);
+        set.set(70);
+        set.set(140);
+
+        simd_bitset<255> required{};
+        required.set(3);
+        required.set(140);
+
+        simd_bitset<255> forbidden{};
+        forbidden.set(71);
+
+        ASSERT_TRUE(set.matches(required, forbidden));
+        ASSERT_TRUE(set.matches({}, {}));
+
+        forbidden.set(70);
+        ASSERT_FALSE(set.matches(required, forbidden));
+
+        forbidden.reset(70);
+        required.set(254);
+        ASSERT_FALSE(set.matches(required, forbidden));
+
+        // Bits in the same position of different blocks end up in the same bit of the signature
+        ASSERT_EQ(set.signature(), (u64(1) << 3) | (u64(1) << 6) | (u64(1) << 12));
+        ASSERT_NE(required.signature() & ~set.signature(), 0);
+    }
+}
\ No newline at end of file
@@ -2,8 +2,11 @@
 
 #include <oblo/core/string/string_interner.hpp>
 
+#include <format>
 #include <random>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 namespace oblo
 {
@@ -91,4 +94,103 @@ namespace oblo
             }
         }
     }
+
+    TEST(string_interner, concurrent)
+    {
+        string_interner interner;
+        interner.init(32);
+
+        constexpr u32 threadsCount{8};
+        constexpr u32 stringsCount{1u << 14};
+
+        std::vector<std::string> strings;
+        strings.reserve(stringsCount);
+
+        for (u32 i = 0; i < stringsCount; ++i)
+        {
+            strings.emplace_back(std::format("string_{}", i));
+        }
+
+        std::vector<std::vector<h32<string>>> handles(threadsCount);
+        std::vector<std::thread> threads;
+
+        for (u32 t = 0; t < threadsCount; ++t)
+        {
+            threads.emplace_back(
+                [&, t]
+                {
+                    auto& threadHandles = handles[t];
+                    threadHandles.resize(stringsCount);
+
+                    // Each thread visits the strings in a different order, to make them race on the same strings
+                    for (u32 i = 0; i < stringsCount; ++i)
+                    {
+                        const u32 index = (i * 7919u + t * 131u) % stringsCount;
+                        const auto h = interner.get_or_add(strings[index]);
+                        threadHandles[index] = h;
+
+                        ASSERT_EQ(interner.str(h), string_view{strings[index]});
+                    }
+                });
+        }
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        ASSERT_EQ(interner.get_strings_count(), stringsCount);
+
+        for (u32 i = 0; i < stringsCount; ++i)
+        {
+            const auto h = handles[0][i];
+            ASSERT_TRUE(h);
+
+            for (u32 t = 1; t < threadsCount; ++t)
+            {
+                ASSERT_EQ(h, handles[t][i]);
+            }
+
+            ASSERT_EQ(interner.get(strings[i]), h);
+            ASSERT_EQ(interner.c_str(h), string_view{strings[i]});
+        }
+    }
+
+    TEST(string_interner, freeze)
+    {
+        string_interner interner;
+        interner.init(32);
+
+        constexpr u32 stringsCount{5000};
+
+        std::vector<h32<string>> handles;
+
+        for (u32 i = 0; i < stringsCount; ++i)
+        {
+            handles.push_back(interner.get_or_add(std::format("s{}", i)));
+        }
+
+        const auto* const c = interner.c_str(handles[42]);
+
+        ASSERT_TRUE(interner.freeze());
+
+        ASSERT_TRUE(interner.is_frozen());
+        ASSERT_EQ(interner.get_strings_count(), stringsCount);
+
+        // Strings are not moved when freezing
+        ASSERT_EQ(c, interner.c_str(handles[42]));
+
+        for (u32 i = 0; i < stringsCount; ++i)
+        {
+            const auto str = std::format("s{}", i);
+            ASSERT_EQ(interner.get(str), handles[i]);
+            ASSERT_EQ(interner.get_or_add(str), handles[i]);
+            ASSERT_EQ(interner.str(handles[i]), string_view{str});
+        }
+
+        // New strings cannot be added anymore
+        ASSERT_FALSE(interner.get("not_there"));
+        ASSERT_FALSE(interner.get_or_add("not_there"));
+        ASSERT_FALSE(interner.get(""));
+    }
 }
\ No newline at end of file
@@ -0,0 +1,116 @@
+#include "ecs_benchmark_utility.hpp"
+
+#include <oblo/core/dynamic_array.hpp>
+
+#include <algorithm>
+#include <random>
+
+namespace oblo::ecs::benchmarks
+{
+    namespace
+    {
+        dynamic_array<entity> make_shuffled(std::span<const entity> entities)
+        {
+            dynamic_array<entity> shuffled;
+            shuffled.assign(entities.begin(), entities.end());
+
+            // Fixed seed, to make runs comparable
+            std::mt19937 rng{42};
+            std::shuffle(shuffled.begin(), shuffled.end(), rng);
+
+            return shuffled;
+        }
+
+        void get_random_access(benchmark::State& state)
+        {
+            const u32 count = u32(state.range(0));
+
+            dynamic_array<entity> entities;
+            entities.resize(count);
+
+            entity_registry reg{&get_bench_type_registry()};
+            tuple_dispatch<first_n_components<4>>::create(reg, count, entities);
+
+            const auto shuffled = make_shuffled(entities);
+
+            for (auto _ : state)
+            {
+                u64 sum{};
+
+                for (const auto e : shuffled)
+                {
+                    sum += reg.get<bench_component<2>>(e).value;
+                }
+
+                benchmark::DoNotOptimize(sum);
+            }
+
+            set_entities_processed(state, count);
+        }
+
+        void try_get_random_access(benchmark::State& state)
+        {
+            const u32 count = u32(state.range(0));
+            const u32 half = count / 2;
+
+            dynamic_array<entity> entities;
+            entities.resize(count);
+
+            entity_registry reg{&get_bench_type_registry()};
+
+            // Only half of the entities have the component we look for
+            const std::span all{entities};
+            tuple_dispatch<first_n_components<4>>::create(reg, half, all.subspan(0, half));
+            tuple_dispatch<first_n_components<2>>::create(reg, count - half, all.subspan(half));
+
+            const auto shuffled = make_shuffled(entities);
+
+            for (auto _ : state)
+            {
+                u64 sum{};
+
+                for (const auto e : shuffled)
+                {
+                    if (const auto* c = reg.try_get<bench_component<3>>(e))
+                    {
+                        sum += c->value;
+                    }
+                }
+
+                benchmark::DoNotOptimize(sum);
+            }
+
+            set_entities_processed(state, count);
+        }
+
+        void get_sequential_access(benchmark::State& state)
+        {
+            const u32 count = u32(state.range(0));
+
+            dynamic_array<entity> entities;
+            entities.resize(count);
+
+            entity_registry reg{&get_bench_type_registry()};
+            tuple_dispatch<first_n_components<4>>::create(reg, count, entities);
+
+            // The baseline for the random access benchmarks, the lookup is the same but memory access is linear
+            for (auto _ : state)
+            {
+                u64 sum{};
+
+                for (const auto e : entities)
+                {
+                    sum += reg.get<bench_component<2>>(e).value;
+                }
+
+                benchmark::DoNotOptimize(sum);
+            }
+
+            set_entities_processed(state, count);
+        }
+    }
+
+    BENCHMARK(get_random_access)->Apply(entities_range);
+    BENCHMARK(try_get_random_access)->Apply(entities_range);
+    BENCHMARK(get_sequential_access)->Apply(entities_range);
+}
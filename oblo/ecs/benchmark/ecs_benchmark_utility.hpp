@@ -0,0 +1,99 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <oblo/core/types.hpp>
+#include <oblo/ecs/entity_registry.hpp>
+#include <oblo/ecs/range.hpp>
+#include <oblo/ecs/type_registry.hpp>
+#include <oblo/ecs/utility/registration.hpp>
+
+#include <tuple>
+#include <utility>
+
+namespace oblo::ecs::benchmarks
+{
+    template <u32 I>
+    struct bench_component
+    {
+        u32 value;
+    };
+
+    struct bench_tag
+    {
+    };
+
+    inline constexpr u32 MaxBenchComponents{8};
+
+    // Benchmarks scale from 1k to 10M entities, use --benchmark_filter to restrict the range
+    inline constexpr i64 MinEntities{1'000};
+    inline constexpr i64 MaxEntities{10'000'000};
+
+    namespace detail
+    {
+        template <typename Sequence>
+        struct make_components;
+
+        template <u32... I>
+        struct make_components<std::integer_sequence<u32, I...>>
+        {
+            using type = std::tuple<bench_component<I>...>;
+        };
+    }
+
+    /// @brief A std::tuple of the first N bench components.
+    template <u32 N>
+    using first_n_components = typename detail::make_components<std::make_integer_sequence<u32, N>>::type;
+
+    template <typename Tuple>
+    struct tuple_dispatch;
+
+    /// @brief Forwards the types of a std::tuple to the templated entity_registry functions.
+    template <typename... T>
+    struct tuple_dispatch<std::tuple<T...>>
+    {
+        static void create(entity_registry& reg, u32 count, std::span<entity> outEntityIds = {})
+        {
+            reg.create<T...>(count, outEntityIds);
+        }
+
+        template <typename F>
+        static void for_each_chunk(entity_registry& reg, F&& f)
+        {
+            reg.range<T...>().for_each_chunk(std::forward<F>(f));
+        }
+    };
+
+    /// @brief The type registry with all the bench components and tags registered, shared by all benchmarks.
+    inline type_registry& get_bench_type_registry()
+    {
+        struct registered_types
+        {
+            registered_types()
+            {
+                [this]<u32... I>(std::integer_sequence<u32, I...>)
+                {
+                    (register_type<bench_component<I>>(typeRegistry), ...);
+                }(std::make_integer_sequence<u32, MaxBenchComponents>{});
+
+                register_type<bench_tag>(typeRegistry);
+            }
+
+            type_registry typeRegistry;
+        };
+
+        static registered_types s_types;
+        return s_types.typeRegistry;
+    }
+
+    inline void set_entities_processed(benchmark::State& state, i64 entitiesPerIteration)
+    {
+        state.SetItemsProcessed(state.iterations() * entitiesPerIteration);
+    }
+
+    /// @brief Used with Apply to run a benchmark on every order of magnitude of entities, passed as range(0).
+    inline void entities_range(benchmark::internal::Benchmark* b)
+    {
+        b->RangeMultiplier(10)->Range(MinEntities, MaxEntities)->Unit(benchmark::kMicrosecond);
+    }
+}
@@ -0,0 +1,74 @@
+#include "ecs_benchmark_utility.hpp"
+
+namespace oblo::ecs::benchmarks
+{
+    namespace
+    {
+        template <u32 NumComponents>
+        void iterate_components(benchmark::State& state)
+        {
+            const u32 count = u32(state.range(0));
+
+            entity_registry reg{&get_bench_type_registry()};
+
+            // Entities have all components, only the first N are accessed
+            tuple_dispatch<first_n_components<MaxBenchComponents>>::create(reg, count);
+
+            for (auto _ : state)
+            {
+                u64 sum{};
+
+                tuple_dispatch<first_n_components<NumComponents>>::for_each_chunk(reg,
+                    [&sum](std::span<const entity> entities, auto... components)
+                    {
+                        for (usize i = 0; i < entities.size(); ++i)
+                        {
+                            sum += (components[i].value + ...);
+                        }
+                    });
+
+                benchmark::DoNotOptimize(sum);
+            }
+
+            set_entities_processed(state, count);
+        }
+
+        void iterate_range_for(benchmark::State& state)
+        {
+            const u32 count = u32(state.range(0));
+
+            entity_registry reg{&get_bench_type_registry()};
+
+            // The same layout of iterate_components, but going through the range iterator instead of for_each_chunk
+            tuple_dispatch<first_n_components<MaxBenchComponents>>::create(reg, count);
+
+            for (auto _ : state)
+            {
+                u64 sum{};
+
+                for (const auto [entities, components] : reg.range<bench_component<0>>())
+                {
+                    for (const auto& c : components)
+                    {
+                        sum += c.value;
+                    }
+                }
+
+                benchmark::DoNotOptimize(sum);
+            }
+
+            set_entities_processed(state, count);
+        }
+    }
+
+    BENCHMARK_TEMPLATE(iterate_components, 1)->Apply(entities_range);
+    BENCHMARK_TEMPLATE(iterate_components, 2)->Apply(entities_range);
+    BENCHMARK_TEMPLATE(iterate_components, 3)->Apply(entities_range);
+    BENCHMARK_TEMPLATE(iterate_components, 4)->Apply(entities_range);
+    BENCHMARK_TEMPLATE(iterate_components, 5)->Apply(entities_range);
+    BENCHMARK_TEMPLATE(iterate_components, 6)->Apply(entities_range);
+    BENCHMARK_TEMPLATE(iterate_components, 7)->Apply(entities_range);
+    BENCHMARK_TEMPLATE(iterate_components, 8)->Apply(entities_range);
+
+    BENCHMARK(iterate_range_for)->Apply(entities_range);
+}
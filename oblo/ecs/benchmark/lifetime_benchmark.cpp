@@ -0,0 +1,147 @@
+#include "ecs_benchmark_utility.hpp"
+
+#include <oblo/core/dynamic_array.hpp>
+
+namespace oblo::ecs::benchmarks
+{
+    namespace
+    {
+        using lifetime_components = first_n_components<4>;
+
+        void create_entities(benchmark::State& state)
+        {
+            const u32 count = u32(state.range(0));
+
+            for (auto _ : state)
+            {
+                entity_registry reg{&get_bench_type_registry()};
+
+                tuple_dispatch<lifetime_components>::create(reg, count);
+                benchmark::ClobberMemory();
+
+                // We only measure the creation
+                state.PauseTiming();
+                reg = {};
+                state.ResumeTiming();
+            }
+
+            set_entities_processed(state, count);
+        }
+
+        void destroy_entities(benchmark::State& state)
+        {
+            const u32 count = u32(state.range(0));
+
+            dynamic_array<entity> entities;
+            entities.resize(count);
+
+            for (auto _ : state)
+            {
+                state.PauseTiming();
+                entity_registry reg{&get_bench_type_registry()};
+                tuple_dispatch<lifetime_components>::create(reg, count, entities);
+                state.ResumeTiming();
+
+                for (const auto e : entities)
+                {
+                    reg.destroy(e);
+                }
+
+                benchmark::ClobberMemory();
+            }
+
+            set_entities_processed(state, count);
+        }
+
+        void create_and_destroy_entities(benchmark::State& state)
+        {
+            const u32 count = u32(state.range(0));
+
+            dynamic_array<entity> entities;
+            entities.resize(count);
+
+            // Reusing the same registry means we also measure the recycling of chunks and entity ids
+            entity_registry reg{&get_bench_type_registry()};
+
+            for (auto _ : state)
+            {
+                tuple_dispatch<lifetime_components>::create(reg, count, entities);
+
+                for (const auto e : entities)
+                {
+                    reg.destroy(e);
+                }
+
+                benchmark::ClobberMemory();
+            }
+
+            set_entities_processed(state, count);
+        }
+
+        void add_remove_churn(benchmark::State& state)
+        {
+            const u32 count = u32(state.range(0));
+
+            dynamic_array<entity> entities;
+            entities.resize(count);
+
+            entity_registry reg{&get_bench_type_registry()};
+            tuple_dispatch<lifetime_components>::create(reg, count, entities);
+
+            for (auto _ : state)
+            {
+                // Every add and remove moves the entity to a different archetype
+                for (const auto e : entities)
+                {
+                    reg.add<bench_component<7>>(e);
+                }
+
+                for (const auto e : entities)
+                {
+                    reg.remove<bench_component<7>>(e);
+                }
+
+                benchmark::ClobberMemory();
+            }
+
+            // Each entity goes through 2 structural changes
+            set_entities_processed(state, 2 * i64{count});
+        }
+
+        void add_remove_tag_churn(benchmark::State& state)
+        {
+            const u32 count = u32(state.range(0));
+
+            dynamic_array<entity> entities;
+            entities.resize(count);
+
+            entity_registry reg{&get_bench_type_registry()};
+            tuple_dispatch<lifetime_components>::create(reg, count, entities);
+
+            const auto tagSets = make_type_sets<bench_tag>(get_bench_type_registry());
+
+            for (auto _ : state)
+            {
+                for (const auto e : entities)
+                {
+                    reg.add(e, tagSets);
+                }
+
+                for (const auto e : entities)
+                {
+                    reg.remove(e, tagSets);
+                }
+
+                benchmark::ClobberMemory();
+            }
+
+            set_entities_processed(state, 2 * i64{count});
+        }
+    }
+
+    BENCHMARK(create_entities)->Apply(entities_range);
+    BENCHMARK(destroy_entities)->Apply(entities_range);
+    BENCHMARK(create_and_destroy_entities)->Apply(entities_range);
+    BENCHMARK(add_remove_churn)->Apply(entities_range);
+    BENCHMARK(add_remove_tag_churn)->Apply(entities_range);
+}
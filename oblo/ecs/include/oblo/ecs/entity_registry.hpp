@@ -1,9 +1,11 @@
 #pragma once
 
+#include <oblo/core/dynamic_array.hpp>
 #include <oblo/core/handle_flat_pool_map.hpp>
 #include <oblo/core/handle_pool.hpp>
 #include <oblo/core/type_id.hpp>
 #include <oblo/ecs/handles.hpp>
+#include <oblo/ecs/journal.hpp>
 #include <oblo/ecs/traits.hpp>
 #include <oblo/ecs/type_set.hpp>
 
@@ -17,6 +19,20 @@ namespace oblo::ecs
     struct component_and_tag_sets;
     struct type_set;
 
+    struct entity_registry_config
+    {
+        /// @brief The size in bytes of each archetype chunk, including its header. It has to be a power of two.
+        /// @remarks Smaller chunks waste less memory on small archetypes, bigger ones make iteration more linear.
+        u32 chunkSize{1u << 14};
+
+        /// @brief When not 0, chunks are allocated from a range of virtual memory of this size, reserved upfront and
+        /// committed on demand. Chunks that don't fit in the arena are allocated from the heap instead.
+        usize chunkArenaSize{0};
+
+        /// @brief Hints the system to back the chunk arena with huge pages, where supported.
+        bool useHugePages{false};
+    };
+
     class entity_registry final
     {
 
@@ -33,7 +49,10 @@ namespace oblo::ecs
         entity_registry& operator=(entity_registry&&) noexcept;
         ~entity_registry();
 
-        void init(type_registry* typeRegistry);
+        /// @brief Resets the registry, using the given configuration.
+        /// @remarks Fails when the chunk size is not a power of two or the chunk arena can't be reserved, in which case
+        /// the registry is left untouched.
+        bool init(type_registry* typeRegistry, const entity_registry_config& config = {});
 
         entity create(const component_and_tag_sets& types);
         void create(const component_and_tag_sets& types, u32 count, std::span<entity> outEntityIds = {});
@@ -108,6 +127,20 @@ namespace oblo::ecs
         /// This function allows extracting the index part of the handle.
         u32 extract_entity_index(ecs::entity e) const;
 
+        /// @brief Enables or disables recording of created, destroyed and archetype-changed entities.
+        void set_journaling_enabled(bool enable);
+
+        bool is_journaling_enabled() const;
+
+        /// @brief Returns the records added to the journal since the last read with the given cursor, and advances it.
+        /// @remarks Records survive two calls to trim_journal, so readers are expected to read at least once between
+        /// them, e.g. once per frame. Records that were already trimmed are skipped.
+        std::span<const journal_record> read_journal(journal_cursor& cursor) const;
+
+        /// @brief Discards the records that were already in the journal the last time this function was called.
+        /// @remarks Meant to be called once per frame.
+        void trim_journal();
+
     private:
         struct memory_pool;
         struct tags_storage;
@@ -155,11 +188,17 @@ namespace oblo::ecs
 
         void move_archetype(entity_data& entityData, const archetype_storage& newStorage);
 
+        void record(entity e, journal_event event, archetype_storage previous, archetype_storage current);
+
     private:
         type_registry* m_typeRegistry{nullptr};
         std::unique_ptr<memory_pool> m_pool;
         entities_map m_entities;
         std::vector<archetype_storage> m_componentsStorage;
+        dynamic_array<journal_record> m_journal;
+        u64 m_journalBase{};
+        u64 m_journalTrimPosition{};
+        bool m_isJournalingEnabled{};
     };
 
     template <typename... ComponentsOrTags>
@@ -283,7 +322,6 @@ namespace oblo::ecs
         const auto querySets = make_type_sets<ComponentsOrTags...>(*m_typeRegistry);
         const auto entitySets = get_type_sets(e);
 
-        return querySets.components.intersection(entitySets.components) == querySets.components &&
-            querySets.tags.intersection(entitySets.tags) == querySets.tags;
+        return entitySets.components.includes(querySets.components) && entitySets.tags.includes(querySets.tags);
     }
 }
\ No newline at end of file
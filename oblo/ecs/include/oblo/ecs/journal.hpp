@@ -0,0 +1,49 @@
+#pragma once
+
+#include <oblo/core/types.hpp>
+#include <oblo/ecs/archetype_storage.hpp>
+#include <oblo/ecs/handles.hpp>
+#include <oblo/ecs/type_set.hpp>
+
+namespace oblo::ecs
+{
+    enum class journal_event : u8
+    {
+        created,
+        destroyed,
+        archetype_changed,
+    };
+
+    /// @brief A structural change recorded by the entity_registry when journaling is enabled.
+    /// @remarks The previous archetype is empty for created entities, the current one is empty for destroyed entities.
+    struct journal_record
+    {
+        ecs::entity entity;
+        journal_event event;
+        archetype_storage previous;
+        archetype_storage current;
+    };
+
+    /// @brief Tracks the position of a reader in the journal of an entity_registry.
+    struct journal_cursor
+    {
+        u64 position;
+    };
+
+    /// @brief Checks whether the archetype contains all the includes and none of the excludes.
+    /// @remarks An empty archetype storage never matches.
+    bool matches(const archetype_storage& storage,
+        const component_and_tag_sets& includes,
+        const component_and_tag_sets& excludes = {});
+
+    /// @brief Checks whether the record makes the entity start matching the given sets.
+    bool has_entered(const journal_record& record,
+        const component_and_tag_sets& includes,
+        const component_and_tag_sets& excludes = {});
+
+    /// @brief Checks whether the record makes the entity stop matching the given sets, either because the entity was
+    /// destroyed or because of an archetype change.
+    bool has_exited(const journal_record& record,
+        const component_and_tag_sets& includes,
+        const component_and_tag_sets& excludes = {});
+}
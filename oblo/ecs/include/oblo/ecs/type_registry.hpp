@@ -1,10 +1,11 @@
 #pragma once
 
+#include <oblo/core/flat_hash_map.hpp>
 #include <oblo/core/type_id.hpp>
 #include <oblo/ecs/handles.hpp>
 
 #include <span>
-#include <unordered_map>
+#include <vector>
 
 namespace oblo::ecs
 {
@@ -46,7 +47,7 @@ namespace oblo::ecs
         struct any_type_info;
 
     private:
-        std::unordered_map<type_id, any_type_info> m_types;
+        flat_hash_map<type_id, any_type_info> m_types;
         std::vector<component_type_desc> m_components;
         std::vector<tag_type_desc> m_tags;
     };
@@ -1,12 +1,14 @@
 #pragma once
 
 #include <oblo/core/debug.hpp>
+#include <oblo/core/simd_bitset.hpp>
 #include <oblo/core/utility.hpp>
 #include <oblo/ecs/handles.hpp>
 #include <oblo/ecs/limits.hpp>
 #include <oblo/ecs/traits.hpp>
 #include <oblo/ecs/type_registry.hpp>
 
+#include <bit>
 #include <compare>
 
 namespace oblo::ecs
@@ -17,72 +19,62 @@ namespace oblo::ecs
         void add(h32<T> index)
         {
             OBLO_ASSERT(index);
-            const u64 maskOffset = index.value % BitsPerBlock;
-            const u64 mask = u64(1) << maskOffset;
-            const u64 block = index.value / BitsPerBlock;
-            bitset[block] |= mask;
+            bitset.set(index.value);
         }
 
         void add(const type_set& other)
         {
-            for (u32 i = 0; i < BlocksCount; ++i)
-            {
-                bitset[i] |= other.bitset[i];
-            }
+            bitset.add(other.bitset);
         }
 
         template <typename T>
         void remove(h32<T> index)
         {
             OBLO_ASSERT(index);
-            const u64 maskOffset = index.value % BitsPerBlock;
-            const u64 mask = u64(1) << maskOffset;
-            const u64 block = index.value / BitsPerBlock;
-            bitset[block] &= ~mask;
+            bitset.reset(index.value);
         }
 
         void remove(const type_set& other)
         {
-            for (u32 i = 0; i < BlocksCount; ++i)
-            {
-                bitset[i] &= ~other.bitset[i];
-            }
+            bitset.remove(other.bitset);
         }
 
-        constexpr bool is_empty() const
+        bool is_empty() const
         {
-            return *this == type_set{};
+            return bitset.is_empty();
         }
 
         template <typename T>
-        constexpr bool contains(h32<T> index) const
+        bool contains(h32<T> index) const
         {
             OBLO_ASSERT(index);
-            const u64 maskOffset = index.value % BitsPerBlock;
-            const u64 mask = u64(1) << maskOffset;
-            const u64 block = index.value / BitsPerBlock;
-            const u64 res = bitset[block] & mask;
-            return res != 0;
+            return bitset.test(index.value);
         }
 
-        [[nodiscard]] constexpr type_set intersection(const type_set& other) const
+        [[nodiscard]] type_set intersection(const type_set& other) const
         {
-            type_set r;
+            return {bitset.intersection(other.bitset)};
+        }
 
-            for (u32 i = 0; i < BlocksCount; ++i)
-            {
-                r.bitset[i] = bitset[i] & other.bitset[i];
-            }
+        /// @brief Checks whether all the types in the other set are also in this one.
+        bool includes(const type_set& other) const
+        {
+            return bitset.includes(other.bitset);
+        }
 
-            return r;
+        bool intersects(const type_set& other) const
+        {
+            return bitset.intersects(other.bitset);
         }
 
-        constexpr auto operator<=>(const type_set&) const = default;
+        u64 signature() const
+        {
+            return bitset.signature();
+        }
 
-        static constexpr u32 BitsPerBlock{64u};
-        static constexpr u32 BlocksCount{round_up_div(MaxComponentTypes, BitsPerBlock)};
+        auto operator<=>(const type_set&) const = default;
 
-        u64 bitset[BlocksCount];
+        simd_bitset<MaxComponentTypes + 1> bitset;
     };
 
     struct component_and_tag_sets
@@ -90,7 +82,20 @@ namespace oblo::ecs
         type_set components;
         type_set tags;
 
-        constexpr auto operator<=>(const component_and_tag_sets&) const = default;
+        /// @brief Checks whether all the types in includes are in the sets, and none of the ones in excludes are.
+        bool matches(const component_and_tag_sets& includes, const component_and_tag_sets& excludes) const
+        {
+            return components.bitset.matches(includes.components.bitset, excludes.components.bitset) &&
+                tags.bitset.matches(includes.tags.bitset, excludes.tags.bitset);
+        }
+
+        /// @brief Combines the signatures of both sets, preserving the subset relation (see simd_bitset::signature).
+        u64 signature() const
+        {
+            return components.signature() | std::rotl(tags.signature(), 32);
+        }
+
+        auto operator<=>(const component_and_tag_sets&) const = default;
     };
 
     template <typename... ComponentsOrTags>
@@ -1,58 +1,43 @@
 #include <oblo/ecs/archetype_impl.hpp>
 
-#include <oblo/core/array_size.hpp>
 #include <oblo/core/iterator/zip_range.hpp>
 #include <oblo/core/memory_pool.hpp>
 #include <oblo/ecs/archetype_storage.hpp>
+#include <oblo/ecs/chunk_allocator.hpp>
 #include <oblo/ecs/type_registry.hpp>
 #include <oblo/math/power_of_two.hpp>
 
 #include <algorithm>
+#include <cstddef>
 
 namespace oblo::ecs
 {
-    static_assert(sizeof(chunk) == ChunkWithHeaderSize);
+    static_assert(offsetof(chunk, data) == PageAlignment);
     static_assert(MaxComponentTypes <= std::numeric_limits<decltype(archetype_impl::numComponents)>::max());
 
     namespace
     {
         template <typename T, usize N>
-        std::span<T> make_type_span(std::span<T, N> inOut, type_set current)
+        std::span<T> make_type_span(std::span<T, N> inOut, const type_set& current)
         {
             u32 count{0};
 
-            for (usize i = 0; i < array_size(current.bitset); ++i)
-            {
-                const u64 v = current.bitset[i];
-
-                if (v == 0)
+            current.bitset.for_each_set_bit(
+                [&inOut, &count](u32 id)
                 {
-                    continue;
-                }
-
-                u32 nextId = u32(i * 32);
-
-                // TODO: Could use bitscan reverse instead
-                for (u64 mask = 1; mask != 0; mask <<= 1)
-                {
-                    if (v & mask)
-                    {
-                        inOut[count] = T{nextId};
-                        ++count;
-                    }
-
-                    ++nextId;
-                }
-            }
+                    inOut[count] = T{id};
+                    ++count;
+                });
 
             return inOut.subspan(0, count);
         }
     }
 
-    archetype_impl* create_archetype_impl(
-        memory_pool& pool, const type_registry& typeRegistry, const component_and_tag_sets& types)
+    archetype_impl* create_archetype_impl(memory_pool& pool,
+        const chunk_allocator& chunks,
+        const type_registry& typeRegistry,
+        const component_and_tag_sets& types)
     {
-
         component_type componentTypeHandlesArray[MaxComponentTypes];
         tag_type tagTypeHandlesArray[MaxTagTypes];
 
@@ -65,6 +50,7 @@ namespace oblo::ecs
 
         archetype_impl* storage = new (pool.allocate<archetype_impl>()) archetype_impl{
             .types = types,
+            .signature = types.signature(),
             .numComponents = numComponents,
             .numTags = numTags,
         };
@@ -121,7 +107,11 @@ namespace oblo::ecs
             }
         }
 
-        const u32 numEntitiesPerChunk = u32((ChunkSize - paddingWorstCase) / columnsSizeSum);
+        const u32 chunkDataSize = chunks.get_chunk_data_size();
+
+        const u32 numEntitiesPerChunk = u32((chunkDataSize - paddingWorstCase) / columnsSizeSum);
+        OBLO_ASSERT(numEntitiesPerChunk > 0, "The chunk size is too small for the archetype");
+
         storage->numEntitiesPerChunk = numEntitiesPerChunk;
 
         u32 currentOffset = 0;
@@ -152,7 +142,7 @@ namespace oblo::ecs
             storage->offsets[componentIndex] = startOffset;
 
             currentOffset = startOffset + size * numEntitiesPerChunk;
-            OBLO_ASSERT(currentOffset <= ChunkSize);
+            OBLO_ASSERT(currentOffset <= chunkDataSize);
 
             previousAlignment = alignment;
         }
@@ -160,7 +150,7 @@ namespace oblo::ecs
         return storage;
     }
 
-    void destroy_archetype_impl(memory_pool& pool, archetype_impl* storage)
+    void destroy_archetype_impl(memory_pool& pool, chunk_allocator& chunks, archetype_impl* storage)
     {
         const auto numComponents = storage->numComponents;
 
@@ -186,7 +176,7 @@ namespace oblo::ecs
                     numEntities -= numEntitiesInChunk;
                 }
 
-                pool.deallocate(*it);
+                chunks.deallocate(*it);
             }
 
             pool.deallocate_array(storage->chunks, numChunks);
@@ -209,7 +199,7 @@ namespace oblo::ecs
         pool.deallocate(storage);
     }
 
-    void reserve_chunks(memory_pool& pool, archetype_impl& archetype, u32 newCount)
+    void reserve_chunks(memory_pool& pool, chunk_allocator& chunks, archetype_impl& archetype, u32 newCount)
     {
         const u32 oldCount = archetype.numCurrentChunks;
 
@@ -231,7 +221,7 @@ namespace oblo::ecs
 
         for (chunk **it = newChunksArray + oldCount, **end = newChunksArray + newCount; it != end; ++it)
         {
-            chunk* const newChunk = pool.create_uninitialized<chunk>();
+            chunk* const newChunk = new (chunks.allocate()) chunk;
             *it = newChunk;
 
             newChunk->header = {};
@@ -14,12 +14,11 @@ namespace oblo
 
 namespace oblo::ecs
 {
+    class chunk_allocator;
     class type_registry;
     struct type_set;
 
     static constexpr usize PageAlignment{alignof(std::max_align_t)};
-    static constexpr u32 ChunkWithHeaderSize{1u << 14};
-    static constexpr u32 ChunkSize{ChunkWithHeaderSize - PageAlignment};
     static constexpr u8 InvalidComponentIndex{MaxComponentTypes + 1};
 
     struct chunk_header
@@ -30,7 +29,8 @@ namespace oblo::ecs
     struct chunk
     {
         chunk_header header;
-        alignas(PageAlignment) std::byte data[ChunkSize];
+        // The actual size depends on the chunk size the registry was configured with
+        alignas(PageAlignment) std::byte data[PageAlignment];
     };
 
     struct component_fn_table
@@ -84,6 +84,8 @@ namespace oblo::ecs
     struct archetype_impl
     {
         component_and_tag_sets types;
+        // Precomputed types.signature(), to quickly reject archetypes when matching queries
+        u64 signature;
         component_type* components;
         tag_type* tags;
         u32* offsets;
@@ -107,10 +109,12 @@ namespace oblo::ecs
         type_set types;
     };
 
-    archetype_impl* create_archetype_impl(
-        memory_pool& pool, const type_registry& typeRegistry, const component_and_tag_sets& types);
+    archetype_impl* create_archetype_impl(memory_pool& pool,
+        const chunk_allocator& chunks,
+        const type_registry& typeRegistry,
+        const component_and_tag_sets& types);
 
-    void destroy_archetype_impl(memory_pool& pool, archetype_impl* storage);
+    void destroy_archetype_impl(memory_pool& pool, chunk_allocator& chunks, archetype_impl* storage);
 
     inline entity* get_entity_pointer(std::byte* chunk, u32 offset)
     {
@@ -128,7 +132,7 @@ namespace oblo::ecs
         return chunk + archetype.offsets[componentIndex] + offset * archetype.sizes[componentIndex];
     }
 
-    void reserve_chunks(memory_pool& pool, archetype_impl& archetype, u32 newCount);
+    void reserve_chunks(memory_pool& pool, chunk_allocator& chunks, archetype_impl& archetype, u32 newCount);
 
     // TODO: Could be implemented with bitwise operations and type_set instead
     inline u8 find_component_index(std::span<const component_type> types, component_type component)
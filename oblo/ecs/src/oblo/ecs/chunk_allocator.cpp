@@ -0,0 +1,145 @@
+#include <oblo/ecs/chunk_allocator.hpp>
+
+#include <oblo/core/debug.hpp>
+#include <oblo/core/memory_pool.hpp>
+#include <oblo/core/platform/virtual_memory.hpp>
+#include <oblo/core/utility.hpp>
+#include <oblo/ecs/archetype_impl.hpp>
+#include <oblo/math/power_of_two.hpp>
+
+#include <cstddef>
+
+namespace oblo::ecs
+{
+    namespace
+    {
+        constexpr usize MinCommitSize{64u << 10};
+    }
+
+    struct chunk_allocator::free_chunk
+    {
+        free_chunk* next;
+    };
+
+    chunk_allocator::~chunk_allocator()
+    {
+        if (m_reservation)
+        {
+            platform::virtual_memory_release(m_reservation, m_reservationSize);
+        }
+    }
+
+    bool chunk_allocator::init(memory_pool& pool, u32 chunkSize, usize arenaSize, bool useHugePages)
+    {
+        OBLO_ASSERT(!m_pool, "The chunk allocator was already initialized");
+
+        if (!is_power_of_two(chunkSize) || chunkSize <= 2 * PageAlignment)
+        {
+            return false;
+        }
+
+        if (arenaSize == 0)
+        {
+            m_pool = &pool;
+            m_chunkSize = chunkSize;
+            return true;
+        }
+
+        const usize pageSize = platform::virtual_memory_page_size();
+
+        // Commit at least a few chunks at a time, or a whole huge page when we can use them
+        const usize commitGranularity =
+            round_up_multiple(max(usize{chunkSize}, useHugePages ? platform::HugePageSize : MinCommitSize), pageSize);
+
+        const usize usableSize = round_up_multiple(arenaSize, commitGranularity);
+
+        platform::virtual_memory_reservation reservation;
+
+        if (!platform::virtual_memory_reserve(usableSize, useHugePages, reservation))
+        {
+            return false;
+        }
+
+        m_pool = &pool;
+        m_chunkSize = chunkSize;
+        m_commitGranularity = commitGranularity;
+        m_reservation = static_cast<u8*>(reservation.base);
+        m_reservationSize = reservation.size;
+        m_arenaBegin = static_cast<u8*>(reservation.begin);
+        m_arenaEnd = m_arenaBegin + usableSize;
+        m_end = m_arenaBegin;
+        m_commitEnd = m_arenaBegin;
+
+        return true;
+    }
+
+    chunk* chunk_allocator::allocate()
+    {
+        OBLO_ASSERT(m_pool);
+
+        if (m_freeList)
+        {
+            free_chunk* const c = m_freeList;
+            m_freeList = c->next;
+            return reinterpret_cast<chunk*>(c);
+        }
+
+        if (usize(m_arenaEnd - m_end) >= m_chunkSize)
+        {
+            u8* const newEnd = m_end + m_chunkSize;
+
+            if (newEnd > m_commitEnd)
+            {
+                const usize commitSize = min(m_commitGranularity, usize(m_arenaEnd - m_commitEnd));
+
+                if (platform::virtual_memory_commit(m_commitEnd, commitSize))
+                {
+                    m_commitEnd += commitSize;
+                }
+            }
+
+            if (newEnd <= m_commitEnd)
+            {
+                auto* const c = reinterpret_cast<chunk*>(m_end);
+                m_end = newEnd;
+                return c;
+            }
+        }
+
+        return static_cast<chunk*>(m_pool->allocate_bytes(m_chunkSize, alignof(chunk)));
+    }
+
+    void chunk_allocator::deallocate(chunk* c)
+    {
+        if (is_in_arena(c))
+        {
+            auto* const f = new (c) free_chunk;
+            f->next = m_freeList;
+            m_freeList = f;
+        }
+        else
+        {
+            m_pool->deallocate_bytes(c, m_chunkSize, alignof(chunk));
+        }
+    }
+
+    u32 chunk_allocator::get_chunk_size() const
+    {
+        return m_chunkSize;
+    }
+
+    u32 chunk_allocator::get_chunk_data_size() const
+    {
+        return m_chunkSize - u32(offsetof(chunk, data));
+    }
+
+    usize chunk_allocator::get_committed_arena_size() const
+    {
+        return usize(m_commitEnd - m_arenaBegin);
+    }
+
+    bool chunk_allocator::is_in_arena(const void* ptr) const
+    {
+        return ptr >= m_arenaBegin && ptr < m_arenaEnd;
+    }
+}
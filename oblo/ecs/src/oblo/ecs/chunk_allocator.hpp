@@ -0,0 +1,59 @@
+#pragma once
+
+#include <oblo/core/types.hpp>
+
+namespace oblo
+{
+    class memory_pool;
+}
+
+namespace oblo::ecs
+{
+    struct chunk;
+
+    /// @brief Allocates archetype chunks, optionally from a range of virtual memory reserved upfront.
+    /// @remarks The arena is committed on demand and chunks are recycled through a free list, when the arena is
+    /// exhausted (or disabled) chunks are allocated from the memory pool instead.
+    class chunk_allocator
+    {
+    public:
+        chunk_allocator() = default;
+        chunk_allocator(const chunk_allocator&) = delete;
+        chunk_allocator(chunk_allocator&&) noexcept = delete;
+        chunk_allocator& operator=(const chunk_allocator&) = delete;
+        chunk_allocator& operator=(chunk_allocator&&) noexcept = delete;
+        ~chunk_allocator();
+
+        /// @brief Fails when the chunk size is not a power of two, or when the arena can't be reserved.
+        /// @remarks The allocator can't be used until it's successfully initialized.
+        bool init(memory_pool& pool, u32 chunkSize, usize arenaSize, bool useHugePages);
+
+        chunk* allocate();
+        void deallocate(chunk* c);
+
+        /// @brief The size of a chunk, including its header.
+        u32 get_chunk_size() const;
+
+        /// @brief The number of bytes available for entities and components in each chunk.
+        u32 get_chunk_data_size() const;
+
+        usize get_committed_arena_size() const;
+
+        bool is_in_arena(const void* ptr) const;
+
+    private:
+        struct free_chunk;
+
+    private:
+        memory_pool* m_pool{};
+        u8* m_reservation{};
+        usize m_reservationSize{};
+        u8* m_arenaBegin{};
+        u8* m_arenaEnd{};
+        u8* m_end{};
+        u8* m_commitEnd{};
+        usize m_commitGranularity{};
+        free_chunk* m_freeList{};
+        u32 m_chunkSize{};
+    };
+}
@@ -4,6 +4,7 @@
 #include <oblo/core/iterator/zip_range.hpp>
 #include <oblo/core/memory_pool.hpp>
 #include <oblo/ecs/archetype_impl.hpp>
+#include <oblo/ecs/chunk_allocator.hpp>
 #include <oblo/ecs/component_type_desc.hpp>
 #include <oblo/ecs/range.hpp>
 #include <oblo/ecs/type_registry.hpp>
@@ -25,6 +26,7 @@ namespace oblo::ecs
 
     struct entity_registry::memory_pool : oblo::memory_pool
     {
+        chunk_allocator chunks;
     };
 
     entity_registry::entity_registry() = default;
@@ -34,6 +36,14 @@ namespace oblo::ecs
         OBLO_ASSERT(m_typeRegistry);
 
         m_pool = std::make_unique<memory_pool>();
+
+        // The default configuration doesn't reserve an arena, so it can't fail
+        constexpr entity_registry_config defaultConfig{};
+
+        [[maybe_unused]] const bool chunksInitialized =
+            m_pool->chunks.init(*m_pool, defaultConfig.chunkSize, defaultConfig.chunkArenaSize, false);
+
+        OBLO_ASSERT(chunksInitialized);
     }
 
     entity_registry::entity_registry(entity_registry&&) noexcept = default;
@@ -49,13 +59,27 @@ namespace oblo::ecs
     {
         for (const auto& storage : m_componentsStorage)
         {
-            destroy_archetype_impl(*m_pool, storage.archetype);
+            destroy_archetype_impl(*m_pool, m_pool->chunks, storage.archetype);
         }
     }
 
-    void entity_registry::init(type_registry* typeRegistry)
+    bool entity_registry::init(type_registry* typeRegistry, const entity_registry_config& config)
     {
-        *this = entity_registry{typeRegistry};
+        OBLO_ASSERT(typeRegistry);
+
+        auto pool = std::make_unique<memory_pool>();
+
+        if (!pool->chunks.init(*pool, config.chunkSize, config.chunkArenaSize, config.useHugePages))
+        {
+            return false;
+        }
+
+        *this = entity_registry{};
+
+        m_typeRegistry = typeRegistry;
+        m_pool = std::move(pool);
+
+        return true;
     }
 
     entity entity_registry::create(const component_and_tag_sets& types)
@@ -82,7 +106,7 @@ namespace oblo::ecs
         const u32 newCount = oldCount + count;
         const u32 numRequiredChunks = round_up_div(newCount, numEntitiesPerChunk);
 
-        reserve_chunks(*m_pool, *archetype, numRequiredChunks);
+        reserve_chunks(*m_pool, m_pool->chunks, *archetype, numRequiredChunks);
 
         chunk** const chunks = archetype->chunks;
         const u32 firstChunkIndex = oldCount / numEntitiesPerChunk;
@@ -110,6 +134,8 @@ namespace oblo::ecs
 
                 new (it) entity{entityId};
 
+                record(entityId, journal_event::created, {}, storage);
+
                 if (outIt != outEntityIds.end())
                 {
                     *outIt = entityId;
@@ -146,6 +172,8 @@ namespace oblo::ecs
             return;
         }
 
+        record(e, journal_event::destroyed, {entityData->archetype}, {});
+
         move_last_and_pop(*entityData);
 
         m_entities.erase(e);
@@ -303,6 +331,43 @@ namespace oblo::ecs
         return decltype(m_entities)::extractor_type{}.extract_key(e);
     }
 
+    void entity_registry::set_journaling_enabled(bool enable)
+    {
+        m_isJournalingEnabled = enable;
+
+        if (!enable)
+        {
+            m_journalBase += m_journal.size();
+            m_journalTrimPosition = m_journalBase;
+            m_journal.clear();
+        }
+    }
+
+    bool entity_registry::is_journaling_enabled() const
+    {
+        return m_isJournalingEnabled;
+    }
+
+    std::span<const journal_record> entity_registry::read_journal(journal_cursor& cursor) const
+    {
+        const u64 end = m_journalBase + m_journal.size();
+        const usize offset = usize(max(cursor.position, m_journalBase) - m_journalBase);
+
+        cursor.position = end;
+
+        return {m_journal.data() + offset, m_journal.size() - offset};
+    }
+
+    void entity_registry::trim_journal()
+    {
+        const usize trimmedCount = usize(m_journalTrimPosition - m_journalBase);
+
+        m_journal.erase(m_journal.begin(), m_journal.begin() + trimmedCount);
+
+        m_journalBase = m_journalTrimPosition;
+        m_journalTrimPosition = m_journalBase + m_journal.size();
+    }
+
     const archetype_storage* entity_registry::find_first_match(const archetype_storage* begin,
         usize increment,
         const component_and_tag_sets& includes,
@@ -310,23 +375,19 @@ namespace oblo::ecs
     {
         auto* const end = m_componentsStorage.data() + m_componentsStorage.size();
 
+        const u64 includesSignature = includes.signature();
+
         for (auto* it = begin + increment; it != end; ++it)
         {
-            if (it->archetype->numCurrentEntities == 0)
+            const archetype_impl& archetype = *it->archetype;
+
+            // The signature check rejects most archetypes that miss some of the included types
+            if (archetype.numCurrentEntities == 0 || (includesSignature & ~archetype.signature) != 0)
             {
                 continue;
             }
 
-            const auto& archetypeTypes = it->archetype->types;
-
-            const auto compInt = archetypeTypes.components.intersection(includes.components);
-            const auto tagsInt = archetypeTypes.tags.intersection(includes.tags);
-
-            const auto forbiddenCompInt = archetypeTypes.components.intersection(excludes.components);
-            const auto forbiddenTagsInt = archetypeTypes.tags.intersection(excludes.tags);
-
-            if (compInt == includes.components && tagsInt == includes.tags && forbiddenCompInt.is_empty() &&
-                forbiddenTagsInt.is_empty())
+            if (archetype.types.matches(includes, excludes))
             {
                 return it;
             }
@@ -415,9 +476,11 @@ namespace oblo::ecs
 
     const archetype_storage& entity_registry::find_or_create_storage(const component_and_tag_sets& types)
     {
+        const u64 signature = types.signature();
+
         for (const auto& storage : m_componentsStorage)
         {
-            if (storage.archetype->types == types)
+            if (storage.archetype->signature == signature && storage.archetype->types == types)
             {
                 return storage;
             }
@@ -425,7 +488,7 @@ namespace oblo::ecs
 
         auto& newStorage = m_componentsStorage.emplace_back();
 
-        newStorage.archetype = create_archetype_impl(*m_pool, *m_typeRegistry, types);
+        newStorage.archetype = create_archetype_impl(*m_pool, m_pool->chunks, *m_typeRegistry, types);
 
         return newStorage;
     }
@@ -568,7 +631,7 @@ namespace oblo::ecs
 
         const auto [newChunkIndex, newChunkOffset] = get_entity_location(newArchetype, newArchetypeIndex);
 
-        reserve_chunks(*m_pool, newArchetype, newChunkIndex + 1);
+        reserve_chunks(*m_pool, m_pool->chunks, newArchetype, newChunkIndex + 1);
 
         // Move old components into the new ones
         chunk* const oldChunk = oldArchetype.chunks[oldChunkIndex];
@@ -626,5 +689,20 @@ namespace oblo::ecs
         // Update new chunk counters
         ++newChunk->header.numEntities;
         ++newArchetype.numCurrentEntities;
+
+        record(*newEntityPtr, journal_event::archetype_changed, {&oldArchetype}, newStorage);
+    }
+
+    void entity_registry::record(entity e, journal_event event, archetype_storage previous, archetype_storage current)
+    {
+        if (m_isJournalingEnabled)
+        {
+            m_journal.push_back({
+                .entity = e,
+                .event = event,
+                .previous = previous,
+                .current = current,
+            });
+        }
     }
 }
\ No newline at end of file
@@ -0,0 +1,32 @@
+#include <oblo/ecs/journal.hpp>
+
+#include <oblo/ecs/archetype_impl.hpp>
+
+namespace oblo::ecs
+{
+    bool matches(const archetype_storage& storage,
+        const component_and_tag_sets& includes,
+        const component_and_tag_sets& excludes)
+    {
+        if (!storage.archetype)
+        {
+            return false;
+        }
+
+        const archetype_impl& archetype = *storage.archetype;
+
+        return (includes.signature() & ~archetype.signature) == 0 && archetype.types.matches(includes, excludes);
+    }
+
+    bool has_entered(
+        const journal_record& record, const component_and_tag_sets& includes, const component_and_tag_sets& excludes)
+    {
+        return !matches(record.previous, includes, excludes) && matches(record.current, includes, excludes);
+    }
+
+    bool has_exited(
+        const journal_record& record, const component_and_tag_sets& includes, const component_and_tag_sets& excludes)
+    {
+        return matches(record.previous, includes, excludes) && !matches(record.current, includes, excludes);
+    }
+}
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+
+#include <oblo/core/iterator/zip_range.hpp>
+#include <oblo/ecs/entity_registry.hpp>
+#include <oblo/ecs/range.hpp>
+#include <oblo/ecs/type_registry.hpp>
+#include <oblo/ecs/utility/registration.hpp>
+
+#include <vector>
+
+namespace oblo::ecs
+{
+    namespace
+    {
+        struct mock_payload_component
+        {
+            u64 value;
+            f32 padding[6];
+        };
+
+        u32 create_and_check(entity_registry& reg, u32 count)
+        {
+            std::vector<entity> entities;
+            entities.resize(count);
+
+            reg.create<mock_payload_component>(count, entities);
+
+            for (u32 i = 0; i < count; ++i)
+            {
+                reg.get<mock_payload_component>(entities[i]).value = i;
+            }
+
+            // Destroy some to have chunks recycled when creating again
+            for (u32 i = 0; i < count; i += 3)
+            {
+                reg.destroy(entities[i]);
+            }
+
+            u64 sum{};
+            u32 alive{};
+            u32 chunks{};
+
+            for (const auto [ids, payloads] : reg.range<mock_payload_component>())
+            {
+                ++chunks;
+
+                for (const auto& [e, payload] : zip_range(ids, payloads))
+                {
+                    EXPECT_NE(payload.value % 3, 0);
+                    EXPECT_EQ(reg.get<mock_payload_component>(e).value, payload.value);
+                    sum += payload.value;
+                    ++alive;
+                }
+            }
+
+            u64 expectedSum{};
+
+            for (u32 i = 0; i < count; ++i)
+            {
+                if (i % 3 != 0)
+                {
+                    expectedSum += i;
+                }
+            }
+
+            EXPECT_EQ(sum, expectedSum);
+            EXPECT_EQ(alive, count - (count + 2) / 3);
+
+            for (u32 i = 0; i < count; ++i)
+            {
+                if (i % 3 != 0)
+                {
+                    reg.destroy(entities[i]);
+                }
+            }
+
+            return chunks;
+        }
+    }
+
+    TEST(chunk_config_test, chunk_size)
+    {
+        type_registry typeRegistry;
+        ASSERT_TRUE(register_type<mock_payload_component>(typeRegistry));
+
+        constexpr u32 N{4096};
+
+        entity_registry defaultRegistry{&typeRegistry};
+
+        entity_registry smallChunksRegistry;
+        ASSERT_TRUE(smallChunksRegistry.init(&typeRegistry, {.chunkSize = 1u << 12}));
+
+        const u32 defaultChunks = create_and_check(defaultRegistry, N);
+        const u32 smallChunks = create_and_check(smallChunksRegistry, N);
+
+        // Chunks are 4 times smaller, modulo the header and padding
+        ASSERT_GT(smallChunks, defaultChunks * 3);
+    }
+
+    TEST(chunk_config_test, arena)
+    {
+        type_registry typeRegistry;
+        ASSERT_TRUE(register_type<mock_payload_component>(typeRegistry));
+
+        constexpr u32 N{16384};
+
+        entity_registry arenaRegistry;
+        ASSERT_TRUE(arenaRegistry.init(&typeRegistry, {.chunkArenaSize = 1u << 20, .useHugePages = true}));
+
+        // This also overflows the arena, making the registry fall back to the heap
+        const u32 chunks = create_and_check(arenaRegistry, N);
+
+        // Chunks freed are reused the second time around
+        ASSERT_EQ(create_and_check(arenaRegistry, N), chunks);
+
+        entity_registry tinyArenaRegistry;
+        ASSERT_TRUE(tinyArenaRegistry.init(&typeRegistry, {.chunkSize = 1u << 12, .chunkArenaSize = 1u << 12}));
+
+        create_and_check(tinyArenaRegistry, N);
+    }
+
+    TEST(chunk_config_test, invalid_config)
+    {
+        type_registry typeRegistry;
+        ASSERT_TRUE(register_type<mock_payload_component>(typeRegistry));
+
+        entity_registry reg{&typeRegistry};
+
+        ASSERT_FALSE(reg.init(&typeRegistry, {.chunkSize = 3000}));
+        ASSERT_FALSE(reg.init(&typeRegistry, {.chunkSize = 16}));
+
+        // Larger than the address space, so the arena can't be reserved
+        ASSERT_FALSE(reg.init(&typeRegistry, {.chunkArenaSize = usize{1} << 62}));
+
+        // The registry is still usable after failing
+        create_and_check(reg, 1024);
+    }
+}
\ No newline at end of file
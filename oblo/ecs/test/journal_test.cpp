@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include <oblo/ecs/entity_registry.hpp>
+#include <oblo/ecs/journal.hpp>
+#include <oblo/ecs/type_registry.hpp>
+#include <oblo/ecs/type_set.hpp>
+#include <oblo/ecs/utility/registration.hpp>
+
+namespace oblo::ecs
+{
+    namespace
+    {
+        struct mock_position_component
+        {
+            f32 x, y;
+        };
+
+        struct mock_light_component
+        {
+            f32 intensity;
+        };
+
+        struct mock_disabled_tag
+        {
+        };
+    }
+
+    TEST(journal_test, records_structural_changes)
+    {
+        type_registry typeRegistry;
+
+        ASSERT_TRUE(register_type<mock_position_component>(typeRegistry));
+        ASSERT_TRUE(register_type<mock_light_component>(typeRegistry));
+        ASSERT_TRUE(register_type<mock_disabled_tag>(typeRegistry));
+
+        entity_registry reg{&typeRegistry};
+
+        // Changes are not recorded until journaling is enabled
+        reg.create<mock_position_component>();
+        reg.set_journaling_enabled(true);
+
+        journal_cursor cursor{};
+        ASSERT_TRUE(reg.read_journal(cursor).empty());
+
+        const auto lights = make_type_sets<mock_light_component>(typeRegistry);
+        const auto disabled = make_type_sets<mock_disabled_tag>(typeRegistry);
+
+        const auto a = reg.create<mock_position_component>();
+        const auto b = reg.create<mock_position_component, mock_light_component>();
+
+        {
+            const auto records = reg.read_journal(cursor);
+            ASSERT_EQ(records.size(), 2);
+
+            ASSERT_EQ(records[0].entity, a);
+            ASSERT_EQ(records[0].event, journal_event::created);
+            ASSERT_FALSE(records[0].previous.archetype);
+            ASSERT_FALSE(has_entered(records[0], lights));
+
+            ASSERT_EQ(records[1].entity, b);
+            ASSERT_EQ(records[1].event, journal_event::created);
+            ASSERT_TRUE(has_entered(records[1], lights));
+            ASSERT_FALSE(has_exited(records[1], lights));
+        }
+
+        // Reading again without changes gives nothing
+        ASSERT_TRUE(reg.read_journal(cursor).empty());
+
+        reg.add<mock_light_component>(a);
+        reg.add(b, disabled);
+        reg.destroy(b);
+
+        {
+            const auto records = reg.read_journal(cursor);
+            ASSERT_EQ(records.size(), 3);
+
+            ASSERT_EQ(records[0].entity, a);
+            ASSERT_EQ(records[0].event, journal_event::archetype_changed);
+            ASSERT_TRUE(has_entered(records[0], lights));
+
+            ASSERT_EQ(records[1].entity, b);
+            ASSERT_EQ(records[1].event, journal_event::archetype_changed);
+            ASSERT_FALSE(has_exited(records[1], lights));
+            ASSERT_TRUE(has_exited(records[1], lights, disabled));
+
+            ASSERT_EQ(records[2].entity, b);
+            ASSERT_EQ(records[2].event, journal_event::destroyed);
+            ASSERT_FALSE(records[2].current.archetype);
+            ASSERT_TRUE(has_exited(records[2], lights));
+            ASSERT_FALSE(has_exited(records[2], lights, disabled));
+        }
+    }
+
+    TEST(journal_test, trim)
+    {
+        type_registry typeRegistry;
+
+        ASSERT_TRUE(register_type<mock_position_component>(typeRegistry));
+
+        entity_registry reg{&typeRegistry};
+        reg.set_journaling_enabled(true);
+
+        journal_cursor eager{};
+        journal_cursor lazy{};
+
+        reg.create<mock_position_component>(4);
+
+        ASSERT_EQ(reg.read_journal(eager).size(), 4);
+
+        // The first trim keeps everything, since records need to survive at least a frame
+        reg.trim_journal();
+
+        reg.create<mock_position_component>(2);
+
+        ASSERT_EQ(reg.read_journal(eager).size(), 2);
+
+        // The second trim drops the records that were there before the first trim
+        reg.trim_journal();
+
+        ASSERT_EQ(reg.read_journal(lazy).size(), 2);
+        ASSERT_TRUE(reg.read_journal(eager).empty());
+
+        reg.trim_journal();
+        reg.create<mock_position_component>();
+
+        ASSERT_EQ(reg.read_journal(lazy).size(), 1);
+        ASSERT_EQ(reg.read_journal(eager).size(), 1);
+
+        // Disabling discards everything
+        reg.set_journaling_enabled(false);
+        reg.create<mock_position_component>();
+
+        ASSERT_TRUE(reg.read_journal(eager).empty());
+    }
+}
@@ -41,6 +41,11 @@ namespace oblo
 
         m_sceneRenderer->ensure_setup();
 
+        OBLO_ASSERT(ctx.entities->is_journaling_enabled());
+
+        m_lightTypes =
+            ecs::make_type_sets<light_component, global_transform_component>(ctx.entities->get_type_registry());
+
         // Hacky setup for directional light
         const auto e = ecs_utility::create_named_physical_entity<light_component, transient_tag>(*ctx.entities,
             "Sun",
@@ -74,9 +79,13 @@ namespace oblo
         dynamic_array<vk::light_data> lightData{ctx.frameAllocator};
         lightData.reserve(lightsCount);
 
-        for (auto& shadow : m_shadows.values())
+        // Only lights that were destroyed or lost their components since the last update need to be cleaned up
+        for (const auto& record : ctx.entities->read_journal(m_journalCursor))
         {
-            shadow.lightIndex = -1;
+            if (ecs::has_exited(record, m_lightTypes))
+            {
+                remove_shadow(record.entity);
+            }
         }
 
         for (const auto [entities, lights, transforms] : lightsRange)
@@ -104,6 +113,10 @@ namespace oblo
                     it->lightIndex = narrow_cast<i32>(lightData.size());
                     it->light = &light;
                 }
+                else
+                {
+                    remove_shadow(e);
+                }
 
                 lightData.push_back({
                     .position = {position.x, position.y, position.z},
@@ -122,113 +135,112 @@ namespace oblo
             .data = lightData,
         });
 
-        // TODO: (#57) We defer removal because we don't have a way to iterate and delete
-        buffered_array<ecs::entity, 8> removedShadows{ctx.frameAllocator};
         buffered_array<h32<vk::frame_graph_subgraph>, 4> lastFrameViews{ctx.frameAllocator};
 
         auto& frameGraph = m_sceneRenderer->get_frame_graph();
 
-        for (const auto& [e, shadow] : zip_range(m_shadows.keys(), m_shadows.values()))
+        for (auto& shadow : m_shadows.values())
         {
-            if (shadow.lightIndex < 0)
+            const auto shadowViews = shadow.shadowGraphs.keys();
+            lastFrameViews.assign(shadowViews.begin(), shadowViews.end());
+
+            for (const auto scene : lastFrameViews)
             {
-                for (const auto shadowGraph : shadow.shadowGraphs.values())
+                if (!m_sceneRenderer->is_scene_view(scene))
                 {
-                    frameGraph.remove(shadowGraph);
+                    shadow.shadowGraphs.erase(scene);
                 }
-
-                removedShadows.push_back(e);
-                shadow.shadowGraphs.clear();
             }
-            else
+
+            for (auto sceneView : m_sceneRenderer->get_scene_views())
             {
-                const auto shadowViews = shadow.shadowGraphs.keys();
-                lastFrameViews.assign(shadowViews.begin(), shadowViews.end());
+                auto* v = shadow.shadowGraphs.try_find(sceneView);
 
-                for (const auto scene : shadowViews)
+                if (!v)
                 {
-                    if (!m_sceneRenderer->is_scene_view(scene))
-                    {
-                        shadow.shadowGraphs.erase(scene);
-                    }
+                    const auto shadowMappingGraph = frameGraph.instantiate(m_rtShadows);
+
+                    frameGraph.connect(m_sceneRenderer->get_scene_data_provider(),
+                        vk::scene_data::OutLightBuffer,
+                        shadowMappingGraph,
+                        vk::raytraced_shadow_view::InLightBuffer);
+
+                    frameGraph.connect(sceneView,
+                        vk::main_view::OutCameraBuffer,
+                        shadowMappingGraph,
+                        vk::raytraced_shadow_view::InCameraBuffer);
+
+                    frameGraph.connect(sceneView,
+                        vk::main_view::OutResolution,
+                        shadowMappingGraph,
+                        vk::raytraced_shadow_view::InResolution);
+
+                    frameGraph.connect(sceneView,
+                        vk::main_view::OutDepthBuffer,
+                        shadowMappingGraph,
+                        vk::raytraced_shadow_view::InDepthBuffer);
+
+                    frameGraph.connect(sceneView,
+                        vk::main_view::OutVisibilityBuffer,
+                        shadowMappingGraph,
+                        vk::raytraced_shadow_view::InVisibilityBuffer);
+
+                    frameGraph.connect(shadowMappingGraph,
+                        vk::raytraced_shadow_view::OutShadowSink,
+                        sceneView,
+                        vk::main_view::InShadowSink);
+
+                    const auto sceneDataProvider = m_sceneRenderer->get_scene_data_provider();
+
+                    frameGraph.connect(sceneDataProvider,
+                        vk::scene_data::OutInstanceTables,
+                        shadowMappingGraph,
+                        vk::raytraced_shadow_view::InInstanceTables);
+                    frameGraph.connect(sceneDataProvider,
+                        vk::scene_data::OutInstanceBuffers,
+                        shadowMappingGraph,
+                        vk::raytraced_shadow_view::InInstanceBuffers);
+
+                    frameGraph.connect(sceneDataProvider,
+                        vk::scene_data::OutMeshDatabase,
+                        shadowMappingGraph,
+                        vk::raytraced_shadow_view::InMeshDatabase);
+
+                    const auto [it, ok] = shadow.shadowGraphs.emplace(sceneView, shadowMappingGraph);
+
+                    v = &*it;
                 }
 
-                for (auto sceneView : m_sceneRenderer->get_scene_views())
-                {
-                    auto* v = shadow.shadowGraphs.try_find(sceneView);
-
-                    if (!v)
-                    {
-                        const auto shadowMappingGraph = frameGraph.instantiate(m_rtShadows);
-
-                        frameGraph.connect(m_sceneRenderer->get_scene_data_provider(),
-                            vk::scene_data::OutLightBuffer,
-                            shadowMappingGraph,
-                            vk::raytraced_shadow_view::InLightBuffer);
-
-                        frameGraph.connect(sceneView,
-                            vk::main_view::OutCameraBuffer,
-                            shadowMappingGraph,
-                            vk::raytraced_shadow_view::InCameraBuffer);
-
-                        frameGraph.connect(sceneView,
-                            vk::main_view::OutResolution,
-                            shadowMappingGraph,
-                            vk::raytraced_shadow_view::InResolution);
-
-                        frameGraph.connect(sceneView,
-                            vk::main_view::OutDepthBuffer,
-                            shadowMappingGraph,
-                            vk::raytraced_shadow_view::InDepthBuffer);
-
-                        frameGraph.connect(sceneView,
-                            vk::main_view::OutVisibilityBuffer,
-                            shadowMappingGraph,
-                            vk::raytraced_shadow_view::InVisibilityBuffer);
-
-                        frameGraph.connect(shadowMappingGraph,
-                            vk::raytraced_shadow_view::OutShadowSink,
-                            sceneView,
-                            vk::main_view::InShadowSink);
-
-                        const auto sceneDataProvider = m_sceneRenderer->get_scene_data_provider();
-
-                        frameGraph.connect(sceneDataProvider,
-                            vk::scene_data::OutInstanceTables,
-                            shadowMappingGraph,
-                            vk::raytraced_shadow_view::InInstanceTables);
-                        frameGraph.connect(sceneDataProvider,
-                            vk::scene_data::OutInstanceBuffers,
-                            shadowMappingGraph,
-                            vk::raytraced_shadow_view::InInstanceBuffers);
-
-                        frameGraph.connect(sceneDataProvider,
-                            vk::scene_data::OutMeshDatabase,
-                            shadowMappingGraph,
-                            vk::raytraced_shadow_view::InMeshDatabase);
-
-                        const auto [it, ok] = shadow.shadowGraphs.emplace(sceneView, shadowMappingGraph);
-
-                        v = &*it;
-                    }
-
-                    const vk::raytraced_shadow_config cfg{
-                        .shadowSamples = max(1u, shadow.light->shadowSamples),
-                        .lightIndex = u32(shadow.lightIndex),
-                        .type = vk::light_type(shadow.light->type),
-                        .shadowPunctualRadius = shadow.light->shadowPunctualRadius,
-                        .temporalAccumulationFactor = shadow.light->shadowTemporalAccumulationFactor,
-                        .hardShadows = shadow.light->hardShadows,
-                    };
-
-                    frameGraph.set_input(*v, vk::raytraced_shadow_view::InConfig, cfg).assert_value();
-                }
+                const vk::raytraced_shadow_config cfg{
+                    .shadowSamples = max(1u, shadow.light->shadowSamples),
+                    .lightIndex = u32(shadow.lightIndex),
+                    .type = vk::light_type(shadow.light->type),
+                    .shadowPunctualRadius = shadow.light->shadowPunctualRadius,
+                    .temporalAccumulationFactor = shadow.light->shadowTemporalAccumulationFactor,
+                    .hardShadows = shadow.light->hardShadows,
+                };
+
+                frameGraph.set_input(*v, vk::raytraced_shadow_view::InConfig, cfg).assert_value();
             }
         }
+    }
 
-        for (auto e : removedShadows)
+    void lighting_system::remove_shadow(ecs::entity e)
+    {
+        auto* const shadow = m_shadows.try_find(e);
+
+        if (!shadow)
         {
-            m_shadows.erase(e);
+            return;
         }
+
+        auto& frameGraph = m_sceneRenderer->get_frame_graph();
+
+        for (const auto shadowGraph : shadow->shadowGraphs.values())
+        {
+            frameGraph.remove(shadowGraph);
+        }
+
+        m_shadows.erase(e);
     }
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include <oblo/core/handle_flat_pool_map.hpp>
 #include <oblo/ecs/forward.hpp>
+#include <oblo/ecs/journal.hpp>
 #include <oblo/vulkan/graph/frame_graph_template.hpp>
 
 namespace oblo::ecs
@@ -36,9 +37,14 @@ namespace oblo
     private:
         struct shadow_directional;
 
+    private:
+        void remove_shadow(ecs::entity e);
+
     private:
         scene_renderer* m_sceneRenderer{};
         vk::frame_graph_template m_rtShadows;
         h32_flat_extpool_dense_map<ecs::entity_handle, shadow_directional> m_shadows;
+        ecs::component_and_tag_sets m_lightTypes{};
+        ecs::journal_cursor m_journalCursor{};
     };
 };
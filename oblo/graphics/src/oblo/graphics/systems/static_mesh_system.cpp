@@ -150,6 +150,37 @@ namespace oblo
     {
         auto& drawRegistry = m_renderer->get_draw_registry();
 
+        // Reloaded textures are uploaded again in place, so the handles stored in the materials stay valid
+        m_resourceCache->update();
+
+        bool anyMaterialReloaded{false};
+
+        for (auto& [id, cached] : m_materials)
+        {
+            const auto version = cached.resource.get_version();
+            cached.isReloaded = cached.version != version;
+            cached.version = version;
+
+            anyMaterialReloaded |= cached.isReloaded;
+        }
+
+        if (anyMaterialReloaded)
+        {
+            for (const auto [entities, meshComponents, gpuMaterials] :
+                ctx.entities->range<static_mesh_component, gpu_material>())
+            {
+                for (auto&& [meshComponent, gpuMaterial] : zip_range(meshComponents, gpuMaterials))
+                {
+                    const auto it = m_materials.find(meshComponent.material.id);
+
+                    if (it != m_materials.end() && it->second.isReloaded)
+                    {
+                        gpuMaterial = convert(*m_resourceCache, it->second.resource);
+                    }
+                }
+            }
+        }
+
         struct deferred_creation
         {
             ecs::entity e;
@@ -188,7 +219,24 @@ namespace oblo
                 ctx.entities->add<gpu_material, entity_id_component, vk::draw_mesh_component, vk::draw_raytraced_tag>(
                     e);
 
-            gpuMaterial = convert(*m_resourceCache, m_resourceRegistry->get_resource(materialRef.id).as<material>());
+            resource_ptr<material> materialPtr;
+
+            if (const auto it = m_materials.find(materialRef.id); it != m_materials.end())
+            {
+                materialPtr = it->second.resource;
+            }
+            else if (materialPtr = m_resourceRegistry->get_resource(materialRef.id).as<material>(); materialPtr)
+            {
+                // Kept to detect when the material is reloaded, so that the entities using it are converted again
+                m_materials.emplace(materialRef.id,
+                    cached_material{
+                        .resource = materialPtr,
+                        .version = materialPtr.get_version(),
+                        .isReloaded = false,
+                    });
+            }
+
+            gpuMaterial = convert(*m_resourceCache, materialPtr);
             pickingId.entityId = e;
             meshComponent.mesh = mesh;
         }
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <oblo/core/flat_hash_map.hpp>
 #include <oblo/core/handle.hpp>
+#include <oblo/core/uuid.hpp>
+#include <oblo/resource/resource_ptr.hpp>
 
 namespace oblo::ecs
 {
@@ -16,6 +19,7 @@ namespace oblo::vk
 
 namespace oblo
 {
+    class material;
     class resource_registry;
 
     class static_mesh_system
@@ -24,6 +28,14 @@ namespace oblo
         void first_update(const ecs::system_update_context& ctx);
         void update(const ecs::system_update_context& ctx);
 
+    private:
+        struct cached_material
+        {
+            resource_ptr<material> resource;
+            u32 version;
+            bool isReloaded;
+        };
+
     private:
         vk::renderer* m_renderer{};
         resource_registry* m_resourceRegistry;
@@ -31,5 +43,6 @@ namespace oblo
         h32<vk::draw_buffer> m_transformBuffer{};
         h32<vk::draw_buffer> m_materialsBuffer{};
         h32<vk::draw_buffer> m_entityIdBuffer{};
+        flat_hash_map<uuid, cached_material> m_materials;
     };
 }
\ No newline at end of file
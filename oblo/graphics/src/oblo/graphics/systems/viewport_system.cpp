@@ -1,6 +1,5 @@
 #include <oblo/graphics/systems/viewport_system.hpp>
 
-#include <oblo/core/allocation_helpers.hpp>
 #include <oblo/core/array_size.hpp>
 #include <oblo/core/frame_allocator.hpp>
 #include <oblo/core/iterator/zip_range.hpp>
@@ -46,7 +45,6 @@ namespace oblo
 
     struct viewport_system::render_graph_data
     {
-        bool isAlive{};
         h32<vk::frame_graph_subgraph> subgraph{};
         h32<vk::texture> texture{};
         u32 width{};
@@ -206,6 +204,11 @@ namespace oblo
         OBLO_ASSERT(m_sceneRenderer);
         m_sceneRenderer->ensure_setup();
 
+        OBLO_ASSERT(ctx.entities->is_journaling_enabled());
+
+        m_viewportTypes = ecs::make_type_sets<global_transform_component, camera_component, viewport_component>(
+            ctx.entities->get_type_registry());
+
         create_vulkan_objects();
 
         update(ctx);
@@ -220,10 +223,13 @@ namespace oblo
         auto& rm = m_renderer->get_resource_manager();
         auto& frameGraph = m_renderer->get_frame_graph();
 
-        for (auto& renderGraphData : m_renderGraphs.values())
+        // Release the graphs of viewports that were destroyed or lost their components since the last update
+        for (const auto& record : ctx.entities->read_journal(m_journalCursor))
         {
-            // Set to false to garbage collect
-            renderGraphData.isAlive = false;
+            if (ecs::has_exited(record, m_viewportTypes))
+            {
+                remove_render_graph(record.entity);
+            }
         }
 
         for (const auto [entities, transforms, cameras, viewports] :
@@ -238,7 +244,6 @@ namespace oblo
                 if (!renderGraphData)
                 {
                     const auto [it, ok] = m_renderGraphs.emplace(entity);
-                    it->isAlive = true;
 
                     const auto registry = vk::create_frame_graph_registry();
 
@@ -257,10 +262,6 @@ namespace oblo
 
                     isFirstFrame = true;
                 }
-                else
-                {
-                    renderGraphData->isAlive = true;
-                }
 
                 constexpr auto viewportImageLayout{VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL};
 
@@ -435,34 +436,23 @@ namespace oblo
             }
         }
 
-        if (!m_renderGraphs.empty())
-        {
-            // TODO: Should implement an iterator for flat_dense_map instead, and erase using that
-            auto* const elementsToRemove = allocate_n<ecs::entity>(*ctx.frameAllocator, m_renderGraphs.size());
-            u32 numRemovedElements{0};
-
-            for (auto&& [entity, renderGraphData] : zip_range(m_renderGraphs.keys(), m_renderGraphs.values()))
-            {
-                if (renderGraphData.isAlive)
-                {
-                    continue;
-                }
-
-                m_renderer->get_frame_graph().remove(renderGraphData.subgraph);
-                m_sceneRenderer->remove_scene_view(renderGraphData.subgraph);
-                destroy_graph_vulkan_objects(renderGraphData);
+        ++m_frameIndex;
+    }
 
-                elementsToRemove[numRemovedElements] = entity;
-                ++numRemovedElements;
-            }
+    void viewport_system::remove_render_graph(ecs::entity e)
+    {
+        auto* const renderGraphData = m_renderGraphs.try_find(e);
 
-            for (auto e : std::span(elementsToRemove, numRemovedElements))
-            {
-                m_renderGraphs.erase(e);
-            }
+        if (!renderGraphData)
+        {
+            return;
         }
 
-        ++m_frameIndex;
+        m_renderer->get_frame_graph().remove(renderGraphData->subgraph);
+        m_sceneRenderer->remove_scene_view(renderGraphData->subgraph);
+        destroy_graph_vulkan_objects(*renderGraphData);
+
+        m_renderGraphs.erase(e);
     }
 
     namespace
@@ -2,6 +2,7 @@
 
 #include <oblo/core/flat_dense_map.hpp>
 #include <oblo/ecs/forward.hpp>
+#include <oblo/ecs/journal.hpp>
 
 #include <vulkan/vulkan.h>
 
@@ -39,6 +40,8 @@ namespace oblo
 
         bool prepare_picking_buffers(render_graph_data& graphData);
 
+        void remove_render_graph(ecs::entity e);
+
     private:
         vk::renderer* m_renderer{};
         scene_renderer* m_sceneRenderer{};
@@ -48,5 +51,7 @@ namespace oblo
         u32 m_frameIndex{};
 
         flat_dense_map<ecs::entity, render_graph_data> m_renderGraphs;
+        ecs::component_and_tag_sets m_viewportTypes{};
+        ecs::journal_cursor m_journalCursor{};
     };
 };
@@ -0,0 +1,64 @@
+#include <benchmark/benchmark.h>
+
+#include <oblo/log/deferred.hpp>
+#include <oblo/log/log.hpp>
+#include <oblo/log/log_module.hpp>
+#include <oblo/log/log_sink.hpp>
+#include <oblo/modules/module_manager.hpp>
+
+namespace oblo::log
+{
+    namespace
+    {
+        class null_sink final : public log_sink
+        {
+        public:
+            void sink(severity, time, cstring_view message) override
+            {
+                benchmark::DoNotOptimize(message.data());
+            }
+        };
+
+        // Messages are dropped when the log thread can't keep up, which is fine since only the call site is measured
+        log_module* init_log_module(module_manager& mm)
+        {
+            auto* const logModule = mm.load<log_module>();
+            logModule->set_overflow_policy(overflow_policy::drop);
+            logModule->add_sink(std::make_unique<null_sink>());
+            return logModule;
+        }
+    }
+
+    void log_formatted(benchmark::State& state)
+    {
+        module_manager mm;
+        init_log_module(mm);
+
+        u32 frame{};
+
+        for (auto _ : state)
+        {
+            log::info("Frame {} took {:.2f}ms on {}", ++frame, 16.6f, "renderer");
+        }
+
+        log::flush();
+    }
+
+    void log_deferred(benchmark::State& state)
+    {
+        module_manager mm;
+        init_log_module(mm);
+
+        u32 frame{};
+
+        for (auto _ : state)
+        {
+            log::deferred_info<"Frame {} took {:.2f}ms on {}">(++frame, 16.6f, "renderer");
+        }
+
+        log::flush();
+    }
+
+    BENCHMARK(log_formatted);
+    BENCHMARK(log_deferred);
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <oblo/core/dynamic_array.hpp>
+#include <oblo/core/expected.hpp>
+#include <oblo/core/string/cstring_view.hpp>
+#include <oblo/core/string/string_view.hpp>
+#include <oblo/core/time/time.hpp>
+#include <oblo/core/types.hpp>
+#include <oblo/log/deferred.hpp>
+
+#include <span>
+
+namespace oblo::log
+{
+    // A binary log starts with a binary_log_header, followed by a sequence of chunks. Call sites are described by a
+    // site chunk the first time they are referenced, records only contain the site id and the encoded arguments.
+
+    constexpr u32 BinaryLogMagic{0x474C424F}; // OBLG
+    constexpr u32 BinaryLogVersion{1};
+
+    struct binary_log_header
+    {
+        u32 magic;
+        u32 version;
+    };
+
+    enum class binary_log_chunk_kind : u32
+    {
+        site,
+        record,
+    };
+
+    struct binary_log_chunk_header
+    {
+        binary_log_chunk_kind kind;
+        /// @brief Size of the chunk, excluding this header.
+        u32 size;
+    };
+
+    /// @brief Follows a site chunk header, followed by argsCount argument types and the format string.
+    struct binary_log_site
+    {
+        u32 id;
+        u8 severity;
+        u8 argsCount;
+        u16 formatLength;
+    };
+
+    /// @brief Follows a record chunk header, followed by the encoded arguments.
+    struct binary_log_record
+    {
+        u32 siteId;
+        u32 argsSize;
+        time timestamp;
+    };
+
+    struct binary_log_message
+    {
+        log::severity severity;
+        time timestamp;
+        cstring_view message;
+    };
+
+    /// @brief Reads a binary log, formatting the messages one at a time.
+    class LOG_API binary_log_reader
+    {
+    public:
+        /// @brief Validates the header, the data has to outlive the reader.
+        expected<> init(std::span<const byte> data);
+
+        /// @brief Decodes the next message, the message string is valid until the next call.
+        /// @return false when the end of the log is reached, an error if the log is malformed.
+        expected<bool> read_next(binary_log_message& out);
+
+    private:
+        struct site
+        {
+            log::severity severity;
+            std::span<const deferred_arg_type> argTypes;
+            string_view format;
+        };
+
+    private:
+        std::span<const byte> m_data;
+        usize m_offset{};
+        dynamic_array<site> m_sites;
+        char m_message[detail::MaxLogMessageLength + 1];
+    };
+}
\ No newline at end of file
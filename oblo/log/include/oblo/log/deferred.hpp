@@ -0,0 +1,236 @@
+#pragma once
+
+#include <oblo/core/expected.hpp>
+#include <oblo/core/string/fixed_string.hpp>
+#include <oblo/core/string/string_view.hpp>
+#include <oblo/core/types.hpp>
+#include <oblo/log/log.hpp>
+
+#include <concepts>
+#include <cstring>
+#include <format>
+#include <span>
+#include <type_traits>
+
+namespace oblo::log
+{
+    /// @brief How an argument of a deferred log call is encoded in the record.
+    enum class deferred_arg_type : u8
+    {
+        boolean,
+        character,
+        i64,
+        u64,
+        f64,
+        pointer,
+        /// @brief A u16 length followed by the characters, without null-terminator.
+        string,
+    };
+
+    /// @brief Static description of a deferred log call site, the records only reference it by id.
+    struct deferred_site
+    {
+        log::severity severity;
+        u8 argsCount;
+        const deferred_arg_type* argTypes;
+        const char* format;
+    };
+
+    /// @brief Upper bound for the encoded arguments of a record, longer strings are truncated to fit.
+    constexpr u32 MaxDeferredArgsSize{256};
+
+    constexpr u32 MaxDeferredArgsCount{16};
+
+    /// @brief Formats the encoded arguments of a deferred record, truncating the output if it doesn't fit.
+    /// @remarks Replacement fields with nested arguments (e.g. dynamic width) are not supported.
+    /// @return The number of characters written, or an error if the arguments don't match the types.
+    LOG_API expected<usize> format_deferred(
+        string_view format, std::span<const deferred_arg_type> types, std::span<const byte> args, std::span<char> out);
+
+    namespace detail
+    {
+        template <typename T>
+        concept deferred_string = std::same_as<T, const char*> || std::same_as<T, char*> || requires(const T& s) {
+            { s.data() } -> std::convertible_to<const char*>;
+            { s.size() } -> std::convertible_to<usize>;
+        };
+
+        template <typename T>
+        consteval deferred_arg_type get_deferred_arg_type()
+        {
+            if constexpr (std::same_as<T, bool>)
+            {
+                return deferred_arg_type::boolean;
+            }
+            else if constexpr (std::same_as<T, char>)
+            {
+                return deferred_arg_type::character;
+            }
+            else if constexpr (std::signed_integral<T>)
+            {
+                return deferred_arg_type::i64;
+            }
+            else if constexpr (std::unsigned_integral<T>)
+            {
+                return deferred_arg_type::u64;
+            }
+            else if constexpr (std::floating_point<T>)
+            {
+                return deferred_arg_type::f64;
+            }
+            else if constexpr (deferred_string<T>)
+            {
+                return deferred_arg_type::string;
+            }
+            else
+            {
+                static_assert(std::is_pointer_v<T>, "Unsupported type for deferred logging");
+                return deferred_arg_type::pointer;
+            }
+        }
+
+        template <deferred_arg_type Type>
+        struct deferred_decoded;
+
+        // clang-format off
+        template <> struct deferred_decoded<deferred_arg_type::boolean> { using type = bool; };
+        template <> struct deferred_decoded<deferred_arg_type::character> { using type = char; };
+        template <> struct deferred_decoded<deferred_arg_type::i64> { using type = i64; };
+        template <> struct deferred_decoded<deferred_arg_type::u64> { using type = u64; };
+        template <> struct deferred_decoded<deferred_arg_type::f64> { using type = f64; };
+        template <> struct deferred_decoded<deferred_arg_type::pointer> { using type = const void*; };
+        template <> struct deferred_decoded<deferred_arg_type::string> { using type = const char*; };
+        // clang-format on
+
+        /// @brief The type the argument is formatted as, which is used to validate the format string at compile time.
+        template <typename T>
+        using deferred_decoded_t = typename deferred_decoded<get_deferred_arg_type<std::decay_t<T>>()>::type;
+
+        template <typename T>
+        usize write_deferred_arg(byte* out, usize available, const T& value)
+        {
+            using arg_type = std::decay_t<T>;
+            constexpr auto type = get_deferred_arg_type<arg_type>();
+
+            if constexpr (type == deferred_arg_type::string)
+            {
+                const char* data;
+                usize size;
+
+                if constexpr (std::is_pointer_v<arg_type>)
+                {
+                    data = value;
+                    size = value ? std::strlen(value) : 0;
+                }
+                else
+                {
+                    data = value.data();
+                    size = value.size();
+                }
+
+                const u16 length = u16(available < sizeof(u16) + size ? available - sizeof(u16) : size);
+
+                std::memcpy(out, &length, sizeof(u16));
+                std::memcpy(out + sizeof(u16), data, length);
+
+                return sizeof(u16) + length;
+            }
+            else
+            {
+                using decoded_type = deferred_decoded_t<arg_type>;
+                const auto decoded = decoded_type(value);
+
+                std::memcpy(out, &decoded, sizeof(decoded));
+                return sizeof(decoded);
+            }
+        }
+
+        template <typename T>
+        constexpr usize get_deferred_arg_reserved_size()
+        {
+            if constexpr (get_deferred_arg_type<std::decay_t<T>>() == deferred_arg_type::string)
+            {
+                return sizeof(u16);
+            }
+            else
+            {
+                return sizeof(deferred_decoded_t<T>);
+            }
+        }
+
+        LOG_API u32 register_deferred_site(const deferred_site& site);
+
+        LOG_API void push_deferred_record(u32 siteId, const byte* args, u32 argsSize);
+    }
+
+    /// @brief Logs a message, deferring the formatting to the log thread or to the decoding of the binary log.
+    /// @remarks The call site only records the id of the format string, a timestamp and a copy of the arguments in a
+    /// buffer owned by the calling thread. Only arithmetic types, pointers and strings are supported, strings are
+    /// copied and might be truncated. Messages are dropped when the buffer of the thread is full.
+    template <severity Severity, fixed_string Format, typename... Args>
+    void deferred(const Args&... args)
+    {
+        static_assert(sizeof...(Args) <= MaxDeferredArgsCount);
+
+        // Validates the format string against the types used for formatting later on
+        [[maybe_unused]] constexpr std::format_string<detail::deferred_decoded_t<Args>...> check{Format.c_str()};
+
+        static constexpr deferred_arg_type argTypes[] = {
+            detail::get_deferred_arg_type<std::decay_t<Args>>()...,
+            deferred_arg_type{},
+        };
+
+        static const u32 siteId = detail::register_deferred_site({
+            .severity = Severity,
+            .argsCount = u8(sizeof...(Args)),
+            .argTypes = argTypes,
+            .format = Format.c_str(),
+        });
+
+        constexpr usize reservedSize = (usize{} + ... + detail::get_deferred_arg_reserved_size<Args>());
+        static_assert(reservedSize <= MaxDeferredArgsSize);
+
+        byte buffer[MaxDeferredArgsSize];
+        usize offset{};
+
+        // Strings can only use the space left after reserving the fixed size arguments
+        usize available = MaxDeferredArgsSize - reservedSize;
+
+        (
+            [&](const auto& arg)
+            {
+                constexpr usize reserved = detail::get_deferred_arg_reserved_size<decltype(arg)>();
+                const usize written = detail::write_deferred_arg(buffer + offset, available + reserved, arg);
+
+                offset += written;
+                available -= written - reserved;
+            }(args),
+            ...);
+
+        detail::push_deferred_record(siteId, buffer, u32(offset));
+    }
+
+    template <fixed_string Format, typename... Args>
+    void deferred_debug(const Args&... args)
+    {
+        deferred<severity::debug, Format>(args...);
+    }
+
+    template <fixed_string Format, typename... Args>
+    void deferred_info(const Args&... args)
+    {
+        deferred<severity::info, Format>(args...);
+    }
+
+    template <fixed_string Format, typename... Args>
+    void deferred_warn(const Args&... args)
+    {
+        deferred<severity::warn, Format>(args...);
+    }
+
+    template <fixed_string Format, typename... Args>
+    void deferred_error(const Args&... args)
+    {
+        deferred<severity::error, Format>(args...);
+    }
+}
\ No newline at end of file
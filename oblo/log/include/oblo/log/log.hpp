@@ -19,13 +19,21 @@ namespace oblo::log
     namespace detail
     {
         static constexpr usize MaxLogMessageLength{1023u};
+
+        /// @brief Returns a buffer of MaxLogMessageLength + 1 characters, owned by the calling thread.
+        LOG_API char* get_format_buffer();
+
         LOG_API void sink_it(severity severity, time t, char* str, usize n);
     }
 
+    /// @brief Blocks until all the messages logged so far have been processed by the sinks.
+    /// @remarks Messages are processed asynchronously by a dedicated thread, errors are flushed automatically.
+    LOG_API void flush();
+
     template <typename... Args>
     void generic(severity severity, std::format_string<Args...> formatString, Args&&... args)
     {
-        char buffer[detail::MaxLogMessageLength + 1];
+        char* const buffer = detail::get_format_buffer();
 
         const auto endIt =
             std::format_to_n(buffer, detail::MaxLogMessageLength, formatString, std::forward<Args>(args)...);
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <oblo/core/filesystem/file_ptr.hpp>
+#include <oblo/core/types.hpp>
 #include <oblo/modules/module_interface.hpp>
 
 #include <memory>
@@ -8,12 +10,37 @@ namespace oblo::log
 {
     class log_sink;
 
+    /// @brief What to do with new messages when the queue of the sink thread is full.
+    enum class overflow_policy : u8
+    {
+        /// @brief Waits for the sink thread to make room for the message.
+        block,
+        /// @brief Discards the message.
+        drop,
+        /// @brief Discards debug messages, waits for room for any other severity.
+        drop_debug_first,
+    };
+
+    /// @brief Runs the sinks on a dedicated thread, while the module is loaded.
+    /// @remarks Messages logged before startup or after shutdown are sunk synchronously instead. The module also
+    /// installs handlers that flush the pending messages when the process crashes or terminates.
     class log_module final : public module_interface
     {
     public:
         LOG_API bool startup(const module_initializer& initializer) override;
         LOG_API void shutdown() override;
 
+        /// @brief Registers a sink, which will be called from the sink thread only.
         LOG_API void add_sink(std::unique_ptr<log_sink> sink);
+
+        LOG_API void set_overflow_policy(overflow_policy policy);
+
+        /// @brief The number of messages discarded since startup, because the queue or the deferred buffers were full.
+        LOG_API u64 get_dropped_messages_count() const;
+
+        /// @brief Writes the deferred messages to the file in binary form, instead of formatting them for the sinks.
+        /// @remarks The file can be decoded with binary_log_reader, or the log_decoder tool. Passing a null file goes
+        /// back to formatting the messages.
+        LOG_API void set_binary_log(filesystem::file_ptr file);
     };
 }
\ No newline at end of file
@@ -14,5 +14,8 @@ namespace oblo::log
         virtual ~log_sink() = default;
 
         virtual void sink(severity severity, time timestamp, cstring_view message) = 0;
+
+        /// @brief Called after a batch of messages has been sunk, when the queue of messages is empty.
+        virtual void flush() {}
     };
 }
\ No newline at end of file
@@ -23,6 +23,8 @@ namespace oblo::log
 
         void sink(severity severity, time timestmap, cstring_view message) override;
 
+        void flush() override;
+
     private:
         FILE* m_file{};
         bool m_isOwned{};
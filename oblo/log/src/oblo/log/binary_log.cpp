@@ -0,0 +1,124 @@
+#include <oblo/log/binary_log.hpp>
+
+#include <cstring>
+
+namespace oblo::log
+{
+    namespace
+    {
+        template <typename T>
+        bool read_struct(std::span<const byte> data, usize& offset, T& out)
+        {
+            if (data.size() - offset < sizeof(T))
+            {
+                return false;
+            }
+
+            std::memcpy(&out, data.data() + offset, sizeof(T));
+            offset += sizeof(T);
+
+            return true;
+        }
+    }
+
+    expected<> binary_log_reader::init(std::span<const byte> data)
+    {
+        m_data = data;
+        m_offset = 0;
+        m_sites.clear();
+
+        binary_log_header header;
+
+        if (!read_struct(m_data, m_offset, header) || header.magic != BinaryLogMagic ||
+            header.version != BinaryLogVersion)
+        {
+            return unspecified_error;
+        }
+
+        return no_error;
+    }
+
+    expected<bool> binary_log_reader::read_next(binary_log_message& out)
+    {
+        while (m_offset != m_data.size())
+        {
+            binary_log_chunk_header chunk;
+
+            if (!read_struct(m_data, m_offset, chunk) || m_data.size() - m_offset < chunk.size)
+            {
+                return unspecified_error;
+            }
+
+            const auto payload = m_data.subspan(m_offset, chunk.size);
+            m_offset += chunk.size;
+
+            usize offset{};
+
+            switch (chunk.kind)
+            {
+            case binary_log_chunk_kind::site: {
+                binary_log_site siteHeader;
+
+                if (!read_struct(payload, offset, siteHeader) ||
+                    payload.size() - offset != usize{siteHeader.argsCount} + siteHeader.formatLength ||
+                    siteHeader.argsCount > MaxDeferredArgsCount || siteHeader.id >= m_data.size() ||
+                    siteHeader.severity > u8(severity::error))
+                {
+                    return unspecified_error;
+                }
+
+                if (m_sites.size() <= siteHeader.id)
+                {
+                    m_sites.resize(siteHeader.id + 1);
+                }
+
+                const auto* const argTypes = reinterpret_cast<const deferred_arg_type*>(payload.data() + offset);
+                const auto* const format = reinterpret_cast<const char*>(argTypes + siteHeader.argsCount);
+
+                m_sites[siteHeader.id] = {
+                    .severity = log::severity(siteHeader.severity),
+                    .argTypes = {argTypes, siteHeader.argsCount},
+                    .format = {format, siteHeader.formatLength},
+                };
+
+                break;
+            }
+
+            case binary_log_chunk_kind::record: {
+                binary_log_record record;
+
+                if (!read_struct(payload, offset, record) || payload.size() - offset != record.argsSize ||
+                    record.siteId >= m_sites.size())
+                {
+                    return unspecified_error;
+                }
+
+                const site& s = m_sites[record.siteId];
+
+                const auto length = format_deferred(s.format, s.argTypes, payload.subspan(offset), m_message);
+
+                if (!length)
+                {
+                    return unspecified_error;
+                }
+
+                m_message[*length] = '\0';
+
+                out = {
+                    .severity = s.severity,
+                    .timestamp = record.timestamp,
+                    .message = cstring_view{m_message, *length},
+                };
+
+                return true;
+            }
+
+            default:
+                // Unknown chunks are skipped, for forward compatibility
+                break;
+            }
+        }
+
+        return false;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,638 @@
+#include <oblo/log/deferred.hpp>
+
+#include <oblo/core/dynamic_array.hpp>
+#include <oblo/core/filesystem/file_ptr.hpp>
+#include <oblo/core/finally.hpp>
+#include <oblo/core/time/clock.hpp>
+#include <oblo/log/binary_log.hpp>
+#include <oblo/log/log_internal.hpp>
+
+#include <atomic>
+#include <cstdio>
+#include <format>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string_view>
+
+namespace oblo::log
+{
+    namespace
+    {
+        // Each thread that logs deferred messages gets its own ring of this size
+        constexpr usize DeferredRingSize{1u << 18};
+
+        // Records are aligned so that there is always room for a padding header at the end of the ring
+        constexpr usize DeferredRecordAlignment{16};
+
+        constexpr u32 PaddingSiteId{~0u};
+
+        static_assert(sizeof(binary_log_record) == DeferredRecordAlignment);
+
+        constexpr usize get_record_size(u32 argsSize)
+        {
+            constexpr usize mask = DeferredRecordAlignment - 1;
+            return (sizeof(binary_log_record) + argsSize + mask) & ~mask;
+        }
+
+        // Single producer, single consumer ring of variable size records
+        class deferred_ring
+        {
+        public:
+            deferred_ring()
+            {
+                m_buffer.resize_default(DeferredRingSize);
+            }
+
+            bool try_write(u32 siteId, time timestamp, const byte* args, u32 argsSize)
+            {
+                constexpr usize mask = DeferredRingSize - 1;
+
+                const usize recordSize = get_record_size(argsSize);
+
+                usize tail = m_tail.load(std::memory_order_relaxed);
+
+                const usize contiguous = DeferredRingSize - (tail & mask);
+                const usize padding = recordSize > contiguous ? contiguous : 0;
+                const usize required = padding + recordSize;
+
+                if (tail + required - m_cachedHead > DeferredRingSize)
+                {
+                    m_cachedHead = m_head.load(std::memory_order_acquire);
+
+                    if (tail + required - m_cachedHead > DeferredRingSize)
+                    {
+                        return false;
+                    }
+                }
+
+                if (padding != 0)
+                {
+                    const binary_log_record paddingHeader{.siteId = PaddingSiteId};
+                    std::memcpy(m_buffer.data() + (tail & mask), &paddingHeader, sizeof(paddingHeader));
+                    tail += padding;
+                }
+
+                const binary_log_record header{
+                    .siteId = siteId,
+                    .argsSize = argsSize,
+                    .timestamp = timestamp,
+                };
+
+                byte* const record = m_buffer.data() + (tail & mask);
+                std::memcpy(record, &header, sizeof(header));
+                std::memcpy(record + sizeof(header), args, argsSize);
+
+                m_tail.store(tail + recordSize, std::memory_order_release);
+
+                return true;
+            }
+
+            template <typename F>
+            usize read_all(F&& f)
+            {
+                constexpr usize mask = DeferredRingSize - 1;
+
+                usize head = m_head.load(std::memory_order_relaxed);
+                const usize tail = m_tail.load(std::memory_order_acquire);
+
+                usize count{};
+
+                while (head != tail)
+                {
+                    const byte* const record = m_buffer.data() + (head & mask);
+
+                    binary_log_record header;
+                    std::memcpy(&header, record, sizeof(header));
+
+                    if (header.siteId == PaddingSiteId)
+                    {
+                        head += DeferredRingSize - (head & mask);
+                    }
+                    else
+                    {
+                        f(header, std::span{record + sizeof(header), header.argsSize});
+                        head += get_record_size(header.argsSize);
+                        ++count;
+                    }
+
+                    // Releasing the space as soon as possible, since the producer never waits
+                    m_head.store(head, std::memory_order_release);
+                }
+
+                return count;
+            }
+
+        public:
+            std::atomic<bool> isAbandoned{};
+
+        private:
+            dynamic_array<byte> m_buffer;
+
+            alignas(64) std::atomic<usize> m_head{};
+
+            alignas(64) std::atomic<usize> m_tail{};
+            usize m_cachedHead{};
+        };
+
+        struct deferred_registry
+        {
+            std::mutex sitesMutex;
+            dynamic_array<deferred_site> sites;
+
+            // Also protects the binary log
+            std::mutex ringsMutex;
+            dynamic_array<std::unique_ptr<deferred_ring>> rings;
+
+            filesystem::file_ptr binaryLog;
+            dynamic_array<bool> writtenSites;
+
+            // Records written to any ring and not read yet, it doesn't need the lock so it can be checked while crashing
+            std::atomic<usize> pendingRecordsCount{};
+        };
+
+        deferred_registry& get_deferred_registry()
+        {
+            // Function local, since sites might be registered during static initialization
+            static deferred_registry registry;
+            return registry;
+        }
+
+        struct thread_ring
+        {
+            ~thread_ring()
+            {
+                if (ring)
+                {
+                    // The ring is released by the log thread, once it's done reading it
+                    ring->isAbandoned.store(true, std::memory_order_release);
+                    ring = nullptr;
+                }
+
+                // The destructors of other thread_local objects might still log, those records are sunk synchronously
+                isReleased = true;
+            }
+
+            deferred_ring* ring{};
+            bool isReleased{};
+        };
+
+        thread_local thread_ring t_ring;
+
+        // Set while draining, since sinks might log deferred messages themselves
+        thread_local bool t_isDraining{};
+
+        deferred_site get_site(u32 id)
+        {
+            auto& registry = get_deferred_registry();
+
+            const std::lock_guard lock{registry.sitesMutex};
+            return registry.sites[id];
+        }
+
+        void write_chunk(FILE* file, binary_log_chunk_kind kind, std::span<const std::span<const byte>> parts)
+        {
+            binary_log_chunk_header header{.kind = kind};
+
+            for (const auto part : parts)
+            {
+                header.size += u32(part.size());
+            }
+
+            std::fwrite(&header, sizeof(header), 1, file);
+
+            for (const auto part : parts)
+            {
+                std::fwrite(part.data(), 1, part.size(), file);
+            }
+        }
+
+        void write_binary_record(
+            deferred_registry& registry, const binary_log_record& header, std::span<const byte> args)
+        {
+            FILE* const file = registry.binaryLog.get();
+
+            if (registry.writtenSites.size() <= header.siteId)
+            {
+                registry.writtenSites.resize(header.siteId + 1, false);
+            }
+
+            if (!registry.writtenSites[header.siteId])
+            {
+                const auto site = get_site(header.siteId);
+                const string_view format{site.format};
+
+                const binary_log_site siteHeader{
+                    .id = header.siteId,
+                    .severity = u8(site.severity),
+                    .argsCount = site.argsCount,
+                    .formatLength = u16(format.size()),
+                };
+
+                const std::span<const byte> parts[] = {
+                    std::as_bytes(std::span{&siteHeader, 1}),
+                    std::as_bytes(std::span{site.argTypes, site.argsCount}),
+                    std::as_bytes(std::span{format.data(), format.size()}),
+                };
+
+                write_chunk(file, binary_log_chunk_kind::site, parts);
+                registry.writtenSites[header.siteId] = true;
+            }
+
+            const std::span<const byte> parts[] = {
+                std::as_bytes(std::span{&header, 1}),
+                args,
+            };
+
+            write_chunk(file, binary_log_chunk_kind::record, parts);
+        }
+
+        void sink_formatted_record(const binary_log_record& header, std::span<const byte> args)
+        {
+            const auto site = get_site(header.siteId);
+
+            char buffer[detail::MaxLogMessageLength + 1];
+
+            const usize length = format_deferred(site.format, std::span{site.argTypes, site.argsCount}, args, buffer)
+                                     .value_or(0);
+
+            buffer[length] = '\0';
+
+            sink_message(site.severity, header.timestamp, cstring_view{buffer, length});
+        }
+
+        struct truncating_buffer
+        {
+            using value_type = char;
+
+            void push_back(char c)
+            {
+                if (size < capacity)
+                {
+                    data[size++] = c;
+                }
+            }
+
+            char* data;
+            usize size;
+            usize capacity;
+        };
+
+        struct deferred_value
+        {
+            deferred_arg_type type;
+
+            union {
+                bool boolean;
+                char character;
+                i64 signedInteger;
+                u64 unsignedInteger;
+                f64 floatingPoint;
+                const void* pointer;
+            };
+
+            std::string_view string;
+        };
+
+        template <typename T>
+        bool read_value(std::span<const byte> args, usize& offset, T& out)
+        {
+            if (args.size() - offset < sizeof(T))
+            {
+                return false;
+            }
+
+            std::memcpy(&out, args.data() + offset, sizeof(T));
+            offset += sizeof(T);
+
+            return true;
+        }
+
+        bool decode_value(deferred_arg_type type, std::span<const byte> args, usize& offset, deferred_value& out)
+        {
+            out.type = type;
+
+            switch (type)
+            {
+            case deferred_arg_type::boolean:
+                return read_value(args, offset, out.boolean);
+
+            case deferred_arg_type::character:
+                return read_value(args, offset, out.character);
+
+            case deferred_arg_type::i64:
+                return read_value(args, offset, out.signedInteger);
+
+            case deferred_arg_type::u64:
+                return read_value(args, offset, out.unsignedInteger);
+
+            case deferred_arg_type::f64:
+                return read_value(args, offset, out.floatingPoint);
+
+            case deferred_arg_type::pointer:
+                return read_value(args, offset, out.pointer);
+
+            case deferred_arg_type::string: {
+                u16 length;
+
+                if (!read_value(args, offset, length) || args.size() - offset < length)
+                {
+                    return false;
+                }
+
+                out.string = {reinterpret_cast<const char*>(args.data() + offset), length};
+                offset += length;
+
+                return true;
+            }
+
+            default:
+                return false;
+            }
+        }
+
+        template <typename OutIt>
+        OutIt format_value(OutIt it, std::string_view format, const deferred_value& value)
+        {
+            switch (value.type)
+            {
+            case deferred_arg_type::boolean:
+                return std::vformat_to(it, format, std::make_format_args(value.boolean));
+
+            case deferred_arg_type::character:
+                return std::vformat_to(it, format, std::make_format_args(value.character));
+
+            case deferred_arg_type::i64:
+                return std::vformat_to(it, format, std::make_format_args(value.signedInteger));
+
+            case deferred_arg_type::u64:
+                return std::vformat_to(it, format, std::make_format_args(value.unsignedInteger));
+
+            case deferred_arg_type::f64:
+                return std::vformat_to(it, format, std::make_format_args(value.floatingPoint));
+
+            case deferred_arg_type::pointer:
+                return std::vformat_to(it, format, std::make_format_args(value.pointer));
+
+            default:
+                return std::vformat_to(it, format, std::make_format_args(value.string));
+            }
+        }
+    }
+
+    expected<usize> format_deferred(
+        string_view format, std::span<const deferred_arg_type> types, std::span<const byte> args, std::span<char> out)
+    {
+        if (types.size() > MaxDeferredArgsCount || out.empty())
+        {
+            return unspecified_error;
+        }
+
+        deferred_value values[MaxDeferredArgsCount];
+        usize argsOffset{};
+
+        for (usize i = 0; i < types.size(); ++i)
+        {
+            if (!decode_value(types[i], args, argsOffset, values[i]))
+            {
+                return unspecified_error;
+            }
+        }
+
+        // Leaving room for the null-terminator
+        truncating_buffer buffer{.data = out.data(), .size = 0, .capacity = out.size() - 1};
+        auto it = std::back_inserter(buffer);
+
+        usize nextArg{};
+
+        // Each replacement field is formatted on its own, with the format spec of the original string
+        for (usize i = 0; i < format.size();)
+        {
+            const char c = format.at(i);
+
+            if (c == '}')
+            {
+                if (i + 1 == format.size() || format.at(i + 1) != '}')
+                {
+                    return unspecified_error;
+                }
+
+                *it = '}';
+                i += 2;
+                continue;
+            }
+
+            if (c != '{')
+            {
+                *it = c;
+                ++i;
+                continue;
+            }
+
+            if (i + 1 < format.size() && format.at(i + 1) == '{')
+            {
+                *it = '{';
+                i += 2;
+                continue;
+            }
+
+            const usize fieldEnd = format.find('}', i);
+
+            if (fieldEnd == string_view::npos)
+            {
+                return unspecified_error;
+            }
+
+            const string_view field = format.substr(i + 1, fieldEnd - i - 1);
+
+            if (field.find('{') != string_view::npos)
+            {
+                return unspecified_error;
+            }
+
+            const usize colon = field.find(':');
+            const string_view index = field.substr(0, colon);
+            const string_view spec = colon == string_view::npos ? string_view{} : field.substr(colon + 1);
+
+            usize argIndex{};
+
+            if (index.empty())
+            {
+                argIndex = nextArg++;
+            }
+            else
+            {
+                for (const char digit : index)
+                {
+                    if (digit < '0' || digit > '9')
+                    {
+                        return unspecified_error;
+                    }
+
+                    argIndex = argIndex * 10 + usize(digit - '0');
+                }
+            }
+
+            char fieldFormat[64];
+
+            if (argIndex >= types.size() || spec.size() + 3 > std::size(fieldFormat))
+            {
+                return unspecified_error;
+            }
+
+            fieldFormat[0] = '{';
+            fieldFormat[1] = ':';
+
+            if (!spec.empty())
+            {
+                std::memcpy(fieldFormat + 2, spec.data(), spec.size());
+            }
+
+            fieldFormat[spec.size() + 2] = '}';
+
+            try
+            {
+                it = format_value(it, std::string_view{fieldFormat, spec.size() + 3}, values[argIndex]);
+            }
+            catch (const std::format_error&)
+            {
+                return unspecified_error;
+            }
+
+            i = fieldEnd + 1;
+        }
+
+        return buffer.size;
+    }
+
+    namespace detail
+    {
+        u32 register_deferred_site(const deferred_site& site)
+        {
+            auto& registry = get_deferred_registry();
+
+            const std::lock_guard lock{registry.sitesMutex};
+
+            const u32 id = u32(registry.sites.size());
+            registry.sites.push_back(site);
+
+            return id;
+        }
+
+        void push_deferred_record(u32 siteId, const byte* args, u32 argsSize)
+        {
+            const time timestamp = clock::now();
+
+            if (t_ring.isReleased || !begin_producing())
+            {
+                sink_formatted_record({.siteId = siteId, .argsSize = argsSize, .timestamp = timestamp},
+                    std::span{args, argsSize});
+
+                return;
+            }
+
+            // Stopping the sink thread waits for this before draining the rings for the last time
+            const auto endProducing = finally([] { end_producing(); });
+
+            auto& registry = get_deferred_registry();
+            deferred_ring* ring = t_ring.ring;
+
+            if (!ring)
+            {
+                if (t_isDraining)
+                {
+                    count_dropped_message();
+                    return;
+                }
+
+                const std::lock_guard lock{registry.ringsMutex};
+                ring = registry.rings.emplace_back(std::make_unique<deferred_ring>()).get();
+
+                t_ring.ring = ring;
+            }
+
+            // Counted before writing, so that the record is never pending without being counted
+            registry.pendingRecordsCount.fetch_add(1, std::memory_order_release);
+
+            if (!ring->try_write(siteId, timestamp, args, argsSize))
+            {
+                registry.pendingRecordsCount.fetch_sub(1, std::memory_order_release);
+                count_dropped_message();
+            }
+        }
+    }
+
+    usize drain_deferred_records()
+    {
+        auto& registry = get_deferred_registry();
+
+        const std::lock_guard lock{registry.ringsMutex};
+
+        t_isDraining = true;
+
+        usize count{};
+
+        for (usize i = 0; i < registry.rings.size();)
+        {
+            deferred_ring& ring = *registry.rings[i];
+
+            // Checked before reading, the thread might still write until it's flagged
+            const bool isAbandoned = ring.isAbandoned.load(std::memory_order_acquire);
+
+            count += ring.read_all(
+                [&registry](const binary_log_record& header, std::span<const byte> args)
+                {
+                    if (registry.binaryLog)
+                    {
+                        write_binary_record(registry, header, args);
+                    }
+                    else
+                    {
+                        sink_formatted_record(header, args);
+                    }
+                });
+
+            if (isAbandoned)
+            {
+                registry.rings.erase_unordered(registry.rings.begin() + i);
+            }
+            else
+            {
+                ++i;
+            }
+        }
+
+        registry.pendingRecordsCount.fetch_sub(count, std::memory_order_release);
+
+        if (count > 0 && registry.binaryLog)
+        {
+            std::fflush(registry.binaryLog.get());
+        }
+
+        t_isDraining = false;
+
+        return count;
+    }
+
+    bool has_pending_deferred_records()
+    {
+        const auto& registry = get_deferred_registry();
+        return registry.pendingRecordsCount.load(std::memory_order_acquire) != 0;
+    }
+
+    void set_binary_log(filesystem::file_ptr file)
+    {
+        auto& registry = get_deferred_registry();
+
+        const std::lock_guard lock{registry.ringsMutex};
+
+        registry.binaryLog = std::move(file);
+        registry.writtenSites.clear();
+
+        if (registry.binaryLog)
+        {
+            const binary_log_header header{.magic = BinaryLogMagic, .version = BinaryLogVersion};
+            std::fwrite(&header, sizeof(header), 1, registry.binaryLog.get());
+        }
+    }
+}
\ No newline at end of file
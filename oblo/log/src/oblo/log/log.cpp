@@ -1,25 +1,577 @@
 #include <oblo/log/log.hpp>
 
+#include <oblo/core/dynamic_array.hpp>
+#include <oblo/core/mpsc_queue.hpp>
 #include <oblo/core/platform/core.hpp>
+#include <oblo/core/pool_allocator.hpp>
 #include <oblo/core/string/cstring_view.hpp>
 #include <oblo/core/utility.hpp>
 #include <oblo/log/log_internal.hpp>
 
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
 #include <cstdio>
+#include <cstring>
+#include <exception>
+#include <format>
+#include <mutex>
+#include <thread>
 
-namespace oblo::log::detail
+namespace oblo::log
 {
-    void sink_it(severity severity, time t, char* str, usize n)
+    namespace
     {
-        // Make sure it's null-terminated
-        const auto last = min(detail::MaxLogMessageLength, n);
-        str[last] = '\0';
+        constexpr usize QueueCapacity{4096};
 
-        const cstring_view message{str, last};
+        // The sink thread wakes up periodically even if nobody notifies it, which bounds the latency of missed wake-ups
+        constexpr std::chrono::milliseconds SinkThreadIdleTimeout{10};
 
-        for (const auto& sink : g_logSinks)
+        constexpr std::chrono::milliseconds CrashFlushTimeout{1000};
+
+        struct log_record
+        {
+            log::severity severity;
+            time timestamp;
+            char* text;
+            u32 length;
+        };
+
+        class sink_thread
+        {
+        public:
+            void start();
+            void stop();
+
+            void enqueue(log::severity severity, time timestamp, const char* str, usize n);
+
+            // Registers the caller as a producer, fails when the sink thread is not running. When it succeeds, stop
+            // waits for end_producing before draining the leftovers, so whatever is pushed in between is not lost
+            bool begin_producing();
+            void end_producing();
+
+            void flush();
+
+            // Only uses atomics, with a timeout, since it might be called from a signal handler
+            void flush_on_crash();
+
+            void register_sink(std::unique_ptr<log_sink> sink);
+            void clear_sinks();
+
+            void set_overflow_policy(overflow_policy policy)
+            {
+                m_overflowPolicy.store(policy, std::memory_order_relaxed);
+            }
+
+            u64 get_dropped_messages_count() const
+            {
+                return m_droppedCount.load(std::memory_order_relaxed);
+            }
+
+            void count_dropped_message()
+            {
+                m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            void sink(log::severity severity, time timestamp, cstring_view message);
+
+        private:
+            void run();
+
+            usize drain();
+
+            bool should_drop(log::severity severity) const;
+
+            void wake_up();
+
+        private:
+            mpsc_queue<log_record> m_queue;
+            pool_allocator m_textPool;
+
+            std::mutex m_sinksMutex;
+            dynamic_array<std::unique_ptr<log_sink>> m_sinks;
+
+            std::thread m_thread;
+            std::atomic<bool> m_isRunning{};
+
+            // Producers that saw the sink thread running and might still push, stop waits for them after closing
+            std::atomic<u32> m_activeProducers{};
+
+            // Set while stop drains the leftovers, producers wait for it so that messages of each thread stay in order
+            std::atomic<bool> m_isDraining{};
+            std::atomic<bool> m_isSleeping{};
+            std::atomic<overflow_policy> m_overflowPolicy{overflow_policy::drop_debug_first};
+
+            // Counted before pushing, so that a flush can safely wait for everything enqueued before it
+            std::atomic<u64> m_enqueuedCount{};
+            std::atomic<u64> m_processedCount{};
+            std::atomic<u64> m_droppedCount{};
+            u64 m_reportedDroppedCount{};
+
+            std::mutex m_mutex;
+            std::condition_variable m_wakeUp;
+            std::condition_variable m_flushed;
+            u64 m_flushRequested{};
+            u64 m_flushCompleted{};
+            bool m_stopRequested{};
+        };
+
+        sink_thread g_sinkThread;
+
+        thread_local char t_formatBuffer[detail::MaxLogMessageLength + 1];
+        thread_local bool t_isSinkThread{};
+
+        using signal_handler = void (*)(int);
+
+        constexpr int g_crashSignals[] = {SIGSEGV, SIGILL, SIGFPE, SIGABRT};
+        signal_handler g_previousSignalHandlers[std::size(g_crashSignals)];
+
+        std::terminate_handler g_previousTerminateHandler{};
+
+        void sink_thread::start()
+        {
+            if (m_isRunning.load(std::memory_order_relaxed))
+            {
+                return;
+            }
+
+            m_queue.init(QueueCapacity);
+            m_stopRequested = false;
+            m_droppedCount.store(0, std::memory_order_relaxed);
+            m_reportedDroppedCount = 0;
+            m_isRunning.store(true, std::memory_order_release);
+
+            m_thread = std::thread{[this] { run(); }};
+        }
+
+        void sink_thread::stop()
+        {
+            if (!m_isRunning.load(std::memory_order_relaxed))
+            {
+                return;
+            }
+
+            {
+                const std::lock_guard lock{m_mutex};
+                m_stopRequested = true;
+            }
+
+            m_wakeUp.notify_one();
+            m_thread.join();
+
+            // New messages will be sunk synchronously, this thread is now the only consumer for the leftovers.
+            // Producers that got in before closing might still be pushing, or waiting for space with the block policy.
+            // This thread acts as the sink thread until the end, e.g. sinks that log must not wait for it
+            t_isSinkThread = true;
+
+            m_isDraining.store(true, std::memory_order_relaxed);
+            m_isRunning.store(false, std::memory_order_seq_cst);
+
+            while (m_activeProducers.load(std::memory_order_seq_cst) != 0)
+            {
+                m_processedCount.fetch_add(drain(), std::memory_order_release);
+                std::this_thread::yield();
+            }
+
+            m_processedCount.fetch_add(drain(), std::memory_order_release);
+            drain_deferred_records();
+
+            m_isDraining.store(false, std::memory_order_release);
+            t_isSinkThread = false;
+
+            {
+                const std::lock_guard lock{m_mutex};
+                m_flushed.notify_all();
+            }
+
+            m_queue.shutdown();
+        }
+
+        void sink_thread::enqueue(log::severity severity, time timestamp, const char* str, usize n)
         {
-            sink->sink(severity, t, message);
+            if (!begin_producing())
+            {
+                sink(severity, timestamp, cstring_view{str, n});
+                return;
+            }
+
+            char* const text = reinterpret_cast<char*>(m_textPool.allocate(n + 1, 1));
+
+            if (!text)
+            {
+                // The pool ran out of memory, there's no way to keep the message
+                m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+                end_producing();
+                return;
+            }
+
+            std::memcpy(text, str, n);
+            text[n] = '\0';
+
+            m_enqueuedCount.fetch_add(1, std::memory_order_acq_rel);
+
+            const log_record record{
+                .severity = severity,
+                .timestamp = timestamp,
+                .text = text,
+                .length = u32(n),
+            };
+
+            while (!m_queue.try_push(record))
+            {
+                // Sinks that log would wait for themselves, so messages are always dropped on the sink thread
+                if (t_isSinkThread || should_drop(severity))
+                {
+                    m_textPool.deallocate(reinterpret_cast<byte*>(text), n + 1, 1);
+                    m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+                    m_processedCount.fetch_add(1, std::memory_order_release);
+                    end_producing();
+                    return;
+                }
+
+                wake_up();
+                std::this_thread::yield();
+            }
+
+            // Released before flushing, since stop doesn't complete flush requests until the producers are done
+            end_producing();
+
+            if (m_isSleeping.load(std::memory_order_relaxed))
+            {
+                wake_up();
+            }
+
+            if (severity == log::severity::error)
+            {
+                flush();
+            }
+        }
+
+        bool sink_thread::begin_producing()
+        {
+            // Pairs with stop, which closes the queue before waiting for the active producers
+            m_activeProducers.fetch_add(1, std::memory_order_seq_cst);
+
+            if (m_isRunning.load(std::memory_order_seq_cst))
+            {
+                return true;
+            }
+
+            m_activeProducers.fetch_sub(1, std::memory_order_release);
+
+            // The thread that is draining can't wait for itself, which happens when sinks log
+            while (!t_isSinkThread && m_isDraining.load(std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+            }
+
+            return false;
+        }
+
+        void sink_thread::end_producing()
+        {
+            m_activeProducers.fetch_sub(1, std::memory_order_release);
         }
+
+        void sink_thread::flush()
+        {
+            if (t_isSinkThread || !m_isRunning.load(std::memory_order_acquire))
+            {
+                return;
+            }
+
+            std::unique_lock lock{m_mutex};
+
+            // The sink thread completes the request after draining everything, including the deferred records
+            const u64 request = ++m_flushRequested;
+            m_wakeUp.notify_one();
+
+            m_flushed.wait(lock,
+                [this, request]
+                { return m_flushCompleted >= request || !m_isRunning.load(std::memory_order_acquire); });
+        }
+
+        void sink_thread::flush_on_crash()
+        {
+            if (t_isSinkThread || !m_isRunning.load(std::memory_order_acquire))
+            {
+                return;
+            }
+
+            const u64 target = m_enqueuedCount.load(std::memory_order_acquire);
+            const auto deadline = std::chrono::steady_clock::now() + CrashFlushTimeout;
+
+            // The sink thread is not notified, it will wake up by itself thanks to the idle timeout, which is also when
+            // it drains the deferred records
+            while ((m_processedCount.load(std::memory_order_acquire) < target || has_pending_deferred_records()) &&
+                std::chrono::steady_clock::now() < deadline)
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        void sink_thread::register_sink(std::unique_ptr<log_sink> sink)
+        {
+            const std::lock_guard lock{m_sinksMutex};
+            m_sinks.push_back(std::move(sink));
+        }
+
+        void sink_thread::clear_sinks()
+        {
+            const std::lock_guard lock{m_sinksMutex};
+            m_sinks.clear();
+            m_sinks.shrink_to_fit();
+        }
+
+        void sink_thread::run()
+        {
+            t_isSinkThread = true;
+
+            while (true)
+            {
+                u64 flushRequest;
+
+                {
+                    const std::lock_guard lock{m_mutex};
+                    flushRequest = m_flushRequested;
+                }
+
+                const usize count = drain();
+                const usize deferredCount = drain_deferred_records();
+
+                if (count + deferredCount > 0)
+                {
+                    {
+                        const std::lock_guard lock{m_sinksMutex};
+
+                        for (const auto& s : m_sinks)
+                        {
+                            s->flush();
+                        }
+                    }
+
+                    m_processedCount.fetch_add(count, std::memory_order_release);
+                }
+
+                std::unique_lock lock{m_mutex};
+
+                if (m_flushCompleted != flushRequest)
+                {
+                    m_flushCompleted = flushRequest;
+                    m_flushed.notify_all();
+                }
+
+                if (count + deferredCount > 0 || m_flushCompleted != m_flushRequested)
+                {
+                    continue;
+                }
+
+                if (m_stopRequested)
+                {
+                    break;
+                }
+
+                m_isSleeping.store(true, std::memory_order_relaxed);
+
+                // Deferred records never wake up the thread, they are processed at least once per timeout
+                m_wakeUp.wait_for(lock,
+                    SinkThreadIdleTimeout,
+                    [this]
+                    { return m_stopRequested || m_flushCompleted != m_flushRequested || !m_queue.empty_approx(); });
+
+                m_isSleeping.store(false, std::memory_order_relaxed);
+            }
+        }
+
+        usize sink_thread::drain()
+        {
+            usize count = 0;
+            log_record record;
+
+            while (m_queue.try_pop(record))
+            {
+                sink(record.severity, record.timestamp, cstring_view{record.text, record.length});
+                m_textPool.deallocate(reinterpret_cast<byte*>(record.text), record.length + 1, 1);
+                ++count;
+            }
+
+            const u64 droppedCount = m_droppedCount.load(std::memory_order_relaxed);
+
+            if (droppedCount != m_reportedDroppedCount)
+            {
+                char buffer[64];
+                const auto r = std::format_to_n(buffer,
+                    sizeof(buffer) - 1,
+                    "{} log messages were dropped",
+                    droppedCount - m_reportedDroppedCount);
+
+                *r.out = '\0';
+
+                sink(log::severity::warn, clock::now(), cstring_view{buffer, usize(r.out - buffer)});
+                m_reportedDroppedCount = droppedCount;
+            }
+
+            return count;
+        }
+
+        void sink_thread::sink(log::severity severity, time timestamp, cstring_view message)
+        {
+            const std::lock_guard lock{m_sinksMutex};
+
+            for (const auto& s : m_sinks)
+            {
+                s->sink(severity, timestamp, message);
+            }
+        }
+
+        bool sink_thread::should_drop(log::severity severity) const
+        {
+            switch (m_overflowPolicy.load(std::memory_order_relaxed))
+            {
+            case overflow_policy::drop:
+                return true;
+
+            case overflow_policy::drop_debug_first:
+                return severity == log::severity::debug;
+
+            default:
+                return false;
+            }
+        }
+
+        void sink_thread::wake_up()
+        {
+            m_wakeUp.notify_one();
+        }
+
+        void on_crash_signal(int signal)
+        {
+            g_sinkThread.flush_on_crash();
+
+            signal_handler previous = SIG_DFL;
+
+            for (usize i = 0; i < std::size(g_crashSignals); ++i)
+            {
+                if (g_crashSignals[i] == signal)
+                {
+                    previous = g_previousSignalHandlers[i];
+                    break;
+                }
+            }
+
+            // Hands the signal over to the handler installed before ours, e.g. a crash reporter, otherwise restores
+            // the default behavior, which terminates the process
+            if (previous == SIG_IGN || previous == SIG_ERR || previous == on_crash_signal)
+            {
+                previous = SIG_DFL;
+            }
+
+            std::signal(signal, previous);
+            std::raise(signal);
+        }
+
+        void on_terminate()
+        {
+            g_sinkThread.flush_on_crash();
+
+            if (g_previousTerminateHandler)
+            {
+                g_previousTerminateHandler();
+            }
+
+            std::abort();
+        }
+    }
+
+    namespace detail
+    {
+        char* get_format_buffer()
+        {
+            return t_formatBuffer;
+        }
+
+        void sink_it(severity severity, time t, char* str, usize n)
+        {
+            // Make sure it's null-terminated
+            const auto last = min(detail::MaxLogMessageLength, n);
+            str[last] = '\0';
+
+            g_sinkThread.enqueue(severity, t, str, last);
+        }
+    }
+
+    void flush()
+    {
+        g_sinkThread.flush();
+    }
+
+    void start_sink_thread()
+    {
+        g_sinkThread.start();
+    }
+
+    void stop_sink_thread()
+    {
+        g_sinkThread.stop();
+    }
+
+    void register_sink(std::unique_ptr<log_sink> sink)
+    {
+        g_sinkThread.register_sink(std::move(sink));
+    }
+
+    void clear_sinks()
+    {
+        g_sinkThread.clear_sinks();
+    }
+
+    void set_overflow_policy(overflow_policy policy)
+    {
+        g_sinkThread.set_overflow_policy(policy);
+    }
+
+    u64 get_dropped_messages_count()
+    {
+        return g_sinkThread.get_dropped_messages_count();
+    }
+
+    bool begin_producing()
+    {
+        return g_sinkThread.begin_producing();
+    }
+
+    void end_producing()
+    {
+        g_sinkThread.end_producing();
+    }
+
+    void sink_message(severity severity, time timestamp, cstring_view message)
+    {
+        g_sinkThread.sink(severity, timestamp, message);
+    }
+
+    void count_dropped_message()
+    {
+        g_sinkThread.count_dropped_message();
+    }
+
+    void install_crash_handlers()
+    {
+        for (usize i = 0; i < std::size(g_crashSignals); ++i)
+        {
+            g_previousSignalHandlers[i] = std::signal(g_crashSignals[i], on_crash_signal);
+        }
+
+        g_previousTerminateHandler = std::set_terminate(on_terminate);
+    }
+
+    void uninstall_crash_handlers()
+    {
+        for (usize i = 0; i < std::size(g_crashSignals); ++i)
+        {
+            std::signal(g_crashSignals[i], g_previousSignalHandlers[i]);
+        }
+
+        std::set_terminate(g_previousTerminateHandler);
     }
 }
\ No newline at end of file
@@ -1,13 +1,49 @@
 #pragma once
 
-#include <oblo/core/dynamic_array.hpp>
+#include <oblo/core/filesystem/file_ptr.hpp>
+#include <oblo/log/log_module.hpp>
 #include <oblo/log/log_sink.hpp>
 
 #include <memory>
 
 namespace oblo::log
 {
-    inline dynamic_array<std::unique_ptr<log_sink>> g_logSinks;
+    void start_sink_thread();
+
+    /// @brief Stops the sink thread after it processes all the queued messages.
+    void stop_sink_thread();
+
+    void register_sink(std::unique_ptr<log_sink> sink);
+    void clear_sinks();
+
+    void set_overflow_policy(overflow_policy policy);
+    u64 get_dropped_messages_count();
+
+    void install_crash_handlers();
+    void uninstall_crash_handlers();
+
+    /// @brief Registers the calling thread as a producer, it fails when the sink thread is not running.
+    /// @remarks On success end_producing has to be called once the message is pushed, stopping the sink thread waits
+    /// for it before draining the leftovers. On failure it waits for the leftovers to be drained, so that messages can
+    /// be sunk synchronously without breaking the order.
+    bool begin_producing();
+    void end_producing();
+
+    /// @brief Calls the sinks on the current thread.
+    void sink_message(severity severity, time timestamp, cstring_view message);
+
+    void count_dropped_message();
+
+    /// @brief Processes the deferred records of all threads, either formatting them for the sinks or writing them to
+    /// the binary log. Only called by the thread that consumes the queue of messages.
+    /// @return The number of records processed.
+    usize drain_deferred_records();
+
+    /// @brief Checks whether any thread has deferred records that were not processed yet.
+    /// @remarks It only reads an atomic counter, so it can be called from a signal handler while crashing.
+    bool has_pending_deferred_records();
+
+    void set_binary_log(filesystem::file_ptr file);
 
     constexpr cstring_view g_severityStrings[]{
         "[DEBUG] ",
@@ -6,17 +6,35 @@ namespace oblo::log
 {
     bool log_module::startup(const module_initializer&)
     {
+        start_sink_thread();
+        install_crash_handlers();
         return true;
     }
 
     void log_module::shutdown()
     {
-        g_logSinks.clear();
-        g_logSinks.shrink_to_fit();
+        uninstall_crash_handlers();
+        stop_sink_thread();
+        clear_sinks();
     }
 
     void log_module::add_sink(std::unique_ptr<log_sink> sink)
     {
-        g_logSinks.push_back(std::move(sink));
+        register_sink(std::move(sink));
+    }
+
+    void log_module::set_overflow_policy(overflow_policy policy)
+    {
+        log::set_overflow_policy(policy);
+    }
+
+    u64 log_module::get_dropped_messages_count() const
+    {
+        return log::get_dropped_messages_count();
+    }
+
+    void log_module::set_binary_log(filesystem::file_ptr file)
+    {
+        log::set_binary_log(std::move(file));
     }
 }
\ No newline at end of file
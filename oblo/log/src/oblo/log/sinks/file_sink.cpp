@@ -34,15 +34,18 @@ namespace oblo::log
     {
         const f32 dt = to_f32_seconds(timestamp - m_baseTime);
 
+        // Formatting the whole line first, so that it's written with a single call
         string_builder sb;
         sb.format("[{:.3f}] ", dt);
+        sb.append(get_severity_string(severity));
+        sb.append(message);
+        sb.append('\n');
 
         std::fwrite(sb.data(), 1, sb.size(), m_file);
+    }
 
-        const auto severityString = get_severity_string(severity);
-        std::fwrite(severityString.data(), 1, severityString.size(), m_file);
-
-        std::fwrite(message.data(), 1, message.size(), m_file);
-        std::fputc('\n', m_file);
+    void file_sink::flush()
+    {
+        std::fflush(m_file);
     }
 }
\ No newline at end of file
@@ -20,14 +20,11 @@ namespace oblo::log
 
         string_builder sb;
         sb.format("[{:.3f}] ", dt);
+        sb.append(get_severity_string(severity));
+        sb.append(message);
+        sb.append('\n');
 
         platform::debug_output(sb.c_str());
-
-        const auto severityString = get_severity_string(severity);
-
-        platform::debug_output(severityString.c_str());
-        platform::debug_output(message.c_str());
-        platform::debug_output("\n");
     }
 }
 
@@ -0,0 +1,442 @@
+#include <gtest/gtest.h>
+
+#include <oblo/core/filesystem/file.hpp>
+#include <oblo/core/filesystem/filesystem.hpp>
+#include <oblo/core/string/cstring_view.hpp>
+#include <oblo/log/binary_log.hpp>
+#include <oblo/log/deferred.hpp>
+#include <oblo/log/log.hpp>
+#include <oblo/log/log_module.hpp>
+#include <oblo/log/log_sink.hpp>
+#include <oblo/modules/module_manager.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace oblo::log
+{
+    namespace
+    {
+        constexpr u32 ThreadsCount{4};
+
+        struct sink_state
+        {
+            std::atomic<u32> infoCount{};
+            std::atomic<u32> errorCount{};
+            std::atomic<bool> isBlocked{};
+            std::atomic<bool> isOrdered{true};
+            std::thread::id sinkThread{};
+            u32 lastSequence[ThreadsCount]{};
+            std::vector<std::string> warnings;
+        };
+
+        class test_sink final : public log_sink
+        {
+        public:
+            explicit test_sink(sink_state& state) : m_state{state} {}
+
+            void sink(severity severity, time, cstring_view message) override
+            {
+                while (m_state.isBlocked.load())
+                {
+                    std::this_thread::yield();
+                }
+
+                m_state.sinkThread = std::this_thread::get_id();
+
+                switch (severity)
+                {
+                case severity::info:
+                    check_order(message);
+                    m_state.infoCount.fetch_add(1);
+                    break;
+
+                case severity::warn:
+                    m_state.warnings.emplace_back(message.data(), message.size());
+                    break;
+
+                case severity::error:
+                    m_state.errorCount.fetch_add(1);
+                    break;
+
+                default:
+                    break;
+                }
+            }
+
+        private:
+            // Messages are formatted as "<thread> <sequence>", the sequence has to be increasing for each thread
+            void check_order(cstring_view message)
+            {
+                u32 thread{}, sequence{};
+
+                const char* const end = message.data() + message.size();
+                const auto [threadEnd, threadErr] = std::from_chars(message.data(), end, thread);
+
+                if (threadErr != std::errc{} || thread >= ThreadsCount)
+                {
+                    return;
+                }
+
+                std::from_chars(threadEnd + 1, end, sequence);
+
+                if (sequence <= m_state.lastSequence[thread])
+                {
+                    m_state.isOrdered.store(false);
+                }
+
+                m_state.lastSequence[thread] = sequence;
+            }
+
+        private:
+            sink_state& m_state;
+        };
+    }
+
+    TEST(log, flush_waits_for_all_threads)
+    {
+        sink_state state;
+
+        module_manager mm;
+        auto* const logModule = mm.load<log_module>();
+        ASSERT_TRUE(logModule);
+
+        logModule->set_overflow_policy(overflow_policy::block);
+        logModule->add_sink(std::make_unique<test_sink>(state));
+
+        constexpr u32 MessagesPerThread{10'000};
+
+        std::vector<std::thread> threads;
+
+        for (u32 t = 0; t < ThreadsCount; ++t)
+        {
+            threads.emplace_back(
+                [t]
+                {
+                    for (u32 i = 1; i <= MessagesPerThread; ++i)
+                    {
+                        log::info("{} {}", t, i);
+                    }
+                });
+        }
+
+        for (auto& t : threads)
+        {
+            t.join();
+        }
+
+        log::flush();
+
+        ASSERT_EQ(state.infoCount.load(), ThreadsCount * MessagesPerThread);
+        ASSERT_EQ(logModule->get_dropped_messages_count(), 0);
+        ASSERT_TRUE(state.isOrdered.load());
+        ASSERT_NE(state.sinkThread, std::this_thread::get_id());
+    }
+
+    TEST(log, errors_are_flushed)
+    {
+        sink_state state;
+
+        module_manager mm;
+        auto* const logModule = mm.load<log_module>();
+        ASSERT_TRUE(logModule);
+
+        logModule->add_sink(std::make_unique<test_sink>(state));
+
+        for (u32 i = 0; i < 100; ++i)
+        {
+            log::error("Error {}", i);
+            ASSERT_EQ(state.errorCount.load(), i + 1);
+        }
+    }
+
+    TEST(log, drop_when_full)
+    {
+        sink_state state;
+
+        module_manager mm;
+        auto* const logModule = mm.load<log_module>();
+        ASSERT_TRUE(logModule);
+
+        logModule->set_overflow_policy(overflow_policy::drop);
+        logModule->add_sink(std::make_unique<test_sink>(state));
+
+        // The sink stalls the sink thread, so the queue fills up
+        state.isBlocked.store(true);
+
+        constexpr u32 MessagesCount{20'000};
+
+        for (u32 i = 1; i <= MessagesCount; ++i)
+        {
+            log::info("0 {}", i);
+        }
+
+        const u64 droppedCount = logModule->get_dropped_messages_count();
+        ASSERT_GT(droppedCount, 0);
+
+        state.isBlocked.store(false);
+        log::flush();
+
+        ASSERT_EQ(state.infoCount.load() + droppedCount, MessagesCount);
+        ASSERT_TRUE(state.isOrdered.load());
+    }
+
+    TEST(log, stop_while_logging)
+    {
+        sink_state state;
+
+        module_manager mm;
+        auto* const logModule = mm.load<log_module>();
+        ASSERT_TRUE(logModule);
+
+        logModule->set_overflow_policy(overflow_policy::block);
+        logModule->add_sink(std::make_unique<test_sink>(state));
+
+        // The queue fills up, so producers might be waiting for space when the sink thread stops
+        state.isBlocked.store(true);
+
+        constexpr u32 MessagesPerThread{10'000};
+
+        std::vector<std::thread> threads;
+
+        for (u32 t = 0; t < ThreadsCount; ++t)
+        {
+            threads.emplace_back(
+                [t]
+                {
+                    for (u32 i = 1; i <= MessagesPerThread; ++i)
+                    {
+                        log::info("{} {}", t, i);
+                    }
+                });
+        }
+
+        std::thread stopThread{[&mm] { mm.shutdown(); }};
+
+        state.isBlocked.store(false);
+
+        // Producers must not get stuck on a queue nobody drains, nor sink their messages out of order
+        for (auto& t : threads)
+        {
+            t.join();
+        }
+
+        stopThread.join();
+
+        ASSERT_TRUE(state.isOrdered.load());
+    }
+
+    TEST(log, deferred_formatting)
+    {
+        sink_state state;
+
+        module_manager mm;
+        auto* const logModule = mm.load<log_module>();
+        ASSERT_TRUE(logModule);
+
+        logModule->add_sink(std::make_unique<test_sink>(state));
+
+        const std::string name{"mesh"};
+
+        log::deferred_warn<"Frame {} took {:.2f}ms">(42u, 16.6667f);
+        log::deferred_warn<"{1}-{0} {{escaped}} {2:>6}|{3}">('a', -7, name, true);
+        log::deferred_warn<"No arguments">();
+
+        log::flush();
+
+        ASSERT_EQ(state.warnings.size(), 3);
+        ASSERT_EQ(state.warnings[0], "Frame 42 took 16.67ms");
+        ASSERT_EQ(state.warnings[1], "-7-a {escaped}   mesh|true");
+        ASSERT_EQ(state.warnings[2], "No arguments");
+
+        // Records from multiple threads are formatted on the log thread, preserving the order within each thread
+        constexpr u32 MessagesPerThread{2'000};
+
+        std::vector<std::thread> threads;
+
+        for (u32 t = 0; t < ThreadsCount; ++t)
+        {
+            threads.emplace_back(
+                [t]
+                {
+                    for (u32 i = 1; i <= MessagesPerThread; ++i)
+                    {
+                        log::deferred_info<"{} {}">(t, i);
+                    }
+                });
+        }
+
+        for (auto& t : threads)
+        {
+            t.join();
+        }
+
+        log::flush();
+
+        ASSERT_EQ(state.infoCount.load(), ThreadsCount * MessagesPerThread);
+        ASSERT_EQ(logModule->get_dropped_messages_count(), 0);
+        ASSERT_TRUE(state.isOrdered.load());
+        ASSERT_NE(state.sinkThread, std::this_thread::get_id());
+    }
+
+    TEST(log, deferred_after_thread_exit)
+    {
+        sink_state state;
+
+        module_manager mm;
+        auto* const logModule = mm.load<log_module>();
+        ASSERT_TRUE(logModule);
+
+        logModule->add_sink(std::make_unique<test_sink>(state));
+
+        struct log_on_exit
+        {
+            ~log_on_exit()
+            {
+                log::deferred_warn<"Thread exit">();
+            }
+        };
+
+        std::thread{[]
+            {
+                // Constructed before the ring of the thread, so it's destroyed after it
+                thread_local log_on_exit logOnExit;
+                log::deferred_warn<"Thread start">();
+            }}
+            .join();
+
+        log::flush();
+
+        ASSERT_EQ(state.warnings.size(), 2);
+        ASSERT_NE(std::find(state.warnings.begin(), state.warnings.end(), "Thread start"), state.warnings.end());
+        ASSERT_NE(std::find(state.warnings.begin(), state.warnings.end(), "Thread exit"), state.warnings.end());
+    }
+
+    TEST(log, stop_while_logging_deferred)
+    {
+        constexpr u32 RoundsCount{500};
+        constexpr u32 MessagesPerThread{2'000};
+
+        for (u32 round = 0; round < RoundsCount; ++round)
+        {
+            {
+                sink_state state;
+
+                module_manager mm;
+                auto* const logModule = mm.load<log_module>();
+                ASSERT_TRUE(logModule);
+
+                logModule->add_sink(std::make_unique<test_sink>(state));
+
+                std::atomic<u32> startedCount{};
+                std::vector<std::thread> threads;
+
+                for (u32 t = 0; t < ThreadsCount; ++t)
+                {
+                    threads.emplace_back(
+                        [t, &startedCount]
+                        {
+                            startedCount.fetch_add(1);
+
+                            for (u32 i = 1; i <= MessagesPerThread; ++i)
+                            {
+                                log::deferred_info<"{} {}">(t, i);
+                            }
+                        });
+                }
+
+                while (startedCount.load() != ThreadsCount)
+                {
+                    std::this_thread::yield();
+                }
+
+                // Stops while the producers are still pushing to their rings
+                mm.shutdown();
+
+                for (auto& t : threads)
+                {
+                    t.join();
+                }
+            }
+
+            // Records that missed the last drain would still be in the abandoned rings, and reach the next sinks
+            sink_state leftovers;
+
+            module_manager mm;
+            auto* const logModule = mm.load<log_module>();
+            ASSERT_TRUE(logModule);
+
+            logModule->add_sink(std::make_unique<test_sink>(leftovers));
+
+            log::flush();
+
+            ASSERT_EQ(leftovers.infoCount.load(), 0);
+        }
+    }
+
+    TEST(log, binary_log_roundtrip)
+    {
+        constexpr cstring_view testDir{"./test/log/"};
+        filesystem::remove_all(testDir).assert_value();
+        filesystem::create_directories(testDir).assert_value();
+
+        constexpr cstring_view path{"./test/log/deferred.oblog"};
+
+        sink_state state;
+
+        {
+            module_manager mm;
+            auto* const logModule = mm.load<log_module>();
+            ASSERT_TRUE(logModule);
+
+            logModule->add_sink(std::make_unique<test_sink>(state));
+
+            filesystem::file_ptr file{filesystem::open_file(path, "wb")};
+            ASSERT_TRUE(file);
+
+            logModule->set_binary_log(std::move(file));
+
+            for (u32 i = 0; i < 100; ++i)
+            {
+                log::deferred_warn<"Binary {} {}">(i, "message");
+                log::deferred_error<"Error {:#x}">(i);
+            }
+
+            log::flush();
+
+            // Closes the file
+            logModule->set_binary_log({});
+        }
+
+        // Nothing went through the sinks
+        ASSERT_TRUE(state.warnings.empty());
+        ASSERT_EQ(state.errorCount.load(), 0);
+
+        dynamic_array<byte> data;
+        ASSERT_TRUE(filesystem::load_binary_file_into_memory(data, path));
+
+        binary_log_reader reader;
+        ASSERT_TRUE(reader.init(data));
+
+        binary_log_message message;
+
+        for (u32 i = 0; i < 100; ++i)
+        {
+            ASSERT_TRUE(reader.read_next(message).value_or(false));
+            ASSERT_EQ(message.severity, severity::warn);
+            ASSERT_EQ(std::string_view{message.message.c_str()}, std::format("Binary {} message", i));
+
+            ASSERT_TRUE(reader.read_next(message).value_or(false));
+            ASSERT_EQ(message.severity, severity::error);
+            ASSERT_EQ(std::string_view{message.message.c_str()}, std::format("Error {:#x}", i));
+        }
+
+        const auto end = reader.read_next(message);
+        ASSERT_TRUE(end);
+        ASSERT_FALSE(*end);
+    }
+}
\ No newline at end of file
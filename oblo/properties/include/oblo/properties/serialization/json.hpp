@@ -2,6 +2,9 @@
 
 #include <oblo/core/expected.hpp>
 #include <oblo/core/string/cstring_view.hpp>
+#include <oblo/core/types.hpp>
+
+#include <span>
 
 namespace oblo
 {
@@ -12,5 +15,8 @@ namespace oblo::json
 {
     expected<> read(data_document& doc, cstring_view source);
 
+    /// @brief Reads a document from a buffer holding the JSON text, which doesn't need to be null terminated.
+    expected<> read(data_document& doc, std::span<const byte> content);
+
     expected<> write(const data_document& doc, cstring_view destination);
 }
\ No newline at end of file
@@ -16,6 +16,7 @@
 #include <rapidjson/document.h>
 #include <rapidjson/filereadstream.h>
 #include <rapidjson/filewritestream.h>
+#include <rapidjson/memorystream.h>
 #include <rapidjson/prettywriter.h>
 #include <rapidjson/reader.h>
 
@@ -330,45 +331,61 @@ namespace oblo::json
         };
     }
 
-    expected<> read(data_document& doc, cstring_view source)
+    namespace
     {
-        const auto file = filesystem::file_ptr{filesystem::open_file(source, "r")};
-
-        constexpr auto bufferSize{1024};
-        char buffer[bufferSize];
-
-        rapidjson::FileReadStream rs{file.get(), buffer, bufferSize};
-
-        rapidjson::Reader reader{};
+        template <typename Stream>
+        expected<> read_stream(data_document& doc, Stream& rs, string_view sourceName)
+        {
+            rapidjson::Reader reader{};
 
-        doc.init();
+            doc.init();
 
-        reader.IterativeParseInit();
+            reader.IterativeParseInit();
 
-        Handler handler{doc};
+            Handler handler{doc};
 
-        while (!reader.IterativeParseComplete())
-        {
-            if (!reader.IterativeParseNext<rapidjson::kParseDefaultFlags>(rs, handler))
+            while (!reader.IterativeParseComplete())
             {
-                if (reader.HasParseError())
+                if (!reader.IterativeParseNext<rapidjson::kParseDefaultFlags>(rs, handler))
                 {
-                    log::debug("JSON Parse error {} at {}:{}",
-                        i32(reader.GetParseErrorCode()),
-                        source,
-                        reader.GetErrorOffset());
+                    if (reader.HasParseError())
+                    {
+                        log::debug("JSON Parse error {} at {}:{}",
+                            i32(reader.GetParseErrorCode()),
+                            sourceName,
+                            reader.GetErrorOffset());
+                    }
+
+                    return unspecified_error_tag{};
                 }
+            }
 
+            if (reader.HasParseError())
+            {
                 return unspecified_error_tag{};
             }
-        }
 
-        if (reader.HasParseError())
-        {
-            return unspecified_error_tag{};
+            return success_tag{};
         }
+    }
 
-        return success_tag{};
+    expected<> read(data_document& doc, cstring_view source)
+    {
+        const auto file = filesystem::file_ptr{filesystem::open_file(source, "r")};
+
+        constexpr auto bufferSize{1024};
+        char buffer[bufferSize];
+
+        rapidjson::FileReadStream rs{file.get(), buffer, bufferSize};
+
+        return read_stream(doc, rs, source);
+    }
+
+    expected<> read(data_document& doc, std::span<const byte> content)
+    {
+        rapidjson::MemoryStream rs{reinterpret_cast<const char*>(content.data()), content.size()};
+
+        return read_stream(doc, rs, "<memory>");
     }
 
     expected<> write(const data_document& doc, cstring_view destination)
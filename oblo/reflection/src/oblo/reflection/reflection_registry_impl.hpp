@@ -2,13 +2,13 @@
 
 #include <oblo/core/string/string_view.hpp>
 #include <oblo/core/deque.hpp>
+#include <oblo/core/pool_allocator.hpp>
 #include <oblo/core/type_id.hpp>
 #include <oblo/ecs/entity_registry.hpp>
 #include <oblo/ecs/type_registry.hpp>
 #include <oblo/reflection/reflection_data.hpp>
 
 #include <functional>
-#include <memory_resource>
 #include <unordered_map>
 
 namespace oblo::reflection
@@ -16,8 +16,7 @@ namespace oblo::reflection
     class any_attribute
     {
     public:
-        any_attribute(
-            std::pmr::unsynchronized_pool_resource* pool, void* ptr, void (*destroy)(void*), u32 size, u32 alignment) :
+        any_attribute(pool_allocator* pool, void* ptr, void (*destroy)(void*), u32 size, u32 alignment) :
             m_pool{pool},
             m_ptr{ptr}, m_destroy{destroy}, m_size{size}, m_alignment{alignment}
         {
@@ -40,7 +39,7 @@ namespace oblo::reflection
         ~any_attribute()
         {
             m_destroy(m_ptr);
-            m_pool->deallocate(m_ptr, m_size, m_alignment);
+            m_pool->deallocate(static_cast<byte*>(m_ptr), m_size, m_alignment);
         }
 
         void* get() const
@@ -49,7 +48,7 @@ namespace oblo::reflection
         }
 
     private:
-        std::pmr::unsynchronized_pool_resource* m_pool{};
+        pool_allocator* m_pool{};
         void* m_ptr{};
         void (*m_destroy)(void*){};
         u32 m_size{};
@@ -77,7 +76,7 @@ namespace oblo::reflection
 
     struct reflection_registry_impl
     {
-        std::pmr::unsynchronized_pool_resource pool;
+        pool_allocator pool;
 
         ecs::type_registry typesRegistry;
         ecs::entity_registry registry{&typesRegistry};
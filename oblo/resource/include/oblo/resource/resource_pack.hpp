@@ -0,0 +1,127 @@
+#pragma once
+
+#include <oblo/core/dynamic_array.hpp>
+#include <oblo/core/expected.hpp>
+#include <oblo/core/filesystem/mapped_file.hpp>
+#include <oblo/core/string/cstring_view.hpp>
+#include <oblo/core/string/string.hpp>
+#include <oblo/core/string/string_view.hpp>
+#include <oblo/core/types.hpp>
+#include <oblo/core/uuid.hpp>
+
+#include <span>
+
+namespace oblo
+{
+    struct resource_data;
+    struct type_id;
+
+    // A resource pack stores many resources in a single file, to avoid opening one file per resource when shipping.
+    // It's made of a header, followed by the entries sorted by id, the strings referenced by the entries and finally
+    // the data of each resource, aligned to ResourcePackAlignment. It's meant to be memory mapped and read in place.
+
+    constexpr u32 ResourcePackMagic{0x4B50524F}; // ORPK
+    constexpr u32 ResourcePackVersion{1};
+
+    /// @brief Alignment of the data of each resource, relative to the beginning of the file.
+    constexpr u32 ResourcePackAlignment{64};
+
+    enum class resource_pack_compression : u8
+    {
+        none,
+        /// @brief Compresses the data of each resource as an lz frame, resources that don't shrink are stored as is.
+        lz,
+    };
+
+    struct resource_pack_header
+    {
+        u32 magic;
+        u32 version;
+        u32 entriesCount;
+        u32 stringsSize;
+    };
+
+    struct resource_pack_entry
+    {
+        static constexpr u32 CompressedFlag{1u << 0};
+
+        uuid id;
+        u64 dataOffset;
+        u64 dataSize;
+        u64 uncompressedSize;
+        u32 typeOffset;
+        u32 typeLength;
+        u32 nameOffset;
+        u32 nameLength;
+        u32 flags;
+        u32 reserved;
+    };
+
+    struct resource_pack_record
+    {
+        uuid id;
+        /// @brief The name of the resource type, as in type_id::name.
+        string_view type;
+        string_view name;
+        /// @brief The data as stored in the pack, it's an lz frame when isCompressed is true.
+        std::span<const byte> data;
+        u64 uncompressedSize;
+        bool isCompressed;
+    };
+
+    /// @brief Memory maps a resource pack, records point into the mapping and are valid until it's closed.
+    class resource_pack
+    {
+    public:
+        expected<> open(cstring_view path);
+        void close();
+
+        u32 get_entries_count() const;
+
+        /// @brief Looks up a resource with a binary search on the entries, it doesn't touch the file system.
+        bool find(const uuid& id, resource_pack_record& record) const;
+
+        /// @brief Provider for resource_registry, the userdata is expected to be the pack.
+        static bool find_resource(
+            const uuid& id, type_id& outType, string& outName, resource_data& outData, const void* userdata);
+
+    private:
+        string_view get_string(u32 offset, u32 length) const;
+
+    private:
+        filesystem::mapped_file m_file;
+        std::span<const resource_pack_entry> m_entries;
+        string_view m_strings;
+    };
+
+    class resource_pack_writer
+    {
+    public:
+        /// @brief Adds a resource, the source file is only read when writing the pack.
+        /// @remarks Resources added with the same source file share their data in the pack.
+        void add(const uuid& id, string_view type, string_view name, cstring_view sourceFile);
+
+        /// @brief Writes the pack to a temporary file first, then replaces the destination.
+        /// @remarks Fails when multiple resources have the same id, the temporary file is removed on failure.
+        expected<> write(cstring_view path, resource_pack_compression compression = resource_pack_compression::none);
+
+    private:
+        struct pending_resource
+        {
+            uuid id;
+            u32 typeOffset;
+            u32 typeLength;
+            u32 nameOffset;
+            u32 nameLength;
+            string sourceFile;
+        };
+
+    private:
+        u32 add_string(string_view str);
+        expected<> write_pack(cstring_view path, resource_pack_compression compression) const;
+
+    private:
+        dynamic_array<pending_resource> m_resources;
+        dynamic_array<char> m_strings;
+    };
+}
\ No newline at end of file
@@ -17,6 +17,7 @@ namespace oblo
         type_id resource_type(resource* resource);
         string_view resource_name(resource* resource);
         uuid resource_uuid(resource* resource);
+        u32 resource_version(resource* resource);
     }
 
     template <typename T = void>
@@ -27,7 +28,6 @@ namespace oblo
 
         resource_ptr(const resource_ptr& other)
         {
-            m_ptr = other.m_ptr;
             m_resource = other.m_resource;
 
             if (m_resource)
@@ -38,10 +38,8 @@ namespace oblo
 
         resource_ptr(resource_ptr&& other) noexcept
         {
-            m_ptr = other.m_ptr;
             m_resource = other.m_resource;
 
-            other.m_ptr = nullptr;
             other.m_resource = nullptr;
         }
 
@@ -51,7 +49,6 @@ namespace oblo
             {
                 detail::resource_acquire(resource);
                 m_resource = resource;
-                m_ptr = detail::resource_data(resource);
             }
         }
 
@@ -64,7 +61,6 @@ namespace oblo
         {
             reset();
 
-            m_ptr = other.m_ptr;
             m_resource = other.m_resource;
 
             if (m_resource)
@@ -78,10 +74,8 @@ namespace oblo
         resource_ptr& operator=(resource_ptr&& other) noexcept
         {
             reset();
-            m_ptr = other.m_ptr;
             m_resource = other.m_resource;
 
-            other.m_ptr = nullptr;
             other.m_resource = nullptr;
             return *this;
         }
@@ -93,7 +87,6 @@ namespace oblo
                 detail::resource_release(m_resource);
             }
 
-            m_ptr = nullptr;
             m_resource = nullptr;
         }
 
@@ -112,19 +105,27 @@ namespace oblo
             return detail::resource_uuid(m_resource);
         }
 
+        /// @brief Retrieves the version of the resource, which changes every time the resource is reloaded.
+        u32 get_version() const noexcept
+        {
+            return detail::resource_version(m_resource);
+        }
+
+        /// @remarks The data is looked up on every call, because reloading a resource replaces it. Pointers should not
+        /// be kept across reloads.
         const T* get() const noexcept
         {
-            return m_ptr;
+            return m_resource ? static_cast<const T*>(detail::resource_data(m_resource)) : nullptr;
         }
 
         const T* operator->() const noexcept
         {
-            return m_ptr;
+            return get();
         }
 
         explicit operator bool() const noexcept
         {
-            return m_ptr != nullptr;
+            return m_resource != nullptr;
         }
 
         template <typename U>
@@ -134,9 +135,7 @@ namespace oblo
 
             if (m_resource && get_type_id<U>() == get_type())
             {
-                other.m_ptr = static_cast<const U*>(m_ptr);
                 other.m_resource = m_resource;
-                m_ptr = nullptr;
                 m_resource = nullptr;
             }
 
@@ -150,7 +149,6 @@ namespace oblo
 
             if (m_resource && get_type_id<U>() == get_type())
             {
-                other.m_ptr = static_cast<const U*>(m_ptr);
                 other.m_resource = m_resource;
                 detail::resource_acquire(m_resource);
             }
@@ -173,7 +171,6 @@ namespace oblo
         friend class resource_ptr;
 
     private:
-        const T* m_ptr{};
         resource* m_resource{};
     };
 }
\ No newline at end of file
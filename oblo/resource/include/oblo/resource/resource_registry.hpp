@@ -1,11 +1,13 @@
 #pragma once
 
 #include <oblo/core/dynamic_array.hpp>
+#include <oblo/core/flat_hash_map.hpp>
 #include <oblo/core/handle.hpp>
 #include <oblo/core/type_id.hpp>
+#include <oblo/core/types.hpp>
 #include <oblo/core/uuid.hpp>
 
-#include <unordered_map>
+#include <span>
 
 namespace oblo
 {
@@ -24,6 +26,19 @@ namespace oblo
     using find_resource_fn = bool (*)(
         const uuid& id, type_id& outType, string& outName, string& outPath, const void* userdata);
 
+    /// @brief The content of a resource, for resources that are not stored in their own file.
+    struct resource_data
+    {
+        /// @brief The data to load, it can point to memory owned by the provider or to the buffer.
+        std::span<const byte> content;
+
+        /// @brief Storage the provider can use when the content has to be transformed first, e.g. decompressed.
+        dynamic_array<byte> buffer;
+    };
+
+    using find_resource_data_fn = bool (*)(
+        const uuid& id, type_id& outType, string& outName, resource_data& outData, const void* userdata);
+
     class resource_registry
     {
     public:
@@ -41,15 +56,34 @@ namespace oblo
         void register_provider(find_resource_fn provider, const void* userdata);
         void unregister_provider(find_resource_fn provider);
 
+        /// @brief Registers a provider that serves the content of resources from memory.
+        /// @remarks Data providers are queried after the file providers, the types of their resources are required to
+        /// implement loadFromMemory.
+        void register_provider(find_resource_data_fn provider, const void* userdata);
+        void unregister_provider(find_resource_data_fn provider);
+
         resource_ptr<void> get_resource(const uuid& id);
 
+        /// @brief Loads the resource again from the providers and replaces the data in place, so that existing
+        /// resource_ptr instances point to the new data and observe a new version.
+        /// @remarks Pointers previously retrieved from the resource are invalidated, so this should only be called by
+        /// the thread that owns the registry, when the data is not being accessed.
+        /// @return True if the resource was loaded and replaced, false if it was not loaded or reloading failed.
+        bool reload_resource(const uuid& id);
+
     private:
         struct resource_storage;
         struct provider_storage;
+        struct data_provider_storage;
+
+    private:
+        /// @brief Finds the resource through the providers, then creates and loads its data.
+        void* create_resource(const uuid& id, const resource_type_desc*& outTypeDesc, string& outName);
 
     private:
-        std::unordered_map<type_id, resource_type_desc> m_resourceTypes;
-        std::unordered_map<uuid, resource_storage> m_resources;
+        flat_hash_map<type_id, resource_type_desc> m_resourceTypes;
+        flat_hash_map<uuid, resource_storage> m_resources;
         dynamic_array<provider_storage> m_providers;
+        dynamic_array<data_provider_storage> m_dataProviders;
     };
 }
\ No newline at end of file
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <oblo/core/type_id.hpp>
+#include <oblo/core/types.hpp>
+
+#include <span>
 
 namespace oblo
 {
@@ -10,6 +13,7 @@ namespace oblo
     using destroy_resource_fn = void (*)(void*);
     using load_resource_fn = bool (*)(void* resource, cstring_view source);
     using save_resource_fn = bool (*)(const void* resource, cstring_view destination);
+    using load_resource_from_memory_fn = bool (*)(void* resource, std::span<const byte> source);
 
     struct resource_type_desc
     {
@@ -18,5 +22,7 @@ namespace oblo
         destroy_resource_fn destroy;
         load_resource_fn load;
         save_resource_fn save;
+        /// @brief Optional, required to load resources served by a data provider, e.g. from a resource pack.
+        load_resource_from_memory_fn loadFromMemory;
     };
 }
\ No newline at end of file
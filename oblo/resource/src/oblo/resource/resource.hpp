@@ -17,6 +17,8 @@ namespace oblo
         uuid id;
         string name;
         std::atomic<u32> counter;
+        /// @brief Incremented every time the data is replaced by a reload.
+        u32 version;
         destroy_resource_fn destroy;
     };
 
@@ -0,0 +1,359 @@
+#include <oblo/resource/resource_pack.hpp>
+
+#include <oblo/core/compression/lz.hpp>
+#include <oblo/core/filesystem/file.hpp>
+#include <oblo/core/filesystem/filesystem.hpp>
+#include <oblo/core/flat_hash_map.hpp>
+#include <oblo/core/string/hashed_string_view.hpp>
+#include <oblo/core/string/string_builder.hpp>
+#include <oblo/core/string/transparent_string_hash.hpp>
+#include <oblo/core/type_id.hpp>
+#include <oblo/resource/resource_registry.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace oblo
+{
+    namespace
+    {
+        static_assert(sizeof(resource_pack_header) % alignof(resource_pack_entry) == 0);
+
+        // A sequence of the lz format can't expand the data more than this, larger sizes mean the entry is corrupt
+        constexpr u64 MaxCompressionRatio{255};
+
+        constexpr u64 align_offset(u64 offset)
+        {
+            return (offset + ResourcePackAlignment - 1) & ~u64{ResourcePackAlignment - 1};
+        }
+
+        bool write_padding(FILE* file, u64& offset)
+        {
+            constexpr byte zeroes[ResourcePackAlignment]{};
+
+            const u64 aligned = align_offset(offset);
+            const usize paddingSize = usize(aligned - offset);
+
+            offset = aligned;
+            return paddingSize == 0 || std::fwrite(zeroes, 1, paddingSize, file) == paddingSize;
+        }
+    }
+
+    expected<> resource_pack::open(cstring_view path)
+    {
+        close();
+
+        if (!m_file.open(path))
+        {
+            return unspecified_error;
+        }
+
+        const auto bytes = m_file.get_bytes();
+
+        if (bytes.size() < sizeof(resource_pack_header))
+        {
+            close();
+            return unspecified_error;
+        }
+
+        resource_pack_header header;
+        std::memcpy(&header, bytes.data(), sizeof(header));
+
+        const usize entriesSize = usize{header.entriesCount} * sizeof(resource_pack_entry);
+
+        if (header.magic != ResourcePackMagic || header.version != ResourcePackVersion ||
+            bytes.size() < sizeof(header) + entriesSize + header.stringsSize)
+        {
+            close();
+            return unspecified_error;
+        }
+
+        const byte* it = bytes.data() + sizeof(header);
+
+        m_entries = {reinterpret_cast<const resource_pack_entry*>(it), header.entriesCount};
+        it += entriesSize;
+
+        m_strings = {reinterpret_cast<const char*>(it), header.stringsSize};
+
+        // Validate all ranges once, so lookups don't need to
+        for (const auto& entry : m_entries)
+        {
+            if (usize{entry.typeOffset} + entry.typeLength > m_strings.size() ||
+                usize{entry.nameOffset} + entry.nameLength > m_strings.size() || entry.dataOffset > bytes.size() ||
+                entry.dataSize > bytes.size() - entry.dataOffset)
+            {
+                close();
+                return unspecified_error;
+            }
+
+            // The uncompressed size is used to allocate the buffer when loading, so it's bound by the data size
+            const bool isCompressed = (entry.flags & resource_pack_entry::CompressedFlag) != 0;
+
+            if (isCompressed ? entry.uncompressedSize > entry.dataSize * MaxCompressionRatio
+                             : entry.uncompressedSize != entry.dataSize)
+            {
+                close();
+                return unspecified_error;
+            }
+        }
+
+        // Only the entries are accessed randomly, the data of each resource is read sequentially when loading it
+        m_file.advise(filesystem::mapped_file_advice::random, 0, sizeof(header) + entriesSize);
+
+        return no_error;
+    }
+
+    void resource_pack::close()
+    {
+        m_file.close();
+        m_entries = {};
+        m_strings = {};
+    }
+
+    u32 resource_pack::get_entries_count() const
+    {
+        return u32(m_entries.size());
+    }
+
+    bool resource_pack::find(const uuid& id, resource_pack_record& record) const
+    {
+        const auto it = std::lower_bound(m_entries.begin(),
+            m_entries.end(),
+            id,
+            [](const resource_pack_entry& entry, const uuid& id) { return entry.id < id; });
+
+        if (it == m_entries.end() || it->id != id)
+        {
+            return false;
+        }
+
+        record = {
+            .id = it->id,
+            .type = get_string(it->typeOffset, it->typeLength),
+            .name = get_string(it->nameOffset, it->nameLength),
+            .data = m_file.get_bytes().subspan(it->dataOffset, it->dataSize),
+            .uncompressedSize = it->uncompressedSize,
+            .isCompressed = (it->flags & resource_pack_entry::CompressedFlag) != 0,
+        };
+
+        return true;
+    }
+
+    bool resource_pack::find_resource(
+        const uuid& id, type_id& outType, string& outName, resource_data& outData, const void* userdata)
+    {
+        auto* const self = static_cast<const resource_pack*>(userdata);
+
+        resource_pack_record record;
+
+        if (!self->find(id, record))
+        {
+            return false;
+        }
+
+        if (record.isCompressed)
+        {
+            // The headers of the frame are checked before allocating, since the entry could disagree with them
+            const auto frameInfo = lz::read_frame_info(record.data);
+
+            if (!frameInfo || frameInfo->uncompressedSize != record.uncompressedSize)
+            {
+                return false;
+            }
+
+            outData.buffer.resize_default(record.uncompressedSize);
+
+            const auto decompressed = lz::decompress_frame(record.data, outData.buffer);
+
+            if (!decompressed || *decompressed != record.uncompressedSize)
+            {
+                return false;
+            }
+
+            outData.content = outData.buffer;
+        }
+        else
+        {
+            outData.content = record.data;
+        }
+
+        // The registry maps the type to the registered one, so the name doesn't need to outlive the mapping
+        outType = type_id{hashed_string_view{record.type}};
+        outName = record.name;
+
+        return true;
+    }
+
+    string_view resource_pack::get_string(u32 offset, u32 length) const
+    {
+        return m_strings.substr(offset, length);
+    }
+
+    void resource_pack_writer::add(const uuid& id, string_view type, string_view name, cstring_view sourceFile)
+    {
+        m_resources.push_back({
+            .id = id,
+            .typeOffset = add_string(type),
+            .typeLength = u32(type.size()),
+            .nameOffset = add_string(name),
+            .nameLength = u32(name.size()),
+            .sourceFile = sourceFile.as<string>(),
+        });
+    }
+
+    expected<> resource_pack_writer::write(cstring_view path, resource_pack_compression compression)
+    {
+        // Entries are sorted by id, to allow binary searching them when reading
+        std::sort(m_resources.begin(),
+            m_resources.end(),
+            [](const pending_resource& lhs, const pending_resource& rhs) { return lhs.id < rhs.id; });
+
+        const auto duplicate = std::adjacent_find(m_resources.begin(),
+            m_resources.end(),
+            [](const pending_resource& lhs, const pending_resource& rhs) { return lhs.id == rhs.id; });
+
+        if (duplicate != m_resources.end())
+        {
+            return unspecified_error;
+        }
+
+        string_builder tmpPath;
+        tmpPath.append(path).append(".tmp");
+
+        // The destination is only replaced when the whole pack was written, nothing is left behind otherwise
+        if (!write_pack(tmpPath, compression) || !filesystem::rename(tmpPath, path))
+        {
+            filesystem::remove(tmpPath).value_or(false);
+            return unspecified_error;
+        }
+
+        return no_error;
+    }
+
+    expected<> resource_pack_writer::write_pack(cstring_view path, resource_pack_compression compression) const
+    {
+        const resource_pack_header header{
+            .magic = ResourcePackMagic,
+            .version = ResourcePackVersion,
+            .entriesCount = u32(m_resources.size()),
+            .stringsSize = u32(m_strings.size()),
+        };
+
+        dynamic_array<resource_pack_entry> entries;
+
+        const filesystem::file_ptr file{filesystem::open_file(path, "wb")};
+
+        if (!file)
+        {
+            return unspecified_error;
+        }
+
+        const usize entriesSize = m_resources.size() * sizeof(resource_pack_entry);
+
+        // The entries are only known after writing the data, so their space is reserved and they are written last
+        entries.resize(m_resources.size());
+
+        if (std::fwrite(&header, sizeof(header), 1, file.get()) != 1 ||
+            (entriesSize != 0 && std::fwrite(entries.data(), entriesSize, 1, file.get()) != 1) ||
+            (!m_strings.empty() && std::fwrite(m_strings.data(), m_strings.size(), 1, file.get()) != 1))
+        {
+            return unspecified_error;
+        }
+
+        u64 offset = sizeof(header) + entriesSize + m_strings.size();
+
+        dynamic_array<byte> compressed;
+
+        // Resources with the same source file share their data
+        flat_hash_map<string_view, usize, transparent_string_hash, transparent_string_equal> writtenSources;
+
+        for (usize i = 0; i < m_resources.size(); ++i)
+        {
+            const auto& resource = m_resources[i];
+
+            if (const auto [it, inserted] = writtenSources.emplace(string_view{resource.sourceFile}, i); !inserted)
+            {
+                const auto& shared = entries[it->second];
+
+                entries[i] = {
+                    .id = resource.id,
+                    .dataOffset = shared.dataOffset,
+                    .dataSize = shared.dataSize,
+                    .uncompressedSize = shared.uncompressedSize,
+                    .typeOffset = resource.typeOffset,
+                    .typeLength = resource.typeLength,
+                    .nameOffset = resource.nameOffset,
+                    .nameLength = resource.nameLength,
+                    .flags = shared.flags,
+                };
+
+                continue;
+            }
+
+            filesystem::mapped_file source;
+
+            if (!source.open(resource.sourceFile))
+            {
+                return unspecified_error;
+            }
+
+            source.advise(filesystem::mapped_file_advice::sequential);
+
+            std::span<const byte> data = source.get_bytes();
+            u32 flags{};
+
+            if (compression == resource_pack_compression::lz && !data.empty())
+            {
+                compressed.clear();
+
+                if (lz::compress_frame(data, compressed) && compressed.size() < data.size())
+                {
+                    data = compressed;
+                    flags |= resource_pack_entry::CompressedFlag;
+                }
+            }
+
+            if (!write_padding(file.get(), offset) ||
+                (!data.empty() && std::fwrite(data.data(), data.size(), 1, file.get()) != 1))
+            {
+                return unspecified_error;
+            }
+
+            entries[i] = {
+                .id = resource.id,
+                .dataOffset = offset,
+                .dataSize = data.size(),
+                .uncompressedSize = source.size(),
+                .typeOffset = resource.typeOffset,
+                .typeLength = resource.typeLength,
+                .nameOffset = resource.nameOffset,
+                .nameLength = resource.nameLength,
+                .flags = flags,
+            };
+
+            offset += data.size();
+        }
+
+        if (entriesSize != 0 &&
+            (std::fseek(file.get(), long(sizeof(header)), SEEK_SET) != 0 ||
+                std::fwrite(entries.data(), entriesSize, 1, file.get()) != 1))
+        {
+            return unspecified_error;
+        }
+
+        if (std::fflush(file.get()) != 0)
+        {
+            return unspecified_error;
+        }
+
+        return no_error;
+    }
+
+    u32 resource_pack_writer::add_string(string_view str)
+    {
+        const auto offset = u32(m_strings.size());
+        m_strings.append(str.begin(), str.end());
+        return offset;
+    }
+}
\ No newline at end of file
@@ -14,6 +14,7 @@ namespace oblo::detail
             .id = id,
             .name = std::move(name),
             .counter = 0,
+            .version = 0,
             .destroy = destroy,
         };
     }
@@ -51,4 +52,9 @@ namespace oblo::detail
     {
         return resource->id;
     }
+
+    u32 resource_version(resource* resource)
+    {
+        return resource->version;
+    }
 }
\ No newline at end of file
@@ -21,6 +21,12 @@ namespace oblo
         const void* userdata;
     };
 
+    struct resource_registry::data_provider_storage
+    {
+        find_resource_data_fn find;
+        const void* userdata;
+    };
+
     resource_registry::resource_registry() = default;
 
     resource_registry::~resource_registry() = default;
@@ -53,52 +59,148 @@ namespace oblo
         }
     }
 
+    void resource_registry::register_provider(find_resource_data_fn provider, const void* userdata)
+    {
+        m_dataProviders.emplace_back(provider, userdata);
+    }
+
+    void resource_registry::unregister_provider(find_resource_data_fn provider)
+    {
+        const auto it = std::find_if(m_dataProviders.begin(),
+            m_dataProviders.end(),
+            [provider](const data_provider_storage& storage) { return storage.find == provider; });
+
+        if (it != m_dataProviders.end())
+        {
+            std::swap(*it, m_dataProviders.back());
+            m_dataProviders.pop_back();
+        }
+    }
+
     resource_ptr<void> resource_registry::get_resource(const uuid& id)
     {
         const auto it = m_resources.find(id);
 
         if (it == m_resources.end())
         {
-            type_id type;
-            string path;
+            const resource_type_desc* typeDesc;
             string name;
-            bool anyFound{false};
 
-            for (const auto [find, userdata] : m_providers)
+            void* const data = create_resource(id, typeDesc, name);
+
+            if (!data)
             {
-                if (find(id, type, name, path, userdata))
-                {
-                    anyFound = true;
-                    break;
-                }
+                return {};
             }
 
-            if (!anyFound)
+            auto* const resource = detail::resource_create(data, typeDesc->type, id, name, typeDesc->destroy);
+            resource_ptr<void> handle{resource};
+            m_resources.emplace(id, resource_storage{.resource = resource, .handle = handle});
+            return handle;
+        }
+
+        return it->second.handle;
+    }
+
+    bool resource_registry::reload_resource(const uuid& id)
+    {
+        const auto it = m_resources.find(id);
+
+        if (it == m_resources.end())
+        {
+            return false;
+        }
+
+        const resource_type_desc* typeDesc;
+        string name;
+
+        void* const data = create_resource(id, typeDesc, name);
+
+        if (!data)
+        {
+            return false;
+        }
+
+        auto* const resource = it->second.resource;
+
+        // The type is part of the handles given out, it can't change without invalidating them
+        if (typeDesc->type != resource->type)
+        {
+            typeDesc->destroy(data);
+            return false;
+        }
+
+        resource->destroy(resource->data);
+
+        resource->data = data;
+        resource->name = std::move(name);
+        resource->destroy = typeDesc->destroy;
+        ++resource->version;
+
+        return true;
+    }
+
+    void* resource_registry::create_resource(const uuid& id, const resource_type_desc*& outTypeDesc, string& outName)
+    {
+        type_id type;
+        string path;
+
+        for (const auto [find, userdata] : m_providers)
+        {
+            if (!find(id, type, outName, path, userdata))
             {
-                return {};
+                continue;
             }
 
             const auto typeIt = m_resourceTypes.find(type);
 
             if (typeIt == m_resourceTypes.end())
             {
-                return {};
+                return nullptr;
             }
 
-            void* const data = typeIt->second.create();
+            const auto& typeDesc = typeIt->second;
+            void* const data = typeDesc.create();
 
-            if (!typeIt->second.load(data, path))
+            if (!typeDesc.load(data, path))
             {
-                typeIt->second.destroy(data);
-                return {};
+                typeDesc.destroy(data);
+                return nullptr;
             }
 
-            auto* const resource = detail::resource_create(data, type, id, name, typeIt->second.destroy);
-            resource_ptr<void> handle{resource};
-            m_resources.emplace(id, resource_storage{.resource = resource, .handle = handle});
-            return handle;
+            outTypeDesc = &typeDesc;
+            return data;
         }
 
-        return it->second.handle;
+        resource_data resourceData;
+
+        for (const auto [find, userdata] : m_dataProviders)
+        {
+            if (!find(id, type, outName, resourceData, userdata))
+            {
+                continue;
+            }
+
+            const auto typeIt = m_resourceTypes.find(type);
+
+            if (typeIt == m_resourceTypes.end() || !typeIt->second.loadFromMemory)
+            {
+                return nullptr;
+            }
+
+            const auto& typeDesc = typeIt->second;
+            void* const data = typeDesc.create();
+
+            if (!typeDesc.loadFromMemory(data, resourceData.content))
+            {
+                typeDesc.destroy(data);
+                return nullptr;
+            }
+
+            outTypeDesc = &typeDesc;
+            return data;
+        }
+
+        return nullptr;
     }
 }
\ No newline at end of file
@@ -0,0 +1,348 @@
+#include <gtest/gtest.h>
+
+#include <oblo/core/filesystem/file.hpp>
+#include <oblo/core/filesystem/filesystem.hpp>
+#include <oblo/core/string/string.hpp>
+#include <oblo/core/string/string_builder.hpp>
+#include <oblo/core/type_id.hpp>
+#include <oblo/resource/resource_pack.hpp>
+#include <oblo/resource/resource_ptr.hpp>
+#include <oblo/resource/resource_registry.hpp>
+#include <oblo/resource/type_desc.hpp>
+
+#include <cstring>
+
+namespace oblo
+{
+    namespace
+    {
+        struct test_blob
+        {
+            string content;
+        };
+
+        bool write_file(cstring_view path, std::span<const byte> content)
+        {
+            const filesystem::file_ptr f{filesystem::open_file(path, "wb")};
+            return f && (content.empty() || std::fwrite(content.data(), content.size(), 1, f.get()) == 1);
+        }
+
+        bool write_file(cstring_view path, string_view content)
+        {
+            return write_file(path, std::as_bytes(std::span{content.data(), content.size()}));
+        }
+
+        string_view as_string_view(std::span<const byte> bytes)
+        {
+            return {reinterpret_cast<const char*>(bytes.data()), bytes.size()};
+        }
+
+        // Patches the first entry of the pack on disk, to simulate corrupted files
+        template <typename F>
+        bool patch_first_entry(cstring_view path, F&& f)
+        {
+            dynamic_array<byte> bytes;
+
+            if (!filesystem::load_binary_file_into_memory(bytes, path))
+            {
+                return false;
+            }
+
+            resource_pack_entry entry;
+            std::memcpy(&entry, bytes.data() + sizeof(resource_pack_header), sizeof(entry));
+
+            f(entry);
+
+            std::memcpy(bytes.data() + sizeof(resource_pack_header), &entry, sizeof(entry));
+            return write_file(path, bytes);
+        }
+    }
+
+    TEST(resource_pack, write_and_find)
+    {
+        constexpr cstring_view testDir{"./test/resource_pack_write_and_find/"};
+        filesystem::remove_all(testDir).assert_value();
+        filesystem::create_directories(testDir).assert_value();
+
+        string_builder zeroesPath, textPath, emptyPath, packPath;
+        zeroesPath.append(testDir).append_path("zeroes.bin");
+        textPath.append(testDir).append_path("text.bin");
+        emptyPath.append(testDir).append_path("empty.bin");
+        packPath.append(testDir).append_path("resources.opack");
+
+        dynamic_array<byte> zeroes;
+        zeroes.resize(usize{1} << 20, byte{});
+
+        ASSERT_TRUE(write_file(zeroesPath, zeroes));
+        ASSERT_TRUE(write_file(textPath, "some text"));
+        ASSERT_TRUE(write_file(emptyPath, ""));
+
+        const uuid zeroesId = "a0000000-0000-0000-0000-000000000001"_uuid;
+        const uuid textId = "10000000-0000-0000-0000-000000000002"_uuid;
+        const uuid sharedId = "50000000-0000-0000-0000-000000000003"_uuid;
+        const uuid emptyId = "30000000-0000-0000-0000-000000000004"_uuid;
+
+        for (const auto compression : {resource_pack_compression::none, resource_pack_compression::lz})
+        {
+            resource_pack_writer writer;
+
+            // Added out of order on purpose, the writer sorts the entries
+            writer.add(zeroesId, "zeroes_type", "zeroes", zeroesPath);
+            writer.add(textId, "text_type", "text", textPath);
+            writer.add(sharedId, "text_type", "shared", textPath);
+            writer.add(emptyId, "empty_type", "", emptyPath);
+
+            ASSERT_TRUE(writer.write(packPath, compression));
+
+            resource_pack pack;
+            ASSERT_TRUE(pack.open(packPath));
+            ASSERT_EQ(pack.get_entries_count(), 4);
+
+            resource_pack_record record;
+
+            ASSERT_TRUE(pack.find(zeroesId, record));
+            ASSERT_EQ(record.id, zeroesId);
+            ASSERT_EQ(record.type, "zeroes_type");
+            ASSERT_EQ(record.name, "zeroes");
+            ASSERT_EQ(record.uncompressedSize, zeroes.size());
+            ASSERT_EQ(record.isCompressed, compression == resource_pack_compression::lz);
+            ASSERT_EQ(reinterpret_cast<uintptr>(record.data.data()) % ResourcePackAlignment, 0);
+
+            type_id type;
+            string name;
+            resource_data data;
+
+            ASSERT_TRUE(resource_pack::find_resource(zeroesId, type, name, data, &pack));
+            ASSERT_EQ(type, type_id{"zeroes_type"_hsv});
+            ASSERT_EQ(name, "zeroes");
+            ASSERT_EQ(data.content.size(), zeroes.size());
+            ASSERT_EQ(std::memcmp(data.content.data(), zeroes.data(), zeroes.size()), 0);
+
+            // Resources with the same source share the data, but keep their own names
+            resource_pack_record sharedRecord;
+            ASSERT_TRUE(pack.find(textId, record));
+            ASSERT_TRUE(pack.find(sharedId, sharedRecord));
+            ASSERT_EQ(record.data.data(), sharedRecord.data.data());
+            ASSERT_EQ(sharedRecord.name, "shared");
+
+            resource_data textData;
+            ASSERT_TRUE(resource_pack::find_resource(sharedId, type, name, textData, &pack));
+            ASSERT_EQ(as_string_view(textData.content), "some text");
+
+            ASSERT_TRUE(pack.find(emptyId, record));
+            ASSERT_TRUE(record.data.empty());
+            ASSERT_TRUE(record.name.empty());
+        }
+    }
+
+    TEST(resource_pack, missing_id)
+    {
+        constexpr cstring_view testDir{"./test/resource_pack_missing_id/"};
+        filesystem::remove_all(testDir).assert_value();
+        filesystem::create_directories(testDir).assert_value();
+
+        string_builder sourcePath, packPath;
+        sourcePath.append(testDir).append_path("source.bin");
+        packPath.append(testDir).append_path("resources.opack");
+
+        ASSERT_TRUE(write_file(sourcePath, "data"));
+
+        resource_pack_writer writer;
+        writer.add("20000000-0000-0000-0000-000000000000"_uuid, "type", "name", sourcePath);
+        ASSERT_TRUE(writer.write(packPath));
+
+        resource_pack pack;
+        ASSERT_TRUE(pack.open(packPath));
+
+        // Ids both before and after the only entry
+        resource_pack_record record;
+        ASSERT_FALSE(pack.find("10000000-0000-0000-0000-000000000000"_uuid, record));
+        ASSERT_FALSE(pack.find("30000000-0000-0000-0000-000000000000"_uuid, record));
+
+        type_id type;
+        string name;
+        resource_data data;
+        ASSERT_FALSE(resource_pack::find_resource(uuid{}, type, name, data, &pack));
+    }
+
+    TEST(resource_pack, failed_writes)
+    {
+        constexpr cstring_view testDir{"./test/resource_pack_failed_writes/"};
+        filesystem::remove_all(testDir).assert_value();
+        filesystem::create_directories(testDir).assert_value();
+
+        string_builder sourcePath, missingPath, packPath, tmpPath;
+        sourcePath.append(testDir).append_path("source.bin");
+        missingPath.append(testDir).append_path("missing.bin");
+        packPath.append(testDir).append_path("resources.opack");
+        tmpPath.append(packPath).append(".tmp");
+
+        ASSERT_TRUE(write_file(sourcePath, "data"));
+
+        const uuid id = "20000000-0000-0000-0000-000000000000"_uuid;
+
+        {
+            resource_pack_writer writer;
+            writer.add(id, "type", "first", sourcePath);
+            writer.add(id, "type", "second", sourcePath);
+            ASSERT_FALSE(writer.write(packPath));
+            ASSERT_FALSE(filesystem::exists(packPath).value_or(true));
+        }
+
+        {
+            resource_pack_writer writer;
+            writer.add(id, "type", "name", sourcePath);
+            ASSERT_TRUE(writer.write(packPath));
+        }
+
+        // The previous pack is kept when writing fails, and the temporary file is removed
+        {
+            resource_pack_writer writer;
+            writer.add("10000000-0000-0000-0000-000000000000"_uuid, "type", "missing", missingPath);
+            ASSERT_FALSE(writer.write(packPath));
+            ASSERT_FALSE(filesystem::exists(tmpPath).value_or(true));
+        }
+
+        resource_pack pack;
+        ASSERT_TRUE(pack.open(packPath));
+
+        resource_pack_record record;
+        ASSERT_TRUE(pack.find(id, record));
+        ASSERT_EQ(record.name, "name");
+    }
+
+    TEST(resource_pack, corrupt_files)
+    {
+        constexpr cstring_view testDir{"./test/resource_pack_corrupt_files/"};
+        filesystem::remove_all(testDir).assert_value();
+        filesystem::create_directories(testDir).assert_value();
+
+        string_builder sourcePath, packPath;
+        sourcePath.append(testDir).append_path("source.bin");
+        packPath.append(testDir).append_path("resources.opack");
+
+        dynamic_array<byte> zeroes;
+        zeroes.resize(4096, byte{});
+        ASSERT_TRUE(write_file(sourcePath, zeroes));
+
+        const uuid id = "20000000-0000-0000-0000-000000000000"_uuid;
+
+        const auto writePack = [&]
+        {
+            resource_pack_writer writer;
+            writer.add(id, "type", "name", sourcePath);
+            return writer.write(packPath, resource_pack_compression::lz).has_value();
+        };
+
+        resource_pack pack;
+
+        dynamic_array<byte> bytes;
+
+        // Truncated header
+        ASSERT_TRUE(writePack());
+        ASSERT_TRUE(filesystem::load_binary_file_into_memory(bytes, packPath));
+        ASSERT_TRUE(write_file(packPath, std::span{bytes}.first(sizeof(resource_pack_header) - 1)));
+        ASSERT_FALSE(pack.open(packPath));
+
+        // Truncated entries
+        ASSERT_TRUE(write_file(packPath, std::span{bytes}.first(sizeof(resource_pack_header) + 8)));
+        ASSERT_FALSE(pack.open(packPath));
+
+        // Wrong magic
+        bytes[0] = ~bytes[0];
+        ASSERT_TRUE(write_file(packPath, bytes));
+        ASSERT_FALSE(pack.open(packPath));
+
+        // Data out of the file
+        ASSERT_TRUE(writePack());
+        ASSERT_TRUE(patch_first_entry(packPath, [](resource_pack_entry& e) { e.dataSize += 1u << 20; }));
+        ASSERT_FALSE(pack.open(packPath));
+
+        // Strings out of the file
+        ASSERT_TRUE(writePack());
+        ASSERT_TRUE(patch_first_entry(packPath, [](resource_pack_entry& e) { e.nameLength = ~u32{}; }));
+        ASSERT_FALSE(pack.open(packPath));
+
+        // A huge uncompressed size is rejected before anything gets allocated
+        ASSERT_TRUE(writePack());
+        ASSERT_TRUE(patch_first_entry(packPath, [](resource_pack_entry& e) { e.uncompressedSize = ~u64{}; }));
+        ASSERT_FALSE(pack.open(packPath));
+
+        ASSERT_TRUE(writePack());
+        ASSERT_TRUE(patch_first_entry(packPath,
+            [](resource_pack_entry& e)
+            {
+                e.flags = 0;
+                e.uncompressedSize = e.dataSize + 1;
+            }));
+        ASSERT_FALSE(pack.open(packPath));
+
+        // A plausible size that doesn't match the frame is only detected when loading
+        ASSERT_TRUE(writePack());
+        ASSERT_TRUE(patch_first_entry(packPath, [](resource_pack_entry& e) { e.uncompressedSize -= 1; }));
+        ASSERT_TRUE(pack.open(packPath));
+
+        type_id type;
+        string name;
+        resource_data data;
+        ASSERT_FALSE(resource_pack::find_resource(id, type, name, data, &pack));
+        ASSERT_TRUE(data.buffer.empty());
+
+        pack.close();
+
+        ASSERT_TRUE(writePack());
+        ASSERT_TRUE(pack.open(packPath));
+        ASSERT_TRUE(resource_pack::find_resource(id, type, name, data, &pack));
+        ASSERT_EQ(data.content.size(), zeroes.size());
+    }
+
+    TEST(resource_pack, resource_registry)
+    {
+        constexpr cstring_view testDir{"./test/resource_pack_resource_registry/"};
+        filesystem::remove_all(testDir).assert_value();
+        filesystem::create_directories(testDir).assert_value();
+
+        string_builder sourcePath, packPath;
+        sourcePath.append(testDir).append_path("source.bin");
+        packPath.append(testDir).append_path("resources.opack");
+
+        ASSERT_TRUE(write_file(sourcePath, "blob content, blob content, blob content, blob content"));
+
+        const uuid id = "20000000-0000-0000-0000-000000000000"_uuid;
+        const auto blobType = get_type_id<test_blob>();
+
+        {
+            resource_pack_writer writer;
+            writer.add(id, blobType.name, "blob", sourcePath);
+            ASSERT_TRUE(writer.write(packPath, resource_pack_compression::lz));
+        }
+
+        resource_pack pack;
+        ASSERT_TRUE(pack.open(packPath));
+
+        resource_registry registry;
+
+        registry.register_type({
+            .type = blobType,
+            .create = []() -> void* { return new test_blob{}; },
+            .destroy = [](void* ptr) { delete static_cast<test_blob*>(ptr); },
+            .load = [](void*, cstring_view) { return false; },
+            .save = [](const void*, cstring_view) { return false; },
+            .loadFromMemory =
+                [](void* ptr, std::span<const byte> source)
+            {
+                static_cast<test_blob*>(ptr)->content = as_string_view(source);
+                return true;
+            },
+        });
+
+        registry.register_provider(&resource_pack::find_resource, &pack);
+
+        const auto blob = registry.get_resource(id).as<test_blob>();
+        ASSERT_TRUE(blob);
+        ASSERT_EQ(blob.get_name(), "blob");
+        ASSERT_EQ(blob->content, "blob content, blob content, blob content, blob content");
+
+        ASSERT_FALSE(registry.get_resource("10000000-0000-0000-0000-000000000000"_uuid));
+    }
+}
\ No newline at end of file
@@ -32,6 +32,7 @@ namespace oblo
         vk::vulkan_context* vulkanContext;
         std::span<ecs::world_builder* const> worldBuilders;
         usize frameAllocatorMaxSize{1u << 28};
+        usize entityChunksArenaSize{1ull << 30};
     };
 
     struct runtime_update_context
@@ -1,6 +1,7 @@
 #include <oblo/runtime/runtime.hpp>
 
 #include <oblo/core/frame_allocator.hpp>
+#include <oblo/core/memory_tracking.hpp>
 #include <oblo/core/service_registry.hpp>
 #include <oblo/ecs/component_type_desc.hpp>
 #include <oblo/ecs/entity_registry.hpp>
@@ -93,7 +94,18 @@ namespace oblo
             &m_impl->typeRegistry,
             initializer.propertyRegistry);
 
-        m_impl->entities.init(&m_impl->typeRegistry);
+        if (!m_impl->entities.init(&m_impl->typeRegistry,
+                {
+                    .chunkArenaSize = initializer.entityChunksArenaSize,
+                    .useHugePages = true,
+                }))
+        {
+            m_impl.reset();
+            return false;
+        }
+
+        // Systems rely on the journal to react to structural changes, rather than scanning the whole world
+        m_impl->entities.set_journaling_enabled(true);
 
         m_impl->services.add<vk::vulkan_context>().externally_owned(initializer.vulkanContext);
         m_impl->services.add<vk::renderer>().externally_owned(&m_impl->renderer);
@@ -147,12 +159,18 @@ namespace oblo
 
         const auto frameAllocatorScope = m_impl->frameAllocator.make_scoped_restore();
 
-        m_impl->executor.update({
-            .entities = &m_impl->entities,
-            .services = &m_impl->services,
-            .frameAllocator = &m_impl->frameAllocator,
-            .dt = ctx.dt,
-        });
+        {
+            OBLO_MEMORY_TAG_SCOPE("ecs");
+
+            m_impl->entities.trim_journal();
+
+            m_impl->executor.update({
+                .entities = &m_impl->entities,
+                .services = &m_impl->services,
+                .frameAllocator = &m_impl->frameAllocator,
+                .dt = ctx.dt,
+            });
+        }
 
         m_impl->renderer.update(m_impl->frameAllocator);
     }
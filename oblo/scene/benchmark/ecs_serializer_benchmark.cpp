@@ -0,0 +1,178 @@
+#include <benchmark/benchmark.h>
+
+#include <oblo/core/iterator/zip_range.hpp>
+#include <oblo/core/types.hpp>
+#include <oblo/ecs/entity_registry.hpp>
+#include <oblo/ecs/range.hpp>
+#include <oblo/ecs/type_registry.hpp>
+#include <oblo/math/quaternion.hpp>
+#include <oblo/math/vec3.hpp>
+#include <oblo/modules/module_manager.hpp>
+#include <oblo/properties/property_registry.hpp>
+#include <oblo/properties/serialization/data_document.hpp>
+#include <oblo/reflection/reflection_module.hpp>
+#include <oblo/reflection/reflection_registry.hpp>
+#include <oblo/scene/components/position_component.hpp>
+#include <oblo/scene/components/rotation_component.hpp>
+#include <oblo/scene/components/scale_component.hpp>
+#include <oblo/scene/scene_module.hpp>
+#include <oblo/scene/serialization/ecs_serializer.hpp>
+#include <oblo/scene/utility/ecs_utility.hpp>
+
+namespace oblo::benchmarks
+{
+    namespace
+    {
+        // Serialization goes through a data_document, which is considerably bigger than the registry itself
+        constexpr i64 MinEntities{1'000};
+        constexpr i64 MaxEntities{1'000'000};
+
+        using ecs::entity_registry;
+        using ecs::type_registry;
+
+        struct serialization_context
+        {
+            serialization_context() : reflectionRegistry{mm.load<reflection::reflection_module>()->get_registry()}
+            {
+                mm.load<scene_module>();
+
+                propertyRegistry.init(reflectionRegistry);
+
+                ecs_utility::register_reflected_component_and_tag_types(reflectionRegistry,
+                    &typeRegistry,
+                    &propertyRegistry);
+            }
+
+            module_manager mm;
+            const reflection::reflection_registry& reflectionRegistry;
+            type_registry typeRegistry;
+            property_registry propertyRegistry;
+        };
+
+        serialization_context& get_serialization_context()
+        {
+            static serialization_context s_ctx;
+            return s_ctx;
+        }
+
+        void set_entities_processed(benchmark::State& state, i64 entitiesPerIteration)
+        {
+            state.SetItemsProcessed(state.iterations() * entitiesPerIteration);
+        }
+
+        void populate(entity_registry& reg, u32 count)
+        {
+            reg.create<position_component, rotation_component, scale_component>(count);
+
+            f32 i{};
+
+            for (const auto [entities, positions, rotations, scales] :
+                reg.range<position_component, rotation_component, scale_component>())
+            {
+                for (auto&& [p, r, s] : zip_range(positions, rotations, scales))
+                {
+                    p.value = vec3{i, i + 1, i + 2};
+                    r.value = quaternion::identity();
+                    s.value = vec3::splat(1.f);
+                    ++i;
+                }
+            }
+        }
+
+        void serialize_write(benchmark::State& state)
+        {
+            auto& ctx = get_serialization_context();
+            const u32 count = u32(state.range(0));
+
+            entity_registry reg{&ctx.typeRegistry};
+            populate(reg, count);
+
+            for (auto _ : state)
+            {
+                data_document doc;
+                doc.init();
+
+                const auto r = ecs_serializer::write(doc, doc.get_root(), reg, ctx.propertyRegistry);
+                benchmark::DoNotOptimize(r);
+            }
+
+            set_entities_processed(state, count);
+        }
+
+        void serialize_read(benchmark::State& state)
+        {
+            auto& ctx = get_serialization_context();
+            const u32 count = u32(state.range(0));
+
+            data_document doc;
+            doc.init();
+
+            {
+                entity_registry reg{&ctx.typeRegistry};
+                populate(reg, count);
+
+                if (!ecs_serializer::write(doc, doc.get_root(), reg, ctx.propertyRegistry))
+                {
+                    state.SkipWithError("Failed to write the document");
+                    return;
+                }
+            }
+
+            for (auto _ : state)
+            {
+                entity_registry reg{&ctx.typeRegistry};
+
+                const auto r = ecs_serializer::read(reg, doc, doc.get_root(), ctx.propertyRegistry);
+                benchmark::DoNotOptimize(r);
+
+                state.PauseTiming();
+                reg = {};
+                state.ResumeTiming();
+            }
+
+            set_entities_processed(state, count);
+        }
+
+        void serialize_round_trip(benchmark::State& state)
+        {
+            auto& ctx = get_serialization_context();
+            const u32 count = u32(state.range(0));
+
+            entity_registry source{&ctx.typeRegistry};
+            populate(source, count);
+
+            for (auto _ : state)
+            {
+                data_document doc;
+                doc.init();
+
+                if (!ecs_serializer::write(doc, doc.get_root(), source, ctx.propertyRegistry))
+                {
+                    state.SkipWithError("Failed to write the document");
+                    break;
+                }
+
+                entity_registry destination{&ctx.typeRegistry};
+
+                if (!ecs_serializer::read(destination, doc, doc.get_root(), ctx.propertyRegistry))
+                {
+                    state.SkipWithError("Failed to read the document");
+                    break;
+                }
+
+                benchmark::ClobberMemory();
+            }
+
+            set_entities_processed(state, count);
+        }
+
+        void serialization_range(benchmark::internal::Benchmark* b)
+        {
+            b->RangeMultiplier(10)->Range(MinEntities, MaxEntities)->Unit(benchmark::kMillisecond);
+        }
+    }
+
+    BENCHMARK(serialize_write)->Apply(serialization_range);
+    BENCHMARK(serialize_read)->Apply(serialization_range);
+    BENCHMARK(serialize_round_trip)->Apply(serialization_range);
+}
\ No newline at end of file
@@ -12,6 +12,7 @@
 
 namespace oblo
 {
+    class data_document;
     class property_registry;
     class texture;
 
@@ -84,6 +85,10 @@ namespace oblo
 
         SCENE_API bool save(cstring_view destination) const;
         SCENE_API bool load(cstring_view source);
+        SCENE_API bool load(std::span<const byte> source);
+
+    private:
+        bool load(const data_document& doc);
 
     private:
         struct string_hash
@@ -169,4 +174,4 @@ namespace oblo
     {
         return material_property_type::texture;
     }
-}
+}
\ No newline at end of file
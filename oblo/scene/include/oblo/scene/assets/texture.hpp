@@ -51,6 +51,7 @@ namespace oblo
 
         bool save(cstring_view path) const;
         bool load(cstring_view path);
+        bool load(std::span<const byte> data);
 
         texture_desc get_description() const;
 
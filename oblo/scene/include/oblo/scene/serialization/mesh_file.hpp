@@ -2,6 +2,9 @@
 
 #include <oblo/core/dynamic_array.hpp>
 #include <oblo/core/flags.hpp>
+#include <oblo/core/types.hpp>
+
+#include <span>
 
 namespace tinygltf
 {
@@ -34,4 +37,5 @@ namespace oblo
         flags<mesh_post_process> processingFlags);
 
     SCENE_API bool load_mesh(mesh& mesh, cstring_view source);
+    SCENE_API bool load_mesh(mesh& mesh, std::span<const byte> content);
 }
\ No newline at end of file
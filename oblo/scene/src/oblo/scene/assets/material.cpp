@@ -124,6 +124,26 @@ namespace oblo
             return false;
         }
 
+        return load(doc);
+    }
+
+    bool material::load(std::span<const byte> source)
+    {
+        m_map.clear();
+        m_properties.clear();
+
+        data_document doc;
+
+        if (!json::read(doc, source))
+        {
+            return false;
+        }
+
+        return load(doc);
+    }
+
+    bool material::load(const data_document& doc)
+    {
         const auto& nodes = doc.get_nodes();
         const auto root = doc.get_root();
 
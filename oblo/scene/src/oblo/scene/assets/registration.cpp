@@ -1,5 +1,6 @@
 #include <oblo/scene/assets/registration.hpp>
 
+#include <oblo/core/filesystem/mapped_file.hpp>
 #include <oblo/resource/resource_registry.hpp>
 #include <oblo/resource/type_desc.hpp>
 #include <oblo/scene/assets/material.hpp>
@@ -9,6 +10,7 @@
 #include <oblo/scene/serialization/mesh_file.hpp>
 
 #include <fstream>
+#include <span>
 
 #include <nlohmann/json.hpp>
 
@@ -71,11 +73,24 @@ namespace oblo
             }
 
             static bool load(model& model, cstring_view source)
+            {
+                filesystem::mapped_file file;
+
+                if (!file.open(source))
+                {
+                    return false;
+                }
+
+                return load(model, file.get_bytes());
+            }
+
+            static bool load(model& model, std::span<const byte> source)
             {
                 try
                 {
-                    std::ifstream ifs{source.as<std::string>()};
-                    const auto json = nlohmann::json::parse(ifs);
+                    const auto* const begin = reinterpret_cast<const char*>(source.data());
+
+                    const auto json = nlohmann::json::parse(begin, begin + source.size());
                     json.at("meshes").get_to(model.meshes);
                     json.at("materials").get_to(model.materials);
                     return true;
@@ -99,6 +114,11 @@ namespace oblo
             {
                 return load_mesh(mesh, source);
             }
+
+            static bool load(mesh& mesh, std::span<const byte> source)
+            {
+                return load_mesh(mesh, source);
+            }
         };
 
         template <>
@@ -113,6 +133,11 @@ namespace oblo
             {
                 return texture.load(source);
             }
+
+            static bool load(texture& texture, std::span<const byte> source)
+            {
+                return texture.load(source);
+            }
         };
 
         template <>
@@ -127,6 +152,11 @@ namespace oblo
             {
                 return material.load(source);
             }
+
+            static bool load(material& material, std::span<const byte> source)
+            {
+                return material.load(source);
+            }
         };
 
         template <typename T>
@@ -139,6 +169,8 @@ namespace oblo
                 .load = [](void* ptr, cstring_view source) { return meta<T>::load(*static_cast<T*>(ptr), source); },
                 .save = [](const void* ptr, cstring_view destination)
                 { return meta<T>::save(*static_cast<const T*>(ptr), destination); },
+                .loadFromMemory = [](void* ptr, std::span<const byte> source)
+                { return meta<T>::load(*static_cast<T*>(ptr), source); },
             };
         }
     }
@@ -2,6 +2,7 @@
 
 #include <oblo/core/debug.hpp>
 #include <oblo/core/filesystem/file.hpp>
+#include <oblo/core/filesystem/mapped_file.hpp>
 #include <oblo/math/vec2u.hpp>
 
 #include <vulkan/vulkan_core.h>
@@ -179,18 +180,28 @@ namespace oblo
 
     bool texture::load(cstring_view path)
     {
-        deallocate();
-
-        ktxTexture* newKtx{};
-
-        const filesystem::file_ptr f{filesystem::open_file(path, "rb")};
+        filesystem::mapped_file file;
 
-        if (!f)
+        if (!file.open(path))
         {
+            deallocate();
             return false;
         }
 
-        const auto err = ktxTexture_CreateFromStdioStream(f.get(),
+        file.advise(filesystem::mapped_file_advice::sequential);
+
+        // KTX copies the image data into its own storage, so the mapping can go away after this
+        return load(file.get_bytes());
+    }
+
+    bool texture::load(std::span<const byte> data)
+    {
+        deallocate();
+
+        ktxTexture* newKtx{};
+
+        const auto err = ktxTexture_CreateFromMemory(reinterpret_cast<const ktx_uint8_t*>(data.data()),
+            data.size(),
             ktxTextureCreateStorageEnum::KTX_TEXTURE_CREATE_ALLOC_STORAGE,
             &newKtx);
 
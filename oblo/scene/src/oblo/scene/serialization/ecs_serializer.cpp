@@ -51,8 +51,8 @@ namespace oblo::ecs_serializer
         {
             const auto componentsAndTags = get_component_and_tag_sets(archetype);
 
-            if (!componentsAndTags.components.intersection(cfg.skipEntities.components).is_empty() ||
-                !componentsAndTags.tags.intersection(cfg.skipEntities.tags).is_empty())
+            if (componentsAndTags.components.intersects(cfg.skipEntities.components) ||
+                componentsAndTags.tags.intersects(cfg.skipEntities.tags))
             {
                 continue;
             }
@@ -3,6 +3,7 @@
 #include <oblo/core/data_format.hpp>
 #include <oblo/core/debug.hpp>
 #include <oblo/core/filesystem/filesystem.hpp>
+#include <oblo/core/filesystem/mapped_file.hpp>
 #include <oblo/core/string/cstring_view.hpp>
 #include <oblo/math/float.hpp>
 #include <oblo/math/vec2.hpp>
@@ -669,152 +670,157 @@ namespace oblo
         return true;
     }
 
-    bool load_mesh(mesh& mesh, cstring_view source)
+    namespace
     {
-        std::ifstream ifs{source.as<std::string>(), std::ios::ate | std::ios::binary};
-
-        if (!ifs)
-        {
-            return false;
-        }
-
-        const auto fileSize = narrow_cast<u32>(ifs.tellg());
-
-        constexpr auto MagicCharsCount{4};
-
-        if (MagicCharsCount > fileSize)
+        // The base directory is only used to resolve external buffers, meshes written by save_mesh have none
+        bool load_mesh_from_memory(mesh& mesh, std::span<const byte> content, const std::string& baseDir)
         {
-            return false;
-        }
-
-        char magic[MagicCharsCount];
-
-        ifs.seekg(0);
-        ifs.read(magic, MagicCharsCount);
-
-        if (!ifs)
-        {
-            return false;
-        }
-
-        ifs.seekg(0);
+            const auto fileSize = narrow_cast<u32>(content.size());
 
-        std::vector<char> content;
-        content.resize(fileSize);
+            constexpr auto MagicCharsCount{4};
 
-        ifs.read(content.data(), fileSize);
+            if (MagicCharsCount > fileSize)
+            {
+                return false;
+            }
 
-        tinygltf::TinyGLTF loader;
-        loader.SetStoreOriginalJSONForExtrasAndExtensions(true);
+            const std::string_view magic{reinterpret_cast<const char*>(content.data()), MagicCharsCount};
 
-        tinygltf::Model model;
+            tinygltf::TinyGLTF loader;
+            loader.SetStoreOriginalJSONForExtrasAndExtensions(true);
 
-        const auto parentPath = filesystem::parent_path(source).as<std::string>();
+            tinygltf::Model model;
 
-        std::string err, warn;
+            std::string err, warn;
 
-        bool success;
-
-        if (std::string_view{magic, MagicCharsCount} == "glTF")
-        {
-            success = loader.LoadBinaryFromMemory(&model,
-                &err,
-                &warn,
-                reinterpret_cast<const unsigned char*>(content.data()),
-                fileSize,
-                parentPath);
-        }
-        else
-        {
-            success = loader.LoadASCIIFromString(&model, &err, &warn, content.data(), fileSize, parentPath);
-        }
+            bool success;
 
-        if (!success)
-        {
-            return false;
-        }
+            if (magic == "glTF")
+            {
+                success = loader.LoadBinaryFromMemory(&model,
+                    &err,
+                    &warn,
+                    reinterpret_cast<const unsigned char*>(content.data()),
+                    fileSize,
+                    baseDir);
+            }
+            else
+            {
+                success = loader.LoadASCIIFromString(&model,
+                    &err,
+                    &warn,
+                    reinterpret_cast<const char*>(content.data()),
+                    fileSize,
+                    baseDir);
+            }
 
-        if (model.meshes.size() != 1 || model.meshes[0].primitives.size() != 1)
-        {
-            return false;
-        }
+            if (!success)
+            {
+                return false;
+            }
 
-        const auto& primitive = model.meshes[0].primitives[0];
+            if (model.meshes.size() != 1 || model.meshes[0].primitives.size() != 1)
+            {
+                return false;
+            }
 
-        // We count indices as attributes here
-        const auto maxAttributes = primitive.attributes.size() + 1;
+            const auto& primitive = model.meshes[0].primitives[0];
 
-        dynamic_array<mesh_attribute> attributes;
-        attributes.reserve(maxAttributes);
+            // We count indices as attributes here
+            const auto maxAttributes = primitive.attributes.size() + 1;
 
-        dynamic_array<gltf_accessor> sources;
-        sources.reserve(maxAttributes);
+            dynamic_array<mesh_attribute> attributes;
+            attributes.reserve(maxAttributes);
 
-        if (load_mesh(mesh, model, primitive, attributes, sources, nullptr, {}))
-        {
-            aabb aabb = aabb::make_invalid();
+            dynamic_array<gltf_accessor> sources;
+            sources.reserve(maxAttributes);
 
-            if (const auto& extra = model.meshes[0].extras_json_string; !extra.empty())
+            if (load_mesh(mesh, model, primitive, attributes, sources, nullptr, {}))
             {
-                using tinygltf::Value;
+                aabb aabb = aabb::make_invalid();
 
-                const auto json = tinygltf::detail::json::parse(extra, nullptr, false);
+                if (const auto& extra = model.meshes[0].extras_json_string; !extra.empty())
+                {
+                    using tinygltf::Value;
 
-                Value extraValue;
+                    const auto json = tinygltf::detail::json::parse(extra, nullptr, false);
 
-                if (!json.is_discarded() && tinygltf::ParseJsonAsValue(&extraValue, json))
-                {
-                    auto& aabbValue = extraValue.Get(ExtraAabb);
+                    Value extraValue;
 
-                    if (aabbValue.IsObject())
+                    if (!json.is_discarded() && tinygltf::ParseJsonAsValue(&extraValue, json))
                     {
-                        auto& minValue = aabbValue.Get("min");
-                        auto& maxValue = aabbValue.Get("max");
+                        auto& aabbValue = extraValue.Get(ExtraAabb);
 
-                        for (u32 i = 0; i < 3; ++i)
+                        if (aabbValue.IsObject())
                         {
-                            aabb.min[i] = f32(minValue.Get(i).GetNumberAsDouble());
-                            aabb.max[i] = f32(maxValue.Get(i).GetNumberAsDouble());
+                            auto& minValue = aabbValue.Get("min");
+                            auto& maxValue = aabbValue.Get("max");
+
+                            for (u32 i = 0; i < 3; ++i)
+                            {
+                                aabb.min[i] = f32(minValue.Get(i).GetNumberAsDouble());
+                                aabb.max[i] = f32(maxValue.Get(i).GetNumberAsDouble());
+                            }
                         }
-                    }
 
-                    auto& meshletsValue = extraValue.Get(ExtraMeshlets);
+                        auto& meshletsValue = extraValue.Get(ExtraMeshlets);
 
-                    if (meshletsValue.IsObject())
-                    {
-                        auto& countValue = meshletsValue.Get("count");
-                        auto& bufferViewIdValue = meshletsValue.Get("bufferViewId");
+                        if (meshletsValue.IsObject())
+                        {
+                            auto& countValue = meshletsValue.Get("count");
+                            auto& bufferViewIdValue = meshletsValue.Get("bufferViewId");
 
-                        const u32 meshletCount = u32(countValue.GetNumberAsInt());
-                        const u32 bufferViewId = u32(bufferViewIdValue.GetNumberAsInt());
+                            const u32 meshletCount = u32(countValue.GetNumberAsInt());
+                            const u32 bufferViewId = u32(bufferViewIdValue.GetNumberAsInt());
 
-                        mesh.reset_meshlets(meshletCount);
+                            mesh.reset_meshlets(meshletCount);
 
-                        if (bufferViewId < model.bufferViews.size())
-                        {
-                            const auto dstMeshlets = mesh.get_meshlets();
+                            if (bufferViewId < model.bufferViews.size())
+                            {
+                                const auto dstMeshlets = mesh.get_meshlets();
 
-                            auto& bufferView = model.bufferViews[bufferViewId];
-                            OBLO_ASSERT(bufferView.byteLength == dstMeshlets.size_bytes());
+                                auto& bufferView = model.bufferViews[bufferViewId];
+                                OBLO_ASSERT(bufferView.byteLength == dstMeshlets.size_bytes());
 
-                            if (bufferView.byteLength == dstMeshlets.size_bytes())
-                            {
-                                auto& buffer = model.buffers[bufferView.buffer];
+                                if (bufferView.byteLength == dstMeshlets.size_bytes())
+                                {
+                                    auto& buffer = model.buffers[bufferView.buffer];
 
-                                std::memcpy(dstMeshlets.data(),
-                                    buffer.data.data() + bufferView.byteOffset,
-                                    bufferView.byteLength);
+                                    std::memcpy(dstMeshlets.data(),
+                                        buffer.data.data() + bufferView.byteOffset,
+                                        bufferView.byteLength);
+                                }
                             }
                         }
                     }
                 }
+
+                mesh.set_aabb(aabb);
+
+                return true;
             }
 
-            mesh.set_aabb(aabb);
+            return false;
+        }
+    }
+
+    bool load_mesh(mesh& mesh, cstring_view source)
+    {
+        // Map the file and parse it in place, rather than reading it into a temporary buffer
+        filesystem::mapped_file file;
 
-            return true;
+        if (!file.open(source))
+        {
+            return false;
         }
 
-        return false;
+        file.advise(filesystem::mapped_file_advice::sequential);
+
+        return load_mesh_from_memory(mesh, file.get_bytes(), filesystem::parent_path(source).as<std::string>());
+    }
+
+    bool load_mesh(mesh& mesh, std::span<const byte> content)
+    {
+        return load_mesh_from_memory(mesh, content, {});
     }
 }
\ No newline at end of file
@@ -1,9 +1,12 @@
 #include <oblo/scene/systems/transform_system.hpp>
 
+#include <oblo/core/dynamic_array.hpp>
+#include <oblo/core/frame_allocator.hpp>
 #include <oblo/core/iterator/zip_range.hpp>
 #include <oblo/ecs/entity_registry.hpp>
 #include <oblo/ecs/range.hpp>
 #include <oblo/ecs/systems/system_update_context.hpp>
+#include <oblo/math/batch_transform.hpp>
 #include <oblo/math/transform.hpp>
 #include <oblo/scene/components/global_transform_component.hpp>
 #include <oblo/scene/components/position_component.hpp>
@@ -14,22 +17,61 @@ namespace oblo
 {
     void transform_system::update(const ecs::system_update_context& ctx)
     {
+        dynamic_array<f32> trs{ctx.frameAllocator};
+        dynamic_array<mat4> matrices{ctx.frameAllocator};
+
         for (const auto [entities, globalTransforms] : ctx.entities->range<global_transform_component>())
         {
-            for (auto&& [e, globalTransform] : zip_range(entities, globalTransforms))
+            const usize count = entities.size();
+
+            // Gathering position, rotation and scale as structure of arrays, to compose the matrices in batches
+            trs.resize(count * 10);
+
+            const auto component = [base = trs.data(), count](usize index) { return base + index * count; };
+
+            f32* const p[3] = {component(0), component(1), component(2)};
+            f32* const r[4] = {component(3), component(4), component(5), component(6)};
+            f32* const s[3] = {component(7), component(8), component(9)};
+
+            for (usize i = 0; i < count; ++i)
             {
+                const ecs::entity e = entities[i];
+
                 auto* const position = ctx.entities->try_get<position_component>(e);
                 auto* const rotation = ctx.entities->try_get<rotation_component>(e);
                 auto* const scale = ctx.entities->try_get<scale_component>(e);
 
-                globalTransform.lastFrameLocalToWorld = globalTransform.localToWorld;
+                const vec3 pValue = position ? position->value : vec3{};
+                const quaternion rValue = rotation ? rotation->value : quaternion::identity();
+                const vec3 sValue = scale ? scale->value : vec3::splat(1.f);
+
+                p[0][i] = pValue.x;
+                p[1][i] = pValue.y;
+                p[2][i] = pValue.z;
 
-                globalTransform.localToWorld = make_transform_matrix(position ? position->value : vec3{},
-                    rotation ? rotation->value : quaternion::identity(),
-                    scale ? scale->value : vec3::splat(1.f));
+                r[0][i] = rValue.x;
+                r[1][i] = rValue.y;
+                r[2][i] = rValue.z;
+                r[3][i] = rValue.w;
 
-                globalTransform.normalMatrix =
-                    transpose(inverse(globalTransform.localToWorld).value_or(mat4::identity()));
+                s[0][i] = sValue.x;
+                s[1][i] = sValue.y;
+                s[2][i] = sValue.z;
+            }
+
+            matrices.resize(count * 2);
+
+            const std::span localToWorld{matrices.data(), count};
+            const std::span normalMatrices{matrices.data() + count, count};
+
+            make_transform_matrices({p[0], p[1], p[2]}, {r[0], r[1], r[2], r[3]}, {s[0], s[1], s[2]}, localToWorld);
+            inverse_transpose(localToWorld, normalMatrices);
+
+            for (auto&& [globalTransform, l, n] : zip_range(globalTransforms, localToWorld, normalMatrices))
+            {
+                globalTransform.lastFrameLocalToWorld = globalTransform.localToWorld;
+                globalTransform.localToWorld = l;
+                globalTransform.normalMatrix = n;
             }
         }
     }
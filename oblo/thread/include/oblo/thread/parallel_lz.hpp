@@ -0,0 +1,160 @@
+#pragma once
+
+#include <oblo/core/compression/lz.hpp>
+#include <oblo/core/dynamic_array.hpp>
+#include <oblo/thread/parallel_for.hpp>
+
+#include <atomic>
+#include <cstring>
+
+namespace oblo::lz
+{
+    /// @brief Compresses the blocks of a frame in parallel, appending the frame to the output array.
+    /// @remarks The produced frame is identical to the one produced by compress_frame.
+    inline expected<usize> parallel_compress_frame(
+        std::span<const byte> src, dynamic_array<byte>& out, u32 blockSize = DefaultBlockSize)
+    {
+        if (blockSize == 0 || blockSize > MaxBlockSize)
+        {
+            return unspecified_error;
+        }
+
+        const usize blocksCount = (src.size() + blockSize - 1) / blockSize;
+
+        if (blocksCount <= 1)
+        {
+            return compress_frame(src, out, blockSize);
+        }
+
+        // Each block is compressed in its own slot, sized for the worst case, then slots are concatenated
+        const usize slotSize = sizeof(block_header) + compress_bound(blockSize);
+
+        dynamic_array<byte> slots;
+        slots.resize_default(blocksCount * slotSize);
+
+        dynamic_array<usize> slotSizes;
+        slotSizes.resize_default(blocksCount);
+
+        parallel_for(
+            [&](job_range range)
+            {
+                for (u32 block = range.begin; block < range.end; ++block)
+                {
+                    const usize offset = usize{block} * blockSize;
+                    const auto data = src.subspan(offset, min(usize{blockSize}, src.size() - offset));
+
+                    slotSizes[block] = write_frame_block(data, std::span{slots}.subspan(block * slotSize, slotSize));
+                }
+            },
+            job_range{0, u32(blocksCount)},
+            1);
+
+        usize frameSize = sizeof(frame_header) + sizeof(u32);
+
+        for (const usize size : slotSizes)
+        {
+            frameSize += size;
+        }
+
+        const usize begin = out.size();
+        out.resize_default(begin + frameSize);
+
+        byte* it = out.data() + begin;
+
+        const frame_header header{.magic = FrameMagic, .blockSize = blockSize};
+        std::memcpy(it, &header, sizeof(header));
+        it += sizeof(header);
+
+        for (usize block = 0; block < blocksCount; ++block)
+        {
+            std::memcpy(it, slots.data() + block * slotSize, slotSizes[block]);
+            it += slotSizes[block];
+        }
+
+        constexpr u32 endMarker{0};
+        std::memcpy(it, &endMarker, sizeof(endMarker));
+
+        return frameSize;
+    }
+
+    /// @brief Decompresses the blocks of a frame in parallel, see decompress_frame.
+    inline expected<usize> parallel_decompress_frame(std::span<const byte> frame, std::span<byte> dst)
+    {
+        const auto info = read_frame_info(frame);
+
+        if (!info || dst.size() < info->uncompressedSize)
+        {
+            return unspecified_error;
+        }
+
+        if (info->blocksCount <= 1)
+        {
+            return decompress_frame(frame, dst);
+        }
+
+        struct block_location
+        {
+            usize frameOffset;
+            usize dstOffset;
+            block_header header;
+        };
+
+        // The frame was already validated, so it's safe to walk the headers to find where each block starts
+        dynamic_array<block_location> blocks;
+        blocks.resize_default(info->blocksCount);
+
+        usize frameOffset = sizeof(frame_header);
+        usize dstOffset = 0;
+
+        for (auto& block : blocks)
+        {
+            std::memcpy(&block.header, frame.data() + frameOffset, sizeof(block_header));
+            frameOffset += sizeof(block_header);
+
+            block.frameOffset = frameOffset;
+            block.dstOffset = dstOffset;
+
+            frameOffset += block.header.compressedSize & ~block_header::StoredFlag;
+            dstOffset += block.header.uncompressedSize;
+        }
+
+        std::atomic<bool> failed{false};
+
+        parallel_for(
+            [&](job_range range)
+            {
+                for (u32 i = range.begin; i < range.end; ++i)
+                {
+                    const block_location& block = blocks[i];
+
+                    const u32 dataSize = block.header.compressedSize & ~block_header::StoredFlag;
+                    const auto data = frame.subspan(block.frameOffset, dataSize);
+                    const auto out = dst.subspan(block.dstOffset, block.header.uncompressedSize);
+
+                    if (block.header.compressedSize & block_header::StoredFlag)
+                    {
+                        if (dataSize != out.size())
+                        {
+                            failed.store(true, std::memory_order_relaxed);
+                            continue;
+                        }
+
+                        std::memcpy(out.data(), data.data(), dataSize);
+                    }
+                    else if (decompress_block(data, out).value_or(~usize{}) != out.size())
+                    {
+                        failed.store(true, std::memory_order_relaxed);
+                    }
+                }
+            },
+            job_range{0, info->blocksCount},
+            1);
+
+        if (failed.load(std::memory_order_relaxed))
+        {
+            return unspecified_error;
+        }
+
+        return usize(info->uncompressedSize);
+    }
+}
\ No newline at end of file
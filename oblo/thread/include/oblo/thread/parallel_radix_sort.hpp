@@ -0,0 +1,180 @@
+#pragma once
+
+#include <oblo/core/dynamic_array.hpp>
+#include <oblo/core/radix_sort.hpp>
+#include <oblo/thread/parallel_for.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace oblo
+{
+    namespace detail
+    {
+        template <radix_sort_key Key, typename Payload>
+        void parallel_radix_sort_impl(
+            Key* keys, Payload* payloads, Key* keysScratch, Payload* payloadsScratch, u32 count, u32 granularity)
+        {
+            const u32 blocksCount = count / granularity + u32{count % granularity != 0};
+
+            if (blocksCount <= 1)
+            {
+                radix_sort_impl(keys, payloads, keysScratch, payloadsScratch, count);
+                return;
+            }
+
+            constexpr u32 passesCount = radix_passes_count<Key>();
+
+            // One histogram per block, which becomes the list of write offsets of the block after the prefix sum
+            dynamic_array<u32> blockHistograms;
+            blockHistograms.resize(usize{blocksCount} * RadixSortBuckets);
+
+            Key* srcKeys = keys;
+            Key* dstKeys = keysScratch;
+            Payload* srcPayloads = payloads;
+            Payload* dstPayloads = payloadsScratch;
+
+            for (u32 pass = 0; pass < passesCount; ++pass)
+            {
+                // Elements move across blocks after each pass, so histograms have to be recomputed every time
+                parallel_for(
+                    [&](job_range range)
+                    {
+                        for (u32 block = range.begin; block < range.end; ++block)
+                        {
+                            u32* const histogram = blockHistograms.data() + usize{block} * RadixSortBuckets;
+                            std::fill_n(histogram, RadixSortBuckets, 0u);
+
+                            const u32 begin = block * granularity;
+                            const u32 end = begin + min(granularity, count - begin);
+
+                            for (u32 i = begin; i < end; ++i)
+                            {
+                                ++histogram[radix_digit(srcKeys[i], pass)];
+                            }
+                        }
+                    },
+                    job_range{0, blocksCount},
+                    1);
+
+                const u32 firstDigit = radix_digit(srcKeys[0], pass);
+                u32 firstDigitCount = 0;
+
+                for (u32 block = 0; block < blocksCount; ++block)
+                {
+                    firstDigitCount += blockHistograms[usize{block} * RadixSortBuckets + firstDigit];
+                }
+
+                if (firstDigitCount == count)
+                {
+                    continue;
+                }
+
+                // Digit-major prefix sum, so that each block writes after the previous blocks with the same digit
+                u32 offset = 0;
+
+                for (u32 d = 0; d < RadixSortBuckets; ++d)
+                {
+                    for (u32 block = 0; block < blocksCount; ++block)
+                    {
+                        u32& entry = blockHistograms[usize{block} * RadixSortBuckets + d];
+                        const u32 n = entry;
+                        entry = offset;
+                        offset += n;
+                    }
+                }
+
+                parallel_for(
+                    [&](job_range range)
+                    {
+                        for (u32 block = range.begin; block < range.end; ++block)
+                        {
+                            u32* const offsets = blockHistograms.data() + usize{block} * RadixSortBuckets;
+
+                            const u32 begin = block * granularity;
+                            const u32 end = begin + min(granularity, count - begin);
+
+                            for (u32 i = begin; i < end; ++i)
+                            {
+                                const u32 dst = offsets[radix_digit(srcKeys[i], pass)]++;
+                                dstKeys[dst] = srcKeys[i];
+
+                                if constexpr (radix_has_payload<Payload>)
+                                {
+                                    dstPayloads[dst] = std::move(srcPayloads[i]);
+                                }
+                            }
+                        }
+                    },
+                    job_range{0, blocksCount},
+                    1);
+
+                std::swap(srcKeys, dstKeys);
+                std::swap(srcPayloads, dstPayloads);
+            }
+
+            if (srcKeys != keys)
+            {
+                parallel_for(
+                    [&](job_range range)
+                    {
+                        const u32 begin = range.begin * granularity;
+                        const u32 end = begin + min((range.end - range.begin) * granularity, count - begin);
+
+                        std::memcpy(keys + begin, srcKeys + begin, (end - begin) * sizeof(Key));
+
+                        if constexpr (radix_has_payload<Payload>)
+                        {
+                            for (u32 i = begin; i < end; ++i)
+                            {
+                                payloads[i] = std::move(srcPayloads[i]);
+                            }
+                        }
+                    },
+                    job_range{0, blocksCount},
+                    1);
+            }
+        }
+    }
+
+    /// @brief Parallel version of radix_sort, running on the job_manager.
+    /// @remarks The input is split into blocks of granularity elements. Each pass computes the histograms of all
+    /// blocks in parallel, then scatters the blocks in parallel to disjoint ranges of the output, so the sort stays
+    /// stable. Inputs that fit in a single block are sorted on the calling thread.
+    template <radix_sort_key Key, typename Payload>
+    void parallel_radix_sort(std::span<Key> keys,
+        std::span<Payload> payloads,
+        std::span<Key> keysScratch,
+        std::span<Payload> payloadsScratch,
+        u32 granularity = 1u << 16)
+    {
+        OBLO_ASSERT(keys.size() == payloads.size());
+        OBLO_ASSERT(keysScratch.size() >= keys.size());
+        OBLO_ASSERT(payloadsScratch.size() >= keys.size());
+        OBLO_ASSERT(keys.size() <= ~u32{});
+        OBLO_ASSERT(granularity > 0);
+
+        detail::parallel_radix_sort_impl(keys.data(),
+            payloads.data(),
+            keysScratch.data(),
+            payloadsScratch.data(),
+            u32(keys.size()),
+            granularity);
+    }
+
+    /// @brief Parallel version of radix_sort_keys, running on the job_manager.
+    template <radix_sort_key Key>
+    void parallel_radix_sort_keys(std::span<Key> keys, std::span<Key> keysScratch, u32 granularity = 1u << 16)
+    {
+        OBLO_ASSERT(keysScratch.size() >= keys.size());
+        OBLO_ASSERT(keys.size() <= ~u32{});
+        OBLO_ASSERT(granularity > 0);
+
+        detail::parallel_radix_sort_impl(keys.data(),
+            static_cast<detail::radix_no_payload*>(nullptr),
+            keysScratch.data(),
+            static_cast<detail::radix_no_payload*>(nullptr),
+            u32(keys.size()),
+            granularity);
+    }
+}
\ No newline at end of file
@@ -2,13 +2,13 @@
 
 #include <oblo/core/compressed_pointer_with_flags.hpp>
 #include <oblo/core/dynamic_array.hpp>
+#include <oblo/core/pool_allocator.hpp>
 #include <oblo/trace/profile.hpp>
 
 #include <moodycamel/concurrentqueue.h>
 
 #include <atomic>
 #include <format>
-#include <memory_resource>
 #include <span>
 #include <thread>
 
@@ -168,10 +168,14 @@ namespace oblo
 
         void worker_thread_init(job_manager* manager, u32 id, job_queue* q, std::atomic<worker_state>* state)
         {
-#ifdef TRACY_ENABLE
+#if defined(TRACY_ENABLE) || defined(OBLO_BUILTIN_PROFILER)
             char threadName[64]{};
             std::format_to_n(threadName, 64, "{}oblo worker #{}", id == 0 ? "main - " : "", id);
+    #ifdef TRACY_ENABLE
             tracy::SetThreadName(threadName);
+    #else
+            trace::set_thread_name(threadName);
+    #endif
 #endif
 
             s_tlsWorkerCtx = {
@@ -216,7 +220,7 @@ namespace oblo
         explicit impl(u32 numThreads) : threads{get_global_allocator(), numThreads} {}
 
         dynamic_array<worker_thread> threads;
-        std::pmr::synchronized_pool_resource userdataPool;
+        pool_allocator userdataPool;
     };
 
     THREAD_API job_manager* job_manager::get()
@@ -410,7 +414,7 @@ namespace oblo
 
     void job_manager::deallocate_userdata(void* ptr, usize size, usize alignment)
     {
-        m_impl->userdataPool.deallocate(ptr, size, alignment);
+        m_impl->userdataPool.deallocate(static_cast<byte*>(ptr), size, alignment);
     }
 
     void* job_manager::do_inline_buffer(job_handle h)
@@ -3,7 +3,11 @@
 #include <oblo/core/dynamic_array.hpp>
 #include <oblo/thread/job_manager.hpp>
 #include <oblo/thread/parallel_for.hpp>
+#include <oblo/thread/parallel_lz.hpp>
+#include <oblo/thread/parallel_radix_sort.hpp>
 
+#include <algorithm>
+#include <random>
 #include <thread>
 
 namespace oblo
@@ -230,4 +234,91 @@ namespace oblo
 
         jm.shutdown();
     }
+
+    TEST(parallel_radix_sort, matches_stable_sort)
+    {
+        job_manager jm;
+
+        ASSERT_TRUE(jm.init());
+
+        constexpr u32 N{100'000};
+
+        std::mt19937_64 rng{42};
+
+        dynamic_array<u64> keys;
+        dynamic_array<u32> payloads;
+        keys.resize(N);
+        payloads.resize(N);
+
+        for (u32 i = 0; i < N; ++i)
+        {
+            // Few distinct keys spread over different digits, to check stability and skipped passes
+            keys[i] = (rng() & 0xFF00000000000F0Full);
+            payloads[i] = i;
+        }
+
+        dynamic_array<u32> expected;
+        expected.assign(payloads.begin(), payloads.end());
+
+        std::stable_sort(expected.begin(),
+            expected.end(),
+            [&keys](u32 lhs, u32 rhs) { return keys[lhs] < keys[rhs]; });
+
+        dynamic_array<u64> keysScratch;
+        dynamic_array<u32> payloadsScratch;
+        keysScratch.resize(N);
+        payloadsScratch.resize(N);
+
+        // Using an uneven granularity, so that the last block is partial
+        parallel_radix_sort(std::span<u64>{keys},
+            std::span<u32>{payloads},
+            std::span<u64>{keysScratch},
+            std::span<u32>{payloadsScratch},
+            7'000);
+
+        ASSERT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+
+        for (u32 i = 0; i < N; ++i)
+        {
+            ASSERT_EQ(payloads[i], expected[i]);
+        }
+
+        jm.shutdown();
+    }
+
+    TEST(parallel_lz, matches_sequential_frame)
+    {
+        job_manager jm;
+
+        ASSERT_TRUE(jm.init());
+
+        std::mt19937 rng{42};
+
+        dynamic_array<byte> data;
+        data.resize(1'000'000);
+
+        for (auto& b : data)
+        {
+            // Low entropy data, so that blocks are actually compressed
+            b = byte(rng() % 8);
+        }
+
+        constexpr u32 BlockSize{1u << 15};
+
+        dynamic_array<byte> expected;
+        lz::compress_frame(data, expected, BlockSize).assert_value();
+
+        dynamic_array<byte> frame;
+        ASSERT_EQ(lz::parallel_compress_frame(data, frame, BlockSize).value_or(0), expected.size());
+
+        ASSERT_TRUE(std::equal(frame.begin(), frame.end(), expected.begin()));
+
+        dynamic_array<byte> decompressed;
+        decompressed.resize(data.size());
+
+        ASSERT_EQ(lz::parallel_decompress_frame(frame, decompressed).value_or(0), data.size());
+        ASSERT_TRUE(std::equal(data.begin(), data.end(), decompressed.begin()));
+
+        jm.shutdown();
+    }
 }
\ No newline at end of file
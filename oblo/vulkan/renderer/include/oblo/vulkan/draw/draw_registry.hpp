@@ -5,6 +5,7 @@
 #include <oblo/core/string/string_interner.hpp>
 #include <oblo/core/uuid.hpp>
 #include <oblo/ecs/entity_registry.hpp>
+#include <oblo/ecs/journal.hpp>
 #include <oblo/ecs/type_registry.hpp>
 #include <oblo/vulkan/draw/mesh_database.hpp>
 #include <oblo/vulkan/dynamic_buffer.hpp>
@@ -23,6 +24,9 @@ namespace oblo
 
     template <typename>
     struct resource_ref;
+
+    template <typename>
+    class resource_ptr;
 }
 
 namespace oblo::vk
@@ -121,6 +125,7 @@ namespace oblo::vk
 
     private:
         struct blas;
+        struct pending_mesh_release;
         struct pending_mesh_upload;
         struct instance_data_type_info;
 
@@ -133,6 +138,9 @@ namespace oblo::vk
 
     private:
         void create_instances();
+        void reload_meshes();
+        void release_unused_meshes();
+        h32<draw_mesh> upload_mesh(const resource_ref<mesh>& resourceId, const resource_ptr<mesh>& meshResource);
         void defer_upload(const std::span<const byte> data, const buffer& b);
 
         void release(rt_acceleration_structure& as);
@@ -154,6 +162,10 @@ namespace oblo::vk
         ecs::tag_type m_indexU16Tag{};
         ecs::tag_type m_indexU32Tag{};
 
+        ecs::component_and_tag_sets m_meshTypes{};
+        ecs::component_and_tag_sets m_instanceTypes{};
+        ecs::journal_cursor m_journalCursor{};
+
         const batch_draw_data* m_drawData{};
         u32 m_drawDataCount{};
 
@@ -170,6 +182,7 @@ namespace oblo::vk
         std::array<h32<string>, MeshBuffersCount> m_meshDataNames{};
 
         dynamic_array<pending_mesh_upload> m_pendingMeshUploads;
+        dynamic_array<pending_mesh_release> m_pendingMeshReleases;
 
         h32_flat_extpool_dense_map<draw_mesh, blas> m_meshToBlas;
 
@@ -65,6 +65,10 @@ namespace oblo::vk
         mesh_handle create_mesh(
             u32 meshAttributesMask, mesh_index_type indexType, u32 vertexCount, u32 indexCount, u32 meshletsCount);
 
+        /// @brief Makes the space of the mesh available to new meshes, the handle might be reused.
+        /// @remarks The caller has to make sure the GPU is done with the mesh.
+        void release_mesh(mesh_handle mesh);
+
         bool fetch_buffers(mesh_handle mesh,
             std::span<const u32> vertexAttributes,
             std::span<buffer> vertexBuffers,
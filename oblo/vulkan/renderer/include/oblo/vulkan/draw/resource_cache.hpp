@@ -1,11 +1,10 @@
 #pragma once
 
+#include <oblo/core/flat_hash_map.hpp>
 #include <oblo/core/handle.hpp>
 #include <oblo/core/types.hpp>
 #include <oblo/core/uuid.hpp>
 
-#include <unordered_map>
-
 namespace oblo
 {
     template <typename T>
@@ -34,14 +33,22 @@ namespace oblo::vk
 
         void init(resource_registry& resources, texture_registry& textureRegistry);
 
+        /// @brief Retrieves the resident texture for the resource, uploading it if necessary.
+        /// @remarks The handle stays valid when the resource is reloaded, the texture is uploaded again in place.
         h32<resident_texture> get_or_add(const texture_resource_ref& t);
 
+        /// @brief Uploads again the textures whose resources were reloaded since they were uploaded.
+        void update();
+
     private:
         struct cached_texture;
 
+    private:
+        void update(cached_texture& cached);
+
     private:
         resource_registry* m_resources{};
         texture_registry* m_textureRegistry{};
-        std::unordered_map<uuid, cached_texture> m_textures;
+        flat_hash_map<uuid, cached_texture> m_textures;
     };
 }
\ No newline at end of file
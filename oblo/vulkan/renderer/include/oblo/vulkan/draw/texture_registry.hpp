@@ -44,6 +44,11 @@ namespace oblo::vk
         h32<resident_texture> add(const texture_resource& texture, const debug_label& debugName);
         void remove(h32<resident_texture> texture);
 
+        /// @brief Uploads new data for the texture, keeping the handle valid.
+        /// @remarks The previous image is destroyed once the frames in flight are done with it.
+        /// @return False if the new texture could not be created, the previous one is kept in that case.
+        bool update(h32<resident_texture> texture, const texture_resource& data, const debug_label& debugName);
+
         std::span<const VkDescriptorImageInfo> get_textures2d_info() const;
 
         u32 get_max_descriptor_count() const;
@@ -56,6 +61,7 @@ namespace oblo::vk
     private:
         bool create(const texture_resource& texture, resident_texture& out, const debug_label& debugName);
         void set_texture(h32<resident_texture> h, const resident_texture& residentTexture, VkImageLayout layout);
+        void destroy_deferred(const resident_texture& texture);
 
     private:
         vulkan_context* m_vkCtx{};
@@ -113,6 +113,14 @@ namespace oblo::vk
     {
         rt_acceleration_structure as;
         resource_ref<mesh> mesh;
+        resource_ptr<oblo::mesh> resource;
+        u32 version;
+    };
+
+    struct draw_registry::pending_mesh_release
+    {
+        mesh_handle mesh;
+        u64 submitIndex;
     };
 
     struct draw_registry::pending_mesh_upload
@@ -241,12 +249,18 @@ namespace oblo::vk
 
         m_typeRegistry = &entities.get_type_registry();
 
-        m_typeRegistry->register_component(ecs::make_component_type_desc<draw_mesh_component>());
+        const auto meshComponent =
+            m_typeRegistry->register_component(ecs::make_component_type_desc<draw_mesh_component>());
         m_typeRegistry->register_tag(ecs::make_tag_type_desc<draw_raytraced_tag>());
 
         m_instanceComponent =
             m_typeRegistry->register_component(ecs::make_component_type_desc<draw_instance_component>());
 
+        m_meshTypes.components.add(meshComponent);
+        m_instanceTypes.components.add(m_instanceComponent);
+
+        OBLO_ASSERT(entities.is_journaling_enabled());
+
         m_instanceIdComponent =
             m_typeRegistry->register_component(ecs::make_component_type_desc<draw_instance_id_component>());
 
@@ -269,6 +283,7 @@ namespace oblo::vk
 
     void draw_registry::shutdown()
     {
+        m_pendingMeshReleases.clear();
         m_meshes.shutdown();
         m_rtScratchBuffer.shutdown();
         m_rtInstanceBuffer.shutdown();
@@ -316,8 +331,15 @@ namespace oblo::vk
             return {};
         }
 
-        mesh convertedMesh;
+        const auto globalMeshId = upload_mesh(resourceId, meshResource);
+        m_cachedMeshes.emplace(resourceId.id, globalMeshId);
 
+        return globalMeshId;
+    }
+
+    h32<draw_mesh> draw_registry::upload_mesh(
+        const resource_ref<mesh>& resourceId, const resource_ptr<mesh>& meshResource)
+    {
         const mesh* const meshPtr = meshResource.get();
 
         const u32 numAttributes = meshPtr->get_attributes_count();
@@ -364,6 +386,12 @@ namespace oblo::vk
             meshPtr->get_index_count(),
             meshPtr->get_meshlet_count());
 
+        if (!meshHandle)
+        {
+            log::error("Failed to allocate mesh {} in the mesh database", resourceId.id);
+            return {};
+        }
+
         buffer indexBuffer{};
         buffer meshletsBuffer{};
         buffer vertexBuffers[u32(vertex_attributes::enum_max)];
@@ -421,7 +449,6 @@ namespace oblo::vk
         }
 
         const h32<draw_mesh> globalMeshId{make_mesh_id(meshHandle)};
-        m_cachedMeshes.emplace(resourceId.id, globalMeshId);
 
         // We need to cache the meshlets to build the BLAS on-demand
 
@@ -429,10 +456,113 @@ namespace oblo::vk
         OBLO_ASSERT(ok);
 
         meshIt->mesh = resourceId;
+        meshIt->resource = meshResource;
+        meshIt->version = meshResource.get_version();
 
         return globalMeshId;
     }
 
+    void draw_registry::reload_meshes()
+    {
+        struct reloaded_mesh
+        {
+            h32<draw_mesh> previous;
+            h32<draw_mesh> current;
+        };
+
+        dynamic_array<reloaded_mesh> reloadedMeshes;
+
+        for (auto& [id, meshId] : m_cachedMeshes)
+        {
+            auto* const blas = m_meshToBlas.try_find(meshId);
+
+            if (!blas || blas->version == blas->resource.get_version())
+            {
+                continue;
+            }
+
+            const resource_ref<mesh> resourceId = blas->mesh;
+            const resource_ptr<mesh> meshResource = blas->resource;
+
+            // The previous mesh is kept when the new one can't be uploaded, until the resource changes again
+            blas->version = meshResource.get_version();
+
+            const auto newMeshId = upload_mesh(resourceId, meshResource);
+
+            if (!newMeshId)
+            {
+                continue;
+            }
+
+            // The acceleration structure and the previous mesh are released once the frames in flight are done, the
+            // lookup is repeated since uploading might have moved the entries
+            release(m_meshToBlas.try_find(meshId)->as);
+            m_meshToBlas.erase(meshId);
+
+            m_pendingMeshReleases.push_back({
+                .mesh = std::bit_cast<mesh_handle>(meshId),
+                .submitIndex = m_ctx->get_submit_index(),
+            });
+
+            reloadedMeshes.emplace_back(meshId, newMeshId);
+            meshId = newMeshId;
+        }
+
+        if (reloadedMeshes.empty())
+        {
+            return;
+        }
+
+        dynamic_array<ecs::entity> entitiesToUpdate;
+
+        for (auto&& [entities, meshes] : m_entities->range<draw_mesh_component>())
+        {
+            for (auto&& [entity, mesh] : zip_range(entities, meshes))
+            {
+                for (const auto& reloaded : reloadedMeshes)
+                {
+                    if (mesh.mesh == reloaded.previous)
+                    {
+                        mesh.mesh = reloaded.current;
+                        entitiesToUpdate.push_back(entity);
+                        break;
+                    }
+                }
+            }
+        }
+
+        // The index type of the mesh might have changed, so the instances are created again by create_instances
+        ecs::component_and_tag_sets instanceSets{};
+        instanceSets.components.add(m_instanceComponent);
+        instanceSets.components.add(m_instanceIdComponent);
+        instanceSets.tags.add(m_indexNoneTag);
+        instanceSets.tags.add(m_indexU8Tag);
+        instanceSets.tags.add(m_indexU16Tag);
+        instanceSets.tags.add(m_indexU32Tag);
+
+        for (const auto entity : entitiesToUpdate)
+        {
+            m_entities->remove(entity, instanceSets);
+        }
+    }
+
+    void draw_registry::release_unused_meshes()
+    {
+        for (usize i = 0; i < m_pendingMeshReleases.size();)
+        {
+            const auto& pending = m_pendingMeshReleases[i];
+
+            if (!m_ctx->is_submit_done(pending.submitIndex))
+            {
+                ++i;
+                continue;
+            }
+
+            m_meshes.release_mesh(pending.mesh);
+            m_pendingMeshReleases.erase_unordered(m_pendingMeshReleases.begin() + i);
+        }
+    }
+
     void draw_registry::create_instances()
     {
         // Just gather entities and create after the iteration for now, should do something better after fixing #7
@@ -444,18 +574,28 @@ namespace oblo::vk
 
         dynamic_array<deferred_creation> entitiesToUpdate;
 
-        for (const auto [entities, meshes] :
-            m_entities->range<draw_mesh_component>().exclude<draw_instance_component>())
+        // Only entities that received a mesh since the last frame need to be looked at
+        for (const auto& record : m_entities->read_journal(m_journalCursor))
         {
-            for (const auto [entity, mesh] : zip_range(entities, meshes))
+            if (!ecs::has_entered(record, m_meshTypes, m_instanceTypes))
             {
-                entitiesToUpdate.emplace_back(entity, mesh.mesh);
+                continue;
             }
+
+            // The entity might have been changed again or destroyed after this record
+            if (!ecs::matches(m_entities->get_archetype_storage(record.entity), m_meshTypes, m_instanceTypes))
+            {
+                continue;
+            }
+
+            const auto& mesh = m_entities->get<draw_mesh_component>(record.entity);
+            entitiesToUpdate.emplace_back(record.entity, mesh.mesh);
         }
 
         for (const auto [entity, mesh] : entitiesToUpdate)
         {
-            if (!mesh)
+            // The journal may hold multiple records for the same entity, the first one we process adds the instance
+            if (!mesh || !ecs::matches(m_entities->get_archetype_storage(entity), m_meshTypes, m_instanceTypes))
             {
                 continue;
             }
@@ -572,6 +712,8 @@ namespace oblo::vk
 
     void draw_registry::generate_draw_calls(frame_allocator& allocator, staging_buffer& stagingBuffer)
     {
+        release_unused_meshes();
+        reload_meshes();
         create_instances();
 
         const std::span archetypes = m_entities->get_archetypes();
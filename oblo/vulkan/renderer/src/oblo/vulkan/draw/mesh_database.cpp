@@ -236,6 +236,16 @@ namespace oblo::vk
         return make_mesh_handle(u32(&*it - m_tables.data()), outHandle[0]);
     }
 
+    void mesh_database::release_mesh(mesh_handle mesh)
+    {
+        OBLO_ASSERT(mesh);
+
+        const auto [tableId, meshId] = parse_mesh_handle(mesh);
+        const mesh_table_entry_id ids[] = {meshId};
+
+        m_tables[tableId].meshes->free_meshes(ids);
+    }
+
     bool mesh_database::fetch_buffers(mesh_handle mesh,
         std::span<const u32> vertexAttributes,
         std::span<buffer> vertexBuffers,
@@ -9,6 +9,81 @@ namespace oblo::vk
 {
     namespace
     {
+        // Takes the first free range that fits, or grows the used part of the table
+        template <typename FreeList>
+        bool allocate_range(FreeList& freeList, u32& firstFree, u32 capacity, u32 count, u32& offset)
+        {
+            if (count == 0)
+            {
+                offset = firstFree;
+                return true;
+            }
+
+            for (auto it = freeList.begin(); it != freeList.end(); ++it)
+            {
+                if (it->count >= count)
+                {
+                    offset = it->offset;
+                    it->offset += count;
+                    it->count -= count;
+
+                    if (it->count == 0)
+                    {
+                        freeList.erase(it);
+                    }
+
+                    return true;
+                }
+            }
+
+            if (capacity - firstFree < count)
+            {
+                return false;
+            }
+
+            offset = firstFree;
+            firstFree += count;
+            return true;
+        }
+
+        // Merges the range with the adjacent free ones, giving it back to the unused part of the table when possible
+        template <typename FreeList>
+        void free_range(FreeList& freeList, u32& firstFree, u32 offset, u32 count)
+        {
+            if (count == 0)
+            {
+                return;
+            }
+
+            for (auto it = freeList.begin(); it != freeList.end();)
+            {
+                if (it->offset + it->count == offset)
+                {
+                    offset = it->offset;
+                    count += it->count;
+                    it = freeList.erase(it);
+                }
+                else if (offset + count == it->offset)
+                {
+                    count += it->count;
+                    it = freeList.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+
+            if (offset + count == firstFree)
+            {
+                firstFree = offset;
+            }
+            else
+            {
+                freeList.push_back({offset, count});
+            }
+        }
+
         u32 compute_buffer_size(std::span<const buffer_column_description> columns, u32 multiplier, u32 alignment)
         {
             u32 maxBufferSize = narrow_cast<u32>((alignment - 1) * columns.size());
@@ -152,6 +227,11 @@ namespace oblo::vk
         m_firstFreeMesh = 0u;
         m_firstFreeMeshlet = 0u;
 
+        m_freeVertices.clear();
+        m_freeIndices.clear();
+        m_freeMeshes.clear();
+        m_freeMeshlets.clear();
+
         return true;
     }
 
@@ -188,6 +268,11 @@ namespace oblo::vk
         m_ranges.clear();
         m_firstFreeIndex = 0u;
         m_firstFreeVertex = 0u;
+
+        m_freeVertices.clear();
+        m_freeIndices.clear();
+        m_freeMeshes.clear();
+        m_freeMeshlets.clear();
     }
 
     bool mesh_table::fetch_buffers(const resource_manager& resourceManager,
@@ -306,30 +391,8 @@ namespace oblo::vk
     {
         OBLO_ASSERT(meshes.size() == outHandles.size());
 
-        u32 numVertices{0};
-        u32 numIndices{0};
-        u32 numMeshlets{0};
-
-        for (const auto& mesh : meshes)
-        {
-            numVertices += mesh.vertexCount;
-            numIndices += mesh.indexCount;
-            numMeshlets += mesh.meshletCount;
-        }
-
-        const auto newVertexEnd = m_firstFreeVertex + numVertices;
-        const auto newIndexEnd = m_firstFreeIndex + numIndices;
-        const auto newMeshletEnd = m_firstFreeMeshlet + numMeshlets;
-
         // If we have no mesh data to attach, we can ignore allocations for m_meshDataTable
         const u32 meshDataRow = m_meshDataTable.rows_count() == 0 ? 0 : 1;
-        const auto newMeshesEnd = m_firstFreeMesh + meshDataRow * meshes.size();
-
-        if (newVertexEnd > m_vertexTable.rows_count() || newMeshesEnd > m_meshDataTable.rows_count() ||
-            newIndexEnd > m_totalIndices || newMeshletEnd > m_meshDataTable.rows_count())
-        {
-            return false;
-        }
 
         bool allSucceeded = true;
 
@@ -337,25 +400,64 @@ namespace oblo::vk
 
         for (const auto [meshVertices, meshIndices, meshletCount] : meshes)
         {
-            const auto [it, key] = m_ranges.emplace(buffer_range{
-                .vertexOffset = m_firstFreeVertex,
+            buffer_range range{
                 .vertexCount = meshVertices,
-                .indexOffset = m_firstFreeIndex,
                 .indexCount = meshIndices,
-                .meshOffset = m_firstFreeMesh,
-                .meshletOffset = m_firstFreeMeshlet,
                 .meshletCount = meshletCount,
-            });
+            };
+
+            const bool hasVertices = allocate_range(m_freeVertices,
+                m_firstFreeVertex,
+                m_vertexTable.rows_count(),
+                meshVertices,
+                range.vertexOffset);
 
-            if (key)
+            const bool hasIndices = hasVertices &&
+                allocate_range(m_freeIndices, m_firstFreeIndex, m_totalIndices, meshIndices, range.indexOffset);
+
+            const bool hasMeshData = hasIndices &&
+                allocate_range(
+                    m_freeMeshes, m_firstFreeMesh, m_meshDataTable.rows_count(), meshDataRow, range.meshOffset);
+
+            const bool hasMeshlets = hasMeshData &&
+                allocate_range(m_freeMeshlets,
+                    m_firstFreeMeshlet,
+                    m_meshDataTable.rows_count(),
+                    meshletCount,
+                    range.meshletOffset);
+
+            mesh_table_entry_id key{};
+
+            if (hasMeshlets)
+            {
+                key = m_ranges.emplace(range).second;
+            }
+
+            if (!key)
             {
-                m_firstFreeVertex += meshVertices;
-                m_firstFreeIndex += meshIndices;
-                m_firstFreeMesh += meshDataRow;
-                m_firstFreeMeshlet += meshletCount;
-                *outIt = key;
+                // Gives back whatever was allocated for this mesh
+                if (hasMeshlets)
+                {
+                    free_range(m_freeMeshlets, m_firstFreeMeshlet, range.meshletOffset, meshletCount);
+                }
+
+                if (hasMeshData)
+                {
+                    free_range(m_freeMeshes, m_firstFreeMesh, range.meshOffset, meshDataRow);
+                }
+
+                if (hasIndices)
+                {
+                    free_range(m_freeIndices, m_firstFreeIndex, range.indexOffset, meshIndices);
+                }
+
+                if (hasVertices)
+                {
+                    free_range(m_freeVertices, m_firstFreeVertex, range.vertexOffset, meshVertices);
+                }
             }
 
+            *outIt = key;
             ++outIt;
 
             allSucceeded &= bool{key};
@@ -364,6 +466,28 @@ namespace oblo::vk
         return allSucceeded;
     }
 
+    void mesh_table::free_meshes(std::span<const mesh_table_entry_id> meshes)
+    {
+        const u32 meshDataRow = m_meshDataTable.rows_count() == 0 ? 0 : 1;
+
+        for (const auto mesh : meshes)
+        {
+            const auto* const range = m_ranges.try_find(mesh);
+
+            if (!range)
+            {
+                continue;
+            }
+
+            free_range(m_freeVertices, m_firstFreeVertex, range->vertexOffset, range->vertexCount);
+            free_range(m_freeIndices, m_firstFreeIndex, range->indexOffset, range->indexCount);
+            free_range(m_freeMeshes, m_firstFreeMesh, range->meshOffset, meshDataRow);
+            free_range(m_freeMeshlets, m_firstFreeMeshlet, range->meshletOffset, range->meshletCount);
+
+            m_ranges.erase(mesh);
+        }
+    }
+
     std::span<const h32<string>> mesh_table::vertex_attribute_names() const
     {
         return m_vertexTable.names();
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <oblo/core/dynamic_array.hpp>
 #include <oblo/core/handle_flat_pool_map.hpp>
 #include <oblo/vulkan/buffer_table.hpp>
 
@@ -77,6 +78,10 @@ namespace oblo::vk
 
         bool allocate_meshes(std::span<const mesh_table_entry> meshes, std::span<mesh_table_entry_id> outHandles);
 
+        /// @brief Makes the space of the meshes available to new allocations.
+        /// @remarks The caller has to make sure the GPU is done with the meshes.
+        void free_meshes(std::span<const mesh_table_entry_id> meshes);
+
         std::span<const h32<string>> vertex_attribute_names() const;
         std::span<const h32<buffer>> vertex_attribute_buffers() const;
         std::span<const u32> vertex_attribute_element_sizes() const;
@@ -96,6 +101,13 @@ namespace oblo::vk
 
         buffer_range get_mesh_range(mesh_table_entry_id mesh) const;
 
+    private:
+        struct unused_range
+        {
+            u32 offset;
+            u32 count;
+        };
+
     private:
         static constexpr u32 GenIdBits = 0;
 
@@ -108,6 +120,10 @@ namespace oblo::vk
         u32 m_firstFreeIndex{0u};
         u32 m_firstFreeMesh{0u};
         u32 m_firstFreeMeshlet{0u};
+        dynamic_array<unused_range> m_freeVertices;
+        dynamic_array<unused_range> m_freeIndices;
+        dynamic_array<unused_range> m_freeMeshes;
+        dynamic_array<unused_range> m_freeMeshlets;
         u32 m_totalIndices{0u};
         u32 m_indexByteSize{0u};
         h32<buffer> m_indexBuffer{};
@@ -1,5 +1,6 @@
 #include <oblo/vulkan/draw/resource_cache.hpp>
 
+#include <oblo/log/log.hpp>
 #include <oblo/resource/resource_ptr.hpp>
 #include <oblo/resource/resource_ref.hpp>
 #include <oblo/resource/resource_registry.hpp>
@@ -10,6 +11,8 @@ namespace oblo::vk
     struct resource_cache::cached_texture
     {
         h32<resident_texture> handle;
+        resource_ptr<texture> resource;
+        u32 version;
     };
 
     resource_cache::resource_cache() = default;
@@ -26,7 +29,9 @@ namespace oblo::vk
     {
         if (const auto it = m_textures.find(t.id); it != m_textures.end())
         {
-            return it->second.handle;
+            auto& cached = it->second;
+            update(cached);
+            return cached.handle;
         }
 
         const auto resource = m_resources->get_resource(t.id).as<texture>();
@@ -40,9 +45,37 @@ namespace oblo::vk
 
         if (handle)
         {
-            m_textures.emplace(t.id, handle);
+            const auto version = resource.get_version();
+            m_textures.emplace(t.id, cached_texture{.handle = handle, .resource = resource, .version = version});
         }
 
         return handle;
     }
+
+    void resource_cache::update()
+    {
+        for (auto& [id, cached] : m_textures)
+        {
+            update(cached);
+        }
+    }
+
+    void resource_cache::update(cached_texture& cached)
+    {
+        const auto version = cached.resource.get_version();
+
+        if (cached.version == version)
+        {
+            return;
+        }
+
+        // The handle is kept, since it might be stored in GPU data (e.g. materials) that is not converted again
+        if (!m_textureRegistry->update(cached.handle, *cached.resource.get(), cached.resource.get_name()))
+        {
+            log::warn("Failed to upload the reloaded texture {}", cached.resource.get_name());
+        }
+
+        // Failures are not retried until the resource is reloaded again
+        cached.version = version;
+    }
 }
\ No newline at end of file
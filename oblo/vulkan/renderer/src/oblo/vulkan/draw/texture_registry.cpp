@@ -183,13 +183,7 @@ namespace oblo::vk
 
         auto& t = m_textures[index];
 
-        if (t.image.allocation)
-        {
-            const auto submitIndex = m_vkCtx->get_submit_index();
-            m_vkCtx->destroy_deferred(t.image.allocation, submitIndex);
-            m_vkCtx->destroy_deferred(t.image.image, submitIndex);
-            m_vkCtx->destroy_deferred(t.imageView, submitIndex);
-        }
+        destroy_deferred(t);
 
         // Reset to the dummy
         t = m_textures[0];
@@ -200,6 +194,26 @@ namespace oblo::vk
         m_handlePool.release(texture.value);
     }
 
+    bool texture_registry::update(
+        h32<resident_texture> texture, const texture_resource& data, const debug_label& debugName)
+    {
+        const auto index = m_handlePool.get_index(texture.value);
+        OBLO_ASSERT(index != 0 && index < m_imageInfo.size());
+
+        resident_texture residentTexture;
+
+        if (!create(data, residentTexture, debugName))
+        {
+            return false;
+        }
+
+        // Descriptor sets are written every frame, so only the frames in flight might still be reading the old image
+        destroy_deferred(m_textures[index]);
+
+        set_texture(texture, residentTexture, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        return true;
+    }
+
     std::span<const VkDescriptorImageInfo> texture_registry::get_textures2d_info() const
     {
         return m_imageInfo;
@@ -282,6 +296,17 @@ namespace oblo::vk
         m_pendingUploads.clear();
     }
 
+    void texture_registry::destroy_deferred(const resident_texture& texture)
+    {
+        if (texture.image.allocation)
+        {
+            const auto submitIndex = m_vkCtx->get_submit_index();
+            m_vkCtx->destroy_deferred(texture.image.allocation, submitIndex);
+            m_vkCtx->destroy_deferred(texture.image.image, submitIndex);
+            m_vkCtx->destroy_deferred(texture.imageView, submitIndex);
+        }
+    }
+
     bool texture_registry::create(const texture_resource& texture, resident_texture& out, const debug_label& debugName)
     {
         out = resident_texture{};
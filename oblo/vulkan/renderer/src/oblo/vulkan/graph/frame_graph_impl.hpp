@@ -1,11 +1,14 @@
 #pragma once
 
 #include <oblo/core/dynamic_array.hpp>
+#include <oblo/core/flat_hash_map.hpp>
+#include <oblo/core/flat_hash_set.hpp>
 #include <oblo/core/frame_allocator.hpp>
 #include <oblo/core/graph/directed_graph.hpp>
 #include <oblo/core/handle_flat_pool_map.hpp>
 #include <oblo/core/hash.hpp>
 #include <oblo/core/random_generator.hpp>
+#include <oblo/core/string/transparent_string_hash.hpp>
 #include <oblo/core/types.hpp>
 #include <oblo/vulkan/graph/frame_graph_node_desc.hpp>
 #include <oblo/vulkan/graph/frame_graph_template.hpp>
@@ -18,8 +21,6 @@
 
 #include <iosfwd>
 #include <memory_resource>
-#include <unordered_map>
-#include <unordered_set>
 
 #include <vulkan/vulkan_core.h>
 
@@ -145,23 +146,8 @@ namespace oblo::vk
         staging_buffer_span source;
     };
 
-    struct transparent_string_hash
-    {
-        using is_transparent = void;
-
-        usize operator()(string_view str) const
-        {
-            return hash<string_view>{}(str);
-        }
-
-        usize operator()(const string& str) const
-        {
-            return hash<string>{}(str);
-        }
-    };
-
     using name_to_vertex_map =
-        std::unordered_map<string, frame_graph_topology::vertex_handle, transparent_string_hash, std::equal_to<>>;
+        flat_hash_map<string, frame_graph_topology::vertex_handle, transparent_string_hash, transparent_string_equal>;
 
     struct frame_graph_subgraph
     {
@@ -254,7 +240,7 @@ namespace oblo::vk
         u32 frameCounter{};
 
         // Used to send signals to the frame graph (e.g. reset an effect)
-        std::unordered_set<type_id> emptyEvents;
+        flat_hash_set<type_id> emptyEvents;
 
     public: // Internals for frame graph execution
         void mark_active_nodes();
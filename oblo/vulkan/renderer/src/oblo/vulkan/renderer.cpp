@@ -1,5 +1,6 @@
 #include <oblo/vulkan/renderer.hpp>
 
+#include <oblo/core/memory_tracking.hpp>
 #include <oblo/core/string/string.hpp>
 #include <oblo/trace/profile.hpp>
 #include <oblo/vulkan/draw/descriptor_set_pool.hpp>
@@ -86,6 +87,7 @@ namespace oblo::vk
     void renderer::update(frame_allocator& frameAllocator)
     {
         OBLO_PROFILE_SCOPE();
+        OBLO_MEMORY_TAG_SCOPE("renderer");
 
         auto& commandBuffer = m_vkContext->get_active_command_buffer();
 
@@ -0,0 +1,99 @@
+param(
+    # Path to a benchmark executable, e.g. oblo_ecs_benchmarks
+    [Parameter(Mandatory = $true)]
+    [string]
+    $Executable,
+    # Only run the benchmarks matching this regex
+    [string]
+    $Filter,
+    # Where to write the JSON results, defaults to <executable name>.json in the current directory
+    [string]
+    $Output,
+    # A JSON file produced by a previous run, to compare the results against
+    [string]
+    $Baseline,
+    # Relative slowdown of the CPU time above which a benchmark is reported as a regression
+    [double]
+    $Threshold = 0.05,
+    [int]
+    $Repetitions = 1
+)
+
+if (!$Output) {
+    $Output = "$([System.IO.Path]::GetFileNameWithoutExtension($Executable)).json"
+}
+
+$benchmarkParams = @(
+    "--benchmark_out=$Output"
+    '--benchmark_out_format=json'
+    "--benchmark_repetitions=$Repetitions"
+)
+
+if ($Filter) {
+    $benchmarkParams += "--benchmark_filter=$Filter"
+}
+
+if ($Repetitions -gt 1) {
+    # Only keep the aggregates, the median is used for the comparison
+    $benchmarkParams += '--benchmark_report_aggregates_only=true'
+}
+
+& $Executable $benchmarkParams
+
+if ($LASTEXITCODE -ne 0) {
+    exit $LASTEXITCODE
+}
+
+if (!$Baseline) {
+    exit 0
+}
+
+function ReadResults([string] $Path) {
+    $results = @{}
+
+    $json = Get-Content -Raw -Path $Path | ConvertFrom-Json
+
+    foreach ($b in $json.benchmarks) {
+        $isMedian = $b.run_type -eq 'aggregate' -and $b.aggregate_name -eq 'median'
+
+        if ($b.run_type -eq 'iteration' -or $isMedian) {
+            $results[$b.run_name ?? $b.name] = $b
+        }
+    }
+
+    return $results
+}
+
+$current = ReadResults $Output
+$previous = ReadResults $Baseline
+
+$regressions = 0
+
+$comparison = foreach ($name in $current.Keys | Sort-Object) {
+    $new = $current[$name]
+    $old = $previous[$name]
+
+    if (!$old) {
+        continue
+    }
+
+    $delta = ($new.cpu_time - $old.cpu_time) / $old.cpu_time
+
+    if ($delta -gt $Threshold) {
+        ++$regressions
+    }
+
+    [PSCustomObject]@{
+        Benchmark = $name
+        Baseline  = "{0:N2} {1}" -f $old.cpu_time, $old.time_unit
+        Current   = "{0:N2} {1}" -f $new.cpu_time, $new.time_unit
+        Delta     = "{0:P1}" -f $delta
+    }
+}
+
+$comparison | Format-Table -AutoSize
+
+if ($regressions -gt 0) {
+    Write-Host "$regressions benchmark(s) regressed by more than $("{0:P0}" -f $Threshold)"
+    exit 1
+}
@@ -0,0 +1,174 @@
+#include <oblo/core/filesystem/mapped_file.hpp>
+#include <oblo/core/uuid.hpp>
+#include <oblo/resource/resource_pack.hpp>
+
+#include <cxxopts.hpp>
+#include <nlohmann/json.hpp>
+
+#include <cstdio>
+#include <filesystem>
+
+namespace oblo
+{
+    namespace
+    {
+        constexpr std::string_view ArtifactMetaExtension{".oartifact"};
+        constexpr std::string_view ArtifactContentDirectory{"content"};
+
+        struct artifact_info
+        {
+            uuid id;
+            std::string type;
+            std::string name;
+            /// @brief The name of the data file in the content directory, empty if the data is stored by id.
+            std::string content;
+        };
+
+        bool read_artifact_meta(const std::filesystem::path& path, artifact_info& out)
+        {
+            filesystem::mapped_file file;
+
+            if (!file.open(cstring_view{path.u8string().c_str()}))
+            {
+                return false;
+            }
+
+            const auto bytes = file.get_bytes();
+            const auto* const begin = reinterpret_cast<const char*>(bytes.data());
+
+            const auto json = nlohmann::json::parse(begin, begin + bytes.size(), nullptr, false);
+
+            if (!json.is_object())
+            {
+                return false;
+            }
+
+            const auto idIt = json.find("id");
+            const auto typeIt = json.find("type");
+
+            if (idIt == json.end() || !idIt->is_string() || typeIt == json.end() || !typeIt->is_string())
+            {
+                return false;
+            }
+
+            const auto id = uuid::parse(idIt->get<std::string_view>());
+
+            if (!id)
+            {
+                return false;
+            }
+
+            out.id = *id;
+            out.type = typeIt->get<std::string>();
+
+            if (const auto nameIt = json.find("name"); nameIt != json.end() && nameIt->is_string())
+            {
+                out.name = nameIt->get<std::string>();
+            }
+            else
+            {
+                out.name.clear();
+            }
+
+            if (const auto contentIt = json.find("content"); contentIt != json.end() && contentIt->is_string())
+            {
+                out.content = contentIt->get<std::string>();
+            }
+            else
+            {
+                out.content.clear();
+            }
+
+            return true;
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    using namespace oblo;
+
+    cxxopts::Options options{"artifact_packer", "Packs the artifacts of a project into a single resource pack"};
+
+    options.add_options()("input", "Artifacts directory", cxxopts::value<std::string>())(
+        "output",
+        "Resource pack to write",
+        cxxopts::value<std::string>())("compress", "Compress the artifacts that shrink with lz");
+
+    options.parse_positional({"input", "output"});
+
+    const auto result = options.parse(argc, argv);
+
+    if (!result.count("input") || !result.count("output"))
+    {
+        std::fputs(options.help().c_str(), stderr);
+        return 1;
+    }
+
+    const std::filesystem::path inputDir{result["input"].as<std::string>()};
+    const auto outputPath = result["output"].as<std::string>();
+
+    std::error_code ec;
+    std::filesystem::directory_iterator artifactsIt{inputDir, ec};
+
+    if (ec)
+    {
+        std::fprintf(stderr, "Failed to read %s\n", inputDir.string().c_str());
+        return 1;
+    }
+
+    resource_pack_writer writer;
+    artifact_info artifact;
+    u32 artifactsCount{};
+
+    // Each artifact is made of a meta named after its id, pointing to the data by content hash. Artifacts that share
+    // the same content share the data in the pack as well.
+    for (const auto& entry : artifactsIt)
+    {
+        const auto& metaPath = entry.path();
+
+        if (!entry.is_regular_file(ec) || metaPath.extension() != ArtifactMetaExtension)
+        {
+            continue;
+        }
+
+        if (!read_artifact_meta(metaPath, artifact))
+        {
+            std::fprintf(stderr, "Skipping %s, the meta is not valid\n", metaPath.string().c_str());
+            continue;
+        }
+
+        std::filesystem::path dataPath;
+
+        if (!artifact.content.empty())
+        {
+            dataPath = inputDir / ArtifactContentDirectory / artifact.content;
+        }
+        else
+        {
+            dataPath = metaPath;
+            dataPath.replace_extension();
+        }
+
+        if (!std::filesystem::is_regular_file(dataPath, ec))
+        {
+            std::fprintf(stderr, "Skipping %s, the data file is missing\n", metaPath.string().c_str());
+            continue;
+        }
+
+        writer.add(artifact.id, artifact.type, artifact.name, cstring_view{dataPath.u8string().c_str()});
+        ++artifactsCount;
+    }
+
+    const auto compression = result.count("compress") ? resource_pack_compression::lz : resource_pack_compression::none;
+
+    if (!writer.write(cstring_view{outputPath.c_str()}, compression))
+    {
+        std::fprintf(stderr, "Failed to write %s\n", outputPath.c_str());
+        return 1;
+    }
+
+    std::printf("Packed %u artifacts into %s\n", artifactsCount, outputPath.c_str());
+
+    return 0;
+}
\ No newline at end of file
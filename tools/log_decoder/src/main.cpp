@@ -0,0 +1,117 @@
+#include <oblo/core/dynamic_array.hpp>
+#include <oblo/core/filesystem/file.hpp>
+#include <oblo/core/filesystem/file_ptr.hpp>
+#include <oblo/core/string/string_builder.hpp>
+#include <oblo/log/binary_log.hpp>
+
+#include <cxxopts.hpp>
+
+#include <cstdio>
+
+namespace oblo
+{
+    namespace
+    {
+        constexpr cstring_view g_severityStrings[]{
+            "[DEBUG] ",
+            "[INFO] ",
+            "[WARN] ",
+            "[ERROR] ",
+        };
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    using namespace oblo;
+
+    cxxopts::Options options{"log_decoder", "Formats the messages of a binary log"};
+
+    options.add_options()("input", "Binary log file", cxxopts::value<std::string>())(
+        "output",
+        "Text file to write, stdout if not specified",
+        cxxopts::value<std::string>());
+
+    options.parse_positional({"input"});
+
+    const auto result = options.parse(argc, argv);
+
+    if (!result.count("input"))
+    {
+        std::fputs(options.help().c_str(), stderr);
+        return 1;
+    }
+
+    const auto inputPath = result["input"].as<std::string>();
+
+    dynamic_array<byte> data;
+
+    if (!filesystem::load_binary_file_into_memory(data, cstring_view{inputPath.c_str()}))
+    {
+        std::fprintf(stderr, "Failed to read %s\n", inputPath.c_str());
+        return 1;
+    }
+
+    log::binary_log_reader reader;
+
+    if (!reader.init(data))
+    {
+        std::fprintf(stderr, "%s is not a binary log\n", inputPath.c_str());
+        return 1;
+    }
+
+    filesystem::file_ptr outputFile;
+    FILE* output = stdout;
+
+    if (result.count("output"))
+    {
+        const auto outputPath = result["output"].as<std::string>();
+        outputFile.reset(filesystem::open_file(cstring_view{outputPath.c_str()}, "w"));
+
+        if (!outputFile)
+        {
+            std::fprintf(stderr, "Failed to open %s\n", outputPath.c_str());
+            return 1;
+        }
+
+        output = outputFile.get();
+    }
+
+    // Timestamps are printed relative to the first message, like the file sink does with its base time
+    oblo::time baseTime{};
+    bool isFirst{true};
+
+    string_builder line;
+    log::binary_log_message message;
+
+    while (true)
+    {
+        const auto r = reader.read_next(message);
+
+        if (!r)
+        {
+            std::fprintf(stderr, "The log is malformed, or it was truncated\n");
+            return 1;
+        }
+
+        if (!*r)
+        {
+            break;
+        }
+
+        if (isFirst)
+        {
+            baseTime = message.timestamp;
+            isFirst = false;
+        }
+
+        line.clear().format("[{:.3f}] ", to_f32_seconds(message.timestamp - baseTime));
+        line.append(g_severityStrings[u32(message.severity)]);
+        line.append(message.message);
+        line.append('\n');
+
+        std::fwrite(line.data(), 1, line.size(), output);
+    }
+
+    return 0;
+}
\ No newline at end of file